@@ -1,12 +1,19 @@
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <sstream>
 
 #include "modules/csv_order_generator.hpp"
+#include "modules/hiccup_benchmark.hpp"
+#include "modules/idle_strategy_benchmark.hpp"
 #include "modules/mock_client.hpp"
 #include "modules/mpsc_benchmark.hpp"
+#include "modules/open_loop.hpp"
 #include "modules/order_book_benchmark.hpp"
 #include "modules/order_generator.hpp"
+#include "modules/parser_benchmark.hpp"
+#include "modules/sharded_benchmark.hpp"
+#include "modules/timer_benchmark.hpp"
 
 #include "core/order.hpp"
 #include "core/order_book_factory.hpp"
@@ -18,16 +25,41 @@ void printUsage()
 {
     std::cout << "Usage: orderbook_benchmark [options]\n"
               << "Options:\n"
-              << "  --mode <direct|gateway|mpsc>  (default: direct)\n"
+              << "  --mode <direct|gateway|mpsc|idle|sharded|parser|timer|hiccup> (default: direct)\n"
               << "  --book <map|array|vector|hybrid|pool|all> (default: map)\n"
               << "  --scenario <name|all>    (default: mixed)\n"
               << "  --csv <filename>         (optional: load orders from CSV)\n"
               << "  --orders <count>         (default: 10000, if no CSV)\n"
               << "  --port <number>          (default: 12345, for gateway mode)\n"
+              << "  --transport <tcp|unix|shm> (default: tcp, for gateway mode; match the server's --transport)\n"
+              << "  --socket-path <path>     (default: /tmp/hft-gateway-<port>.sock, for unix/shm transports)\n"
               << "  --producers <count|all>  (default: 4, for mpsc mode; 'all' sweeps 1/2/4/8)\n"
+              << "  --idle <name|all>        (default: all, for idle mode: spin|pause|backoff|park)\n"
+              << "  --idle-gap-us <us>       (default: 20, for idle mode: producer gap between orders)\n"
+              << "  --shards <count|all>     (default: all, for sharded mode; 'all' sweeps 1/2/4/8 engine threads)\n"
+              << "  --clients <count>        (default: 1, for gateway mode: concurrent connections sharing the orders)\n"
+              << "  --variant <label>        (optional, for gateway mode: server configuration tag, e.g. pool4)\n"
+              << "  --protocol <fix|binary> (default: fix, for gateway mode: order entry encoding)\n"
+              << "  --exec-reports           (gateway mode: read acks from an --exec-reports server, time round trip)\n"
+              << "  --fix-session            (gateway mode: Logon, then sequence every message; needs --fix-session)\n"
+              << "  --seq-gap-every <n>      (default: 0, --fix-session: drop every n-th order, forcing a resend)\n"
+              << "  --fragment               (gateway mode: send every frame in pieces split at adversarial bytes)\n"
+              << "  --rate <r[,r...]>        (optional, gateway/mpsc: open loop at r orders/s; a list sweeps)\n"
+              << "  --capture <file>         (optional, for parser mode: raw FIX byte stream decoded as an extra mix)\n"
+              << "  --price-decimals <n>     (default: 0, for parser mode: write Price(44) with n implied decimals)\n"
+              << "  --symbols <count>        (default: 1, or 64 in sharded mode: instruments, one book each)\n"
+              << "  --symbol-skew <s>        (default: 1.0, Zipf exponent of symbol popularity; 0 = uniform)\n"
+              << "  --trace-capacity <n>     (optional, for direct mode: trace every order like the server's --trace)\n"
+              << "  --perf-counters          (direct mode: per-operation hardware counters -> *_counters.csv)\n"
+              << "  --sample-every <n>       (direct mode: time about 1 order in n, at random gaps)\n"
+              << "  --batch-size <k>         (direct mode: time blocks of k orders, report the average)\n"
+              << "  --hiccup-ms <ms>         (default: 1000, for hiccup mode: spin time per core)\n"
+              << "  --jitter-threshold-us <us> (default: 2, for hiccup mode: gaps above this count as stalls)\n"
               << "  --runs <count>           (default: 1)\n"
               << "  --csv_out <filename>     (default: results/results.csv)\n"
-              << "  --pin-core <id>          (optional: pin benchmark thread in direct/mpsc modes)\n"
+              << "  --pin-core <id>          (optional: pin benchmark thread in direct/mpsc/parser/timer modes,\n"
+              << "                            engine in idle mode, shard i to core id+i in sharded mode,\n"
+              << "                            the only core measured in hiccup mode)\n"
               << "  --list_books             (list all supported order book types and exit)\n"
               << "  --list_scenarios         (list all supported scenarios and exit)\n"
               << "  --help                   (show this help and exit)\n";
@@ -66,6 +98,31 @@ struct BenchmarkResult
     uint64_t mpscQueueP99 = 0;
     double mpscEngineMean = 0.0;
     uint64_t mpscEngineP99 = 0;
+
+    // Variant of the mode under test (e.g. idle strategy); part of the result key when set
+    std::string variant;
+    double cpuUtilPct = 0.0;
+
+    // Number of instruments the flow was spread over; part of the result key
+    size_t symbolCount = 1;
+
+    // Engine threads in sharded mode (0 otherwise); part of the sharded result key
+    int shardCount = 0;
+
+    // Gateway with --exec-reports: client round trip, order send -> ack received (0 otherwise)
+    double rttMean = 0.0;
+    double rttP99 = 0.0;
+
+    // Direct with --perf-counters: user-space events per order over the measured phase (0 otherwise)
+    double cyclesPerOrder = 0.0;
+    double instructionsPerOrder = 0.0;
+    double l1dMissesPerOrder = 0.0;
+    double llcMissesPerOrder = 0.0;
+    double branchMissesPerOrder = 0.0;
+    double dtlbMissesPerOrder = 0.0;
+
+    // Direct: timer brackets inside the mean latency, from the measured p50 of an empty fenced region
+    double timerOverheadNs = 0.0;
 };
 
 // Helper for mean and standard deviation
@@ -103,6 +160,8 @@ std::vector<BenchmarkResult> loadExistingResults(const std::string &filename)
         std::string mode, book, scenario, lat_s, lat_sd_s, p99_s, p99_sd_s, max_s, thru_s, thru_sd_s;
         std::string net_s, que_s, eng_s, ins_s, can_s, lkp_s, mtc_s;
         std::string prod_s, drop_s, depth_s, m_que_s, m_p99_s, m_eng_s, m_ep99_s;
+        std::string variant_s, cpu_s, sym_s, shard_s, rtt_s, rtt_p99_s;
+        std::string cyc_s, ins_cnt_s, l1d_s, llc_s, brm_s, tlb_s, tmr_s;
 
         std::getline(ss, mode, ',');
         std::getline(ss, book, ',');
@@ -128,6 +187,19 @@ std::vector<BenchmarkResult> loadExistingResults(const std::string &filename)
         std::getline(ss, m_p99_s, ',');
         std::getline(ss, m_eng_s, ',');
         std::getline(ss, m_ep99_s, ',');
+        std::getline(ss, variant_s, ',');
+        std::getline(ss, cpu_s, ',');
+        std::getline(ss, sym_s, ',');
+        std::getline(ss, shard_s, ',');
+        std::getline(ss, rtt_s, ',');
+        std::getline(ss, rtt_p99_s, ',');
+        std::getline(ss, cyc_s, ',');
+        std::getline(ss, ins_cnt_s, ',');
+        std::getline(ss, l1d_s, ',');
+        std::getline(ss, llc_s, ',');
+        std::getline(ss, brm_s, ',');
+        std::getline(ss, tlb_s, ',');
+        std::getline(ss, tmr_s, ',');
 
         try
         {
@@ -198,6 +270,31 @@ std::vector<BenchmarkResult> loadExistingResults(const std::string &filename)
                 res.mpscEngineMean = std::stod(m_eng_s);
             if (!m_ep99_s.empty())
                 res.mpscEngineP99 = std::stoull(m_ep99_s);
+            res.variant = variant_s;
+            if (!cpu_s.empty())
+                res.cpuUtilPct = std::stod(cpu_s);
+            if (!sym_s.empty())
+                res.symbolCount = std::stoul(sym_s);
+            if (!shard_s.empty())
+                res.shardCount = std::stoi(shard_s);
+            if (!rtt_s.empty())
+                res.rttMean = std::stod(rtt_s);
+            if (!rtt_p99_s.empty())
+                res.rttP99 = std::stod(rtt_p99_s);
+            if (!cyc_s.empty())
+                res.cyclesPerOrder = std::stod(cyc_s);
+            if (!ins_cnt_s.empty())
+                res.instructionsPerOrder = std::stod(ins_cnt_s);
+            if (!l1d_s.empty())
+                res.l1dMissesPerOrder = std::stod(l1d_s);
+            if (!llc_s.empty())
+                res.llcMissesPerOrder = std::stod(llc_s);
+            if (!brm_s.empty())
+                res.branchMissesPerOrder = std::stod(brm_s);
+            if (!tlb_s.empty())
+                res.dtlbMissesPerOrder = std::stod(tlb_s);
+            if (!tmr_s.empty())
+                res.timerOverheadNs = std::stod(tmr_s);
             results.push_back(res);
         }
         catch (...)
@@ -218,7 +315,8 @@ void saveResults(const std::string &filename, const std::vector<BenchmarkResult>
     // Updated header to include P99StdDev
     outFile << "Mode,Book,Scenario,Latency_ns,LatencyStdDev_ns,P99_ns,P99StdDev_ns,Max_ns,Throughput,ThroughputStdDev,"
                "Network_ns,Queue_ns,Engine_ns,Insert_ns,Cancel_ns,Lookup_ns,Match_ns,Producers,Dropped,PeakDepth,"
-               "MpscQue_ns,MpscQueP99_ns,MpscEng_ns,MpscEngP99_ns\n";
+               "MpscQue_ns,MpscQueP99_ns,MpscEng_ns,MpscEngP99_ns,Variant,CpuUtil_pct,Symbols,Shards,Rtt_ns,"
+               "RttP99_ns,Cycles,Instructions,L1dMisses,LlcMisses,BranchMisses,DtlbMisses,TimerOverhead_ns\n";
     for (const auto &res : results)
     {
         double meanLat = (res.mode == "gateway") ? res.serverMean : res.mean;
@@ -232,18 +330,24 @@ void saveResults(const std::string &filename, const std::vector<BenchmarkResult>
                 << "," << res.dirCancelMean << "," << res.dirLookupMean << "," << res.dirMatchMean << ","
                 << res.producerCount << "," << res.ordersDropped << "," << res.peakQueueDepth << ","
                 << res.mpscQueueMean << "," << res.mpscQueueP99 << "," << res.mpscEngineMean << "," << res.mpscEngineP99
-                << "\n";
+                << "," << res.variant << "," << res.cpuUtilPct << "," << res.symbolCount << ","
+                << res.shardCount << "," << res.rttMean << "," << res.rttP99 << "," << res.cyclesPerOrder << ","
+                << res.instructionsPerOrder << "," << res.l1dMissesPerOrder << "," << res.llcMissesPerOrder << ","
+                << res.branchMissesPerOrder << "," << res.dtlbMissesPerOrder << "," << res.timerOverheadNs << "\n";
     }
 }
 
 void upsertResult(std::vector<BenchmarkResult> &results, const BenchmarkResult &newRes)
 {
-    // For MPSC, each producer count is a distinct experiment — include it in the key.
+    // For MPSC (producers) and gateway (clients), each connection count is a distinct experiment — include it in the key.
     auto isSameKey = [&](const BenchmarkResult &r)
     {
-        bool base = r.mode == newRes.mode && r.book == newRes.book && r.scenario == newRes.scenario;
-        if (newRes.mode == "mpsc")
+        bool base = r.mode == newRes.mode && r.book == newRes.book && r.scenario == newRes.scenario &&
+                    r.variant == newRes.variant && r.symbolCount == newRes.symbolCount;
+        if (newRes.mode == "mpsc" || newRes.mode == "gateway")
             return base && r.producerCount == newRes.producerCount;
+        if (newRes.mode == "sharded")
+            return base && r.shardCount == newRes.shardCount;
         return base;
     };
     results.erase(std::remove_if(results.begin(), results.end(), isSameKey), results.end());
@@ -259,8 +363,10 @@ void cleanupDuplicates(std::vector<BenchmarkResult> &results)
         bool duplicate = false;
         for (const auto &u : uniqueResults)
         {
-            if (u.mode == res.mode && u.scenario == res.scenario && u.book == res.book &&
-                (res.mode != "mpsc" || u.producerCount == res.producerCount))
+            if (u.mode == res.mode && u.scenario == res.scenario && u.book == res.book && u.variant == res.variant &&
+                u.symbolCount == res.symbolCount && (res.mode != "mpsc" || u.producerCount == res.producerCount) &&
+                (res.mode != "gateway" || u.producerCount == res.producerCount) &&
+                (res.mode != "sharded" || u.shardCount == res.shardCount))
             {
                 duplicate = true;
                 break;
@@ -287,19 +393,25 @@ void printSummaryTable(const std::vector<BenchmarkResult> &allResults, const std
                       return a.mode < b.mode;
                   if (a.scenario != b.scenario)
                       return a.scenario < b.scenario;
-                  return a.book < b.book;
+                  if (a.book != b.book)
+                      return a.book < b.book;
+                  if (a.variant != b.variant)
+                      return a.variant < b.variant;
+                  if (a.symbolCount != b.symbolCount)
+                      return a.symbolCount < b.symbolCount;
+                  return a.shardCount < b.shardCount;
               });
 
-    std::cout << "\n" << std::string(205, '=') << "\n";
+    std::cout << "\n" << std::string(213, '=') << "\n";
     std::cout << "GLOBAL PERFORMANCE SUMMARY (all recorded runs)\n";
-    std::cout << std::string(205, '=') << "\n";
-    std::cout << std::left << std::setw(10) << "Mode" << std::setw(20) << "Scenario" << std::setw(12) << "Book"
+    std::cout << std::string(213, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Mode" << std::setw(20) << "Scenario" << std::setw(20) << "Book"
               << std::right << std::setw(13) << "Latency(ns)" << std::setw(12) << "Std" << std::setw(12) << "P99(ns)"
               << std::setw(12) << "P99Std" << std::setw(12) << "Max(ns)" << std::setw(15) << "Throughput"
               << std::setw(12) << "Net/Prod" << std::setw(12) << "Que(ns)" << std::setw(12) << "Eng(ns)"
               << std::setw(12) << "Ins(ns)" << std::setw(12) << "Can(ns)" << std::setw(12) << "Lkp(ns)" << std::setw(15)
               << "Match/Drop";
-    std::cout << "\n" << std::string(205, '-') << "\n";
+    std::cout << "\n" << std::string(213, '-') << "\n";
 
     std::string lastModeScenario = "";
     for (const auto &res : sortedResults)
@@ -307,11 +419,20 @@ void printSummaryTable(const std::vector<BenchmarkResult> &allResults, const std
         std::string currentKey = res.mode + res.scenario;
         if (!lastModeScenario.empty() && currentKey != lastModeScenario)
         {
-            std::cout << std::string(205, '-') << "\n";
+            std::cout << std::string(213, '-') << "\n";
         }
 
-        std::cout << std::left << std::setw(10) << res.mode << std::setw(20) << res.scenario << std::setw(12)
-                  << res.book;
+        std::string bookLabel = res.variant.empty() ? res.book : res.book + "/" + res.variant;
+        if (res.symbolCount > 1)
+        {
+            bookLabel += " x" + std::to_string(res.symbolCount);
+        }
+        if (res.mode == "gateway" && res.producerCount > 1)
+        {
+            bookLabel += " c" + std::to_string(res.producerCount);
+        }
+        std::cout << std::left << std::setw(10) << res.mode << std::setw(20) << res.scenario << std::setw(20)
+                  << bookLabel;
 
         double displayMean = (res.mode == "gateway") ? res.serverMean : res.mean;
         uint64_t displayP99 = (res.mode == "gateway") ? res.serverP99 : res.p99;
@@ -329,6 +450,34 @@ void printSummaryTable(const std::vector<BenchmarkResult> &allResults, const std
                       << res.serverQueMean << std::setw(12) << res.serverEngMean << std::setw(12) << "-"
                       << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(15) << "-";
         }
+        else if (res.mode == "idle")
+        {
+            // Que=wake-up latency, Match/Drop column carries engine CPU burn (%)
+            std::cout << std::setw(12) << "-" << std::setw(12) << std::fixed << std::setprecision(2) << res.mean
+                      << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-"
+                      << std::setw(14) << res.cpuUtilPct << "%";
+        }
+        else if (res.mode == "sharded")
+        {
+            // Prod column: shard count. Que=router-to-engine latency, Eng=engine latency
+            std::cout << std::setw(12) << std::fixed << std::setprecision(0) << (double)res.shardCount
+                      << std::setw(12) << std::setprecision(2) << res.serverQueMean << std::setw(12)
+                      << res.serverEngMean << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-"
+                      << std::setw(15) << "-";
+        }
+        else if (res.mode == "hiccup")
+        {
+            // Gaps between a spinning thread's clock reads; last column = share of the time it ran
+            std::cout << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-"
+                      << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(14) << std::fixed
+                      << std::setprecision(3) << res.cpuUtilPct << "%";
+        }
+        else if (res.mode == "parser" || res.mode == "timer")
+        {
+            // Parser: decode time per message, msgs/s. Timer: empty timed region, timestamp reads/s
+            std::cout << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-"
+                      << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(15) << "-";
+        }
         else if (res.mode == "mpsc")
         {
             // Prod column: producer count. Que=queue latency, Eng=engine latency, Match=dropped orders
@@ -346,30 +495,205 @@ void printSummaryTable(const std::vector<BenchmarkResult> &allResults, const std
         std::cout << "\n";
         lastModeScenario = currentKey;
     }
-    std::cout << std::string(205, '=') << "\n";
+    std::cout << std::string(213, '=') << "\n";
     std::cout << "[Note] Latency = Pure Algorithmic Time (Direct) or End-to-End System Time (Gateway)\n";
+    std::cout << "[Note] Idle rows: Latency = push-to-engine wake-up time, last column = engine CPU burn\n";
+    std::cout << "[Note] Book 'xN' = order flow spread over N instruments (one book per symbol), 'cN' = N gateway clients\n";
+    std::cout << "[Note] Sharded rows: Net/Prod column = engine threads, Latency = router-to-engine queue time\n";
+    std::cout << "[Note] Parser rows: Book = fix/<message mix>/<parser>, Latency = decode time per message\n";
+    std::cout << "[Note] Timer rows: Latency = empty timed region (subtract from direct), Throughput = reads/s\n";
+    std::cout << "[Note] Hiccup rows: Latency = gap between clock reads of a spinning thread, last column = % it ran\n";
+    std::cout << "[Note] Variant 'openN' = open loop at N orders/s, latency from intended send time\n";
+    std::cout << "[Note] Variant 'probes' = HFT_ENABLE_MATCH_PROBES build, match() time includes the probes\n";
+    std::cout << "[Note] Variant 'sampleN' / 'batchK' = direct mode timing 1 order in N / blocks of K orders\n";
     if (!csvOut.empty())
     {
         std::cout << "Results saved to: " << csvOut << "\n\n";
     }
 }
 
+// Companion of the results CSV: results/results.csv -> results/results_<name>.csv
+std::string companionCsvPath(const std::string &csvOut, const std::string &name)
+{
+    const std::string suffix = ".csv";
+    if (csvOut.size() > suffix.size() && csvOut.compare(csvOut.size() - suffix.size(), suffix.size(), suffix) == 0)
+        return csvOut.substr(0, csvOut.size() - suffix.size()) + "_" + name + ".csv";
+    return csvOut + "_" + name + ".csv";
+}
+
+// Companion rows start with the result's key. Rows of the same mode, book, scenario, variant and symbol
+// count are replaced, the way upsertResult replaces result rows.
+std::string companionKey(const BenchmarkResult &res)
+{
+    return res.mode + "," + res.book + "," + res.scenario + "," + res.variant + "," + std::to_string(res.symbolCount) +
+           ",";
+}
+
+void upsertCompanionRows(const std::string &filename, const std::string &header, const std::string &key,
+                         const std::vector<std::string> &rows)
+{
+    std::vector<std::string> kept;
+    {
+        std::ifstream in(filename);
+        std::string line;
+        std::getline(in, line); // Skip header
+        while (std::getline(in, line))
+        {
+            if (line.rfind(key, 0) != 0)
+                kept.push_back(line);
+        }
+    }
+
+    std::ofstream out(filename, std::ios::trunc);
+    if (!out.is_open())
+        return;
+    out << header << "\n";
+    for (const auto &line : kept)
+        out << line << "\n";
+    for (const auto &line : rows)
+        out << key << line << "\n";
+}
+
+// --perf-counters: one row per operation type and event, long format for plotting
+void saveCounterResults(const std::string &filename, const BenchmarkResult &res, const OperationCounters &counters)
+{
+    std::vector<std::string> rows;
+    const std::pair<const char *, const PerfTotals *> operations[] = {{"insert", &counters.insert},
+                                                                      {"cancel", &counters.cancel},
+                                                                      {"lookup", &counters.lookup},
+                                                                      {"match", &counters.match},
+                                                                      {"total", &counters.total}};
+    for (const auto &[operation, totals] : operations)
+    {
+        for (size_t e = 0; e < counters.events.size(); ++e)
+        {
+            if (totals->regions > 0 && counters.counted[e])
+            {
+                std::ostringstream row;
+                row << operation << "," << counters.events[e].name << "," << std::fixed << std::setprecision(3)
+                    << totals->perRegion(e) << "," << totals->regions;
+                rows.push_back(row.str());
+            }
+        }
+    }
+    upsertCompanionRows(filename, "Mode,Book,Scenario,Variant,Symbols,Operation,Event,PerOperation,Operations",
+                        companionKey(res), rows);
+}
+
+// HFT_ENABLE_MATCH_PROBES builds: one row per match() phase
+void saveMatchPhaseResults(const std::string &filename, const BenchmarkResult &res, const MatchProfile &profile)
+{
+    const uint64_t matches = profile.matches();
+    const double totalTicks = static_cast<double>(profile.totalTicks());
+    if (matches == 0 || totalTicks == 0)
+        return;
+
+    std::vector<std::string> rows;
+    for (size_t p = 0; p < MatchProfile::PHASES; ++p)
+    {
+        const double ticks = static_cast<double>(profile.ticks[p]);
+        std::ostringstream row;
+        row << matchPhaseToString(static_cast<MatchPhase>(p)) << "," << std::fixed << std::setprecision(3)
+            << TscClock::toNs(ticks) / matches << "," << 100.0 * ticks / totalTicks << ","
+            << static_cast<double>(profile.entries[p]) / matches << "," << matches;
+        rows.push_back(row.str());
+    }
+    upsertCompanionRows(filename,
+                        "Mode,Book,Scenario,Variant,Symbols,Phase,NsPerMatch,SharePct,EntriesPerMatch,Matches",
+                        companionKey(res), rows);
+}
+
+// One book per instrument. Pool books are sized from the symbol's share of the flow (all runs reuse the
+// same books), so a thousand instruments do not each preallocate the default 1M-order pool.
+OrderBookRegistry makeDirectBooks(const std::string &currentBook, const std::vector<Order> &orders, size_t symbolCount,
+                                  int runs)
+{
+    if (symbolCount <= 1)
+    {
+        return OrderBookRegistry(OrderBookFactory::create(currentBook));
+    }
+
+    std::vector<Index> capacityBySymbol(symbolCount, 0);
+    for (const auto &order : orders)
+    {
+        if (order.quantity != 0 && order.symbol < symbolCount)
+        {
+            ++capacityBySymbol[order.symbol];
+        }
+    }
+    for (auto &capacity : capacityBySymbol)
+    {
+        capacity = capacity * static_cast<Index>(runs) + 1;
+    }
+    return OrderBookRegistry(currentBook, capacityBySymbol);
+}
+
 void runDirectBenchmark(const std::string &currentBook, const std::string &scenario, const std::vector<Order> &orders,
-                        int runs, std::vector<BenchmarkResult> &allResults)
+                        int runs, size_t symbolCount, size_t traceCapacity, bool perfCounters, TimingMode timing,
+                        size_t timingN, const std::string &csvOut, std::vector<BenchmarkResult> &allResults)
 {
-    auto book = OrderBookFactory::create(currentBook);
-    OrderBookBenchmark benchmark(currentBook, std::move(book));
+    OrderBookBenchmark benchmark(currentBook, makeDirectBooks(currentBook, orders, symbolCount, runs));
+    benchmark.setTiming(timing, timingN);
+    if (traceCapacity > 0)
+    {
+        benchmark.enableOrderTrace(traceCapacity);
+    }
+    if (perfCounters && !benchmark.enablePerfCounters())
+    {
+        std::cerr << "Warning: no hardware counter could be opened (no PMU exposed, or perf_event_paranoid > 2); "
+                     "running without --perf-counters\n";
+        perfCounters = false;
+    }
+
+    std::cout << "Running direct benchmark for " << currentBook << " (" << runs << " runs";
+    if (symbolCount > 1)
+    {
+        std::cout << ", " << symbolCount << " symbols";
+    }
+    if (MetricsCollector::BACKEND != MetricsBackend::Histogram)
+    {
+        std::cout << ", metrics: " << metricsBackendToString(MetricsCollector::BACKEND);
+    }
+    if (traceCapacity > 0)
+    {
+        std::cout << ", order trace";
+    }
+    if (perfCounters)
+    {
+        std::cout << ", hardware counters";
+    }
+    if (MATCH_PROBES_ENABLED)
+    {
+        std::cout << ", match probes";
+    }
+    if (timing == TimingMode::Sampled)
+    {
+        std::cout << ", timing 1 in " << timingN;
+    }
+    else if (timing == TimingMode::Batch)
+    {
+        std::cout << ", timing blocks of " << timingN;
+    }
+    std::cout << ")...\n";
 
-    std::cout << "Running direct benchmark for " << currentBook << " (" << runs << " runs)...\n";
+    // What the fenced TSC brackets add to the measured total per order. A timed order's total region holds
+    // its own bracket plus the nested insert/cancel, lookup and match ones; a batch spreads one bracket
+    // over its block.
+    const size_t readsPerOp = 1;
+    const double regionNs = static_cast<double>(TimerBenchmark::run("tsc-fenced", 100000).regionP50Ns);
+    const double timerOverheadNs =
+        timing == TimingMode::Batch ? regionNs / timingN : regionNs * static_cast<double>(3 + readsPerOp);
 
     std::vector<double> latencies, throughputs, p99s;
     std::vector<double> insLat, canLat, lkpLat, mtcLat;
     uint64_t sumMax = 0;
+    OperationCounters counters;
+    MatchProfile matchPhases;
 
     for (int r = 0; r < runs; ++r)
     {
         auto start = std::chrono::high_resolution_clock::now();
-        auto stats = benchmark.runScenario(orders, 1, orders.size() / 10);
+        auto stats = benchmark.runScenario(orders, readsPerOp, orders.size() / 10);
         auto end = std::chrono::high_resolution_clock::now();
 
         latencies.push_back(stats.totalStats.mean);
@@ -380,6 +704,8 @@ void runDirectBenchmark(const std::string &currentBook, const std::string &scena
         canLat.push_back(stats.cancelStats.mean);
         lkpLat.push_back(stats.lookupStats.mean);
         mtcLat.push_back(stats.matchStats.mean);
+        counters.merge(stats.counters);
+        matchPhases.merge(stats.matchPhases);
 
         auto durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
         if (durationNs > 0)
@@ -396,6 +722,38 @@ void runDirectBenchmark(const std::string &currentBook, const std::string &scena
     res.mode = "direct";
     res.book = currentBook;
     res.scenario = scenario;
+    res.variant = traceCapacity > 0 ? "trace" : ""; // Next to the untraced row: the difference is the trace cost
+    if (timing != TimingMode::Exhaustive)
+    {
+        const std::string tag = (timing == TimingMode::Sampled ? "sample" : "batch") + std::to_string(timingN);
+        res.variant = res.variant.empty() ? tag : res.variant + "-" + tag;
+    }
+    if (perfCounters)
+    {
+        // Counter reads are system calls between the timed regions: keep these latencies apart as well
+        res.variant = res.variant.empty() ? "perf" : res.variant + "-perf";
+        auto perOrder = [&](const std::string &event)
+        {
+            for (size_t e = 0; e < counters.events.size(); ++e)
+            {
+                if (counters.events[e].name == event && counters.counted[e])
+                    return counters.total.perRegion(e);
+            }
+            return 0.0;
+        };
+        res.cyclesPerOrder = perOrder("cycles");
+        res.instructionsPerOrder = perOrder("instructions");
+        res.l1dMissesPerOrder = perOrder("l1d_misses");
+        res.llcMissesPerOrder = perOrder("llc_misses");
+        res.branchMissesPerOrder = perOrder("branch_misses");
+        res.dtlbMissesPerOrder = perOrder("dtlb_misses");
+    }
+    if (MATCH_PROBES_ENABLED)
+    {
+        // The probes' TSC reads run inside the match region
+        res.variant = res.variant.empty() ? "probes" : res.variant + "-probes";
+    }
+    res.symbolCount = symbolCount;
     res.mean = latStats.mean;
     res.latencyStdDev = latStats.stddev;
     res.p99 = p99Stats.mean;
@@ -408,47 +766,152 @@ void runDirectBenchmark(const std::string &currentBook, const std::string &scena
     res.dirCancelMean = calculateStats(canLat).mean;
     res.dirLookupMean = calculateStats(lkpLat).mean;
     res.dirMatchMean = calculateStats(mtcLat).mean;
+    res.timerOverheadNs = timerOverheadNs;
 
     upsertResult(allResults, res);
     std::cout << "  Mean Latency:   " << std::fixed << std::setprecision(2) << res.mean << " ± " << res.latencyStdDev
               << " ns\n";
+    std::cout << "  Timer Overhead: " << std::fixed << std::setprecision(2) << timerOverheadNs
+              << " ns of the mean latency";
+    if (timing != TimingMode::Batch)
+    {
+        std::cout << ", " << regionNs << " ns of each per-operation mean";
+    }
+    std::cout << " (empty fenced region p50 " << regionNs << " ns)\n";
+
+    if (perfCounters)
+    {
+        BenchmarkFormatter::printCounterTable(currentBook, scenario, counters);
+        if (!csvOut.empty())
+            saveCounterResults(companionCsvPath(csvOut, "counters"), res, counters);
+    }
+    if (MATCH_PROBES_ENABLED)
+    {
+        BenchmarkFormatter::printMatchPhaseTable(currentBook, scenario, matchPhases);
+        if (!csvOut.empty())
+            saveMatchPhaseResults(companionCsvPath(csvOut, "match_phases"), res, matchPhases);
+    }
+}
+
+// Sends orders over clientCount concurrent connections (contiguous slices, one thread each).
+// Connection 0 doubles as the control connection for the U1 stats barrier. Returns false on any failure.
+// With rate > 0 the connections share an open-loop schedule at that combined rate and every order is
+// stamped with its intended send time; maxSendLagNs gets the worst lag behind the schedule.
+bool sendOverClients(std::vector<std::unique_ptr<MockClient>> &clients, const std::vector<Order> &orders,
+                     double rate, uint64_t &maxSendLagNs)
+{
+    const size_t sliceSize = (orders.size() + clients.size() - 1) / clients.size();
+    const uint64_t scheduleStartNs = getCurrentTimeNs() + OpenLoopSchedule::START_LEAD_NS;
+    std::vector<uint64_t> sendLags(clients.size(), 0);
+    std::atomic<bool> failed{false};
+    auto sendSlice = [&](size_t c)
+    {
+        const size_t from = std::min(c * sliceSize, orders.size());
+        const size_t to = std::min(from + sliceSize, orders.size());
+        if (rate <= 0)
+        {
+            for (size_t i = from; i < to && !failed.load(std::memory_order_relaxed); ++i)
+            {
+                if (!clients[c]->sendOrder(orders[i]))
+                    failed.store(true, std::memory_order_relaxed);
+            }
+            return;
+        }
+        OpenLoopSchedule schedule(rate, scheduleStartNs, clients.size(), c);
+        for (size_t i = from; i < to && !failed.load(std::memory_order_relaxed); ++i)
+        {
+            if (!clients[c]->sendOrder(orders[i], schedule.waitFor(i - from)))
+                failed.store(true, std::memory_order_relaxed);
+        }
+        sendLags[c] = schedule.getMaxLagNs();
+    };
+
+    if (clients.size() == 1)
+    {
+        sendSlice(0);
+    }
+    else
+    {
+        std::vector<std::thread> senders;
+        for (size_t c = 0; c < clients.size(); ++c)
+            senders.emplace_back(sendSlice, c);
+        for (auto &sender : senders)
+            sender.join();
+    }
+    maxSendLagNs = *std::max_element(sendLags.begin(), sendLags.end());
+    return !failed.load();
 }
 
-void runGatewayBenchmark(const std::string &currentBook, const std::string &scenario, const std::vector<Order> &orders,
-                         int runs, int port, std::vector<BenchmarkResult> &allResults)
+// rate > 0: open loop at that offered rate. The returned point is measured from intended send times: the
+// client round trip with execReports, otherwise the server's latencies (which accumulate across every
+// order the server has seen, so restart it between points when sweeping without execReports).
+LoadPoint runGatewayBenchmark(const std::string &currentBook, const std::string &scenario,
+                              const std::vector<Order> &orders, int runs, const TransportEndpoint &endpoint,
+                              size_t symbolCount, int clientCount, const std::string &variant, WireProtocol protocol,
+                              bool execReports, bool fixSession, size_t seqGapEvery, bool fragment, double rate,
+                              std::vector<BenchmarkResult> &allResults)
 {
-    std::cout << "Running gateway benchmark for " << currentBook << " (" << runs << " runs)...\n";
+    std::cout << "Running gateway benchmark for " << currentBook << " (" << runs << " runs";
+    if (clientCount > 1)
+        std::cout << ", " << clientCount << " clients";
+    if (!variant.empty())
+        std::cout << ", " << variant;
+    if (protocol == WireProtocol::Binary)
+        std::cout << ", binary protocol";
+    if (fixSession)
+        std::cout << ", FIX session" << (seqGapEvery > 0 ? ", gap every " + std::to_string(seqGapEvery) : "");
+    if (fragment)
+        std::cout << ", fragmented frames";
+    if (endpoint.kind != TransportKind::Tcp)
+        std::cout << ", " << endpoint.describe();
+    if (rate > 0)
+        std::cout << ", open loop at " << static_cast<uint64_t>(rate) << " orders/s";
+    std::cout << ")...\n";
 
     std::vector<double> latencies, throughputs, p99s;
     std::vector<double> netLats, queLats, engLats;
+    std::vector<double> rtts, rttP99s;
+    std::vector<double> serverP50s, serverP999s, rttP50s, rttP999s, rttMaxes;
     uint64_t sumMax = 0;
+    uint64_t maxSendLagNs = 0;
+    size_t resendRequests = 0;
+    LoadPoint point;
+    point.offeredRate = rate;
 
     for (int r = 0; r < runs; ++r)
     {
-        MockClient client("127.0.0.1", port);
-        if (!client.connect())
-        {
-            std::cerr << "Failed to connect to gateway at 127.0.0.1:" << port << "\n";
-            return;
-        }
-
-        auto startTotal = std::chrono::high_resolution_clock::now();
-        bool sendFailed = false;
-        for (const auto &order : orders)
+        // Connect everyone before the clock starts so connection setup is not measured
+        std::vector<std::unique_ptr<MockClient>> clients;
+        for (int c = 0; c < clientCount; ++c)
         {
-            if (!client.sendOrder(order))
+            clients.push_back(std::make_unique<MockClient>("127.0.0.1", endpoint.port));
+            clients.back()->setTransport(endpoint.kind, endpoint.path);
+            if (!clients.back()->connect())
             {
-                std::cerr << "Failed to send one or more orders to gateway\n";
-                sendFailed = true;
-                break;
+                std::cerr << "Failed to connect to gateway at " << endpoint.describe() << "\n";
+                return point;
+            }
+            clients.back()->setProtocol(protocol);
+            clients.back()->setFragmentation(fragment);
+            if (execReports)
+                clients.back()->enableExecutionReports();
+            if (fixSession)
+            {
+                if (!clients.back()->logon())
+                    std::cerr << "  No Logon reply (is the server running with --fix-session?); sending unsequenced\n";
+                clients.back()->setSequenceGapEvery(seqGapEvery);
             }
         }
+        MockClient &client = *clients[0];
 
-        if (sendFailed)
+        auto startTotal = std::chrono::high_resolution_clock::now();
+        uint64_t runSendLagNs = 0;
+        if (!sendOverClients(clients, orders, rate, runSendLagNs))
         {
-            client.disconnect();
-            return;
+            std::cerr << "Failed to send one or more orders to gateway\n";
+            return point;
         }
+        maxSendLagNs = std::max(maxSendLagNs, runSendLagNs);
 
         auto sStats = client.requestServerStats(orders.size());
         auto endTotal = std::chrono::high_resolution_clock::now();
@@ -459,16 +922,54 @@ void runGatewayBenchmark(const std::string &currentBook, const std::string &scen
             throughputs.push_back(orders.size() * 1e9 / durationNs);
         }
 
+        if (execReports)
+        {
+            // The engine has processed everything (U2 barrier); acks may still be in flight. Orders the
+            // gateway rejects get no ack, hence the bounded wait rather than an exact count.
+            const size_t sliceSize = (orders.size() + clients.size() - 1) / clients.size();
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            std::vector<uint64_t> samples;
+            for (size_t c = 0; c < clients.size(); ++c)
+            {
+                const size_t expected = std::min(sliceSize, orders.size() - std::min(c * sliceSize, orders.size()));
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                clients[c]->waitForAcks(expected, std::max(remaining, std::chrono::milliseconds(0)));
+                auto clientSamples = clients[c]->takeRoundTripSamples();
+                samples.insert(samples.end(), clientSamples.begin(), clientSamples.end());
+            }
+            if (!samples.empty())
+            {
+                std::sort(samples.begin(), samples.end());
+                rtts.push_back(std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size());
+                const size_t p99Index = std::min(samples.size() - 1, samples.size() * 99 / 100);
+                rttP99s.push_back(static_cast<double>(samples[p99Index]));
+                rttP50s.push_back(static_cast<double>(percentileOf(samples, 0.5)));
+                rttP999s.push_back(static_cast<double>(percentileOf(samples, 0.999)));
+                rttMaxes.push_back(static_cast<double>(samples.back()));
+            }
+            else
+            {
+                std::cerr << "  No execution reports received (is the server running with --exec-reports?)\n";
+            }
+        }
+
         if (sStats)
         {
             latencies.push_back(sStats->mean);
             p99s.push_back(sStats->p99);
             sumMax += sStats->max;
+            serverP50s.push_back(sStats->p50);
+            serverP999s.push_back(sStats->p999);
             netLats.push_back(sStats->netMean);
             queLats.push_back(sStats->queMean);
             engLats.push_back(sStats->engMean);
         }
-        client.disconnect();
+        for (auto &connection : clients)
+        {
+            resendRequests += connection->getResendRequestCount();
+            connection->disconnect();
+        }
     }
 
     auto latStats = calculateStats(latencies);
@@ -479,6 +980,26 @@ void runGatewayBenchmark(const std::string &currentBook, const std::string &scen
     gwRes.mode = "gateway";
     gwRes.book = currentBook;
     gwRes.scenario = scenario;
+    gwRes.symbolCount = symbolCount;
+    // Binary order entry is a distinct experiment: tag it so it never overwrites the FIX row
+    gwRes.variant = protocol == WireProtocol::Fix ? variant : (variant.empty() ? "binary" : variant + "-binary");
+    if (fixSession)
+    {
+        // Sequenced sessions (and forced gaps) are distinct experiments as well
+        const std::string tag = seqGapEvery > 0 ? "session-gap" + std::to_string(seqGapEvery) : "session";
+        gwRes.variant = gwRes.variant.empty() ? tag : gwRes.variant + "-" + tag;
+    }
+    if (fragment)
+        gwRes.variant = gwRes.variant.empty() ? "fragmented" : gwRes.variant + "-fragmented";
+    if (rate > 0)
+        gwRes.variant = gwRes.variant.empty() ? openLoopTag(rate) : gwRes.variant + "-" + openLoopTag(rate);
+    if (endpoint.kind != TransportKind::Tcp)
+    {
+        // Transport changes what "network" time means: never overwrite the TCP row
+        const std::string tag = TransportEndpoint::kindToString(endpoint.kind);
+        gwRes.variant = gwRes.variant.empty() ? tag : gwRes.variant + "-" + tag;
+    }
+    gwRes.producerCount = clientCount > 1 ? clientCount : 0; // 0 keeps single-client rows keyed as before
     gwRes.mean = 0; // gateway uses serverMean
     gwRes.latencyStdDev = latStats.stddev;
     gwRes.throughput = thrStats.mean;
@@ -491,29 +1012,63 @@ void runGatewayBenchmark(const std::string &currentBook, const std::string &scen
     gwRes.serverNetMean = calculateStats(netLats).mean;
     gwRes.serverQueMean = calculateStats(queLats).mean;
     gwRes.serverEngMean = calculateStats(engLats).mean;
+    gwRes.rttMean = calculateStats(rtts).mean;
+    gwRes.rttP99 = calculateStats(rttP99s).mean;
 
     upsertResult(allResults, gwRes);
     std::cout << "  Mean Server Latency: " << std::fixed << std::setprecision(2) << gwRes.serverMean << " ± "
               << gwRes.latencyStdDev << " ns\n";
+    if (execReports)
+        std::cout << "  Client Round Trip:   mean " << gwRes.rttMean << " ns, p99 " << gwRes.rttP99 << " ns\n";
+    if (fixSession)
+        std::cout << "  Resend Requests:     " << resendRequests / runs << " per run\n";
+
+    point.achievedRate = thrStats.mean;
+    point.maxSendLagNs = maxSendLagNs;
+    if (!rtts.empty())
+    {
+        point.meanNs = gwRes.rttMean;
+        point.p50Ns = calculateStats(rttP50s).mean;
+        point.p99Ns = gwRes.rttP99;
+        point.p999Ns = calculateStats(rttP999s).mean;
+        point.maxNs = calculateStats(rttMaxes).mean;
+    }
+    else
+    {
+        point.meanNs = gwRes.serverMean;
+        point.p50Ns = calculateStats(serverP50s).mean;
+        point.p99Ns = gwRes.serverP99;
+        point.p999Ns = calculateStats(serverP999s).mean;
+        point.maxNs = static_cast<double>(gwRes.serverMax);
+    }
+    return point;
 }
 
-void runMpscBenchmark(const std::string &currentBook, const std::string &scenario, const std::vector<Order> &orders,
-                      int runs, int producerCount, std::vector<BenchmarkResult> &allResults)
+// rate > 0: open loop at that offered rate; the returned point is the queue latency from intended send times
+LoadPoint runMpscBenchmark(const std::string &currentBook, const std::string &scenario,
+                           const std::vector<Order> &orders, int runs, int producerCount, double rate,
+                           std::vector<BenchmarkResult> &allResults)
 {
     std::cout << "Running MPSC benchmark for " << currentBook << " (" << producerCount << " producers, " << runs
-              << " runs)...\n";
+              << " runs";
+    if (rate > 0)
+        std::cout << ", open loop at " << static_cast<uint64_t>(rate) << " orders/s";
+    std::cout << ")...\n";
 
-    std::vector<double> queueLatencies, engineLatencies, throughputs, queueP99s;
-    uint64_t sumQueMax = 0, sumEngP99 = 0, sumDropped = 0, sumDepth = 0;
+    std::vector<double> queueLatencies, engineLatencies, throughputs, queueP99s, queueP50s, queueP999s;
+    uint64_t sumQueMax = 0, sumEngP99 = 0, sumDropped = 0, sumDepth = 0, maxSendLagNs = 0;
 
     MpscResult lastRes{}; // To keep some reference for printMpscTable
     for (int r = 0; r < runs; ++r)
     {
         auto book = OrderBookFactory::create(currentBook);
-        MpscResult res = MpscBenchmark::run(currentBook, std::move(book), orders, producerCount);
+        MpscResult res = MpscBenchmark::run(currentBook, std::move(book), orders, producerCount, rate);
 
         queueLatencies.push_back(res.queueMeanNs);
         queueP99s.push_back(res.queueP99Ns);
+        queueP50s.push_back(res.queueP50Ns);
+        queueP999s.push_back(res.queueP999Ns);
+        maxSendLagNs = std::max(maxSendLagNs, res.maxSendLagNs);
         engineLatencies.push_back(res.engineMeanNs);
         throughputs.push_back(res.throughputOrdersPerSec);
 
@@ -534,6 +1089,7 @@ void runMpscBenchmark(const std::string &currentBook, const std::string &scenari
     mpscRes.book = currentBook;
     mpscRes.scenario = scenario;
     mpscRes.producerCount = producerCount;
+    mpscRes.variant = rate > 0 ? openLoopTag(rate) : "";
     mpscRes.mean = qStats.mean;
     mpscRes.latencyStdDev = qStats.stddev;
     mpscRes.p99 = qP99Stats.mean;
@@ -561,6 +1117,298 @@ void runMpscBenchmark(const std::string &currentBook, const std::string &scenari
     lastRes.ordersDropped = sumDropped / runs;
 
     printMpscTable(currentBook, scenario, {lastRes});
+
+    LoadPoint point;
+    point.offeredRate = rate;
+    point.achievedRate = tStats.mean;
+    point.meanNs = qStats.mean;
+    point.p50Ns = calculateStats(queueP50s).mean;
+    point.p99Ns = qP99Stats.mean;
+    point.p999Ns = calculateStats(queueP999s).mean;
+    point.maxNs = static_cast<double>(sumQueMax / runs);
+    point.maxSendLagNs = maxSendLagNs;
+    return point;
+}
+
+void runIdleBenchmark(const std::string &currentBook, const std::string &scenario, const std::vector<Order> &orders,
+                      int runs, IdleStrategyType idleType, uint64_t gapNs, int engineCore,
+                      std::vector<BenchmarkResult> &allResults)
+{
+    const std::string strategyName = IdleStrategy::toString(idleType);
+    std::cout << "Running idle-strategy benchmark for " << currentBook << " (" << strategyName << ", " << runs
+              << " runs)...\n";
+
+    std::vector<double> wakeMeans, wakeP99s, cpuPcts, throughputs;
+    uint64_t sumMax = 0, sumWakeups = 0;
+
+    IdleStrategyResult lastRes{};
+    for (int r = 0; r < runs; ++r)
+    {
+        auto book = OrderBookFactory::create(currentBook);
+        IdleStrategyResult res = IdleStrategyBenchmark::run(std::move(book), orders, idleType, gapNs, engineCore);
+
+        wakeMeans.push_back(res.wakeMeanNs);
+        wakeP99s.push_back(res.wakeP99Ns);
+        cpuPcts.push_back(res.engineCpuPct);
+        throughputs.push_back(res.throughputOrdersPerSec);
+        sumMax += res.wakeMaxNs;
+        sumWakeups += res.parkWakeups;
+        lastRes = res;
+    }
+
+    auto wStats = calculateStats(wakeMeans);
+    auto wP99Stats = calculateStats(wakeP99s);
+    auto tStats = calculateStats(throughputs);
+
+    BenchmarkResult idleRes;
+    idleRes.mode = "idle";
+    idleRes.book = currentBook;
+    idleRes.scenario = scenario;
+    idleRes.variant = strategyName;
+    idleRes.mean = wStats.mean;
+    idleRes.latencyStdDev = wStats.stddev;
+    idleRes.p99 = wP99Stats.mean;
+    idleRes.p99StdDev = wP99Stats.stddev;
+    idleRes.max = sumMax / runs;
+    idleRes.throughput = tStats.mean;
+    idleRes.throughputStdDev = tStats.stddev;
+    idleRes.cpuUtilPct = calculateStats(cpuPcts).mean;
+    idleRes.serverQueMean = wStats.mean;
+
+    upsertResult(allResults, idleRes);
+
+    lastRes.wakeMeanNs = wStats.mean;
+    lastRes.engineCpuPct = idleRes.cpuUtilPct;
+    lastRes.throughputOrdersPerSec = tStats.mean;
+    lastRes.parkWakeups = sumWakeups / runs;
+
+    printIdleTable(currentBook, scenario, {lastRes});
+}
+
+void runTimerBenchmark(int runs, std::vector<BenchmarkResult> &allResults)
+{
+    constexpr size_t samples = 1000000;
+    std::cout << "Running timer benchmark (" << runs << " runs, " << samples << " reads per timer)...\n";
+
+    std::vector<TimerBenchResult> table;
+    for (const auto &timer : TimerBenchmark::getSupportedTimers())
+    {
+        std::vector<double> means, p99s, throughputs;
+        uint64_t sumMax = 0;
+        TimerBenchResult lastRes{};
+        for (int r = 0; r < runs; ++r)
+        {
+            TimerBenchResult res = TimerBenchmark::run(timer, samples);
+            means.push_back(res.regionMeanNs);
+            p99s.push_back(static_cast<double>(res.regionP99Ns));
+            throughputs.push_back(1e9 / res.callNs);
+            sumMax += res.regionMaxNs;
+            lastRes = res;
+        }
+
+        auto mStats = calculateStats(means);
+        auto pStats = calculateStats(p99s);
+        auto tStats = calculateStats(throughputs);
+
+        BenchmarkResult timerRes{};
+        timerRes.mode = "timer";
+        timerRes.book = "clock";
+        timerRes.scenario = "overhead";
+        timerRes.variant = timer;
+        timerRes.mean = mStats.mean;
+        timerRes.latencyStdDev = mStats.stddev;
+        timerRes.p99 = pStats.mean;
+        timerRes.p99StdDev = pStats.stddev;
+        timerRes.max = sumMax / runs;
+        timerRes.throughput = tStats.mean;
+        timerRes.throughputStdDev = tStats.stddev;
+        upsertResult(allResults, timerRes);
+
+        lastRes.regionMeanNs = mStats.mean;
+        lastRes.callNs = 1e9 / tStats.mean;
+        table.push_back(lastRes);
+    }
+    printTimerTable(table);
+}
+
+void runHiccupBenchmark(const std::vector<int> &cores, std::chrono::milliseconds duration,
+                        std::chrono::nanoseconds threshold, int runs, std::vector<BenchmarkResult> &allResults)
+{
+    std::cout << "Running hiccup benchmark (" << runs << " runs, " << duration.count() << " ms per core, "
+              << cores.size() << " cores)...\n";
+
+    std::vector<HiccupResult> table;
+    for (const int core : cores)
+    {
+        std::vector<double> means, p99s, throughputs, available;
+        uint64_t sumMax = 0;
+        HiccupResult lastRes{};
+        for (int r = 0; r < runs; ++r)
+        {
+            HiccupResult res = HiccupBenchmark::run(core, duration, threshold);
+            means.push_back(res.gaps.mean);
+            p99s.push_back(static_cast<double>(res.gaps.p99));
+            throughputs.push_back(res.durationMs > 0.0 ? static_cast<double>(res.reads) * 1000.0 / res.durationMs
+                                                       : 0.0);
+            available.push_back(100.0 - res.jitter.stalledPct());
+            sumMax += res.gaps.max;
+            lastRes = res;
+        }
+
+        auto mStats = calculateStats(means);
+        auto pStats = calculateStats(p99s);
+        auto tStats = calculateStats(throughputs);
+
+        BenchmarkResult hiccupRes{};
+        hiccupRes.mode = "hiccup";
+        hiccupRes.book = core < 0 ? "any" : "core" + std::to_string(core);
+        hiccupRes.scenario = "platform";
+        hiccupRes.mean = mStats.mean;
+        hiccupRes.latencyStdDev = mStats.stddev;
+        hiccupRes.p99 = pStats.mean;
+        hiccupRes.p99StdDev = pStats.stddev;
+        hiccupRes.max = sumMax / runs;
+        hiccupRes.throughput = tStats.mean;
+        hiccupRes.throughputStdDev = tStats.stddev;
+        hiccupRes.cpuUtilPct = calculateStats(available).mean;
+        upsertResult(allResults, hiccupRes);
+
+        table.push_back(lastRes);
+    }
+    printHiccupTable(table);
+}
+
+void runParserBenchmark(const std::string &scenario, const std::vector<Order> &orders, int runs, size_t symbolCount,
+                        uint8_t priceDecimals, const std::string &capturePath, std::vector<BenchmarkResult> &allResults)
+{
+    const SymbolTable symbols = SymbolTable::makeSynthetic(symbolCount, priceDecimals);
+    std::cout << "Running FIX parser benchmark (" << runs << " runs, scanner default: "
+              << FixScanner::toString(FixScanner::getLevel()) << ")...\n";
+
+    std::vector<std::pair<std::string, std::string>> streams;
+    for (const auto &mix : ParserBenchmark::getSupportedMixes())
+    {
+        const std::string label = priceDecimals > 0 ? mix + "-d" + std::to_string(priceDecimals) : mix;
+        streams.emplace_back(label, ParserBenchmark::buildStream(orders, mix, priceDecimals));
+    }
+    if (!capturePath.empty())
+    {
+        streams.emplace_back("capture", ParserBenchmark::loadCapture(capturePath));
+        if (streams.back().second.empty())
+        {
+            std::cerr << "Warning: capture " << capturePath << " is empty or unreadable; skipped\n";
+            streams.pop_back();
+        }
+    }
+
+    std::vector<ParserBenchResult> table;
+    for (const auto &[mix, stream] : streams)
+    {
+        // Enough passes for ~128 MB decoded per run, so small --orders still give stable numbers
+        const int passes = static_cast<int>(std::max<size_t>(1, (128u << 20) / std::max<size_t>(1, stream.size())));
+        std::cout << "  " << mix << ": " << std::fixed << std::setprecision(2) << stream.size() / 1048576.0
+                  << " MB stream, " << passes << " passes\n";
+        for (const auto &parser : ParserBenchmark::getSupportedParsers())
+        {
+            if (!ParserBenchmark::appliesTo(parser, mix))
+                continue;
+            std::vector<double> means, p99s, throughputs;
+            uint64_t sumMax = 0;
+            ParserBenchResult lastRes{};
+            for (int r = 0; r < runs; ++r)
+            {
+                ParserBenchResult res = ParserBenchmark::run(stream, parser, symbols, passes);
+                means.push_back(res.meanNs);
+                p99s.push_back(static_cast<double>(res.p99Ns));
+                throughputs.push_back(res.throughputMsgsPerSec);
+                sumMax += res.maxNs;
+                lastRes = res;
+            }
+
+            auto mStats = calculateStats(means);
+            auto pStats = calculateStats(p99s);
+            auto tStats = calculateStats(throughputs);
+
+            BenchmarkResult parserRes{};
+            parserRes.mode = "parser";
+            parserRes.book = "fix";
+            parserRes.scenario = scenario;
+            parserRes.variant = mix + "/" + parser;
+            parserRes.mean = mStats.mean;
+            parserRes.latencyStdDev = mStats.stddev;
+            parserRes.p99 = pStats.mean;
+            parserRes.p99StdDev = pStats.stddev;
+            parserRes.max = sumMax / runs;
+            parserRes.throughput = tStats.mean;
+            parserRes.throughputStdDev = tStats.stddev;
+            parserRes.symbolCount = symbolCount;
+            upsertResult(allResults, parserRes);
+
+            lastRes.mix = mix;
+            lastRes.meanNs = mStats.mean;
+            lastRes.throughputMsgsPerSec = tStats.mean;
+            table.push_back(lastRes);
+        }
+    }
+    printParserTable(scenario, table);
+}
+
+void runShardedBenchmark(const std::string &currentBook, const std::string &scenario, const std::vector<Order> &orders,
+                         int runs, int shardCount, size_t symbolCount, int firstCore,
+                         std::vector<BenchmarkResult> &allResults)
+{
+    std::cout << "Running sharded benchmark for " << currentBook << " (" << shardCount << " shards, " << symbolCount
+              << " symbols, " << runs << " runs)...\n";
+
+    std::vector<double> queueLatencies, queueP99s, engineLatencies, throughputs;
+    uint64_t sumQueMax = 0, sumEngP99 = 0;
+
+    ShardedResult lastRes{};
+    for (int r = 0; r < runs; ++r)
+    {
+        // Fresh books per run so every shard count starts from the same empty state
+        OrderBookRegistry books = makeDirectBooks(currentBook, orders, symbolCount, 1);
+        ShardedResult res = ShardedBenchmark::run(books, orders, shardCount, firstCore);
+
+        queueLatencies.push_back(res.queueMeanNs);
+        queueP99s.push_back(res.queueP99Ns);
+        engineLatencies.push_back(res.engineMeanNs);
+        throughputs.push_back(res.throughputOrdersPerSec);
+        sumQueMax += res.queueMaxNs;
+        sumEngP99 += res.engineP99Ns;
+        lastRes = res;
+    }
+
+    auto qStats = calculateStats(queueLatencies);
+    auto qP99Stats = calculateStats(queueP99s);
+    auto eStats = calculateStats(engineLatencies);
+    auto tStats = calculateStats(throughputs);
+
+    BenchmarkResult shardRes;
+    shardRes.mode = "sharded";
+    shardRes.book = currentBook;
+    shardRes.scenario = scenario;
+    shardRes.symbolCount = symbolCount;
+    shardRes.shardCount = shardCount;
+    shardRes.mean = qStats.mean;
+    shardRes.latencyStdDev = qStats.stddev;
+    shardRes.p99 = qP99Stats.mean;
+    shardRes.p99StdDev = qP99Stats.stddev;
+    shardRes.max = sumQueMax / runs;
+    shardRes.throughput = tStats.mean;
+    shardRes.throughputStdDev = tStats.stddev;
+    shardRes.serverQueMean = qStats.mean;
+    shardRes.serverEngMean = eStats.mean;
+    shardRes.mpscEngineMean = eStats.mean;
+    shardRes.mpscEngineP99 = sumEngP99 / runs;
+
+    upsertResult(allResults, shardRes);
+
+    // Per-shard rows come from the last run; the aggregate line shows the means across runs
+    lastRes.queueMeanNs = qStats.mean;
+    lastRes.engineMeanNs = eStats.mean;
+    lastRes.throughputOrdersPerSec = tStats.mean;
+    printShardedTable(currentBook, scenario, lastRes);
 }
 
 int main(int argc, char *argv[])
@@ -572,9 +1420,32 @@ int main(int argc, char *argv[])
     std::string csvOut = "results/results.csv";
     size_t orderCount = 10000;
     int port = 12345;
+    TransportKind transport = TransportKind::Tcp;
+    std::string socketPath; // Unix/shm transports; empty = the server's per-port default
     int runs = 1;
     int pinCore = -1;
     std::string producersArg = "4"; // Default producer count for MPSC mode; accepts 'all' for sweep
+    std::string idleArg = "all";    // Idle strategy for idle mode; 'all' sweeps every strategy
+    uint64_t idleGapUs = 20;
+    size_t symbolCount = 0; // 0 = not given: 1, or 64 in sharded mode
+    double symbolSkew = 1.0;
+    std::string shardsArg = "all"; // Engine threads for sharded mode; 'all' sweeps 1/2/4/8
+    int clientCount = 1;           // Concurrent gateway connections
+    std::string variantLabel;      // Free-form server configuration tag recorded in the Variant column
+    bool execReports = false;      // Gateway: read execution reports and record client round trip
+    bool fixSession = false;       // Gateway: Logon and sequence numbers (server run with --fix-session)
+    size_t seqGapEvery = 0;        // Gateway session: lose every n-th order to force gap recovery
+    bool fragment = false;         // Gateway: split every frame at adversarial byte boundaries
+    WireProtocol protocol = WireProtocol::Fix;
+    std::string captureFile; // Parser mode: raw FIX byte stream replayed as an extra mix
+    unsigned long priceDecimals = 0; // Parser mode: implied decimals of generated and captured prices
+    size_t traceCapacity = 0;        // Direct mode: trace every order into a ring this size (0 = off)
+    std::vector<double> rates = {0.0}; // Gateway/mpsc: offered loads in orders/s (0 = closed loop)
+    bool perfCounters = false;         // Direct mode: perf_event_open counters per operation type
+    TimingMode timing = TimingMode::Exhaustive; // Direct mode: which orders get timed (--sample-every/--batch-size)
+    size_t timingN = 1;
+    long hiccupMs = 1000;              // Hiccup mode: spin time per core
+    double jitterThresholdUs = 2.0;    // Hiccup mode: gaps above this are stalls
 
     for (int i = 1; i < argc; ++i)
     {
@@ -633,6 +1504,184 @@ int main(int argc, char *argv[])
                 }
             }
         }
+        else if (arg == "--idle" && i + 1 < argc)
+        {
+            idleArg = argv[++i];
+            if (idleArg != "all")
+            {
+                try
+                {
+                    IdleStrategy::fromString(idleArg);
+                }
+                catch (...)
+                {
+                    std::cerr << "Error: --idle must be one of spin|pause|backoff|park|all: " << idleArg << "\n";
+                    printUsage();
+                    return 1;
+                }
+            }
+        }
+        else if (arg == "--idle-gap-us" && i + 1 < argc)
+        {
+            try
+            {
+                idleGapUs = std::stoull(argv[++i]);
+            }
+            catch (...)
+            {
+                std::cerr << "Error: Invalid number for --idle-gap-us: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--symbols" && i + 1 < argc)
+        {
+            try
+            {
+                symbolCount = std::stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                symbolCount = 0;
+            }
+            if (symbolCount == 0)
+            {
+                std::cerr << "Error: --symbols must be a positive integer: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--clients" && i + 1 < argc)
+        {
+            try
+            {
+                clientCount = std::stoi(argv[++i]);
+            }
+            catch (...)
+            {
+                clientCount = 0;
+            }
+            if (clientCount <= 0)
+            {
+                std::cerr << "Error: --clients must be a positive integer: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--variant" && i + 1 < argc)
+            variantLabel = argv[++i];
+        else if (arg == "--exec-reports")
+            execReports = true;
+        else if (arg == "--perf-counters")
+            perfCounters = true;
+        else if (arg == "--fix-session")
+            fixSession = true;
+        else if (arg == "--fragment")
+            fragment = true;
+        else if (arg == "--seq-gap-every" && i + 1 < argc)
+        {
+            try
+            {
+                seqGapEvery = std::stoull(argv[++i]);
+            }
+            catch (...)
+            {
+                std::cerr << "Error: Invalid number for --seq-gap-every: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--rate" && i + 1 < argc)
+        {
+            try
+            {
+                rates = parseRateList(argv[++i]);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Error: Invalid --rate: " << e.what() << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--capture" && i + 1 < argc)
+            captureFile = argv[++i];
+        else if (arg == "--price-decimals" && i + 1 < argc)
+        {
+            try
+            {
+                priceDecimals = std::stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                priceDecimals = SymbolTable::MAX_PRICE_DECIMALS + 1;
+            }
+            if (priceDecimals > SymbolTable::MAX_PRICE_DECIMALS)
+            {
+                std::cerr << "Error: --price-decimals must be 0.." << +SymbolTable::MAX_PRICE_DECIMALS << ": "
+                          << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--transport" && i + 1 < argc)
+        {
+            try
+            {
+                transport = TransportEndpoint::kindFromString(argv[++i]);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Error: " << e.what() << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--socket-path" && i + 1 < argc)
+            socketPath = argv[++i];
+        else if (arg == "--protocol" && i + 1 < argc)
+        {
+            const std::string name = argv[++i];
+            if (name != "fix" && name != "binary")
+            {
+                std::cerr << "Error: --protocol must be fix or binary\n";
+                return 1;
+            }
+            protocol = name == "binary" ? WireProtocol::Binary : WireProtocol::Fix;
+        }
+        else if (arg == "--shards" && i + 1 < argc)
+        {
+            shardsArg = argv[++i];
+            if (shardsArg != "all")
+            {
+                int shards = 0;
+                try
+                {
+                    shards = std::stoi(shardsArg);
+                }
+                catch (...)
+                {
+                }
+                if (shards <= 0)
+                {
+                    std::cerr << "Error: --shards must be a positive integer or 'all': " << shardsArg << "\n";
+                    printUsage();
+                    return 1;
+                }
+            }
+        }
+        else if (arg == "--symbol-skew" && i + 1 < argc)
+        {
+            try
+            {
+                symbolSkew = std::stod(argv[++i]);
+            }
+            catch (...)
+            {
+                std::cerr << "Error: Invalid number for --symbol-skew: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
         else if (arg == "--port" && i + 1 < argc)
         {
             try
@@ -646,6 +1695,77 @@ int main(int argc, char *argv[])
                 return 1;
             }
         }
+        else if ((arg == "--sample-every" || arg == "--batch-size") && i + 1 < argc)
+        {
+            const TimingMode requested = arg == "--sample-every" ? TimingMode::Sampled : TimingMode::Batch;
+            if (timing != TimingMode::Exhaustive && timing != requested)
+            {
+                std::cerr << "Error: --sample-every and --batch-size are alternatives\n";
+                return 1;
+            }
+            try
+            {
+                timingN = std::stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                timingN = 0;
+            }
+            if (timingN == 0)
+            {
+                std::cerr << "Error: Invalid number for " << arg << ": " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+            timing = requested;
+        }
+        else if (arg == "--hiccup-ms" && i + 1 < argc)
+        {
+            try
+            {
+                hiccupMs = std::stol(argv[++i]);
+            }
+            catch (...)
+            {
+                hiccupMs = 0;
+            }
+            if (hiccupMs <= 0)
+            {
+                std::cerr << "Error: Invalid number for --hiccup-ms: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--jitter-threshold-us" && i + 1 < argc)
+        {
+            try
+            {
+                jitterThresholdUs = std::stod(argv[++i]);
+            }
+            catch (...)
+            {
+                jitterThresholdUs = 0.0;
+            }
+            if (!(jitterThresholdUs * 1000.0 >= 1.0))
+            {
+                std::cerr << "Error: Invalid threshold for --jitter-threshold-us: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--trace-capacity" && i + 1 < argc)
+        {
+            try
+            {
+                traceCapacity = std::stoul(argv[++i]);
+            }
+            catch (...)
+            {
+                std::cerr << "Error: Invalid number for --trace-capacity: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
         else if (arg == "--pin-core" && i + 1 < argc)
         {
             try
@@ -688,15 +1808,16 @@ int main(int argc, char *argv[])
         }
     }
 
-    if (mode != "direct" && mode != "gateway" && mode != "mpsc")
+    if (mode != "direct" && mode != "gateway" && mode != "mpsc" && mode != "idle" && mode != "sharded" &&
+        mode != "parser" && mode != "timer" && mode != "hiccup")
     {
         std::cerr << "Error: Invalid --mode value: " << mode << "\n";
-        std::cerr << "Valid values are: direct, gateway, mpsc\n";
+        std::cerr << "Valid values are: direct, gateway, mpsc, idle, sharded, parser, timer, hiccup\n";
         printUsage();
         return 1;
     }
 
-    if ((mode == "direct" || mode == "mpsc") && pinCore >= 0)
+    if ((mode == "direct" || mode == "mpsc" || mode == "parser" || mode == "timer") && pinCore >= 0)
     {
         if (hft::pinToCore(pinCore))
             std::cout << "Thread successfully pinned to core " << pinCore << "\n";
@@ -704,6 +1825,49 @@ int main(int argc, char *argv[])
             std::cerr << "Warning: Failed to pin benchmark thread to core " << pinCore << "\n";
     }
 
+    if (symbolCount == 0)
+    {
+        // Sharding partitions by symbol, so a single-instrument flow would only ever use one shard
+        symbolCount = (mode == "sharded") ? 64 : 1;
+    }
+    if (symbolCount > 1 && mode != "direct" && mode != "gateway" && mode != "sharded" && mode != "parser")
+    {
+        std::cerr << "Warning: --symbols only applies to direct, gateway, sharded and parser modes; "
+                     "running single-instrument\n";
+        symbolCount = 1;
+    }
+    if (perfCounters && mode != "direct")
+    {
+        std::cerr << "Warning: --perf-counters only applies to direct mode; counters stay off\n";
+        perfCounters = false;
+    }
+    if (timing != TimingMode::Exhaustive && mode != "direct")
+    {
+        std::cerr << "Warning: --sample-every and --batch-size only apply to direct mode; timing every order\n";
+        timing = TimingMode::Exhaustive;
+        timingN = 1;
+    }
+    if (timing == TimingMode::Batch && (traceCapacity > 0 || perfCounters))
+    {
+        std::cerr << "Warning: --batch-size times whole blocks; --trace-capacity and the per-operation counters "
+                     "only see timed orders, so they stay empty\n";
+    }
+    if (rates.front() > 0 && mode != "gateway" && mode != "mpsc")
+    {
+        std::cerr << "Warning: --rate only applies to gateway and mpsc modes; sending closed loop\n";
+        rates = {0.0};
+    }
+    if (rates.front() > 0 && mode == "gateway" && rates.size() > 1 && !execReports)
+    {
+        std::cerr << "Warning: sweeping --rate without --exec-reports: the server's latencies accumulate over "
+                     "every point; restart the server per rate or read acks with --exec-reports\n";
+    }
+    if (priceDecimals > 0 && mode != "parser")
+    {
+        std::cerr << "Warning: --price-decimals only applies to parser mode; prices stay whole ticks\n";
+        priceDecimals = 0;
+    }
+
     std::cout << "HFT OrderBook Benchmark (" << mode << " mode, " << bookType << " book)\n";
     std::cout << "==========================================\n";
 
@@ -727,12 +1891,49 @@ int main(int argc, char *argv[])
         targetBooks = {bookType};
     }
 
+    // Calibrate the TSC before anything is timed
+    TscClock::calibrate();
+
     OrderGenerator generator(42);
 
     // Load existing results to show a "Global Summary"
     std::vector<BenchmarkResult> allResults = loadExistingResults(csvOut);
     cleanupDuplicates(allResults);
 
+    // The timer benchmark times the clocks alone; no orders or books are involved
+    if (mode == "timer")
+    {
+        runTimerBenchmark(runs, allResults);
+        if (!csvOut.empty())
+            saveResults(csvOut, allResults);
+        printSummaryTable(allResults, csvOut);
+        return 0;
+    }
+
+    // So does the hiccup benchmark: every core in turn, or only --pin-core
+    if (mode == "hiccup")
+    {
+        std::vector<int> cores;
+        if (pinCore >= 0)
+        {
+            cores.push_back(pinCore);
+        }
+        else
+        {
+            for (unsigned core = 0; core < std::max(1u, std::thread::hardware_concurrency()); ++core)
+            {
+                cores.push_back(static_cast<int>(core));
+            }
+        }
+        runHiccupBenchmark(cores, std::chrono::milliseconds(hiccupMs),
+                           std::chrono::nanoseconds(static_cast<int64_t>(jitterThresholdUs * 1000.0)), runs,
+                           allResults);
+        if (!csvOut.empty())
+            saveResults(csvOut, allResults);
+        printSummaryTable(allResults, csvOut);
+        return 0;
+    }
+
     for (const auto &currentScenario : targetScenarios)
     {
         std::vector<Order> orders;
@@ -758,12 +1959,62 @@ int main(int argc, char *argv[])
             orders = generator.generateScenario(currentScenario, orderCount);
         }
 
+        if (symbolCount > 1)
+        {
+            generator.assignSymbols(orders, symbolCount, symbolSkew);
+            std::cout << "Spread over " << symbolCount << " symbols (Zipf skew " << symbolSkew << ")\n";
+        }
+
+        // The parser benchmark decodes wire frames only; no book is involved
+        if (mode == "parser")
+        {
+            runParserBenchmark(currentScenario, orders, runs, symbolCount, static_cast<uint8_t>(priceDecimals),
+                               captureFile, allResults);
+            continue;
+        }
+
         for (const auto &currentBook : targetBooks)
         {
             if (mode == "direct")
-                runDirectBenchmark(currentBook, currentScenario, orders, runs, allResults);
+                runDirectBenchmark(currentBook, currentScenario, orders, runs, symbolCount, traceCapacity,
+                                   perfCounters, timing, timingN, csvOut, allResults);
             else if (mode == "gateway")
-                runGatewayBenchmark(currentBook, currentScenario, orders, runs, port, allResults);
+            {
+                std::vector<LoadPoint> curve;
+                for (double rate : rates)
+                    curve.push_back(runGatewayBenchmark(currentBook, currentScenario, orders, runs,
+                                                        TransportEndpoint{transport, port, socketPath}, symbolCount,
+                                                        clientCount, variantLabel, protocol, execReports, fixSession,
+                                                        seqGapEvery, fragment, rate, allResults));
+                if (rates.front() > 0)
+                    printLoadCurve(mode, currentBook, currentScenario,
+                                   execReports ? "client round trip" : "server total (cumulative)", curve);
+            }
+            else if (mode == "idle")
+            {
+                // Pin the engine thread (not the paced producer) so CPU burn is attributable to one core
+                std::vector<std::string> strategies;
+                if (idleArg == "all")
+                    strategies = IdleStrategy::getSupportedTypes();
+                else
+                    strategies = {idleArg};
+
+                for (const auto &strategy : strategies)
+                    runIdleBenchmark(currentBook, currentScenario, orders, runs, IdleStrategy::fromString(strategy),
+                                     idleGapUs * 1000, pinCore, allResults);
+            }
+            else if (mode == "sharded")
+            {
+                std::vector<int> shardCounts;
+                if (shardsArg == "all")
+                    shardCounts = {1, 2, 4, 8};
+                else
+                    shardCounts = {std::stoi(shardsArg)};
+
+                for (int shards : shardCounts)
+                    runShardedBenchmark(currentBook, currentScenario, orders, runs, shards, symbolCount, pinCore,
+                                        allResults);
+            }
             else if (mode == "mpsc")
             {
                 // Determine which producer counts to sweep
@@ -774,7 +2025,15 @@ int main(int argc, char *argv[])
                     producerCounts = {std::stoi(producersArg)};
 
                 for (int p : producerCounts)
-                    runMpscBenchmark(currentBook, currentScenario, orders, runs, p, allResults);
+                {
+                    std::vector<LoadPoint> curve;
+                    for (double rate : rates)
+                        curve.push_back(runMpscBenchmark(currentBook, currentScenario, orders, runs, p, rate,
+                                                         allResults));
+                    if (rates.front() > 0)
+                        printLoadCurve(mode, currentBook + " p" + std::to_string(p), currentScenario,
+                                       "push to pop", curve);
+                }
             }
             else
             {
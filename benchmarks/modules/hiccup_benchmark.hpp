@@ -0,0 +1,116 @@
+#pragma once
+
+#include "core/jitter_detector.hpp"
+#include "core/latency_histogram.hpp"
+#include "core/metrics_collector.hpp"
+#include "utils/rdtsc.hpp"
+#include "utils/thread_pinning.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hft
+{
+
+struct HiccupResult
+{
+    int core;    // -1 = unpinned
+    bool pinned; // false if pinning to `core` failed
+    double durationMs;
+    uint64_t reads;
+    LatencyStats gaps; // Between consecutive clock reads, in ns
+    JitterReport jitter;
+};
+
+/**
+ * @brief Platform noise on one core, with no book, queue or socket involved (jHiccup-style).
+ *
+ * A thread pinned to the core does nothing but read the TSC for the given time. Every gap between two
+ * reads goes into a histogram, and gaps above the threshold into a JitterDetector, the one the engine
+ * runs in its idle loop (--jitter-threshold-us on the server). What the thread loses here, interrupts,
+ * preemption, SMIs, hypervisor exits, any engine pinned to that core loses too: the floor under its
+ * tail latency. Cores with a high stalled share are the ones to keep the engine off.
+ */
+class HiccupBenchmark
+{
+  public:
+    static HiccupResult run(int core, std::chrono::milliseconds duration, std::chrono::nanoseconds threshold)
+    {
+        HiccupResult result{};
+        result.core = core;
+        result.pinned = core < 0;
+
+        // Own thread, so pinning never sticks to the caller and each core is measured the same way
+        std::thread spinner(
+            [&]()
+            {
+                if (core >= 0)
+                {
+                    result.pinned = pinToCore(core);
+                }
+                JitterDetector detector(threshold);
+                LatencyHistogram gaps;
+
+                const auto durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+                const uint64_t begin = TscClock::now();
+                const uint64_t end = begin + TscClock::fromNs(static_cast<uint64_t>(durationNs));
+                uint64_t last = begin;
+                uint64_t reads = 0;
+                detector.observe(begin);
+                while (last < end)
+                {
+                    const uint64_t now = TscClock::now();
+                    detector.observe(now);
+                    gaps.record(now - last);
+                    last = now;
+                    ++reads;
+                }
+
+                result.durationMs = TscClock::toNs(static_cast<double>(last - begin)) / 1e6;
+                result.reads = reads;
+                result.gaps = toNanoseconds(gaps.stats());
+                result.jitter = detector.getReport();
+            });
+        spinner.join();
+        return result;
+    }
+};
+
+inline void printHiccupTable(const std::vector<HiccupResult> &results)
+{
+    if (results.empty())
+    {
+        return;
+    }
+    std::cout << "\n" << std::string(112, '=') << "\n";
+    std::cout << "PLATFORM HICCUPS — spinning clock reads per core, stalls > " << std::fixed << std::setprecision(1)
+              << static_cast<double>(results.front().jitter.thresholdNs) / 1000.0 << " us\n";
+    std::cout << std::string(112, '=') << "\n";
+    std::cout << std::left << std::setw(8) << "Core" << std::right << std::setw(12) << "Reads/s" << std::setw(10)
+              << "Gap P50" << std::setw(10) << "Gap P99" << std::setw(12) << "Gap P99.99" << std::setw(12)
+              << "Gap Max" << std::setw(10) << "Stalls" << std::setw(14) << "Stalled(us)" << std::setw(12)
+              << "Stalled(%)" << std::setw(12) << "Available"
+              << "\n"
+              << std::string(112, '-') << "\n";
+
+    for (const auto &r : results)
+    {
+        const std::string core = r.core < 0 ? "any" : std::to_string(r.core) + (r.pinned ? "" : "*");
+        const double readsPerSec = r.durationMs > 0.0 ? static_cast<double>(r.reads) * 1000.0 / r.durationMs : 0.0;
+        std::cout << std::left << std::setw(8) << core << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(12) << readsPerSec << std::setw(10) << r.gaps.p50 << std::setw(10) << r.gaps.p99
+                  << std::setw(12) << r.gaps.p9999 << std::setw(12) << r.gaps.max << std::setw(10) << r.jitter.stalls
+                  << std::setprecision(1) << std::setw(14) << static_cast<double>(r.jitter.stallNs) / 1000.0
+                  << std::setprecision(3) << std::setw(12) << r.jitter.stalledPct() << std::setw(11)
+                  << 100.0 - r.jitter.stalledPct() << "%\n";
+    }
+    std::cout << std::string(112, '=') << "\n";
+    std::cout << "Gaps in ns. * = pinning failed, the thread ran wherever the scheduler put it.\n";
+}
+
+} // namespace hft
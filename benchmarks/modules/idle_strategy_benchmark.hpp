@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/i_order_book.hpp"
+#include "core/matching_engine.hpp"
+#include "core/metrics_collector.hpp"
+#include "core/order.hpp"
+#include "utils/idle_strategy.hpp"
+#include "utils/lock_free_queue.hpp"
+#include "utils/rdtsc.hpp"
+#include "utils/thread_pinning.hpp"
+
+namespace hft
+{
+
+/**
+ * @brief Results from a single idle-strategy run.
+ */
+struct IdleStrategyResult
+{
+    std::string strategy;
+
+    // Wake-up latency: producer push -> engine starts processing the order
+    double wakeMeanNs;
+    uint64_t wakeP99Ns;
+    uint64_t wakeMaxNs;
+
+    // CPU burned by the engine thread as a share of wall time (100 = one full core)
+    double engineCpuPct;
+
+    double throughputOrdersPerSec;
+    uint64_t ordersProcessed;
+    uint64_t parkWakeups; // producer wakes that had to signal a parked engine (park strategy only)
+};
+
+/**
+ * @brief Measures latency vs. CPU burn for each engine idle strategy.
+ *
+ * Architecture:
+ *   1 producer (paced, one order every gapNs) ──► LockFreeQueue ──► MatchingEngine::run
+ *
+ * The gap lets the engine fall idle between orders, so the measured queue latency is the
+ * wake-up cost of the strategy rather than a backlog effect.
+ *
+ * The consumer is a real MatchingEngine, so the numbers describe the loop the server ships.
+ *
+ * Timing:
+ *   - Producer stamps order.receiveTimestamp immediately before push
+ *   - Wake-up latency is the engine's queue latency (receiveTimestamp -> dequeue, getQueueStats());
+ *     all zero with HFT_METRICS_BACKEND=disabled, and no percentiles with counters
+ *   - Engine thread CPU time is read from CLOCK_THREAD_CPUTIME_ID around run()
+ */
+class IdleStrategyBenchmark
+{
+  public:
+    static IdleStrategyResult run(std::unique_ptr<IOrderBook> book, const std::vector<Order> &orders,
+                                  IdleStrategyType type, uint64_t gapNs, int engineCore = -1)
+    {
+        LockFreeQueue<Order, 1024> queue;
+        MatchingEngine engine(queue, *book, type);
+        IdleStrategy &idle = engine.getIdleStrategy();
+
+        std::atomic<bool> running{true};
+        std::atomic<bool> engineReady{false};
+        double engineCpuNs = 0.0;
+        double engineWallNs = 0.0;
+
+        std::thread engineThread(
+            [&]()
+            {
+                if (engineCore >= 0)
+                {
+                    pinToCore(engineCore);
+                }
+                engineReady.store(true, std::memory_order_release);
+
+                const uint64_t cpuStart = threadCpuTimeNs();
+                const auto wallStart = std::chrono::steady_clock::now();
+
+                engine.run(running);
+
+                const auto wallEnd = std::chrono::steady_clock::now();
+                const uint64_t cpuEnd = threadCpuTimeNs();
+
+                engineCpuNs = static_cast<double>(cpuEnd - cpuStart);
+                engineWallNs = static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(wallEnd - wallStart).count());
+            });
+
+        while (!engineReady.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+
+        const auto wallStart = std::chrono::steady_clock::now();
+        uint64_t nextSend = getCurrentTimeNs();
+        for (const auto &source : orders)
+        {
+            // Pace on an absolute schedule so the engine goes idle between orders
+            nextSend += gapNs;
+            while (getCurrentTimeNs() < nextSend)
+            {
+                cpuRelax();
+            }
+
+            Order o = source;
+            o.sendTimestamp = 0;
+            o.receiveTimestamp = getCurrentTimeNs();
+            while (!queue.push(o))
+            {
+                cpuRelax();
+            }
+            idle.wake();
+        }
+
+        // Wait for the engine to drain before stopping it so every order is measured
+        while (engine.getMetrics().getOrderCount() < orders.size())
+        {
+            std::this_thread::yield();
+        }
+        const auto wallEnd = std::chrono::steady_clock::now();
+        running.store(false, std::memory_order_relaxed);
+        engineThread.join();
+
+        const double wallNs =
+            static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(wallEnd - wallStart).count());
+        const LatencyStats wake = toNanoseconds(engine.getMetrics().getQueueStats());
+
+        IdleStrategyResult result;
+        result.strategy = IdleStrategy::toString(type);
+        result.wakeMeanNs = wake.mean;
+        result.wakeP99Ns = wake.p99;
+        result.wakeMaxNs = wake.max;
+        result.engineCpuPct = (engineWallNs > 0) ? (100.0 * engineCpuNs / engineWallNs) : 0.0;
+        result.throughputOrdersPerSec = (wallNs > 0) ? (orders.size() * 1e9 / wallNs) : 0.0;
+        result.ordersProcessed = engine.getMetrics().getOrderCount();
+        result.parkWakeups = idle.getWakeCount();
+        return result;
+    }
+
+  private:
+    static uint64_t threadCpuTimeNs()
+    {
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+};
+
+/**
+ * @brief Print a formatted console summary of idle-strategy results.
+ */
+inline void printIdleTable(const std::string &book, const std::string &scenario,
+                           const std::vector<IdleStrategyResult> &results)
+{
+    std::cout << "\n" << std::string(100, '=') << "\n";
+    std::cout << "IDLE STRATEGY BENCHMARK — Book: " << book << "  Scenario: " << scenario << "\n";
+    std::cout << std::string(100, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Strategy" << std::right << std::setw(14) << "Wake_Mean(ns)"
+              << std::setw(14) << "Wake_P99(ns)" << std::setw(14) << "Wake_Max(ns)" << std::setw(12) << "CPU(%)"
+              << std::setw(16) << "Throughput(k/s)" << std::setw(12) << "Processed" << std::setw(10) << "Wakeups"
+              << "\n"
+              << std::string(100, '-') << "\n";
+
+    for (const auto &r : results)
+    {
+        std::cout << std::left << std::setw(10) << r.strategy << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << r.wakeMeanNs << std::setw(14) << r.wakeP99Ns << std::setw(14) << r.wakeMaxNs
+                  << std::setw(12) << r.engineCpuPct << std::setw(16)
+                  << static_cast<uint64_t>(r.throughputOrdersPerSec / 1000) << std::setw(12) << r.ordersProcessed
+                  << std::setw(10) << r.parkWakeups << "\n";
+    }
+    std::cout << std::string(100, '=') << "\n";
+}
+
+} // namespace hft
@@ -1,21 +1,44 @@
 #pragma once
 
+#include "binary/binary_parser.hpp"
 #include "core/order.hpp"
+#include "core/symbol_table.hpp"
+#include "fix/fix_parser.hpp"
+#include "network/shm_channel.hpp"
+#include "network/transport.hpp"
 #include "utils/rdtsc.hpp"
-#include <arpa/inet.h>
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <thread>
 #include <unistd.h>
+#include <utility>
+#include <vector>
 
 namespace hft
 {
 
+// Order entry encoding: FIX text, or the fixed-layout binary frames (BinaryParser)
+enum class WireProtocol
+{
+    Fix,
+    Binary
+};
+
 class MockClient
 {
   public:
@@ -27,21 +50,20 @@ class MockClient
         disconnect();
     }
 
+    // Unix and SharedMemory connect to socketPath (empty = the server's per-port default). Before connect().
+    void setTransport(TransportKind kind, const std::string &socketPath = "")
+    {
+        transport_ = kind;
+        socketPath_ = socketPath;
+    }
+
     bool connect()
     {
-        sock_ = socket(AF_INET, SOCK_STREAM, 0);
+        const TransportEndpoint endpoint{transport_, port_, socketPath_};
+        sock_ = endpoint.connect(host_);
         if (sock_ < 0)
             return false;
 
-        sockaddr_in serv_addr;
-        serv_addr.sin_family = AF_INET;
-        serv_addr.sin_port = htons(port_);
-
-        if (inet_pton(AF_INET, host_.c_str(), &serv_addr.sin_addr) <= 0)
-            return false;
-        if (::connect(sock_, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0)
-            return false;
-
         // Prevent indefinite blocking when waiting for server responses.
         timeval socketTimeout{};
         socketTimeout.tv_sec = 5;
@@ -49,6 +71,21 @@ class MockClient
         setsockopt(sock_, SOL_SOCKET, SO_RCVTIMEO, &socketTimeout, sizeof(socketTimeout));
         setsockopt(sock_, SOL_SOCKET, SO_SNDTIMEO, &socketTimeout, sizeof(socketTimeout));
 
+        if (transport_ == TransportKind::SharedMemory)
+        {
+            // Orders go through a ring we own; the socket only carries the server's replies from now on
+            try
+            {
+                channel_ = ShmChannel::create();
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+            if (!sendDescriptor(sock_, channel_->fd()))
+                return false;
+        }
+
         return true;
     }
 
@@ -56,21 +93,154 @@ class MockClient
     {
         if (sock_ >= 0)
         {
+            if (session_)
+            {
+                sendSessionMessage("35=5\x01"); // Logout; the server answers and closes
+                session_ = false;
+            }
+            if (reader_.joinable())
+            {
+                shutdown(sock_, SHUT_RDWR); // Wakes the reader's recv()
+                reader_.join();
+            }
+            channel_.reset(); // Marks the ring closed once everything in it has been read
             close(sock_);
             sock_ = -1;
         }
     }
 
-    bool sendOrder(const Order &order)
+    // Starts a reader thread for the server's ExecutionReports (server run with --exec-reports).
+    // Acks (150=0) echo the order's TransactTime(60), so each one yields a round-trip sample.
+    // U2 stats replies are then picked up by the reader too. Call after connect().
+    void enableExecutionReports()
     {
-        std::string fix = toFIX(order);
+        if (sock_ < 0 || reader_.joinable())
+        {
+            return;
+        }
+        reader_ = std::thread(&MockClient::readLoop, this);
+    }
+
+    // Waits until count acks have arrived (or timeout); returns whether they all did
+    bool waitForAcks(size_t count, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(readMutex_);
+        return readCv_.wait_for(lock, timeout, [&]() { return ackCount_ >= count || readerDone_; }) &&
+               ackCount_ >= count;
+    }
+
+    // Round-trip times (ns, the order's TransactTime(60) -> ack received) collected since the last call
+    std::vector<uint64_t> takeRoundTripSamples()
+    {
+        std::lock_guard<std::mutex> lock(readMutex_);
+        return std::exchange(roundTripNs_, {});
+    }
+
+    size_t getAckCount() const
+    {
+        std::lock_guard<std::mutex> lock(readMutex_);
+        return ackCount_;
+    }
+
+    size_t getFillCount() const
+    {
+        std::lock_guard<std::mutex> lock(readMutex_);
+        return fillCount_;
+    }
+
+    // Applies to orders and stats requests; replies are FIX text either way. Any time before sending.
+    void setProtocol(WireProtocol protocol)
+    {
+        protocol_ = protocol;
+    }
+
+    // FIX session simulator for a server run with --fix-session. Sends Logon and waits for the
+    // server's Logon; every later FIX message carries SenderCompID/TargetCompID and the next
+    // MsgSeqNum, and is kept so a ResendRequest can be answered (resent with PossDupFlag=Y).
+    // The reader thread answers TestRequests. False (session stays off) if no Logon comes back.
+    bool logon(uint32_t heartbeatSeconds = 30)
+    {
+        if (sock_ < 0 || protocol_ != WireProtocol::Fix)
+        {
+            return false;
+        }
+        enableExecutionReports(); // The reader picks up the Logon reply and session requests
+        session_ = true;
+        char body[48];
+        const int length = std::snprintf(body, sizeof(body),
+                                         "35=A\x01"
+                                         "98=0\x01"
+                                         "108=%u\x01",
+                                         heartbeatSeconds);
+        if (!sendSessionMessage(std::string_view(body, static_cast<size_t>(length))))
+        {
+            session_ = false;
+            return false;
+        }
+        std::unique_lock<std::mutex> lock(readMutex_);
+        readCv_.wait_for(lock, std::chrono::seconds(2), [&]() { return loggedOn_ || readerDone_; });
+        session_ = loggedOn_;
+        return loggedOn_;
+    }
+
+    // Simulated loss: every n-th order is given its MsgSeqNum but not sent, so the server sees a
+    // gap and has to recover it with a ResendRequest. 0 = no loss. Call before sending.
+    void setSequenceGapEvery(size_t every)
+    {
+        gapEvery_ = every;
+    }
+
+    // Fragmentation stress: every frame goes out in separate segments cut after its first byte, inside
+    // BodyLength(9), at an offset that moves by one byte per frame, and inside the CheckSum(10) trailer,
+    // so the gateway's receive buffer almost always holds a partial frame. Call after connect().
+    void setFragmentation(bool enabled)
+    {
+        fragment_ = enabled;
+        if (enabled)
+        {
+            const int noDelay = 1; // Without it the kernel coalesces the pieces again
+            setsockopt(sock_, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+    }
+
+    // ResendRequests the server sent us (one per detected gap)
+    size_t getResendRequestCount() const
+    {
+        std::lock_guard<std::mutex> lock(readMutex_);
+        return resendRequests_;
+    }
+
+    // TransactTime(60) carries sendNs when given (open loop: the order's intended send time), else the
+    // time of the call. The server's latencies and the ack round trip are measured from it.
+    bool sendOrder(const Order &order, uint64_t sendNs = 0)
+    {
+        if (sendNs == 0)
+        {
+            sendNs = getCurrentTimeNs();
+        }
+        if (protocol_ == WireProtocol::Binary)
+        {
+            Order stamped = order;
+            stamped.sendTimestamp = sendNs;
+            char frame[BinaryParser::NEW_ORDER_SIZE];
+            BinaryParser::encodeNewOrder(stamped, frame);
+            return sendAll(frame, sizeof(frame));
+        }
+        if (session_)
+        {
+            const bool drop = gapEvery_ > 0 && ++ordersSent_ % gapEvery_ == 0;
+            return sendSessionMessage(orderBody(order, sendNs), drop);
+        }
+        std::string fix = toFIX(order, sendNs);
         return sendAll(fix.data(), fix.size());
     }
 
     struct ServerStats
     {
         double mean;
+        unsigned long long p50;
         unsigned long long p99;
+        unsigned long long p999;
         unsigned long long max;
         unsigned long long processed;
         double netMean;
@@ -80,26 +250,63 @@ class MockClient
 
     std::optional<ServerStats> requestServerStats(size_t expectedCount = 0)
     {
-        char reqBuf[128];
-        int reqLen = std::snprintf(reqBuf, sizeof(reqBuf),
-                                   "8=FIX.4.2\x01"
-                                   "35=U1\x01"
-                                   "596=%zu\x01"
-                                   "10=000\x01",
-                                   expectedCount);
-        if (reqLen <= 0 || !sendAll(reqBuf, static_cast<size_t>(reqLen)))
+        bool sent = false;
+        if (protocol_ == WireProtocol::Binary)
+        {
+            char reqBuf[BinaryParser::STATS_REQUEST_SIZE];
+            BinaryParser::encodeStatsRequest(expectedCount, reqBuf);
+            sent = sendAll(reqBuf, sizeof(reqBuf));
+        }
+        else
+        {
+            char body[64];
+            const int bodyLen = std::snprintf(body, sizeof(body),
+                                              "35=U1\x01"
+                                              "596=%zu\x01",
+                                              expectedCount);
+            const std::string_view bodyView(body, static_cast<size_t>(bodyLen));
+            if (session_)
+            {
+                sent = sendSessionMessage(bodyView);
+            }
+            else
+            {
+                char reqBuf[128];
+                const size_t reqLen = FIXParser::buildFrame(bodyView, reqBuf, sizeof(reqBuf));
+                sent = reqLen > 0 && sendAll(reqBuf, reqLen);
+            }
+        }
+        if (!sent)
         {
             return std::nullopt;
         }
 
+        if (reader_.joinable())
+        {
+            // The reader owns the socket's receive side: wait for it to hand over the U2 frame
+            std::unique_lock<std::mutex> lock(readMutex_);
+            if (!readCv_.wait_for(lock, std::chrono::seconds(35), [&]() { return statsReply_ || readerDone_; }) ||
+                !statsReply_)
+            {
+                return std::nullopt;
+            }
+            std::string frame = std::move(*statsReply_);
+            statsReply_.reset();
+            return parseStats(frame);
+        }
+
         char buffer[1024];
         ssize_t received = recv(sock_, buffer, sizeof(buffer), 0);
         if (received <= 0)
         {
             return std::nullopt;
         }
+        return parseStats(std::string_view(buffer, received));
+    }
 
-        std::string_view response(buffer, received);
+  private:
+    static std::optional<ServerStats> parseStats(std::string_view response)
+    {
         if (response.find("35=U2") == std::string_view::npos)
         {
             return std::nullopt;
@@ -123,7 +330,9 @@ class MockClient
         };
 
         auto meanStr = getVal("Mean=");
+        auto p50Str = getVal("P50=");
         auto p99Str = getVal("P99=");
+        auto p999Str = getVal("P999=");
         auto maxStr = getVal("Max=");
         auto countStr = getVal("Count=");
         auto netMeanStr = getVal("NetMean=");
@@ -140,6 +349,14 @@ class MockClient
             stats.mean = std::stod(std::string(meanStr));
             stats.p99 = std::stoull(std::string(p99Str));
             stats.max = std::stoull(std::string(maxStr));
+            if (!p50Str.empty())
+            {
+                stats.p50 = std::stoull(std::string(p50Str));
+            }
+            if (!p999Str.empty())
+            {
+                stats.p999 = std::stoull(std::string(p999Str));
+            }
             stats.processed = std::stoull(std::string(countStr));
 
             if (!netMeanStr.empty())
@@ -163,9 +380,213 @@ class MockClient
         return stats;
     }
 
-  private:
+    // Value of a tag inside one frame; tag includes its leading SOH, e.g. "\x01" "60=" (so 160= never matches)
+    static std::string_view tagValue(std::string_view frame, std::string_view tag)
+    {
+        const size_t pos = frame.find(tag);
+        if (pos == std::string_view::npos)
+        {
+            return {};
+        }
+        const size_t start = pos + tag.size();
+        const size_t end = frame.find('\x01', start);
+        return end == std::string_view::npos ? std::string_view{} : frame.substr(start, end - start);
+    }
+
+    void readLoop()
+    {
+        std::vector<char> buffer(64 * 1024);
+        size_t offset = 0;
+        for (;;)
+        {
+            const ssize_t received = recv(sock_, buffer.data() + offset, buffer.size() - offset, 0);
+            if (received < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                continue;
+            }
+            if (received <= 0)
+            {
+                break; // Closed, or shut down by disconnect()
+            }
+            const uint64_t receivedAt = getCurrentTimeNs();
+
+            // Every server frame ends with the CheckSum field: SOH "10=" + 3 digits + SOH
+            const std::string_view data(buffer.data(), offset + static_cast<size_t>(received));
+            size_t consumed = 0;
+            for (;;)
+            {
+                const size_t trailer = data.find("\x01" "10=", consumed);
+                if (trailer == std::string_view::npos || trailer + 8 > data.size())
+                {
+                    break;
+                }
+                onFrame(data.substr(consumed, trailer + 8 - consumed), receivedAt);
+                consumed = trailer + 8;
+            }
+
+            offset = data.size() - consumed;
+            std::memmove(buffer.data(), buffer.data() + consumed, offset);
+            if (offset == buffer.size())
+            {
+                break; // A frame larger than the buffer: not something this server sends
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(readMutex_);
+        readerDone_ = true;
+        readCv_.notify_all();
+    }
+
+    void onFrame(std::string_view frame, uint64_t receivedAt)
+    {
+        if (session_ && onSessionFrame(frame))
+        {
+            return;
+        }
+        if (frame.find("\x01" "35=U2\x01") != std::string_view::npos)
+        {
+            std::lock_guard<std::mutex> lock(readMutex_);
+            statsReply_.emplace(frame);
+            readCv_.notify_all();
+            return;
+        }
+        if (frame.find("\x01" "35=8\x01") == std::string_view::npos)
+        {
+            return;
+        }
+
+        const std::string_view execType = tagValue(frame, "\x01" "150=");
+        std::lock_guard<std::mutex> lock(readMutex_);
+        if (execType == "0")
+        {
+            const std::string_view sentAt = tagValue(frame, "\x01" "60=");
+            uint64_t sentNs = 0;
+            std::from_chars(sentAt.data(), sentAt.data() + sentAt.size(), sentNs);
+            if (sentNs > 0 && receivedAt >= sentNs)
+            {
+                roundTripNs_.push_back(receivedAt - sentNs);
+            }
+            ++ackCount_;
+            readCv_.notify_all();
+        }
+        else if (execType == "F")
+        {
+            ++fillCount_;
+        }
+    }
+
+    // Reader thread: session-level messages from the server. True if frame was one.
+    bool onSessionFrame(std::string_view frame)
+    {
+        const std::string_view type = tagValue(frame, "\x01" "35=");
+        if (type == "A")
+        {
+            std::lock_guard<std::mutex> lock(readMutex_);
+            loggedOn_ = true;
+            readCv_.notify_all();
+        }
+        else if (type == "1")
+        {
+            const std::string heartbeat = "35=0\x01" "112=" + std::string(tagValue(frame, "\x01" "112=")) + "\x01";
+            sendSessionMessage(heartbeat);
+        }
+        else if (type == "2")
+        {
+            uint64_t begin = 0;
+            const std::string_view beginText = tagValue(frame, "\x01" "7=");
+            std::from_chars(beginText.data(), beginText.data() + beginText.size(), begin);
+            {
+                std::lock_guard<std::mutex> lock(readMutex_);
+                ++resendRequests_;
+            }
+            resend(begin);
+        }
+        else if (type == "5")
+        {
+            session_ = false; // Logged out by the server; it closes the connection next
+        }
+        else if (type != "0" && type != "4")
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // Frames body (35=X first) with the session header and the next MsgSeqNum, keeps it for
+    // resends, and sends it unless drop (simulated loss). Called by the sender and the reader.
+    bool sendSessionMessage(std::string_view body, bool drop = false)
+    {
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        const uint64_t seqNum = sentBodies_.size() + 1;
+        sentBodies_.emplace_back(body);
+        return drop || sendSequenced(body, seqNum, false);
+    }
+
+    // Resends every kept message from begin onwards, flagged as possible duplicates
+    void resend(uint64_t begin)
+    {
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        for (uint64_t seqNum = std::max<uint64_t>(begin, 1); seqNum <= sentBodies_.size(); ++seqNum)
+        {
+            if (!sendSequenced(sentBodies_[seqNum - 1], seqNum, true))
+            {
+                return;
+            }
+        }
+    }
+
+    // sendMutex_ held
+    bool sendSequenced(std::string_view body, uint64_t seqNum, bool possDup)
+    {
+        const size_t typeEnd = body.find('\x01') + 1; // MsgType(35) stays the first body field
+        char header[96];
+        const int headerLength = std::snprintf(header, sizeof(header), "49=SIM\x01" "56=EXCHANGE\x01" "34=%llu\x01%s",
+                                               static_cast<unsigned long long>(seqNum), possDup ? "43=Y\x01" : "");
+        char fields[320];
+        if (typeEnd + static_cast<size_t>(headerLength) + (body.size() - typeEnd) > sizeof(fields))
+        {
+            return false;
+        }
+        size_t length = 0;
+        std::memcpy(fields, body.data(), typeEnd);
+        length += typeEnd;
+        std::memcpy(fields + length, header, static_cast<size_t>(headerLength));
+        length += static_cast<size_t>(headerLength);
+        std::memcpy(fields + length, body.data() + typeEnd, body.size() - typeEnd);
+        length += body.size() - typeEnd;
+
+        char frame[384];
+        const size_t frameLength = FIXParser::buildFrame(std::string_view(fields, length), frame, sizeof(frame));
+        return frameLength > 0 && sendAll(frame, frameLength);
+    }
+
     bool sendAll(const char *data, size_t length)
     {
+        if (!fragment_ || length <= 16)
+        {
+            return writeAll(data, length);
+        }
+        // Session messages are sent under sendMutex_; without a session only the sending thread gets here
+        const size_t moving = 12 + fragmentedFrames_++ % (length - 16);
+        const size_t cuts[] = {1, 11, moving, length - 4, length};
+        size_t begin = 0;
+        for (size_t cut : cuts)
+        {
+            if (cut > begin && !writeAll(data + begin, cut - begin))
+            {
+                return false;
+            }
+            begin = std::max(begin, cut);
+        }
+        return true;
+    }
+
+    bool writeAll(const char *data, size_t length)
+    {
+        if (channel_)
+        {
+            return channel_->write(data, length, std::chrono::seconds(5));
+        }
         size_t sentBytes = 0;
         while (sentBytes < length)
         {
@@ -187,33 +608,68 @@ class MockClient
         return true;
     }
 
-    std::string toFIX(const Order &order)
+    std::string toFIX(const Order &order, uint64_t sendNs)
     {
         // Simple FIX 4.2 NewOrderSingle (D)
-        // 8=FIX.4.2|9=000|35=D|11=ID|54=SIDE|44=PRICE|38=QTY|40=TYPE|10=000|
+        // 8=FIX.4.2|9=LEN|35=D|11=ID|55=SYM<n>|54=SIDE|44=PRICE|38=QTY|40=TYPE|60=TS|10=CS|
+        // BodyLength and CheckSum are real, so a server validating them (--fix-validate) accepts the frames.
+        const std::string body = orderBody(order, sendNs);
         char buffer[256];
-        int len = std::snprintf(buffer, sizeof(buffer),
-                                "8=FIX.4.2\x01"
+        const size_t frameLen = FIXParser::buildFrame(body, buffer, sizeof(buffer));
+        return std::string(buffer, frameLen);
+    }
+
+    // NewOrderSingle fields after BodyLength. Symbol names follow SymbolTable::makeSynthetic, so the
+    // server must be started with enough --symbols.
+    static std::string orderBody(const Order &order, uint64_t sendNs)
+    {
+        char body[224];
+        int len = std::snprintf(body, sizeof(body),
                                 "35=D\x01"
                                 "11=%llu\x01"
+                                "55=%.*s%u\x01"
                                 "54=%d\x01"
                                 "44=%llu\x01"
                                 "38=%llu\x01"
                                 "40=%d\x01"
                                 "60=%llu\x01",
-                                (unsigned long long)order.id, (order.side == Side::Buy ? 1 : 2),
+                                (unsigned long long)order.id, static_cast<int>(SymbolTable::SYNTHETIC_PREFIX.size()),
+                                SymbolTable::SYNTHETIC_PREFIX.data(), static_cast<unsigned>(order.symbol),
+                                (order.side == Side::Buy ? 1 : 2),
                                 (unsigned long long)order.price, (unsigned long long)order.quantity,
                                 (order.type == OrderType::Market ? 1 : 2),
-                                (unsigned long long)getCurrentTimeNs()); // order.sendTimestamp is set here
-
-        // Add checksum (simplified for benchmark)
-        int totalLen = std::snprintf(buffer + len, sizeof(buffer) - len, "10=000\x01");
-        return std::string(buffer, len + totalLen);
+                                (unsigned long long)sendNs); // order.sendTimestamp is set here
+        return std::string(body, static_cast<size_t>(len));
     }
 
     std::string host_;
     int port_;
     int sock_;
+    TransportKind transport_ = TransportKind::Tcp;
+    std::string socketPath_;
+    std::unique_ptr<ShmChannel> channel_; // SharedMemory: order bytes bypass the socket
+    WireProtocol protocol_ = WireProtocol::Fix;
+    bool fragment_ = false;
+    size_t fragmentedFrames_ = 0;
+
+    // Session simulator (logon): sentBodies_[n - 1] is the message sent with MsgSeqNum n
+    std::atomic<bool> session_{false};
+    size_t gapEvery_ = 0;
+    size_t ordersSent_ = 0;
+    std::mutex sendMutex_;
+    std::vector<std::string> sentBodies_;
+
+    // Execution report reader (enableExecutionReports); everything below is guarded by readMutex_
+    std::thread reader_;
+    mutable std::mutex readMutex_;
+    std::condition_variable readCv_;
+    std::vector<uint64_t> roundTripNs_;
+    size_t ackCount_ = 0;
+    size_t fillCount_ = 0;
+    std::optional<std::string> statsReply_;
+    bool readerDone_ = false;
+    bool loggedOn_ = false;
+    size_t resendRequests_ = 0;
 };
 
 } // namespace hft
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -11,6 +14,7 @@
 #include "core/order.hpp"
 #include "core/i_order_book.hpp"
 #include "moodycamel/concurrentqueue.h"
+#include "open_loop.hpp"
 #include "utils/rdtsc.hpp"
 
 namespace hft
@@ -25,7 +29,9 @@ struct MpscResult
 
     // Queue statistics (time from push to pop, measures producer contention)
     double queueMeanNs;
+    uint64_t queueP50Ns;
     uint64_t queueP99Ns;
+    uint64_t queueP999Ns;
     uint64_t queueMaxNs;
 
     // Engine statistics (time for addOrder + match, should be independent of producer count)
@@ -40,6 +46,9 @@ struct MpscResult
     uint64_t ordersProcessed;
     uint64_t ordersDropped;  // push() returned false (queue full)
     uint64_t peakQueueDepth; // sampled max queue size during run
+
+    // Open loop: worst lag of a producer behind its schedule (0 in closed loop)
+    uint64_t maxSendLagNs;
 };
 
 /**
@@ -49,10 +58,15 @@ struct MpscResult
  *   N producer threads ──► ConcurrentQueue<Order> ──► 1 consumer thread (matching engine)
  *
  * Timing:
- *   - Each producer stamps order.sendTimestamp before enqueuing
+ *   - Each producer stamps order.sendTimestamp before enqueuing, once: time spent retrying
+ *     a full queue is queueing delay and stays in the sample
  *   - Consumer stamps order.receiveTimestamp on dequeue
  *   - Queue latency = receiveTimestamp - sendTimestamp
  *   - Engine latency = addOrder + match duration
+ *
+ * With ratePerSec > 0 the producers share an open-loop schedule (OpenLoopSchedule) at that combined
+ * rate, and sendTimestamp is the intended send time: queue latency then includes any lag of the
+ * producer behind the schedule, which is how a backlog shows up at a given offered load.
  */
 class MpscBenchmark
 {
@@ -60,7 +74,8 @@ class MpscBenchmark
     static constexpr size_t QUEUE_CAPACITY = 16384; // must be power of two (moodycamel default)
 
     static MpscResult run(const std::string & /*bookName*/, std::unique_ptr<IOrderBook> book,
-                          const std::vector<Order> &orders, int producerCount, size_t warmupCount = 500)
+                          const std::vector<Order> &orders, int producerCount, double ratePerSec = 0.0,
+                          size_t warmupCount = 500)
     {
         moodycamel::ConcurrentQueue<Order> queue(QUEUE_CAPACITY);
 
@@ -83,6 +98,8 @@ class MpscBenchmark
         size_t sliceSize = (totalOrders + producerCount - 1) / producerCount;
 
         auto wallStart = std::chrono::high_resolution_clock::now();
+        const uint64_t scheduleStartNs = getCurrentTimeNs() + OpenLoopSchedule::START_LEAD_NS;
+        std::vector<uint64_t> sendLags(producerCount, 0);
 
         // --- Producer threads ---
         std::vector<std::thread> producers;
@@ -94,26 +111,38 @@ class MpscBenchmark
             size_t to = std::min(from + sliceSize, totalOrders);
 
             producers.emplace_back(
-                [&, from, to]()
+                [&, p, from, to]()
                 {
                     moodycamel::ProducerToken token(queue);
+                    std::optional<OpenLoopSchedule> schedule;
+                    if (ratePerSec > 0)
+                    {
+                        schedule.emplace(ratePerSec, scheduleStartNs, producerCount, p);
+                    }
                     for (size_t i = from; i < to; ++i)
                     {
                         Order o = orders[i];
-                        o.sendTimestamp = getCurrentTimeNs(); // stamp before push
+                        // Stamp before push: the intended send time in open loop, otherwise now
+                        o.sendTimestamp = schedule ? schedule->waitFor(i - from) : getCurrentTimeNs();
                         while (!queue.enqueue(token, o))
                         {
-                            // Queue is full — spin briefly and retry
+                            // Queue is full — spin briefly and retry, keeping the stamp
                             ordersDropped.fetch_add(1, std::memory_order_relaxed);
                             std::this_thread::yield();
-                            o.sendTimestamp = getCurrentTimeNs(); // re-stamp after yield
                         }
                     }
+                    if (schedule)
+                    {
+                        sendLags[p] = schedule->getMaxLagNs();
+                    }
                 });
         }
 
         // --- Consumer thread (matching engine) ---
         uint64_t consumedTotal = 0;
+        // Sanity cap against stale stamps: 100ms max plausible queue latency. Open loop past saturation
+        // legitimately builds longer backlogs, and dropping those samples would hide exactly the tail.
+        const uint64_t maxQueueLatencyNs = ratePerSec > 0 ? UINT64_MAX : 100'000'000ULL;
 
         std::thread consumer(
             [&]()
@@ -149,7 +178,7 @@ class MpscBenchmark
                             if (o.sendTimestamp > 0 && recvTs > o.sendTimestamp)
                             {
                                 uint64_t qLat = recvTs - o.sendTimestamp;
-                                if (qLat < 100'000'000ULL) // sanity cap: 100ms max plausible queue latency
+                                if (qLat < maxQueueLatencyNs)
                                 {
                                     queueLatencies.push_back(qLat);
                                 }
@@ -172,7 +201,7 @@ class MpscBenchmark
                             if (consumedTotal > warmupCount && o.sendTimestamp > 0 && recvTs > o.sendTimestamp)
                             {
                                 uint64_t qLat = recvTs - o.sendTimestamp;
-                                if (qLat < 100'000'000ULL)
+                                if (qLat < maxQueueLatencyNs)
                                 {
                                     queueLatencies.push_back(qLat);
                                 }
@@ -207,6 +236,7 @@ class MpscBenchmark
             uint64_t max = v.back();
             return {mean, p99, max};
         };
+        // calcStats sorts in place: percentiles of the queue samples are read afterwards
 
         auto [qMean, qP99, qMax] = calcStats(queueLatencies);
         auto [eMean, eP99, eMax] = calcStats(engineLatencies);
@@ -216,7 +246,9 @@ class MpscBenchmark
         MpscResult result;
         result.producerCount = producerCount;
         result.queueMeanNs = qMean;
+        result.queueP50Ns = percentileOf(queueLatencies, 0.5);
         result.queueP99Ns = qP99;
+        result.queueP999Ns = percentileOf(queueLatencies, 0.999);
         result.queueMaxNs = qMax;
         result.engineMeanNs = eMean;
         result.engineP99Ns = eP99;
@@ -225,6 +257,7 @@ class MpscBenchmark
         result.ordersProcessed = ordersConsumed.load();
         result.ordersDropped = ordersDropped.load();
         result.peakQueueDepth = peakDepth.load();
+        result.maxSendLagNs = *std::max_element(sendLags.begin(), sendLags.end());
 
         return result;
     }
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "utils/idle_strategy.hpp"
+#include "utils/rdtsc.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief Open-loop send schedule: order k is due at a fixed time, whatever happened to the orders before it.
+ *
+ * A closed-loop sender sends the next order as soon as the previous call returns, so it slows down
+ * whenever the system under test does. The orders that would have queued behind a stall are only sent
+ * after it, and their wait is never measured (coordinated omission). This schedule never waits for the
+ * system: a sender that has fallen behind sends at once, and latency is measured from the intended send
+ * time, so the sender's own lag counts as queueing delay.
+ *
+ * Several senders (lanes) share one schedule at the combined rate: lane c of n owns the slots
+ * c, c + n, c + 2n, ... Times are getCurrentTimeNs() values, comparable across processes.
+ */
+class OpenLoopSchedule
+{
+  public:
+    // Lead before the first slot, so every lane has started when the schedule begins
+    static constexpr uint64_t START_LEAD_NS = 1'000'000;
+
+    // ratePerSec is the combined rate of all lanes. Throws std::invalid_argument unless it is positive.
+    OpenLoopSchedule(double ratePerSec, uint64_t startNs, size_t lanes = 1, size_t lane = 0)
+        : startNs_(startNs), intervalNs_(ratePerSec > 0 ? 1e9 / ratePerSec : 0.0), lanes_(lanes), lane_(lane)
+    {
+        if (ratePerSec <= 0 || lanes == 0 || lane >= lanes)
+        {
+            throw std::invalid_argument("OpenLoopSchedule: rate must be positive and lane < lanes");
+        }
+    }
+
+    // Intended send time of this lane's k-th order
+    uint64_t intendedNs(size_t k) const
+    {
+        return startNs_ + static_cast<uint64_t>(static_cast<double>(k * lanes_ + lane_) * intervalNs_);
+    }
+
+    // Spins until the k-th order is due and returns its intended time. Never skips an order: one that
+    // is already late is due at once, and the lag is recorded.
+    uint64_t waitFor(size_t k)
+    {
+        const uint64_t due = intendedNs(k);
+        uint64_t now = getCurrentTimeNs();
+        while (now < due)
+        {
+            cpuRelax();
+            now = getCurrentTimeNs();
+        }
+        maxLagNs_ = std::max(maxLagNs_, now - due);
+        return due;
+    }
+
+    // Worst lag of a send behind its intended time. Near the interval or above: the sender, not the
+    // system under test, is the bottleneck at this rate.
+    uint64_t getMaxLagNs() const
+    {
+        return maxLagNs_;
+    }
+
+  private:
+    uint64_t startNs_;
+    double intervalNs_;
+    size_t lanes_;
+    size_t lane_;
+    uint64_t maxLagNs_ = 0;
+};
+
+// Comma-separated offered rates in orders/s, e.g. "10000,50000,100000". Throws std::invalid_argument.
+inline std::vector<double> parseRateList(const std::string &list)
+{
+    std::vector<double> rates;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        size_t used = 0;
+        double rate = 0.0;
+        try
+        {
+            rate = std::stod(item, &used);
+        }
+        catch (const std::exception &)
+        {
+            used = 0;
+        }
+        if (used != item.size() || rate <= 0)
+        {
+            throw std::invalid_argument("not a positive rate: '" + item + "'");
+        }
+        rates.push_back(rate);
+    }
+    if (rates.empty())
+    {
+        throw std::invalid_argument("no rates given");
+    }
+    return rates;
+}
+
+// Value at quantile q of sorted samples (0 when empty); the index convention of the benchmark tables
+inline uint64_t percentileOf(const std::vector<uint64_t> &sorted, double q)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(static_cast<double>(sorted.size()) * q))];
+}
+
+// One point of a latency-vs-throughput curve; latencies are measured from the intended send time
+struct LoadPoint
+{
+    double offeredRate = 0.0;
+    double achievedRate = 0.0;
+    double meanNs = 0.0;
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double p999Ns = 0.0;
+    double maxNs = 0.0;
+    uint64_t maxSendLagNs = 0;
+};
+
+// Variant tag of an open-loop row; each offered rate is its own experiment in the results CSV
+inline std::string openLoopTag(double ratePerSec)
+{
+    return "open" + std::to_string(static_cast<uint64_t>(ratePerSec));
+}
+
+inline void printLoadCurve(const std::string &mode, const std::string &book, const std::string &scenario,
+                           const std::string &latencyLabel, const std::vector<LoadPoint> &points)
+{
+    std::cout << "\n" << std::string(110, '=') << "\n";
+    std::cout << "LOAD CURVE (" << mode << ") — Book: " << book << "  Scenario: " << scenario
+              << "  Latency: " << latencyLabel << ", from intended send time\n";
+    std::cout << std::string(110, '=') << "\n";
+    std::cout << std::right << std::setw(14) << "Offered(k/s)" << std::setw(15) << "Achieved(k/s)" << std::setw(13)
+              << "Mean(ns)" << std::setw(13) << "P50(ns)" << std::setw(13) << "P99(ns)" << std::setw(13)
+              << "P99.9(ns)" << std::setw(14) << "Max(ns)" << std::setw(15) << "SendLag(ns)"
+              << "\n"
+              << std::string(110, '-') << "\n";
+    for (const auto &p : points)
+    {
+        std::cout << std::right << std::fixed << std::setprecision(1) << std::setw(14) << p.offeredRate / 1000
+                  << std::setw(15) << p.achievedRate / 1000 << std::setprecision(0) << std::setw(13) << p.meanNs
+                  << std::setw(13) << p.p50Ns << std::setw(13) << p.p99Ns << std::setw(13) << p.p999Ns
+                  << std::setw(14) << p.maxNs << std::setw(15) << p.maxSendLagNs << "\n";
+    }
+    std::cout << std::string(110, '=') << "\n";
+    std::cout << "[Note] Achieved below offered, or SendLag near 1e9/rate: the sender could not keep the schedule\n";
+}
+
+} // namespace hft
@@ -5,10 +5,40 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
 
 namespace hft
 {
 
+void OrderBookBenchmark::setTiming(TimingMode mode, size_t n)
+{
+    if (mode != TimingMode::Exhaustive && n == 0)
+    {
+        throw std::invalid_argument("OrderBookBenchmark: sample gap and batch size must be positive");
+    }
+    timing_ = mode;
+    timingN_ = mode == TimingMode::Exhaustive ? 1 : n;
+}
+
+void OrderBookBenchmark::applyOrder(IOrderBook &book, const Order &order, size_t readsPerOp)
+{
+    if (order.quantity == 0)
+        book.cancelOrder(order.id);
+    else
+        book.addOrder(order);
+
+    for (size_t r = 0; r < readsPerOp; ++r)
+    {
+        volatile auto bestBid = book.getBestBid();
+        volatile auto bestAsk = book.getBestAsk();
+        (void)bestBid;
+        (void)bestAsk;
+    }
+    book.match();
+}
+
 OperationBreakdown OrderBookBenchmark::runScenario(const std::vector<Order> &orders, size_t readsPerOp,
                                                    size_t warmupCount)
 {
@@ -21,65 +51,136 @@ OperationBreakdown OrderBookBenchmark::runScenario(const std::vector<Order> &ord
     // Warmup phase
     for (size_t i = 0; i < warmupCount && i < orders.size(); ++i)
     {
-        if (orders[i].quantity == 0)
-            orderbook_->cancelOrder(orders[i].id);
-        else
-            orderbook_->addOrder(orders[i]);
+        applyOrder(books_.get(orders[i].symbol), orders[i], readsPerOp);
+    }
 
-        for (size_t r = 0; r < readsPerOp; ++r)
+    // Hardware counters (enablePerfCounters): read just outside each timed region, so the counts cover
+    // the operation plus its two timer reads
+    OperationCounters counters;
+    PerfCounterGroup::Reading before;
+    PerfCounterGroup::Reading phaseStart;
+    if (perf_)
+    {
+        counters.events = perf_->events();
+        for (size_t e = 0; e < counters.events.size(); ++e)
         {
-            (void)orderbook_->getBestBid();
-            (void)orderbook_->getBestAsk();
+            counters.counted.push_back(perf_->has(e));
         }
-        orderbook_->match();
+        perf_->enable();
+        phaseStart = perf_->read();
     }
+    MatchProbe::reset(); // Drop the warmup's match phases
 
-    // Measurement phase
-    for (size_t i = warmupCount; i < orders.size(); ++i)
+    // Batch timing: one region per block of timingN_ orders, recorded as the average per order
+    if (timing_ == TimingMode::Batch)
     {
-        uint64_t totalStart = getCurrentTimeNs();
+        for (size_t i = warmupCount; i < orders.size(); i += timingN_)
+        {
+            const size_t end = std::min(i + timingN_, orders.size());
+            uint64_t blockStart = TscClock::start();
+            for (size_t j = i; j < end; ++j)
+            {
+                applyOrder(books_.get(orders[j].symbol), orders[j], readsPerOp);
+            }
+            uint64_t blockEnd = TscClock::stop();
+            totalMetrics.recordLatency((blockEnd - blockStart) / (end - i));
+        }
+    }
+
+    // Sampled timing: the next timed order is a random gap ahead, drawn outside every region. The seed is
+    // fixed, so two books see the same orders timed.
+    std::mt19937_64 sampleRng(12345);
+    std::uniform_int_distribution<size_t> sampleGap(1, 2 * timingN_ - 1);
+    size_t nextTimed = warmupCount + (timing_ == TimingMode::Sampled ? sampleGap(sampleRng) - 1 : 0);
+
+    // Measurement phase. Each region is bracketed by fenced TSC reads (TscClock::start/stop), so the
+    // CPU cannot move book work in or out of it; --mode timer measures what the brackets cost.
+    for (size_t i = warmupCount; timing_ != TimingMode::Batch && i < orders.size(); ++i)
+    {
+        IOrderBook &book = books_.get(orders[i].symbol);
+        if (timing_ == TimingMode::Sampled)
+        {
+            if (i != nextTimed)
+            {
+                applyOrder(book, orders[i], readsPerOp);
+                continue;
+            }
+            nextTimed += sampleGap(sampleRng);
+        }
+        uint64_t totalStart = TscClock::start();
 
         // Measure Insert vs Cancel Separately
         // Note: The generator uses quantity == 0 as a flag to signify a Cancel order
         if (orders[i].quantity == 0)
         {
-            uint64_t cancelStart = getCurrentTimeNs();
-            orderbook_->cancelOrder(orders[i].id);
-            uint64_t cancelEnd = getCurrentTimeNs();
+            if (perf_)
+                before = perf_->read();
+            uint64_t cancelStart = TscClock::start();
+            book.cancelOrder(orders[i].id);
+            uint64_t cancelEnd = TscClock::stop();
+            if (perf_)
+                counters.cancel.add(before, perf_->read());
             cancelMetrics.recordLatency(cancelEnd - cancelStart);
         }
         else
         {
-            uint64_t insertStart = getCurrentTimeNs();
-            orderbook_->addOrder(orders[i]);
-            uint64_t insertEnd = getCurrentTimeNs();
+            if (perf_)
+                before = perf_->read();
+            uint64_t insertStart = TscClock::start();
+            book.addOrder(orders[i]);
+            uint64_t insertEnd = TscClock::stop();
+            if (perf_)
+                counters.insert.add(before, perf_->read());
             insertMetrics.recordLatency(insertEnd - insertStart);
         }
 
         // Measure Lookups (Read Heavy work) for both ask and bid
         for (size_t r = 0; r < readsPerOp; ++r)
         {
-            uint64_t lookupStart = getCurrentTimeNs();
-            volatile auto bestBid = orderbook_->getBestBid();
-            volatile auto bestAsk = orderbook_->getBestAsk();
+            if (perf_)
+                before = perf_->read();
+            uint64_t lookupStart = TscClock::start();
+            volatile auto bestBid = book.getBestBid();
+            volatile auto bestAsk = book.getBestAsk();
             (void)bestBid;
             (void)bestAsk;
-            uint64_t lookupEnd = getCurrentTimeNs();
+            uint64_t lookupEnd = TscClock::stop();
+            if (perf_)
+                counters.lookup.add(before, perf_->read());
             lookupMetrics.recordLatency(lookupEnd - lookupStart);
         }
 
         // Measure Match
-        uint64_t matchStart = getCurrentTimeNs();
-        orderbook_->match();
-        uint64_t matchEnd = getCurrentTimeNs();
+        if (perf_)
+            before = perf_->read();
+        uint64_t matchStart = TscClock::start();
+        const size_t tradeCount = book.match().size(); // Trades are freed inside the region, as before
+        uint64_t matchEnd = TscClock::stop();
+        if (perf_)
+            counters.match.add(before, perf_->read());
         matchMetrics.recordLatency(matchEnd - matchStart);
 
-        uint64_t totalEnd = getCurrentTimeNs();
+        if (trace_)
+        {
+            const Order &order = orders[i];
+            trace_->record({order.id, 0, 0, 0, totalStart, matchEnd, static_cast<uint32_t>(tradeCount),
+                            static_cast<uint32_t>(book.getOrderCount()), order.symbol, order.side, order.type, 0});
+        }
+
+        uint64_t totalEnd = TscClock::stop();
         totalMetrics.recordLatency(totalEnd - totalStart);
     }
 
-    return OperationBreakdown{insertMetrics.getStats(), cancelMetrics.getStats(), lookupMetrics.getStats(),
-                              matchMetrics.getStats(), totalMetrics.getStats()};
+    if (perf_)
+    {
+        counters.total.add(phaseStart, perf_->read(), orders.size() > warmupCount ? orders.size() - warmupCount : 0);
+        perf_->disable();
+    }
+
+    // Samples are TSC ticks until here
+    return OperationBreakdown{toNanoseconds(insertMetrics.getStats()), toNanoseconds(cancelMetrics.getStats()),
+                              toNanoseconds(lookupMetrics.getStats()), toNanoseconds(matchMetrics.getStats()),
+                              toNanoseconds(totalMetrics.getStats()), std::move(counters), MatchProbe::profile()};
 }
 
 void BenchmarkFormatter::exportResults(
@@ -108,7 +209,7 @@ void BenchmarkFormatter::exportResults(
         if (pos != std::string::npos)
             orderCount = scenario.substr(pos + 1);
 
-        file << orderbook << "," << scenario << "," << orderCount << "," << stats.totalStats.sampleCount << ","
+        file << orderbook << "," << scenario << "," << orderCount << "," << stats.totalStats.count << ","
              << stats.totalStats.mean << "," << stats.totalStats.p99 << "," << stats.insertStats.mean << ","
              << stats.insertStats.p99 << "," << stats.cancelStats.mean << "," << stats.cancelStats.p99 << ","
              << stats.lookupStats.mean << "," << stats.lookupStats.p99 << "," << stats.matchStats.mean << ","
@@ -157,4 +258,69 @@ void BenchmarkFormatter::printResultsTable(
     std::cout << std::string(140, '=') << "\n\n";
 }
 
+void BenchmarkFormatter::printCounterTable(const std::string &book, const std::string &scenario,
+                                           const OperationCounters &counters)
+{
+    const size_t width = 12 + 16 * counters.events.size();
+    std::cout << "\n" << std::string(width, '=') << "\n";
+    std::cout << "HARDWARE COUNTERS per operation (user space) — Book: " << book << "  Scenario: " << scenario << "\n";
+    std::cout << std::string(width, '=') << "\n";
+    std::cout << std::left << std::setw(12) << "Operation" << std::right;
+    for (const auto &event : counters.events)
+        std::cout << std::setw(16) << event.name;
+    std::cout << "\n" << std::string(width, '-') << "\n";
+
+    const std::pair<const char *, const PerfTotals *> rows[] = {{"insert", &counters.insert},
+                                                                {"cancel", &counters.cancel},
+                                                                {"lookup", &counters.lookup},
+                                                                {"match", &counters.match},
+                                                                {"total", &counters.total}};
+    for (const auto &[operation, totals] : rows)
+    {
+        if (totals->regions == 0)
+            continue;
+        std::cout << std::left << std::setw(12) << operation << std::right << std::fixed << std::setprecision(2);
+        for (size_t e = 0; e < counters.events.size(); ++e)
+        {
+            if (counters.counted[e])
+                std::cout << std::setw(16) << totals->perRegion(e);
+            else
+                std::cout << std::setw(16) << "n/a";
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::string(width, '=') << "\n";
+    std::cout << "[Note] total = whole measured phase per order, including timers and counter reads\n";
+}
+
+void BenchmarkFormatter::printMatchPhaseTable(const std::string &book, const std::string &scenario,
+                                              const MatchProfile &profile)
+{
+    const uint64_t matches = profile.matches();
+    const double totalTicks = static_cast<double>(profile.totalTicks());
+    if (matches == 0 || totalTicks == 0)
+        return;
+
+    std::cout << "\n" << std::string(70, '=') << "\n";
+    std::cout << "MATCH PHASES — Book: " << book << "  Scenario: " << scenario << "\n";
+    std::cout << std::string(70, '=') << "\n";
+    std::cout << std::left << std::setw(16) << "Phase" << std::right << std::setw(18) << "ns/match" << std::setw(12)
+              << "Share(%)" << std::setw(20) << "Entries/match" << "\n";
+    std::cout << std::string(70, '-') << "\n";
+    for (size_t p = 0; p < MatchProfile::PHASES; ++p)
+    {
+        const double ticks = static_cast<double>(profile.ticks[p]);
+        std::cout << std::left << std::setw(16) << matchPhaseToString(static_cast<MatchPhase>(p)) << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(18) << TscClock::toNs(ticks) / matches
+                  << std::setw(12) << 100.0 * ticks / totalTicks << std::setprecision(2) << std::setw(20)
+                  << static_cast<double>(profile.entries[p]) / matches << "\n";
+    }
+    std::cout << std::string(70, '-') << "\n";
+    std::cout << std::left << std::setw(16) << "match()" << std::right << std::fixed << std::setprecision(1)
+              << std::setw(18) << TscClock::toNs(totalTicks) / matches << "\n";
+    std::cout << std::string(70, '=') << "\n";
+    std::cout << "[Note] Each probe adds two TSC reads, counted in the phases; compare totals with a build without "
+                 "probes\n";
+}
+
 } // namespace hft
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -7,11 +8,43 @@
 
 #include "core/order.hpp"
 #include "core/i_order_book.hpp"
-#include "utils/metrics_collector.hpp"
+#include "core/match_probe.hpp"
+#include "core/order_book_registry.hpp"
+#include "core/metrics_collector.hpp"
+#include "core/order_trace.hpp"
+#include "utils/perf_counters.hpp"
 
 namespace hft
 {
 
+/**
+ * @brief Hardware counters per operation type, from enablePerfCounters (empty events otherwise)
+ *
+ * insert/cancel/lookup/match count each operation's timed region. total counts the whole measured
+ * phase per order, so it also includes the timers, the metrics and the counter reads themselves.
+ */
+struct OperationCounters
+{
+    std::vector<PerfEventSpec> events;
+    std::vector<bool> counted; // Events that opened on this machine
+    PerfTotals insert;
+    PerfTotals cancel;
+    PerfTotals lookup;
+    PerfTotals match;
+    PerfTotals total;
+
+    void merge(const OperationCounters &other)
+    {
+        events = other.events;
+        counted = other.counted;
+        insert.merge(other.insert);
+        cancel.merge(other.cancel);
+        lookup.merge(other.lookup);
+        match.merge(other.match);
+        total.merge(other.total);
+    }
+};
+
 /**
  * @brief Operation-level breakdown metrics
  */
@@ -22,6 +55,26 @@ struct OperationBreakdown
     LatencyStats lookupStats;
     LatencyStats matchStats;
     LatencyStats totalStats;
+    OperationCounters counters;
+    MatchProfile matchPhases; // Measured phase only; all zero unless built with HFT_ENABLE_MATCH_PROBES
+};
+
+/**
+ * @brief Which measured orders runScenario times, and how.
+ *
+ * Exhaustive - every operation of every order in its own fenced region (the default).
+ * Sampled    - the same regions, for about one order in N. The gaps are drawn at random (uniform on
+ *              1..2N-1) so a period in the order flow cannot line up with the sampling. The other
+ *              orders run with no timer at all, so the timers disturb the pipeline less often.
+ * Batch      - one region around K consecutive orders, divided by K: the timer's cost is spread over
+ *              K orders. Only the total is measured; the per-operation stats stay empty, and the
+ *              percentiles are those of block averages, which hide single-order tails.
+ */
+enum class TimingMode : uint8_t
+{
+    Exhaustive = 0,
+    Sampled = 1,
+    Batch = 2
 };
 
 /**
@@ -31,20 +84,57 @@ class OrderBookBenchmark
 {
   public:
     OrderBookBenchmark(const std::string &name, std::unique_ptr<IOrderBook> orderbook)
-        : name_(name), orderbook_(std::move(orderbook))
+        : name_(name), books_(std::move(orderbook))
+    {
+    }
+
+    // Multi-instrument run: each order is applied to the book of its symbol
+    OrderBookBenchmark(const std::string &name, OrderBookRegistry books) : name_(name), books_(std::move(books))
     {
     }
 
     OperationBreakdown runScenario(const std::vector<Order> &orders, size_t readsPerOp, size_t warmupCount = 1000);
 
+    // Traces every measured order the way MatchingEngine does, inside the total region, so the
+    // difference to an untraced run is the trace's cost per order
+    void enableOrderTrace(std::size_t capacity)
+    {
+        trace_ = std::make_unique<OrderTraceRing>(capacity);
+    }
+
+    // Sampled: n is the mean gap between timed orders. Batch: n orders per timed block.
+    // Throws std::invalid_argument if n is 0 in either mode.
+    void setTiming(TimingMode mode, size_t n = 1);
+
+    // Reads a perf_event_open counter group (PerfCounterGroup) around every measured operation and
+    // around the measured phase. Each read is a system call placed outside the operation's timed
+    // region, but the total region still pays for them. False if no counter could be opened.
+    bool enablePerfCounters(std::vector<PerfEventSpec> events = PerfCounterGroup::defaultEvents())
+    {
+        perf_ = std::make_unique<PerfCounterGroup>(std::move(events));
+        if (!perf_->isAvailable())
+        {
+            perf_.reset();
+            return false;
+        }
+        return true;
+    }
+
     const std::string &getName() const
     {
         return name_;
     }
 
   private:
+    // One order as runScenario applies it, without any timer
+    static void applyOrder(IOrderBook &book, const Order &order, size_t readsPerOp);
+
     std::string name_;
-    std::unique_ptr<IOrderBook> orderbook_;
+    OrderBookRegistry books_;
+    TimingMode timing_ = TimingMode::Exhaustive;
+    size_t timingN_ = 1;
+    std::unique_ptr<OrderTraceRing> trace_;
+    std::unique_ptr<PerfCounterGroup> perf_;
 };
 
 /**
@@ -57,6 +147,14 @@ class BenchmarkFormatter
                               const std::vector<std::tuple<std::string, std::string, OperationBreakdown>> &results);
 
     static void printResultsTable(std::vector<std::tuple<std::string, std::string, OperationBreakdown>> &results);
+
+    // Events per operation, one row per operation type
+    static void printCounterTable(const std::string &book, const std::string &scenario,
+                                  const OperationCounters &counters);
+
+    // Where match() spends its time, one row per MatchPhase
+    static void printMatchPhaseTable(const std::string &book, const std::string &scenario,
+                                     const MatchProfile &profile);
 };
 
 } // namespace hft
@@ -1,5 +1,7 @@
 #include "order_generator.hpp"
 #include <chrono>
+#include <cmath>
+#include <unordered_map>
 
 namespace hft
 {
@@ -328,4 +330,39 @@ std::vector<Order> OrderGenerator::generateHighCancellation(size_t count)
     return orders;
 }
 
+void OrderGenerator::assignSymbols(std::vector<Order> &orders, size_t symbolCount, double skew)
+{
+    if (symbolCount <= 1)
+    {
+        for (auto &order : orders)
+        {
+            order.symbol = 0;
+        }
+        return;
+    }
+
+    std::vector<double> weights(symbolCount);
+    for (size_t k = 0; k < symbolCount; ++k)
+    {
+        weights[k] = 1.0 / std::pow(static_cast<double>(k + 1), skew);
+    }
+    std::discrete_distribution<SymbolId> symbolDist(weights.begin(), weights.end());
+
+    std::unordered_map<OrderId, SymbolId> symbolById;
+    symbolById.reserve(orders.size());
+
+    for (auto &order : orders)
+    {
+        if (order.quantity == 0)
+        {
+            auto it = symbolById.find(order.id);
+            order.symbol = it != symbolById.end() ? it->second : 0;
+            continue;
+        }
+
+        order.symbol = symbolDist(rng_);
+        symbolById[order.id] = order.symbol;
+    }
+}
+
 } // namespace hft
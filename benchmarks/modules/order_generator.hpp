@@ -1,6 +1,8 @@
 #pragma once
 
 #include <random>
+#include <string>
+#include <vector>
 
 #include "core/order.hpp"
 #include "core/types.hpp"
@@ -27,6 +29,15 @@ class OrderGenerator
     std::vector<Order> generateMixed(size_t count);
     std::vector<Order> generateHighCancellation(size_t count);
 
+    /**
+     * @brief Spread a single-instrument flow across symbolCount instruments.
+     *
+     * Symbol popularity follows a Zipf law: P(symbol k) ~ 1 / (k + 1)^skew, so SYM0 is the most active
+     * (skew 0 = uniform, ~1 = typical equity-market concentration). Cancels (quantity 0) inherit the
+     * symbol of the order they reference so they land on the right book.
+     */
+    void assignSymbols(std::vector<Order> &orders, size_t symbolCount, double skew);
+
     static std::vector<std::string> getSupportedScenarios()
     {
         return {"tight_spread",    "fixed_levels", "dense_full",       "sparse_extreme",
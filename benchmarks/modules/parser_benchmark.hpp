@@ -0,0 +1,383 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/order.hpp"
+#include "core/symbol_table.hpp"
+#include "fix/fix_parser.hpp"
+#include "fix/fix_scanner.hpp"
+#include "fix/fix_session.hpp"
+#include "utils/rdtsc.hpp"
+
+namespace hft
+{
+
+/**
+ * @brief Results from one parser over one message mix.
+ */
+struct ParserBenchResult
+{
+    std::string mix;
+    std::string parser;
+
+    // Per-message decode cost, from batch timings (a batch is BATCH_SIZE frames)
+    double meanNs;
+    uint64_t p99Ns;
+    uint64_t maxNs;
+
+    double throughputMsgsPerSec;
+    uint64_t messagesParsed; // Frames consumed per pass
+    uint64_t ordersParsed;   // Of which valid NewOrderSingle
+};
+
+/**
+ * @brief The FIX decoder as it was before the single-pass tokenizer: the gateway reads
+ * MsgType(35), then every field is a separate getTagValue search over the frame.
+ *
+ * Kept as the baseline for --mode parser.
+ */
+class TagSearchFixParser
+{
+  public:
+    // Gateway view of one frame: consumed bytes, and the order if it was a valid NewOrderSingle
+    static inline std::optional<Order> decode(std::span<const char> buffer, size_t &bytesConsumed,
+                                              const SymbolTable *symbols)
+    {
+        auto msgType = FIXParser::getMessageType(buffer); // The gateway's dispatch scan
+
+        std::string_view bufferView(buffer.data(), buffer.size());
+        bytesConsumed = 0;
+        size_t checksumPosition = bufferView.find("\x01" "10=");
+        if (checksumPosition == std::string_view::npos || bufferView.size() < checksumPosition + 8)
+        {
+            return std::nullopt;
+        }
+        bytesConsumed = checksumPosition + 8;
+        std::string_view message = bufferView.substr(0, bytesConsumed);
+        if (msgType == "U1" || FIXParser::getTagValue(message, 35) != "D")
+        {
+            return std::nullopt;
+        }
+
+        Order order{};
+        auto side = FIXParser::getTagValue(message, 54);
+        auto price = FIXParser::getTagValue(message, 44);
+        auto type = FIXParser::getTagValue(message, 40);
+        order.symbol = SymbolTable::DEFAULT_SYMBOL;
+        if (symbols != nullptr)
+        {
+            auto symbol = FIXParser::getTagValue(message, 55);
+            if (!symbol.empty() && (order.symbol = symbols->find(symbol)) == SymbolTable::INVALID_SYMBOL)
+            {
+                return std::nullopt;
+            }
+        }
+
+        // Price conversion is shared with FIXParser so decimal streams decode in every row
+        const uint8_t decimals = symbols != nullptr ? symbols->priceDecimals(order.symbol) : 0;
+        if (!number(FIXParser::getTagValue(message, 11), order.id) || (side != "1" && side != "2") ||
+            (!price.empty() && !FixPrice::parse(price, decimals, order.price)) ||
+            !number(FIXParser::getTagValue(message, 38), order.quantity) || order.quantity == 0 ||
+            (type != "1" && type != "2"))
+        {
+            return std::nullopt;
+        }
+        order.side = side == "1" ? Side::Buy : Side::Sell;
+        order.type = type == "1" ? OrderType::Market : OrderType::Limit;
+        if (order.type == OrderType::Limit && order.price == 0)
+        {
+            return std::nullopt;
+        }
+
+        auto transTime = FIXParser::getTagValue(message, 60);
+        if (!transTime.empty() && !number(transTime, order.sendTimestamp))
+        {
+            return std::nullopt;
+        }
+        return order;
+    }
+
+  private:
+    template <typename Number> static bool number(std::string_view value, Number &out)
+    {
+        auto result = std::from_chars(value.data(), value.data() + value.size(), out);
+        return !value.empty() && result.ec == std::errc{} && result.ptr == value.data() + value.size();
+    }
+};
+
+/**
+ * @brief Measures FIX decode cost per message, isolated from sockets and the engine.
+ *
+ * Each mix is encoded once into one contiguous buffer (as a recv() of back-to-back frames would
+ * deliver it), then every parser walks that buffer frame by frame exactly as the gateway does:
+ *
+ *   gateway    - the frames MockClient sends (35 first, 7 body fields)
+ *   session    - a full FIX 4.2 session header (8, 9, 35, 49, 56, 34, 52) and a longer body in
+ *                venue order (11, 1, 21, 55, 54, 60, 38, 40, 44, 59), opened by a Logon (35=A)
+ *   mixed      - session frames with a Heartbeat (35=0) in place of every 8th order
+ *   capture    - a raw byte stream loaded from a file (--capture), replayed unchanged
+ *
+ * With --price-decimals the generated mixes write Price(44) as a decimal (mix label "<mix>-d<n>"),
+ * decoded to ticks against a symbol table with the same implied decimals.
+ *
+ * Generated frames carry a real BodyLength and CheckSum. The tokenizer runs once per FixScanner
+ * level (scalar, sse2, avx2) the CPU supports, so the vectorised delimiter scan is measured against
+ * the scalar kernel on the same bytes, and once more at the default level with BodyLength and
+ * CheckSum validation on (tokenizer-verify) to price what a validating session pays. On the
+ * sequenced mixes (session, mixed) tokenizer-session also runs every frame through a FixSession,
+ * pricing the Logon/MsgSeqNum layer; its clock is read once per batch, as the gateway does per recv().
+ *
+ * The decoded orders are folded into a checksum so the work cannot be optimised away.
+ */
+class ParserBenchmark
+{
+  public:
+    static constexpr size_t BATCH_SIZE = 64;
+
+    static std::vector<std::string> getSupportedMixes()
+    {
+        return {"gateway", "session", "mixed"};
+    }
+
+    // The tag-search baseline, then the tokenizer once per FixScanner level this CPU supports
+    static std::vector<std::string> getSupportedParsers()
+    {
+        std::vector<std::string> parsers = {"tag-search"};
+        for (ScanLevel level : FixScanner::getSupportedLevels())
+        {
+            parsers.push_back("tokenizer-" + FixScanner::toString(level));
+        }
+        parsers.push_back("tokenizer-verify");
+        parsers.push_back("tokenizer-session");
+        return parsers;
+    }
+
+    // tokenizer-session needs MsgSeqNum on every frame: only the generated session and mixed streams have it
+    static bool appliesTo(const std::string &parser, const std::string &mix)
+    {
+        return parser != "tokenizer-session" || mix.starts_with("session") || mix.starts_with("mixed");
+    }
+
+    // A captured byte stream (e.g. a recv() dump of a FIX session) replayed as-is
+    static std::string loadCapture(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // priceDecimals > 0 writes Price(44) as a decimal (ticks 10125 at 2 -> 101.25), matching a symbol
+    // table built with the same implied decimals
+    static std::string buildStream(const std::vector<Order> &orders, const std::string &mix,
+                                   uint8_t priceDecimals = 0)
+    {
+        std::string stream;
+        stream.reserve(orders.size() * 192);
+        uint64_t seq = 1;
+        if (mix != "gateway")
+        {
+            appendFrame(stream, "35=A\x01" "49=CLIENT01\x01" "56=EXCHANGE\x01" "34=1\x01"
+                                "52=20240101-12:00:00.000\x01" "98=0\x01" "108=30\x01");
+            seq = 2;
+        }
+        for (size_t i = 0; i < orders.size(); ++i)
+        {
+            const Order &o = orders[i];
+            const uint64_t ts = 1700000000000000000ULL + i * 1000;
+            const int side = o.side == Side::Buy ? 1 : 2;
+            const int type = o.type == OrderType::Market ? 1 : 2;
+            char price[32];
+            formatPrice(o.price, priceDecimals, price, sizeof(price));
+            char body[256];
+            int len = 0;
+            if (mix == "gateway")
+            {
+                len = std::snprintf(body, sizeof(body),
+                                    "35=D\x01" "11=%" PRIu64 "\x01" "55=SYM%u\x01" "54=%d\x01" "44=%s\x01"
+                                    "38=%" PRIu64 "\x01" "40=%d\x01" "60=%" PRIu64 "\x01",
+                                    o.id, static_cast<unsigned>(o.symbol), side, price, o.quantity, type, ts);
+            }
+            else if (mix == "mixed" && i % 8 == 7)
+            {
+                len = std::snprintf(body, sizeof(body),
+                                    "35=0\x01" "49=CLIENT01\x01" "56=EXCHANGE\x01" "34=%" PRIu64 "\x01"
+                                    "52=20240101-12:00:00.000\x01",
+                                    seq++);
+            }
+            else
+            {
+                len = std::snprintf(body, sizeof(body),
+                                    "35=D\x01" "49=CLIENT01\x01" "56=EXCHANGE\x01" "34=%" PRIu64 "\x01"
+                                    "52=20240101-12:00:00.000\x01" "11=%" PRIu64 "\x01" "1=ACCT42\x01" "21=1\x01"
+                                    "55=SYM%u\x01" "54=%d\x01" "60=%" PRIu64 "\x01" "38=%" PRIu64 "\x01" "40=%d\x01"
+                                    "44=%s\x01" "59=0\x01",
+                                    seq++, o.id, static_cast<unsigned>(o.symbol), side, ts, o.quantity, type, price);
+            }
+            appendFrame(stream, std::string_view(body, static_cast<size_t>(len)));
+        }
+        return stream;
+    }
+
+    // Decodes the stream `passes` times (plus one warm-up pass) with the named parser
+    static ParserBenchResult run(const std::string &stream, const std::string &parser, const SymbolTable &symbols,
+                                 int passes)
+    {
+        const bool tokenizer = parser.starts_with("tokenizer");
+        const bool verify = parser == "tokenizer-verify";
+        const bool sequenced = parser == "tokenizer-session";
+        const std::span<const char> buffer(stream.data(), stream.size());
+        const ScanLevel defaultLevel = FixScanner::getLevel();
+        for (ScanLevel level : FixScanner::getSupportedLevels())
+        {
+            if (parser == "tokenizer-" + FixScanner::toString(level))
+            {
+                FixScanner::setLevel(level);
+            }
+        }
+
+        std::vector<uint64_t> batchNs;
+        uint64_t messages = 0, ordersParsed = 0, fold = 0;
+        double totalNs = 0;
+
+        for (int pass = -1; pass < passes; ++pass)
+        {
+            FixScanner scanner(buffer); // The whole stream is one segment, as a large recv() would be
+            FixSession session;         // Fresh per pass: the stream starts with its Logon
+            size_t processed = 0;
+            messages = 0;
+            ordersParsed = 0;
+            while (processed < buffer.size())
+            {
+                const uint64_t start = getCurrentTimeNs();
+                if (sequenced)
+                {
+                    session.beginBatch(start);
+                }
+                size_t inBatch = 0;
+                for (; inBatch < BATCH_SIZE && processed < buffer.size(); ++inBatch)
+                {
+                    size_t consumed = 0;
+                    std::optional<Order> order =
+                        tokenizer ? decodeTokenized(scanner, processed, consumed, symbols, verify,
+                                                    sequenced ? &session : nullptr)
+                                  : TagSearchFixParser::decode(buffer.subspan(processed), consumed, &symbols);
+                    if (consumed == 0)
+                    {
+                        processed = buffer.size(); // Trailing partial frame (only a capture can end mid-frame)
+                        break;
+                    }
+                    processed += consumed;
+                    if (order)
+                    {
+                        ++ordersParsed;
+                        fold += order->id ^ order->price ^ order->quantity;
+                    }
+                }
+                const uint64_t elapsed = getCurrentTimeNs() - start;
+                session.clearOutbox(); // Only the Logon reply: nothing is sent
+                messages += inBatch;
+                if (pass >= 0 && inBatch > 0)
+                {
+                    batchNs.push_back(elapsed / inBatch);
+                    totalNs += static_cast<double>(elapsed);
+                }
+            }
+        }
+        sink_ = fold;
+        FixScanner::setLevel(defaultLevel);
+
+        ParserBenchResult result{};
+        result.parser = parser;
+        result.messagesParsed = messages;
+        result.ordersParsed = ordersParsed;
+        if (!batchNs.empty())
+        {
+            const double parsedMessages = static_cast<double>(messages) * passes;
+            result.meanNs = totalNs / parsedMessages;
+            std::sort(batchNs.begin(), batchNs.end());
+            result.p99Ns = batchNs[static_cast<size_t>(batchNs.size() * 0.99)];
+            result.maxNs = batchNs.back();
+            result.throughputMsgsPerSec = totalNs > 0 ? parsedMessages * 1e9 / totalNs : 0.0;
+        }
+        return result;
+    }
+
+  private:
+    // The gateway's FIX path: one tokenize (sharing the segment's scanner), the session's sequence
+    // check when there is one, then either dispatch on MsgType or build the order
+    static std::optional<Order> decodeTokenized(FixScanner &scanner, size_t offset, size_t &consumed,
+                                                const SymbolTable &symbols, bool verify, FixSession *session)
+    {
+        FixFields fields;
+        if (FIXParser::tokenize(scanner, offset, consumed, fields, verify) != FIXParser::FrameStatus::Complete)
+        {
+            return std::nullopt;
+        }
+        if (session && session->onMessage(fields) != FixSession::Verdict::Deliver)
+        {
+            return std::nullopt;
+        }
+        return FIXParser::toOrder(fields, &symbols);
+    }
+
+    static void formatPrice(Price ticks, uint8_t decimals, char *out, size_t capacity)
+    {
+        if (decimals == 0)
+        {
+            std::snprintf(out, capacity, "%" PRIu64, ticks);
+            return;
+        }
+        uint64_t scale = 1;
+        for (uint8_t i = 0; i < decimals; ++i)
+        {
+            scale *= 10;
+        }
+        std::snprintf(out, capacity, "%" PRIu64 ".%0*" PRIu64, ticks / scale, static_cast<int>(decimals),
+                      ticks % scale);
+    }
+
+    static void appendFrame(std::string &stream, std::string_view body)
+    {
+        char frame[320];
+        stream.append(frame, FIXParser::buildFrame(body, frame, sizeof(frame)));
+    }
+
+    static inline volatile uint64_t sink_ = 0;
+};
+
+/**
+ * @brief Print a formatted console summary of parser results.
+ */
+inline void printParserTable(const std::string &scenario, const std::vector<ParserBenchResult> &results)
+{
+    std::cout << "\n" << std::string(106, '=') << "\n";
+    std::cout << "FIX PARSER BENCHMARK — Scenario: " << scenario << "\n";
+    std::cout << std::string(106, '=') << "\n";
+    std::cout << std::left << std::setw(12) << "Mix" << std::setw(18) << "Parser" << std::right << std::setw(12)
+              << "Mean(ns)" << std::setw(12) << "P99(ns)" << std::setw(12) << "Max(ns)" << std::setw(16)
+              << "Throughput(M/s)" << std::setw(12) << "Messages" << std::setw(12) << "Orders"
+              << "\n"
+              << std::string(106, '-') << "\n";
+
+    for (const auto &r : results)
+    {
+        std::cout << std::left << std::setw(12) << r.mix << std::setw(18) << r.parser << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << r.meanNs << std::setw(12) << r.p99Ns << std::setw(12)
+                  << r.maxNs << std::setw(16) << std::setprecision(2) << r.throughputMsgsPerSec / 1e6
+                  << std::setw(12) << r.messagesParsed << std::setw(12) << r.ordersParsed << "\n";
+    }
+    std::cout << std::string(106, '=') << "\n";
+}
+
+} // namespace hft
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "core/order.hpp"
+#include "core/order_book_registry.hpp"
+#include "utils/idle_strategy.hpp"
+#include "utils/lock_free_queue.hpp"
+#include "utils/rdtsc.hpp"
+#include "utils/thread_pinning.hpp"
+
+namespace hft
+{
+
+/**
+ * @brief Per-shard breakdown from a sharded run.
+ */
+struct ShardStats
+{
+    uint64_t ordersProcessed;
+    double queueMeanNs;
+    uint64_t queueP99Ns;
+    double engineMeanNs;
+    uint64_t engineP99Ns;
+};
+
+/**
+ * @brief Results from a single sharded-engine run.
+ */
+struct ShardedResult
+{
+    int shardCount;
+
+    // Aggregated over all shards
+    double queueMeanNs;
+    uint64_t queueP99Ns;
+    uint64_t queueMaxNs;
+    double engineMeanNs;
+    uint64_t engineP99Ns;
+
+    double throughputOrdersPerSec;
+    uint64_t ordersProcessed;
+    uint64_t fullRingRetries; // producer found a shard ring full (backpressure)
+
+    std::vector<ShardStats> shards;
+};
+
+/**
+ * @brief Throughput scaling of the sharded matching engine (one engine thread per symbol partition).
+ *
+ * Architecture:
+ *   1 router (symbol % N) ──► N SPSC rings ──► N engine threads, each owning the books of its symbols
+ *
+ * Routing and the per-shard loop mirror ShardedMatchingEngine / MatchingEngine::run. Like the other
+ * benchmark modules it drives the books directly, so only routing and book work are timed.
+ *
+ * A single router keeps the comparison about engine parallelism: it costs one push per order,
+ * well below the addOrder + match cost of any book. Full-ring retries falling to ~0 as shards
+ * are added means the engines have outrun the router and throughput is router-bound from there.
+ *
+ * Timing:
+ *   - Router stamps order.receiveTimestamp immediately before push
+ *   - Queue latency = dequeue - receiveTimestamp; engine latency = addOrder + match
+ */
+class ShardedBenchmark
+{
+  public:
+    static ShardedResult run(OrderBookRegistry &books, const std::vector<Order> &orders, int shardCount,
+                             int firstCore = -1, size_t warmupCount = 500)
+    {
+        struct Shard
+        {
+            LockFreeQueue<Order, 1024> queue;
+            std::vector<uint64_t> queueLatencies;
+            std::vector<uint64_t> engineLatencies;
+            alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> consumed{0};
+            std::thread worker;
+        };
+
+        std::vector<std::unique_ptr<Shard>> shards;
+        for (int s = 0; s < shardCount; ++s)
+        {
+            shards.push_back(std::make_unique<Shard>());
+            shards.back()->queueLatencies.reserve(orders.size() / shardCount + 1);
+            shards.back()->engineLatencies.reserve(orders.size() / shardCount + 1);
+        }
+
+        std::atomic<bool> running{true};
+        std::atomic<int> workersReady{0};
+
+        for (int s = 0; s < shardCount; ++s)
+        {
+            Shard &shard = *shards[s];
+            shard.worker = std::thread(
+                [&, s]()
+                {
+                    if (firstCore >= 0)
+                    {
+                        pinToCore(firstCore + s);
+                    }
+                    workersReady.fetch_add(1, std::memory_order_release);
+
+                    uint64_t seen = 0;
+                    Order o;
+                    auto process = [&]()
+                    {
+                        const uint64_t engineStart = getCurrentTimeNs();
+                        IOrderBook &book = books.get(o.symbol);
+                        book.addOrder(o);
+                        book.match();
+                        const uint64_t engineEnd = getCurrentTimeNs();
+
+                        if (++seen > warmupCount / shardCount)
+                        {
+                            if (engineStart > o.receiveTimestamp)
+                            {
+                                shard.queueLatencies.push_back(engineStart - o.receiveTimestamp);
+                            }
+                            shard.engineLatencies.push_back(engineEnd - engineStart);
+                        }
+                        shard.consumed.fetch_add(1, std::memory_order_release);
+                    };
+
+                    while (running.load(std::memory_order_relaxed))
+                    {
+                        if (shard.queue.pop(o))
+                        {
+                            process();
+                        }
+                        else
+                        {
+                            cpuRelax();
+                        }
+                    }
+                    while (shard.queue.pop(o))
+                    {
+                        process();
+                    }
+                });
+        }
+
+        while (workersReady.load(std::memory_order_acquire) < shardCount)
+        {
+            std::this_thread::yield();
+        }
+
+        uint64_t fullRingRetries = 0;
+        std::vector<uint64_t> routed(shardCount, 0);
+
+        const auto wallStart = std::chrono::steady_clock::now();
+        for (const auto &source : orders)
+        {
+            const size_t s = source.symbol % static_cast<size_t>(shardCount); // ShardedMatchingEngine::shardFor
+            Order o = source;
+            o.sendTimestamp = 0;
+            o.receiveTimestamp = getCurrentTimeNs();
+            while (!shards[s]->queue.push(o))
+            {
+                ++fullRingRetries;
+                cpuRelax();
+            }
+            ++routed[s];
+        }
+
+        for (int s = 0; s < shardCount; ++s)
+        {
+            while (shards[s]->consumed.load(std::memory_order_acquire) < routed[s])
+            {
+                std::this_thread::yield();
+            }
+        }
+        const auto wallEnd = std::chrono::steady_clock::now();
+
+        running.store(false, std::memory_order_relaxed);
+        for (auto &shard : shards)
+        {
+            shard->worker.join();
+        }
+
+        const double wallNs =
+            static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(wallEnd - wallStart).count());
+
+        auto calcStats = [](std::vector<uint64_t> &v) -> std::tuple<double, uint64_t, uint64_t>
+        {
+            if (v.empty())
+                return {0.0, 0, 0};
+            std::sort(v.begin(), v.end());
+            double sum = 0;
+            for (auto x : v)
+                sum += x;
+            return {sum / v.size(), v[static_cast<size_t>(v.size() * 0.99)], v.back()};
+        };
+
+        ShardedResult result{};
+        result.shardCount = shardCount;
+
+        std::vector<uint64_t> allQueue, allEngine;
+        for (auto &shard : shards)
+        {
+            allQueue.insert(allQueue.end(), shard->queueLatencies.begin(), shard->queueLatencies.end());
+            allEngine.insert(allEngine.end(), shard->engineLatencies.begin(), shard->engineLatencies.end());
+
+            auto [qMean, qP99, qMax] = calcStats(shard->queueLatencies);
+            auto [eMean, eP99, eMax] = calcStats(shard->engineLatencies);
+            (void)qMax;
+            (void)eMax;
+            result.shards.push_back(ShardStats{shard->consumed.load(), qMean, qP99, eMean, eP99});
+            result.ordersProcessed += shard->consumed.load();
+        }
+
+        std::tie(result.queueMeanNs, result.queueP99Ns, result.queueMaxNs) = calcStats(allQueue);
+        auto [eMean, eP99, eMax] = calcStats(allEngine);
+        (void)eMax;
+        result.engineMeanNs = eMean;
+        result.engineP99Ns = eP99;
+        result.throughputOrdersPerSec = (wallNs > 0) ? (orders.size() * 1e9 / wallNs) : 0.0;
+        result.fullRingRetries = fullRingRetries;
+        return result;
+    }
+};
+
+/**
+ * @brief Print a formatted console summary of a sharded run, one line per shard.
+ */
+inline void printShardedTable(const std::string &book, const std::string &scenario, const ShardedResult &r)
+{
+    std::cout << "\n" << std::string(100, '=') << "\n";
+    std::cout << "SHARDED BENCHMARK — Book: " << book << "  Scenario: " << scenario << "  Shards: " << r.shardCount
+              << "  Throughput: " << static_cast<uint64_t>(r.throughputOrdersPerSec / 1000) << " k/s\n";
+    std::cout << std::string(100, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Shard" << std::right << std::setw(12) << "Orders" << std::setw(14)
+              << "Que_Mean(ns)" << std::setw(14) << "Que_P99(ns)" << std::setw(14) << "Eng_Mean(ns)" << std::setw(14)
+              << "Eng_P99(ns)" << "\n"
+              << std::string(100, '-') << "\n";
+
+    for (size_t s = 0; s < r.shards.size(); ++s)
+    {
+        const auto &shard = r.shards[s];
+        std::cout << std::left << std::setw(10) << s << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << shard.ordersProcessed << std::setw(14) << shard.queueMeanNs << std::setw(14)
+                  << shard.queueP99Ns << std::setw(14) << shard.engineMeanNs << std::setw(14) << shard.engineP99Ns
+                  << "\n";
+    }
+    std::cout << std::string(100, '-') << "\n";
+    std::cout << std::left << std::setw(10) << "all" << std::right << std::setw(12) << r.ordersProcessed
+              << std::setw(14) << r.queueMeanNs << std::setw(14) << r.queueP99Ns << std::setw(14) << r.engineMeanNs
+              << std::setw(14) << r.engineP99Ns << "   (full-ring retries: " << r.fullRingRetries << ")\n";
+    std::cout << std::string(100, '=') << "\n";
+}
+
+} // namespace hft
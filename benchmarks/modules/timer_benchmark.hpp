@@ -0,0 +1,138 @@
+#pragma once
+
+#include "core/latency_histogram.hpp"
+#include "core/metrics_collector.hpp"
+#include "utils/rdtsc.hpp"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hft
+{
+
+struct TimerBenchResult
+{
+    std::string timer;
+
+    // Back-to-back reads: what taking one timestamp costs the thread
+    double callNs;
+
+    // Empty timed region (start read, then stop read): the floor under every latency measured with the timer
+    double regionMeanNs;
+    uint64_t regionP50Ns;
+    uint64_t regionP99Ns;
+    uint64_t regionMaxNs;
+};
+
+/**
+ * @brief Overhead of the timers latencies are measured with, so it can be subtracted from them.
+ *
+ *   chrono     - getCurrentTimeNs() (high_resolution_clock): the wall clock, as the engine used before
+ *   tsc        - TscClock::now(), a plain RDTSC: the engine's timer
+ *   tsc-fenced - TscClock::start() / stop(), LFENCE;RDTSC ... RDTSCP;LFENCE: direct-mode regions
+ *
+ * A direct-mode latency includes one empty region of tsc-fenced; the region p50 is the amount to
+ * subtract. Without an invariant TSC the tsc rows time steady_clock instead (TscClock's fallback).
+ */
+class TimerBenchmark
+{
+  public:
+    static std::vector<std::string> getSupportedTimers()
+    {
+        return {"chrono", "tsc", "tsc-fenced"};
+    }
+
+    static TimerBenchResult run(const std::string &timer, size_t samples)
+    {
+        if (timer == "chrono")
+        {
+            return measure(timer, samples, false, []() { return getCurrentTimeNs(); },
+                           []() { return getCurrentTimeNs(); });
+        }
+        else if (timer == "tsc")
+        {
+            return measure(timer, samples, true, []() { return TscClock::now(); }, []() { return TscClock::now(); });
+        }
+        else if (timer == "tsc-fenced")
+        {
+            return measure(timer, samples, true, []() { return TscClock::start(); },
+                           []() { return TscClock::stop(); });
+        }
+        throw std::runtime_error("Unknown timer: " + timer);
+    }
+
+  private:
+    template <typename Start, typename Stop>
+    static TimerBenchResult measure(const std::string &timer, size_t samples, bool ticks, Start start, Stop stop)
+    {
+        // Warm up the clock source (and TscClock's calibration) outside the measurement
+        uint64_t fold = 0;
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            fold += start() + stop();
+        }
+
+        const uint64_t callsBegin = getCurrentTimeNs();
+        for (size_t i = 0; i < samples; ++i)
+        {
+            fold += start();
+        }
+        const uint64_t callsEnd = getCurrentTimeNs();
+
+        LatencyHistogram regions;
+        for (size_t i = 0; i < samples; ++i)
+        {
+            const uint64_t begin = start();
+            const uint64_t end = stop();
+            regions.record(end - begin);
+        }
+        sink_ = fold;
+
+        const LatencyStats stats = ticks ? toNanoseconds(regions.stats()) : regions.stats();
+        TimerBenchResult result{};
+        result.timer = timer;
+        result.callNs = static_cast<double>(callsEnd - callsBegin) / static_cast<double>(samples);
+        result.regionMeanNs = stats.mean;
+        result.regionP50Ns = stats.p50;
+        result.regionP99Ns = stats.p99;
+        result.regionMaxNs = stats.max;
+        return result;
+    }
+
+    static inline volatile uint64_t sink_ = 0;
+};
+
+inline void printTimerTable(const std::vector<TimerBenchResult> &results)
+{
+    std::cout << "\n" << std::string(84, '=') << "\n";
+    std::cout << "TIMER OVERHEAD — ";
+    if (TscClock::usesTsc())
+    {
+        std::cout << "invariant TSC at " << std::fixed << std::setprecision(3) << TscClock::calibrate().ticksPerNs
+                  << " GHz\n";
+    }
+    else
+    {
+        std::cout << "no invariant TSC, tsc rows use steady_clock\n";
+    }
+    std::cout << std::string(84, '=') << "\n";
+    std::cout << std::left << std::setw(14) << "Timer" << std::right << std::setw(14) << "Call(ns)" << std::setw(14)
+              << "Region(ns)" << std::setw(14) << "Region P50" << std::setw(14) << "Region P99" << std::setw(14)
+              << "Region Max"
+              << "\n"
+              << std::string(84, '-') << "\n";
+
+    for (const auto &r : results)
+    {
+        std::cout << std::left << std::setw(14) << r.timer << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << r.callNs << std::setw(14) << r.regionMeanNs << std::setw(14) << r.regionP50Ns
+                  << std::setw(14) << r.regionP99Ns << std::setw(14) << r.regionMaxNs << "\n";
+    }
+    std::cout << std::string(84, '=') << "\n";
+}
+
+} // namespace hft
@@ -1,3 +1,4 @@
+#include "binary/binary_parser.hpp"
 #include <arpa/inet.h>
 #include <cerrno>
 #include <chrono>
@@ -62,6 +63,29 @@ std::string create_fix_message(uint64_t id, int price, int quantity, int side)
     return fixMessage;
 }
 
+/**
+ * Creates a binary NewOrder frame (see libs/binary/binary_parser.hpp) for the same order.
+ *
+ * @param id Unique order ID
+ * @param price Order price
+ * @param quantity Order quantity
+ * @param side Order side (1=Buy, 2=Sell)
+ * @return 48-byte frame
+ */
+std::string create_binary_message(uint64_t id, int price, int quantity, int side)
+{
+    hft::Order order{};
+    order.id = id;
+    order.price = static_cast<hft::Price>(price);
+    order.quantity = static_cast<hft::Quantity>(quantity);
+    order.side = side == 1 ? hft::Side::Buy : hft::Side::Sell;
+    order.type = hft::OrderType::Limit;
+
+    std::string frame(hft::BinaryParser::NEW_ORDER_SIZE, '\0');
+    hft::BinaryParser::encodeNewOrder(order, frame.data());
+    return frame;
+}
+
 int main(int argc, char *argv[])
 {
     // Default configuration
@@ -74,6 +98,7 @@ int main(int argc, char *argv[])
     int minQty = 1;
     int maxQty = 100;
     uint32_t seed = 42;
+    bool binary = false;
 
     // Parse command line arguments
     // Usage: ./tcp_order_sender [options]
@@ -87,6 +112,7 @@ int main(int argc, char *argv[])
     //   --min-qty <n>      Minimum quantity (default: 1)
     //   --max-qty <n>      Maximum quantity (default: 100)
     //   --seed <n>         Random seed (default: 42)
+    //   --binary           Send binary frames instead of FIX
     for (int i = 1; i < argc; i++)
     {
         std::string arg = argv[i];
@@ -127,6 +153,10 @@ int main(int argc, char *argv[])
         {
             seed = std::atoi(argv[++i]);
         }
+        else if (arg == "--binary")
+        {
+            binary = true;
+        }
         else if (arg == "--help" || arg == "-h")
         {
             std::cout << "Usage: " << argv[0] << " [options]\n"
@@ -140,6 +170,7 @@ int main(int argc, char *argv[])
                       << "  --min-qty <n>      Minimum quantity (default: 1)\n"
                       << "  --max-qty <n>      Maximum quantity (default: 100)\n"
                       << "  --seed <n>         Random seed for reproducibility (default: 42)\n"
+                      << "  --binary           Send binary order frames instead of FIX\n"
                       << "  --help, -h         Show this help message\n";
             return 0;
         }
@@ -173,7 +204,8 @@ int main(int argc, char *argv[])
               << "  Server: " << serverHost << ":" << serverPort << "\n"
               << "  Price range: [" << minPrice << ", " << maxPrice << "] with tick " << tickSize << "\n"
               << "  Quantity range: [" << minQty << ", " << maxQty << "]\n"
-              << "  Random seed: " << seed << "\n";
+              << "  Random seed: " << seed << "\n"
+              << "  Protocol: " << (binary ? "binary" : "FIX") << "\n";
 
     std::cout << "Preparing " << orderCount << " orders in memory..." << std::endl;
 
@@ -198,8 +230,10 @@ int main(int argc, char *argv[])
     for (int i = 0; i < orderCount; ++i)
     {
         int price = validPrices[priceIndexDistribution(randomGenerator)];
-        orders.push_back(
-            create_fix_message(i, price, quantityDistribution(randomGenerator), sideDistribution(randomGenerator)));
+        int quantity = quantityDistribution(randomGenerator);
+        int side = sideDistribution(randomGenerator);
+        orders.push_back(binary ? create_binary_message(i, price, quantity, side)
+                                : create_fix_message(i, price, quantity, side));
     }
 
     std::cout << "Connecting to " << serverHost << ":" << serverPort << "..." << std::endl;
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "core/Order.hpp"
+#include "core/symbol_table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace hft
+{
+
+/**
+ * @brief Fixed-layout binary order entry, accepted by the gateway alongside FIX.
+ *
+ * Every frame starts with a 4-byte header: MAGIC, message type, and the total frame length
+ * (header included) as a little-endian uint16. All fields sit at fixed offsets and all integers
+ * are little-endian, so decoding is a handful of loads with no scanning.
+ *
+ * The protocol is chosen per message, by its first byte: FIX frames always start with '8'
+ * ("8=FIX..."), binary frames with MAGIC. A connection may therefore use either, and the gateway
+ * keeps no per-connection protocol state. Replies (U2 stats, execution reports) stay FIX text.
+ *
+ * NewOrder (48 bytes)
+ *   0  u8   MAGIC
+ *   1  u8   MSG_NEW_ORDER
+ *   2  u16  length = 48
+ *   4  u8   side (1 buy, 2 sell)
+ *   5  u8   type (1 market, 2 limit)
+ *   6  u16  reserved
+ *   8  u32  symbol id (SymbolTable order; SYM<n> = n)
+ *  12  u32  reserved
+ *  16  u64  order id
+ *  24  u64  price
+ *  32  u64  quantity
+ *  40  u64  send timestamp, ns (FIX tag 60)
+ *
+ * StatsRequest (16 bytes): header with MSG_STATS_REQUEST, u32 reserved, then at offset 8
+ * the u64 expected order count (FIX U1 tag 596).
+ */
+class BinaryParser
+{
+  public:
+    static constexpr unsigned char MAGIC = 0xB5;
+    static constexpr unsigned char MSG_NEW_ORDER = 0x01;
+    static constexpr unsigned char MSG_STATS_REQUEST = 0x02;
+    static constexpr std::size_t HEADER_SIZE = 4;
+    static constexpr std::size_t NEW_ORDER_SIZE = 48;
+    static constexpr std::size_t STATS_REQUEST_SIZE = 16;
+
+    static inline bool isBinary(std::span<const char> buffer)
+    {
+        return !buffer.empty() && static_cast<unsigned char>(buffer[0]) == MAGIC;
+    }
+
+    // Message type of the frame at the start of buffer, or 0 if the header is not complete yet.
+    static inline unsigned char getMessageType(std::span<const char> buffer)
+    {
+        return buffer.size() < HEADER_SIZE ? 0 : static_cast<unsigned char>(buffer[1]);
+    }
+
+    // Same contract as FIXParser::parse: bytesConsumed = 0 means incomplete, otherwise the frame
+    // is consumed and nullopt means it was rejected. A length below the header size cannot be
+    // resynchronised from, so it consumes the whole buffer (the gateway drops the data).
+    static inline std::optional<Order> parse(std::span<const char> buffer, size_t &bytesConsumed,
+                                             const SymbolTable *symbols = nullptr)
+    {
+        bytesConsumed = 0;
+        if (buffer.size() < HEADER_SIZE)
+        {
+            return std::nullopt;
+        }
+
+        const auto *bytes = reinterpret_cast<const unsigned char *>(buffer.data());
+        const std::size_t length = load16(bytes + 2);
+        if (bytes[0] != MAGIC || length < HEADER_SIZE)
+        {
+            bytesConsumed = buffer.size();
+            return std::nullopt;
+        }
+        if (buffer.size() < length)
+        {
+            return std::nullopt; // Incomplete
+        }
+        bytesConsumed = length;
+
+        if (bytes[1] != MSG_NEW_ORDER || length != NEW_ORDER_SIZE)
+        {
+            return std::nullopt; // Stats requests are handled by the gateway; anything else is ignored
+        }
+
+        Order order{};
+        switch (bytes[4])
+        {
+            case 1:
+                order.side = Side::Buy;
+                break;
+            case 2:
+                order.side = Side::Sell;
+                break;
+            default:
+                return std::nullopt;
+        }
+        switch (bytes[5])
+        {
+            case 1:
+                order.type = OrderType::Market;
+                break;
+            case 2:
+                order.type = OrderType::Limit;
+                break;
+            default:
+                return std::nullopt;
+        }
+
+        order.id = load64(bytes + 16);
+        order.price = load64(bytes + 24);
+        order.quantity = load64(bytes + 32);
+        order.sendTimestamp = load64(bytes + 40);
+        if (order.quantity == 0 || (order.type == OrderType::Limit && order.price == 0))
+        {
+            return std::nullopt;
+        }
+
+        // Same symbol policy as FIX: without a table everything goes to the default instrument
+        order.symbol = SymbolTable::DEFAULT_SYMBOL;
+        if (symbols != nullptr)
+        {
+            order.symbol = load32(bytes + 8);
+            if (order.symbol >= symbols->size())
+            {
+                return std::nullopt;
+            }
+        }
+        return order;
+    }
+
+    // Expected count of a complete MSG_STATS_REQUEST frame at the start of buffer
+    static inline uint64_t getExpectedCount(std::span<const char> buffer)
+    {
+        if (buffer.size() < STATS_REQUEST_SIZE)
+        {
+            return 0;
+        }
+        return load64(reinterpret_cast<const unsigned char *>(buffer.data()) + 8);
+    }
+
+    // Writes a NewOrder frame into out (NEW_ORDER_SIZE bytes); sendTimestamp is taken from the order.
+    static inline void encodeNewOrder(const Order &order, char *out)
+    {
+        auto *bytes = reinterpret_cast<unsigned char *>(out);
+        writeHeader(bytes, MSG_NEW_ORDER, NEW_ORDER_SIZE);
+        bytes[4] = order.side == Side::Buy ? 1 : 2;
+        bytes[5] = order.type == OrderType::Market ? 1 : 2;
+        store16(bytes + 6, 0);
+        store32(bytes + 8, order.symbol);
+        store32(bytes + 12, 0);
+        store64(bytes + 16, order.id);
+        store64(bytes + 24, order.price);
+        store64(bytes + 32, order.quantity);
+        store64(bytes + 40, order.sendTimestamp);
+    }
+
+    // Writes a StatsRequest frame into out (STATS_REQUEST_SIZE bytes)
+    static inline void encodeStatsRequest(uint64_t expectedCount, char *out)
+    {
+        auto *bytes = reinterpret_cast<unsigned char *>(out);
+        writeHeader(bytes, MSG_STATS_REQUEST, STATS_REQUEST_SIZE);
+        store32(bytes + 4, 0);
+        store64(bytes + 8, expectedCount);
+    }
+
+  private:
+    // Byte-wise so the layout is little-endian on any host; compilers fold these into single loads/stores.
+    static inline uint16_t load16(const unsigned char *p)
+    {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    static inline uint32_t load32(const unsigned char *p)
+    {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    static inline uint64_t load64(const unsigned char *p)
+    {
+        return static_cast<uint64_t>(load32(p)) | (static_cast<uint64_t>(load32(p + 4)) << 32);
+    }
+
+    static inline void store16(unsigned char *p, uint16_t value)
+    {
+        p[0] = static_cast<unsigned char>(value);
+        p[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    static inline void store32(unsigned char *p, uint32_t value)
+    {
+        store16(p, static_cast<uint16_t>(value));
+        store16(p + 2, static_cast<uint16_t>(value >> 16));
+    }
+
+    static inline void store64(unsigned char *p, uint64_t value)
+    {
+        store32(p, static_cast<uint32_t>(value));
+        store32(p + 4, static_cast<uint32_t>(value >> 32));
+    }
+
+    static inline void writeHeader(unsigned char *p, unsigned char type, std::size_t length)
+    {
+        p[0] = MAGIC;
+        p[1] = type;
+        store16(p + 2, static_cast<uint16_t>(length));
+    }
+};
+
+} // namespace hft
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "fix/fix_scanner.hpp"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(HFT_FIX_SCANNER_X86)
+#include <immintrin.h>
+#endif
+
+namespace hft
+{
+
+/**
+ * @brief FIX CheckSum(10): the byte sum, modulo 256, of everything before the "10=" field.
+ *
+ * The vector kernels sum 16 or 32 bytes per instruction with PSADBW (sum of absolute
+ * differences against zero), which widens to 64-bit lanes, so the accumulators cannot
+ * overflow on any frame. The kernel follows FixScanner's level, so both are switched
+ * together by FixScanner::setLevel().
+ */
+class FixChecksum
+{
+  public:
+    static inline uint8_t compute(const char *data, std::size_t size)
+    {
+        return compute(data, size, FixScanner::getLevel());
+    }
+
+    static inline uint8_t compute(const char *data, std::size_t size, ScanLevel level)
+    {
+        switch (level)
+        {
+#if defined(HFT_FIX_SCANNER_X86)
+            case ScanLevel::Avx2:
+                return sumAvx2(data, size);
+            case ScanLevel::Sse2:
+                return sumSse2(data, size);
+#endif
+            default:
+                return sumScalar(data, size);
+        }
+    }
+
+  private:
+    static inline uint8_t sumScalar(const char *data, std::size_t size)
+    {
+        uint32_t sum = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            sum += static_cast<unsigned char>(data[i]);
+        }
+        return static_cast<uint8_t>(sum);
+    }
+
+#if defined(HFT_FIX_SCANNER_X86)
+    __attribute__((target("sse2"))) static uint8_t sumSse2(const char *data, std::size_t size)
+    {
+        __m128i total = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            total = _mm_add_epi64(total, _mm_sad_epu8(bytes, _mm_setzero_si128()));
+        }
+        const uint64_t vectorSum = static_cast<uint64_t>(_mm_cvtsi128_si64(total)) +
+                                   static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(total, total)));
+        return static_cast<uint8_t>(vectorSum + sumScalar(data + i, size - i));
+    }
+
+    __attribute__((target("avx2"))) static uint8_t sumAvx2(const char *data, std::size_t size)
+    {
+        __m256i total = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+        }
+        const __m128i folded = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+        const uint64_t vectorSum = static_cast<uint64_t>(_mm_cvtsi128_si64(folded)) +
+                                   static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(folded, folded)));
+        return static_cast<uint8_t>(vectorSum + sumScalar(data + i, size - i));
+    }
+#endif
+};
+
+} // namespace hft
@@ -1,9 +1,15 @@
 #pragma once
 
 #include "core/Order.hpp"
-#include <cctype>
+#include "core/symbol_table.hpp"
+#include "fix/fix_checksum.hpp"
+#include "fix/fix_price.hpp"
+#include "fix/fix_scanner.hpp"
+#include <array>
 #include <charconv>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <optional>
 #include <span>
 #include <string_view>
@@ -11,81 +17,219 @@
 namespace hft
 {
 
+/**
+ * @brief The fields FIXParser reads, captured by one pass over a frame.
+ *
+ * Each known tag maps to a fixed slot; values are views into the caller's buffer. As with a tag
+ * search, the first occurrence of a tag wins and unknown tags are skipped. Only the presence
+ * flags are cleared per frame; a value is read only when its flag is set.
+ */
+struct FixFields
+{
+    enum Field : uint8_t
+    {
+        MsgType,       // 35
+        ClOrdId,       // 11
+        Side,          // 54
+        Price,         // 44
+        OrderQty,      // 38
+        OrdType,       // 40
+        Symbol,        // 55
+        TransactTime,  // 60
+        ExpectedCount, // 596 (U1 sync barrier)
+        // Session layer (FixSession)
+        MsgSeqNum,    // 34
+        PossDupFlag,  // 43
+        SenderCompId, // 49
+        TargetCompId, // 56
+        HeartBtInt,   // 108
+        TestReqId,    // 112
+        BeginSeqNo,   // 7
+        EndSeqNo,     // 16
+        NewSeqNo,     // 36
+        GapFillFlag,  // 123
+        FieldCount
+    };
+
+    std::array<std::string_view, FieldCount> values;
+    std::array<bool, FieldCount> present{};
+
+    std::string_view get(Field field) const
+    {
+        return present[field] ? values[field] : std::string_view{};
+    }
+
+    bool has(Field field) const
+    {
+        return present[field];
+    }
+};
+
 class FIXParser
 {
   public:
     static constexpr char SOH = '\x01';
 
-    // Parses a single FIX message from the buffer.
-    // Returns std::nullopt if incomplete or invalid.
-    // Updates bytesConsumed to indicate how much data was processed.
-    static inline std::optional<Order> parse(std::span<const char> buffer, size_t &bytesConsumed)
+    enum class FrameStatus : uint8_t
     {
-        std::string_view bufferView(buffer.data(), buffer.size());
+        Incomplete, // No complete frame yet; nothing consumed
+        Malformed,  // Frame consumed but its CheckSum(10) field (or, when verifying, its length/sum) is invalid
+        Complete    // Frame consumed and fields captured
+    };
 
-        // Find end of message (checksum tag 10=...)
-        size_t checksumPosition = bufferView.find("\x01\x31\x30\x3d"); // \x0110=
-        if (checksumPosition == std::string_view::npos)
-        {
-            bytesConsumed = 0;
-            return std::nullopt; // Incomplete
-        }
+    // Walks one frame field by field: each tag is decoded as an integer and its value stored in
+    // the matching FixFields slot. The frame ends at the first CheckSum(10) field, which must be
+    // 3 digits and SOH ("10=XXX<SOH>"). Consumption rules match parse().
+    // Field boundaries come from FixScanner, which classifies 64 bytes per step.
+    static inline FrameStatus tokenize(std::span<const char> buffer, size_t &bytesConsumed, FixFields &fields,
+                                       bool verify = false)
+    {
+        FixScanner scanner(buffer);
+        return tokenize(scanner, 0, bytesConsumed, fields, verify);
+    }
 
-        // Require full checksum field body (10=XXX<SOH>) before consuming a message.
-        // If the 3 checksum digits are not yet present, treat as incomplete.
-        if (bufferView.size() < checksumPosition + 8)
-        {
-            bytesConsumed = 0;
-            return std::nullopt;
-        }
+    // Same, for the frame starting at offset in the scanner's buffer. Reusing one scanner for
+    // back-to-back frames of a batch classifies each block once instead of once per frame.
+    //
+    // A frame that starts "8=...<SOH>9=N<SOH>" is framed by its BodyLength: the trailer is expected
+    // N bytes after the 9= field, so the walk stops there without testing every field for "10=".
+    // A BodyLength that does not point at "<SOH>10=" is ignored and the frame is found by scanning.
+    //
+    // verify (per session) makes both fields binding: a frame without BodyLength, with one that does
+    // not match, or whose CheckSum is not the byte sum mod 256 is Malformed (and consumed). A
+    // partial frame is then reported Incomplete from its header alone, without scanning it.
+    static inline FrameStatus tokenize(FixScanner &scanner, size_t offset, size_t &bytesConsumed, FixFields &fields,
+                                       bool verify = false)
+    {
+        const std::span<const char> buffer = scanner.buffer().subspan(offset);
+        const char *const data = buffer.data();
+        const size_t size = buffer.size();
+        size_t field = 0;
+        bytesConsumed = 0;
 
-        if (!std::isdigit(static_cast<unsigned char>(bufferView[checksumPosition + 4])) ||
-            !std::isdigit(static_cast<unsigned char>(bufferView[checksumPosition + 5])) ||
-            !std::isdigit(static_cast<unsigned char>(bufferView[checksumPosition + 6])))
+        size_t trailer = 0;
+        bool trailerKnown = false;
+        bool lengthValid = false;
+        if (readBodyLength(data, size, trailer))
         {
-            bytesConsumed = checksumPosition + 8;
-            return std::nullopt; // Malformed checksum value in a complete frame
+            if (size >= trailer + 7)
+            {
+                trailerKnown = data[trailer - 1] == SOH && data[trailer] == '1' && data[trailer + 1] == '0' &&
+                               data[trailer + 2] == '=';
+                lengthValid = trailerKnown;
+            }
+            else if (verify)
+            {
+                return FrameStatus::Incomplete;
+            }
         }
 
-        // Find the SOH after 10=XXX
-        size_t endOfMessagePosition = checksumPosition + 7;
-        if (bufferView[endOfMessagePosition] != SOH)
+        scanner.seek(offset);
+        while (field < size)
         {
-            bytesConsumed = checksumPosition + 8;
-            return std::nullopt; // Malformed checksum terminator
-        }
+            // CheckSum ends the frame; like the tag search, only after an SOH (not as the first field)
+            if (trailerKnown ? field == trailer
+                             : (field != 0 && size - field >= 3 && data[field] == '1' && data[field + 1] == '0' &&
+                                data[field + 2] == '='))
+            {
+                const size_t checksumPosition = field - 1; // The SOH before 10=
+                if (size < checksumPosition + 8)
+                {
+                    return FrameStatus::Incomplete; // 10=XXX<SOH> not fully received yet
+                }
+                bytesConsumed = checksumPosition + 8;
+                if (!isDigit(data[field + 3]) || !isDigit(data[field + 4]) || !isDigit(data[field + 5]) ||
+                    data[field + 6] != SOH)
+                {
+                    return FrameStatus::Malformed;
+                }
+                if (verify)
+                {
+                    const unsigned declared = static_cast<unsigned>(data[field + 3] - '0') * 100 +
+                                              static_cast<unsigned>(data[field + 4] - '0') * 10 +
+                                              static_cast<unsigned>(data[field + 5] - '0');
+                    if (!lengthValid || declared != FixChecksum::compute(data, field))
+                    {
+                        return FrameStatus::Malformed;
+                    }
+                }
+                return FrameStatus::Complete;
+            }
 
-        bytesConsumed = endOfMessagePosition + 1;
-        std::string_view message = bufferView.substr(0, bytesConsumed);
+            // The first delimiter of a field ends its tag when it is '='; the value runs to the next SOH
+            size_t delimiter = 0;
+            bool isSoh = false;
+            if (!scanner.next(delimiter, isSoh))
+            {
+                return FrameStatus::Incomplete;
+            }
+            delimiter -= offset;
+            if (!isSoh)
+            {
+                const int slot = slotFor(data + field, delimiter - field);
+                const size_t valueStart = delimiter + 1;
+                do
+                {
+                    if (!scanner.next(delimiter, isSoh))
+                    {
+                        return FrameStatus::Incomplete;
+                    }
+                } while (!isSoh); // '=' inside a value is data
+                delimiter -= offset;
+                if (slot >= 0 && !fields.present[slot])
+                {
+                    fields.present[slot] = true;
+                    fields.values[slot] = std::string_view(data + valueStart, delimiter - valueStart);
+                }
+            }
+            field = delimiter + 1;
+        }
+        return FrameStatus::Incomplete;
+    }
 
-        // Basic validation: MsgType(35)
-        auto msgType = getTagValue(message, 35);
-        if (msgType == "U1") // Custom Stats Request
+    // Wraps body (the fields after BodyLength, each ending in SOH) into a complete frame:
+    // BeginString, BodyLength, body and a real CheckSum. Returns the frame length, 0 if out is too small.
+    static inline size_t buildFrame(std::string_view body, char *out, size_t capacity)
+    {
+        const int header = std::snprintf(out, capacity, "8=FIX.4.2\x01" "9=%zu\x01", body.size());
+        if (header <= 0 || static_cast<size_t>(header) + body.size() + 7 > capacity)
         {
-            return std::nullopt; // Gateway will handle this separately
+            return 0;
         }
+        std::memcpy(out + header, body.data(), body.size());
+        size_t length = static_cast<size_t>(header) + body.size();
+        const uint8_t checksum = FixChecksum::compute(out, length);
+        out[length++] = '1';
+        out[length++] = '0';
+        out[length++] = '=';
+        out[length++] = static_cast<char>('0' + checksum / 100);
+        out[length++] = static_cast<char>('0' + checksum / 10 % 10);
+        out[length++] = static_cast<char>('0' + checksum % 10);
+        out[length++] = SOH;
+        return length;
+    }
 
-        if (msgType != "D") // NewOrderSingle
+    // Builds an order from a tokenized NewOrderSingle (35=D). Other message types give nullopt.
+    // With a symbol table, Symbol(55) is resolved to its SymbolId and unknown symbols are rejected.
+    // Without one (or when tag 55 is absent) the order goes to the default instrument, symbol 0.
+    // Price(44) may be decimal; it is converted to ticks at that instrument's implied decimals.
+    static inline std::optional<Order> toOrder(const FixFields &fields, const SymbolTable *symbols = nullptr)
+    {
+        if (fields.get(FixFields::MsgType) != "D") // NewOrderSingle
         {
-            return std::nullopt; // Ignore non-order messages
+            return std::nullopt; // Ignore non-order messages (U1 is handled by the gateway)
         }
 
         Order order{};
 
         // ClOrdID (11) -> OrderId
-        auto clientOrderId = getTagValue(message, 11);
-        if (clientOrderId.empty())
-        {
-            return std::nullopt;
-        }
-        auto idResult = std::from_chars(clientOrderId.data(), clientOrderId.data() + clientOrderId.size(), order.id);
-        if (idResult.ec != std::errc{} || idResult.ptr != clientOrderId.data() + clientOrderId.size())
+        if (!parseNumber(fields.get(FixFields::ClOrdId), order.id))
         {
             return std::nullopt;
         }
 
         // Side (54): 1=Buy, 2=Sell
-        auto side = getTagValue(message, 54);
+        auto side = fields.get(FixFields::Side);
         if (side == "1")
         {
             order.side = Side::Buy;
@@ -99,36 +243,37 @@ class FIXParser
             return std::nullopt;
         }
 
-        // Price (44)
-        auto price = getTagValue(message, 44);
-        if (!price.empty())
+        // Symbol (55) -> SymbolId
+        order.symbol = SymbolTable::DEFAULT_SYMBOL;
+        if (symbols != nullptr)
         {
-            auto priceResult = std::from_chars(price.data(), price.data() + price.size(), order.price);
-            if (priceResult.ec != std::errc{} || priceResult.ptr != price.data() + price.size())
+            auto symbol = fields.get(FixFields::Symbol);
+            if (!symbol.empty())
             {
-                return std::nullopt;
+                order.symbol = symbols->find(symbol);
+                if (order.symbol == SymbolTable::INVALID_SYMBOL)
+                {
+                    return std::nullopt;
+                }
             }
         }
 
-        // OrderQty (38)
-        auto quantityString = getTagValue(message, 38);
-        if (quantityString.empty())
-        {
-            return std::nullopt;
-        }
-        auto quantityResult =
-            std::from_chars(quantityString.data(), quantityString.data() + quantityString.size(), order.quantity);
-        if (quantityResult.ec != std::errc{} || quantityResult.ptr != quantityString.data() + quantityString.size())
+        // Price (44) -> ticks at the instrument's implied decimals (whole ticks without a table)
+        auto price = fields.get(FixFields::Price);
+        const uint8_t decimals = symbols != nullptr ? symbols->priceDecimals(order.symbol) : 0;
+        if (!price.empty() && !FixPrice::parse(price, decimals, order.price))
         {
             return std::nullopt;
         }
-        if (order.quantity == 0)
+
+        // OrderQty (38)
+        if (!parseNumber(fields.get(FixFields::OrderQty), order.quantity) || order.quantity == 0)
         {
             return std::nullopt;
         }
 
         // OrdType (40): 1=Market, 2=Limit
-        auto type = getTagValue(message, 40);
+        auto type = fields.get(FixFields::OrdType);
         if (type == "1")
         {
             order.type = OrderType::Market;
@@ -142,29 +287,35 @@ class FIXParser
             return std::nullopt;
         }
 
-        if (order.type == OrderType::Limit && price.empty())
-        {
-            return std::nullopt;
-        }
-        if (order.type == OrderType::Limit && order.price == 0)
+        if (order.type == OrderType::Limit && (price.empty() || order.price == 0))
         {
             return std::nullopt;
         }
 
         // TransactionTime (60) -> sendTimestamp
-        auto transTime = getTagValue(message, 60);
-        if (!transTime.empty())
+        auto transTime = fields.get(FixFields::TransactTime);
+        if (!transTime.empty() && !parseNumber(transTime, order.sendTimestamp))
         {
-            auto tsResult = std::from_chars(transTime.data(), transTime.data() + transTime.size(), order.sendTimestamp);
-            if (tsResult.ec != std::errc{} || tsResult.ptr != transTime.data() + transTime.size())
-            {
-                return std::nullopt;
-            }
+            return std::nullopt;
         }
 
         return order;
     }
 
+    // Parses a single FIX message from the buffer.
+    // Returns std::nullopt if incomplete or invalid.
+    // Updates bytesConsumed to indicate how much data was processed.
+    static inline std::optional<Order> parse(std::span<const char> buffer, size_t &bytesConsumed,
+                                             const SymbolTable *symbols = nullptr)
+    {
+        FixFields fields;
+        if (tokenize(buffer, bytesConsumed, fields) != FrameStatus::Complete)
+        {
+            return std::nullopt;
+        }
+        return toOrder(fields, symbols);
+    }
+
     static inline std::string_view getMessageType(std::span<const char> buffer)
     {
         std::string_view message(buffer.data(), buffer.size());
@@ -208,6 +359,116 @@ class FIXParser
     }
 
   private:
+    static inline bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // BeginString(8) then BodyLength(9) as the first two fields; trailer = where "10=" must start
+    static inline bool readBodyLength(const char *data, size_t size, size_t &trailer)
+    {
+        if (size < 2 || data[0] != '8' || data[1] != '=')
+        {
+            return false;
+        }
+        const void *beginEnd = std::memchr(data, SOH, size < 32 ? size : 32);
+        if (beginEnd == nullptr)
+        {
+            return false;
+        }
+        size_t position = static_cast<size_t>(static_cast<const char *>(beginEnd) - data) + 1;
+        if (size < position + 2 || data[position] != '9' || data[position + 1] != '=')
+        {
+            return false;
+        }
+        position += 2;
+        size_t length = 0, digits = 0;
+        while (position < size && isDigit(data[position]) && digits < 7)
+        {
+            length = length * 10 + static_cast<size_t>(data[position] - '0');
+            ++position;
+            ++digits;
+        }
+        if (digits == 0 || position >= size || data[position] != SOH)
+        {
+            return false;
+        }
+        trailer = position + 1 + length;
+        return true;
+    }
+
+    // Tag text (digits before '=') -> FixFields slot, -1 for tags the parser does not read or that
+    // are not a tag at all
+    static inline int slotFor(const char *tagText, size_t length)
+    {
+        if (length == 0 || length > 6)
+        {
+            return -1;
+        }
+        uint32_t tag = 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (!isDigit(tagText[i]))
+            {
+                return -1;
+            }
+            tag = tag * 10 + static_cast<uint32_t>(tagText[i] - '0');
+        }
+        switch (tag)
+        {
+            case 35:
+                return FixFields::MsgType;
+            case 11:
+                return FixFields::ClOrdId;
+            case 54:
+                return FixFields::Side;
+            case 44:
+                return FixFields::Price;
+            case 38:
+                return FixFields::OrderQty;
+            case 40:
+                return FixFields::OrdType;
+            case 55:
+                return FixFields::Symbol;
+            case 60:
+                return FixFields::TransactTime;
+            case 596:
+                return FixFields::ExpectedCount;
+            case 34:
+                return FixFields::MsgSeqNum;
+            case 43:
+                return FixFields::PossDupFlag;
+            case 49:
+                return FixFields::SenderCompId;
+            case 56:
+                return FixFields::TargetCompId;
+            case 108:
+                return FixFields::HeartBtInt;
+            case 112:
+                return FixFields::TestReqId;
+            case 7:
+                return FixFields::BeginSeqNo;
+            case 16:
+                return FixFields::EndSeqNo;
+            case 36:
+                return FixFields::NewSeqNo;
+            case 123:
+                return FixFields::GapFillFlag;
+            default:
+                return -1;
+        }
+    }
+
+    // Whole value must be digits (empty is rejected)
+    template <typename Number> static inline bool parseNumber(std::string_view value, Number &out)
+    {
+        if (value.empty())
+        {
+            return false;
+        }
+        auto result = std::from_chars(value.data(), value.data() + value.size(), out);
+        return result.ec == std::errc{} && result.ptr == value.data() + value.size();
+    }
 };
 
 } // namespace hft
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "core/Order.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace hft
+{
+
+/**
+ * @brief FIX Price (tag 44) text -> integer ticks, without floating point.
+ *
+ * An instrument quoted with D implied decimals stores 101.25 as 10125 when D is 2. Prices of up
+ * to 8 characters (nearly every quote) never leave registers: the text is loaded into one
+ * uint64_t, the '.' is located with a zero-byte test and squeezed out with two shifts, and the
+ * remaining digits are validated with one mask test and converted by an 8-digit SWAR fold (three
+ * multiplies). The fraction is then scaled to D digits with one multiply by a power of ten.
+ * Longer values are laid out in a 16-byte '0'-filled buffer and converted 8 digits at a time,
+ * and values past 16 digits use a scalar loop with overflow checks.
+ *
+ * Fractional digits beyond D are accepted only when they are zeros; anything else is off the
+ * tick grid and rejected, as are signs, exponents and an empty integer part.
+ */
+class FixPrice
+{
+  public:
+    static constexpr uint8_t MAX_DECIMALS = 9;
+
+    static inline bool parse(std::string_view text, uint8_t decimals, Price &ticks)
+    {
+        if (text.empty() || decimals > MAX_DECIMALS)
+        {
+            return false;
+        }
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (text.size() <= 8)
+            {
+                const int result = parseShort(text.data(), text.size(), decimals, ticks);
+                if (result >= 0)
+                {
+                    return result != 0;
+                }
+            }
+        }
+        const char *const dot = static_cast<const char *>(std::memchr(text.data(), '.', text.size()));
+        const std::size_t integerLength = dot != nullptr ? static_cast<std::size_t>(dot - text.data()) : text.size();
+        const std::size_t fractionStart = dot != nullptr ? integerLength + 1 : text.size();
+        std::size_t fractionLength = text.size() - fractionStart;
+        if (integerLength == 0)
+        {
+            return false;
+        }
+
+        // Digits past the instrument's precision must be trailing zeros
+        for (; fractionLength > decimals; --fractionLength)
+        {
+            if (text[fractionStart + fractionLength - 1] != '0')
+            {
+                return false;
+            }
+        }
+
+        const std::size_t length = integerLength + decimals;
+        if (length > 16 || std::endian::native != std::endian::little)
+        {
+            return parseScalar(text, integerLength, fractionStart, fractionLength, decimals, ticks);
+        }
+
+        char digits[16];
+        std::memset(digits, '0', sizeof(digits));
+        char *const start = digits + (16 - length);
+        std::memcpy(start, text.data(), integerLength);
+        std::memcpy(start + integerLength, text.data() + fractionStart, fractionLength);
+
+        uint64_t high = 0, low = 0;
+        if (!convert8(digits, high) || !convert8(digits + 8, low))
+        {
+            return false;
+        }
+        ticks = high * 100000000ULL + low;
+        return true;
+    }
+
+  private:
+    static constexpr uint64_t ASCII_ZEROS = 0x3030303030303030ULL;
+
+    static constexpr uint64_t POW10[MAX_DECIMALS + 1] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL};
+
+    // 1 = parsed, 0 = invalid, -1 = valid shape but needs the general path (fraction longer than D)
+    static inline int parseShort(const char *text, std::size_t size, uint8_t decimals, Price &ticks)
+    {
+        // Byte i of chunk is text[i]; bytes at or past size are zero. Overlapping loads of the
+        // same bytes OR to the same value, so no byte-by-byte copy is needed.
+        uint64_t chunk = 0;
+        if (size >= 4)
+        {
+            uint32_t head = 0, tail = 0;
+            std::memcpy(&head, text, 4);
+            std::memcpy(&tail, text + size - 4, 4);
+            chunk = head | (static_cast<uint64_t>(tail) << ((size - 4) * 8));
+        }
+        else
+        {
+            chunk = static_cast<uint64_t>(static_cast<unsigned char>(text[0])) |
+                    static_cast<uint64_t>(static_cast<unsigned char>(text[size / 2])) << (size / 2 * 8) |
+                    static_cast<uint64_t>(static_cast<unsigned char>(text[size - 1])) << ((size - 1) * 8);
+        }
+
+        // Lowest '.' (the lowest flagged byte of the zero-byte test is exact)
+        const uint64_t dots = chunk ^ 0x2E2E2E2E2E2E2E2EULL;
+        const uint64_t dotMask = (dots - 0x0101010101010101ULL) & ~dots & 0x8080808080808080ULL;
+        std::size_t digits = size;
+        std::size_t fraction = 0;
+        if (dotMask != 0)
+        {
+            const std::size_t dot = static_cast<std::size_t>(std::countr_zero(dotMask)) / 8;
+            if (dot == 0)
+            {
+                return 0;
+            }
+            fraction = size - dot - 1;
+            if (fraction > decimals)
+            {
+                return -1;
+            }
+            const uint64_t integer = chunk & ((1ULL << (dot * 8)) - 1);
+            chunk = integer | (((chunk >> (dot * 8)) >> 8) << (dot * 8));
+            digits = size - 1;
+        }
+        if (digits == 0)
+        {
+            return 0;
+        }
+
+        // Right-align the digits into all 8 bytes, '0'-filled in front, for the SWAR fold
+        const std::size_t pad = (8 - digits) * 8;
+        chunk = (chunk << pad) | (ASCII_ZEROS & ((1ULL << pad) - 1));
+        uint64_t value = 0;
+        if (!convert8(chunk, value))
+        {
+            return 0;
+        }
+        ticks = value * POW10[decimals - fraction];
+        return 1;
+    }
+
+    static inline bool convert8(const char *text, uint64_t &value)
+    {
+        uint64_t chunk = 0;
+        std::memcpy(&chunk, text, sizeof(chunk));
+        return convert8(chunk, value);
+    }
+
+    // Eight ASCII digits (most significant in the lowest byte) -> value; false if any byte is not a digit
+    static inline bool convert8(uint64_t chunk, uint64_t &value)
+    {
+        // A byte is a digit iff its high nibble is 3 and adding 6 does not carry into it
+        if (((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) !=
+            0x3333333333333333ULL)
+        {
+            return false;
+        }
+        chunk -= ASCII_ZEROS;
+        chunk = chunk * 10 + (chunk >> 8); // Adjacent digits -> 2-digit values in the even bytes
+        chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                 (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+                32;
+        value = chunk;
+        return true;
+    }
+
+    static inline bool parseScalar(std::string_view text, std::size_t integerLength, std::size_t fractionStart,
+                                   std::size_t fractionLength, uint8_t decimals, Price &ticks)
+    {
+        Price value = 0;
+        auto append = [&value](char c)
+        {
+            const unsigned digit = static_cast<unsigned char>(c) - static_cast<unsigned>('0');
+            return digit <= 9 && !__builtin_mul_overflow(value, Price{10}, &value) &&
+                   !__builtin_add_overflow(value, Price{digit}, &value);
+        };
+        for (std::size_t i = 0; i < integerLength; ++i)
+        {
+            if (!append(text[i]))
+            {
+                return false;
+            }
+        }
+        for (std::size_t i = 0; i < decimals; ++i)
+        {
+            if (!append(i < fractionLength ? text[fractionStart + i] : '0'))
+            {
+                return false;
+            }
+        }
+        ticks = value;
+        return true;
+    }
+};
+
+} // namespace hft
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+// x86-64 only: the kernels build 64-bit masks and move 64-bit lanes (_mm_cvtsi128_si64), which
+// 32-bit x86 lacks; it takes the scalar path
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define HFT_FIX_SCANNER_X86 1
+#endif
+
+namespace hft
+{
+
+enum class ScanLevel : uint8_t
+{
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+/**
+ * @brief Vectorised delimiter scanner for FIX framing.
+ *
+ * The buffer is classified one 64-byte block at a time: a single pass of compares produces two
+ * bitmasks, one for SOH and one for '=', where bit i describes byte i of the block. The cursor
+ * then walks the set bits in order, so the tokenizer gets every tag/value boundary of a frame
+ * (and of the frames behind it in a batched segment) without a byte-by-byte loop.
+ *
+ * The block kernel is chosen once at startup from what the CPU supports (AVX2, SSE2, or the
+ * portable scalar loop on other architectures). setLevel() overrides it for tests and
+ * benchmarks and must not race with parsing threads.
+ */
+class FixScanner
+{
+  public:
+    static constexpr std::size_t BLOCK_SIZE = 64;
+
+    struct BlockMask
+    {
+        uint64_t soh = 0;
+        uint64_t equals = 0;
+    };
+
+    using KernelFn = void (*)(const char *, BlockMask &);
+
+    explicit FixScanner(std::span<const char> buffer)
+        : data_(buffer.data()), size_(buffer.size()), kernel_(kernel())
+    {
+        load();
+    }
+
+    std::span<const char> buffer() const
+    {
+        return {data_, size_};
+    }
+
+    // Moves the cursor so the next delimiter returned is the first at or after position. Forward
+    // seeks within the current block only clear bits; blocks are classified at most once while
+    // the cursor moves forward, so one scanner can walk a whole batch of frames.
+    inline void seek(std::size_t position)
+    {
+        if (position < base_ || position >= base_ + BLOCK_SIZE)
+        {
+            base_ = position - position % BLOCK_SIZE;
+            load();
+        }
+        const std::size_t offset = position - base_;
+        const uint64_t keep = offset == 0 ? ~0ull : ~((1ull << offset) - 1);
+        mask_.soh &= keep;
+        mask_.equals &= keep;
+    }
+
+    // Next SOH or '=' after the previous one returned. False once the buffer is exhausted.
+    inline bool next(std::size_t &position, bool &isSoh)
+    {
+        while ((mask_.soh | mask_.equals) == 0)
+        {
+            if (base_ + BLOCK_SIZE >= size_)
+            {
+                return false;
+            }
+            base_ += BLOCK_SIZE;
+            load();
+        }
+        const uint64_t any = mask_.soh | mask_.equals;
+        const int bit = std::countr_zero(any);
+        const uint64_t lowest = any & (~any + 1);
+        position = base_ + static_cast<std::size_t>(bit);
+        isSoh = (mask_.soh & lowest) != 0;
+        mask_.soh &= ~lowest;
+        mask_.equals &= ~lowest;
+        return true;
+    }
+
+    // Masks for the BLOCK_SIZE bytes at block; bytes at or past size count as neither delimiter
+    static inline BlockMask scanBlock(const char *block, std::size_t size)
+    {
+        return scanBlock(kernel(), block, size);
+    }
+
+    static inline ScanLevel getLevel()
+    {
+        return level();
+    }
+
+    // Returns false (and leaves the kernel unchanged) if the CPU cannot run the requested level
+    static inline bool setLevel(ScanLevel requested)
+    {
+        if (!isSupported(requested))
+        {
+            return false;
+        }
+        level() = requested;
+        kernel() = kernelFor(requested);
+        return true;
+    }
+
+    static inline bool isSupported(ScanLevel requested)
+    {
+#if defined(HFT_FIX_SCANNER_X86)
+        __builtin_cpu_init();
+#endif
+        switch (requested)
+        {
+            case ScanLevel::Scalar:
+                return true;
+#if defined(HFT_FIX_SCANNER_X86)
+            case ScanLevel::Sse2:
+                return __builtin_cpu_supports("sse2");
+            case ScanLevel::Avx2:
+                return __builtin_cpu_supports("avx2");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    static inline std::vector<ScanLevel> getSupportedLevels()
+    {
+        std::vector<ScanLevel> levels;
+        for (ScanLevel candidate : {ScanLevel::Scalar, ScanLevel::Sse2, ScanLevel::Avx2})
+        {
+            if (isSupported(candidate))
+            {
+                levels.push_back(candidate);
+            }
+        }
+        return levels;
+    }
+
+    static inline std::string toString(ScanLevel value)
+    {
+        switch (value)
+        {
+            case ScanLevel::Sse2:
+                return "sse2";
+            case ScanLevel::Avx2:
+                return "avx2";
+            default:
+                return "scalar";
+        }
+    }
+
+  private:
+
+    inline void load()
+    {
+        mask_ = base_ < size_ ? scanBlock(kernel_, data_ + base_, size_ - base_) : BlockMask{};
+    }
+
+    static inline BlockMask scanBlock(KernelFn scan, const char *block, std::size_t size)
+    {
+        BlockMask mask;
+        if (size >= BLOCK_SIZE)
+        {
+            scan(block, mask);
+            return mask;
+        }
+        alignas(BLOCK_SIZE) char padded[BLOCK_SIZE] = {};
+        if (size > 0)
+        {
+            std::memcpy(padded, block, size);
+        }
+        scan(padded, mask);
+        return mask;
+    }
+
+    static inline ScanLevel detect()
+    {
+        if (isSupported(ScanLevel::Avx2))
+        {
+            return ScanLevel::Avx2;
+        }
+        if (isSupported(ScanLevel::Sse2))
+        {
+            return ScanLevel::Sse2;
+        }
+        return ScanLevel::Scalar;
+    }
+
+    static inline ScanLevel &level()
+    {
+        static ScanLevel active = detect();
+        return active;
+    }
+
+    static inline KernelFn &kernel()
+    {
+        static KernelFn active = kernelFor(level());
+        return active;
+    }
+
+    static inline KernelFn kernelFor(ScanLevel value)
+    {
+        switch (value)
+        {
+#if defined(HFT_FIX_SCANNER_X86)
+            case ScanLevel::Sse2:
+                return &scanSse2;
+            case ScanLevel::Avx2:
+                return &scanAvx2;
+#endif
+            default:
+                return &scanScalar;
+        }
+    }
+
+    static void scanScalar(const char *block, BlockMask &mask)
+    {
+        uint64_t soh = 0, equals = 0;
+        for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            soh |= static_cast<uint64_t>(block[i] == '\x01') << i;
+            equals |= static_cast<uint64_t>(block[i] == '=') << i;
+        }
+        mask.soh = soh;
+        mask.equals = equals;
+    }
+
+#if defined(HFT_FIX_SCANNER_X86)
+    __attribute__((target("sse2"))) static void scanSse2(const char *block, BlockMask &mask)
+    {
+        const __m128i soh = _mm_set1_epi8('\x01');
+        const __m128i equals = _mm_set1_epi8('=');
+        uint64_t sohBits = 0, equalsBits = 0;
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + lane * 16));
+            sohBits |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, soh))))
+                       << (lane * 16);
+            equalsBits |=
+                static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, equals))))
+                << (lane * 16);
+        }
+        mask.soh = sohBits;
+        mask.equals = equalsBits;
+    }
+
+    __attribute__((target("avx2"))) static void scanAvx2(const char *block, BlockMask &mask)
+    {
+        const __m256i soh = _mm256_set1_epi8('\x01');
+        const __m256i equals = _mm256_set1_epi8('=');
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+        mask.soh = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, soh))) |
+                   (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, soh))))
+                    << 32);
+        mask.equals =
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, equals))) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, equals))))
+             << 32);
+    }
+#endif
+
+    const char *data_;
+    std::size_t size_;
+    KernelFn kernel_; // Level at construction; setLevel() affects scanners created afterwards
+    std::size_t base_ = 0;
+    BlockMask mask_;
+};
+
+} // namespace hft
@@ -0,0 +1,516 @@
+#pragma once
+
+#include "fix/fix_parser.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace hft
+{
+
+/**
+ * @brief FIX 4.2 session layer for one connection: Logon, MsgSeqNum checks, heartbeats, resends.
+ *
+ * The gateway hands it every tokenized frame of a recv() batch. Application messages (orders, U1)
+ * come back as Deliver only when they carry the next expected MsgSeqNum(34); session messages are
+ * answered here. Replies (Logon ack, Heartbeat, TestRequest, ResendRequest, SequenceReset-GapFill,
+ * Logout) are framed into a fixed outbox that the gateway sends once per batch. Nothing on the
+ * message path allocates: comp IDs are copied into fixed arrays at Logon, sequence checks are
+ * integer compares, and the clock is read once per batch (beginBatch) rather than per frame.
+ *
+ * A Logon must be addressed to our CompID (TargetCompID(56)); its SenderCompID(49) becomes the
+ * peer's. Every later message must carry that same SenderCompID and our CompID as TargetCompID,
+ * or the session is logged out.
+ *
+ * A MsgSeqNum above the expected one sends one ResendRequest (7=expected, 16=0) and drops the
+ * frame; the resent copies (43=Y) are then processed in order, and the next gap gets a new request
+ * once everything dropped has been replayed. A lower MsgSeqNum is ignored when
+ * flagged PossDupFlag(43)=Y and ends the session otherwise. Outbound application messages are not
+ * stored, so a client ResendRequest is answered with one SequenceReset-GapFill over the range.
+ */
+class FixSession
+{
+  public:
+    enum class State : uint8_t
+    {
+        AwaitingLogon,
+        Active,
+        LoggedOut
+    };
+
+    enum class Verdict : uint8_t
+    {
+        Deliver,   // In-sequence application message: hand it to the order path
+        Consumed,  // Session message, duplicate or out-of-sequence frame: nothing more to do
+        Disconnect // Session ended (Logout or protocol violation): flush the outbox, then close
+    };
+
+    static constexpr size_t OUTBOX_BYTES = 4096;
+    static constexpr size_t MAX_COMP_ID = 31;
+    static constexpr uint32_t MAX_HEARTBEAT_SECONDS = 3600;
+
+    explicit FixSession(std::string_view compId = "EXCHANGE")
+    {
+        copyCompId(compId, ourCompId_, ourCompIdLength_);
+    }
+
+    // nowNs: wall-clock ns since the epoch (getCurrentTimeNs()), read once per recv() batch.
+    // Any inbound bytes count as a sign of life for the heartbeat timers.
+    void beginBatch(uint64_t nowNs)
+    {
+        nowNs_ = nowNs;
+        lastReceivedNs_ = nowNs;
+        testRequestPending_ = false;
+    }
+
+    Verdict onMessage(const FixFields &fields)
+    {
+        const std::string_view type = fields.get(FixFields::MsgType);
+        uint64_t seqNum = 0;
+        if (!parseNumber(fields.get(FixFields::MsgSeqNum), seqNum) || seqNum == 0)
+        {
+            return logout("MsgSeqNum(34) missing or invalid");
+        }
+        if (state_ == State::Active)
+        {
+            if (fields.get(FixFields::SenderCompId) != peerCompId())
+            {
+                return logout("SenderCompID mismatch");
+            }
+            if (fields.get(FixFields::TargetCompId) != ourCompId())
+            {
+                return logout("TargetCompID mismatch");
+            }
+        }
+
+        // Steady state: the next application message, one compare and one increment
+        if (seqNum == expectedSeqNum_ && state_ == State::Active && !resendPending_ && !isSessionMessage(type))
+        {
+            ++expectedSeqNum_;
+            return Verdict::Deliver;
+        }
+
+        if (state_ == State::AwaitingLogon)
+        {
+            return type == "A" ? logon(fields, seqNum) : logout("First message must be Logon");
+        }
+        if (state_ == State::LoggedOut)
+        {
+            return Verdict::Disconnect;
+        }
+
+        const bool possDup = fields.get(FixFields::PossDupFlag) == "Y";
+        if (type == "4" && fields.get(FixFields::GapFillFlag) != "Y")
+        {
+            return sequenceReset(fields); // Reset mode ignores MsgSeqNum
+        }
+        if (seqNum < expectedSeqNum_)
+        {
+            if (possDup)
+            {
+                ++duplicates_;
+                return Verdict::Consumed;
+            }
+            return logout("MsgSeqNum too low");
+        }
+        if (seqNum > expectedSeqNum_)
+        {
+            if (type == "5")
+            {
+                return acknowledgeLogout();
+            }
+            highestSeenSeqNum_ = std::max(highestSeenSeqNum_, seqNum);
+            requestResend();
+            return Verdict::Consumed;
+        }
+
+        ++expectedSeqNum_;
+        if (expectedSeqNum_ > highestSeenSeqNum_)
+        {
+            resendPending_ = false; // Everything dropped past the gap has been replayed: recovery is over
+        }
+
+        if (type.size() != 1)
+        {
+            return Verdict::Deliver;
+        }
+        switch (type[0])
+        {
+            case '0': // Heartbeat
+                return Verdict::Consumed;
+            case '1': // TestRequest
+                return queueHeartbeat(fields.get(FixFields::TestReqId));
+            case '2': // ResendRequest
+                return answerResend(fields);
+            case '3': // Reject of one of our messages: nothing to retry
+                return Verdict::Consumed;
+            case '4': // SequenceReset-GapFill, in sequence
+                return gapFill(fields);
+            case '5': // Logout
+                return acknowledgeLogout();
+            case 'A':
+                return logout("Logon received twice");
+            default:
+                return Verdict::Deliver;
+        }
+    }
+
+    // Heartbeat timers, called between batches: a Heartbeat after HeartBtInt of send silence, a
+    // TestRequest after 1.2 x HeartBtInt of receive silence, a Logout after 2 x HeartBtInt.
+    // Returns false when the peer is unresponsive and the connection should be closed.
+    bool onTimer(uint64_t nowNs)
+    {
+        if (state_ != State::Active || heartbeatNs_ == 0)
+        {
+            return state_ != State::LoggedOut;
+        }
+        nowNs_ = nowNs;
+        const uint64_t silentNs = nowNs > lastReceivedNs_ ? nowNs - lastReceivedNs_ : 0;
+        if (testRequestPending_ && silentNs >= 2 * heartbeatNs_)
+        {
+            logout("Heartbeat timeout");
+            return false;
+        }
+        if (!testRequestPending_ && silentNs >= heartbeatNs_ + heartbeatNs_ / 5)
+        {
+            char body[48];
+            const int length = std::snprintf(body, sizeof(body), "112=TEST%llu\x01",
+                                             static_cast<unsigned long long>(nextOutgoingSeqNum_));
+            queue('1', std::string_view(body, static_cast<size_t>(length)));
+            testRequestPending_ = true;
+        }
+        if (nowNs > lastSentNs_ && nowNs - lastSentNs_ >= heartbeatNs_)
+        {
+            queue('0', {});
+        }
+        return true;
+    }
+
+    // Session replies queued since the last clearOutbox(), ready to send as one write
+    std::span<const char> outbox() const
+    {
+        return {outbox_.data(), outboxSize_};
+    }
+
+    void clearOutbox()
+    {
+        outboxSize_ = 0;
+    }
+
+    State getState() const
+    {
+        return state_;
+    }
+
+    uint64_t getExpectedSeqNum() const
+    {
+        return expectedSeqNum_;
+    }
+
+    uint64_t getNextOutgoingSeqNum() const
+    {
+        return nextOutgoingSeqNum_;
+    }
+
+    uint32_t getHeartbeatSeconds() const
+    {
+        return static_cast<uint32_t>(heartbeatNs_ / 1'000'000'000ULL);
+    }
+
+    uint64_t getGapCount() const
+    {
+        return gaps_;
+    }
+
+    uint64_t getDuplicateCount() const
+    {
+        return duplicates_;
+    }
+
+  private:
+    // Admin MsgTypes: Heartbeat, TestRequest, ResendRequest, Reject, SequenceReset, Logout, Logon
+    static bool isSessionMessage(std::string_view type)
+    {
+        return type.size() == 1 && ((type[0] >= '0' && type[0] <= '5') || type[0] == 'A');
+    }
+
+    // Sequence numbers are short: a digit loop beats from_chars here
+    static bool parseNumber(std::string_view text, uint64_t &value)
+    {
+        if (text.empty() || text.size() > 19)
+        {
+            return false;
+        }
+        uint64_t result = 0;
+        for (const char c : text)
+        {
+            const unsigned digit = static_cast<unsigned char>(c) - static_cast<unsigned>('0');
+            if (digit > 9)
+            {
+                return false;
+            }
+            result = result * 10 + digit;
+        }
+        value = result;
+        return true;
+    }
+
+    std::string_view ourCompId() const
+    {
+        return {ourCompId_.data(), ourCompIdLength_};
+    }
+
+    std::string_view peerCompId() const
+    {
+        return {peerCompId_.data(), peerCompIdLength_};
+    }
+
+    static bool copyCompId(std::string_view id, std::array<char, MAX_COMP_ID> &out, uint8_t &length)
+    {
+        if (id.empty() || id.size() > MAX_COMP_ID)
+        {
+            return false;
+        }
+        std::memcpy(out.data(), id.data(), id.size());
+        length = static_cast<uint8_t>(id.size());
+        return true;
+    }
+
+    Verdict logon(const FixFields &fields, uint64_t seqNum)
+    {
+        uint64_t heartbeat = 0;
+        if (!parseNumber(fields.get(FixFields::HeartBtInt), heartbeat) || heartbeat > MAX_HEARTBEAT_SECONDS)
+        {
+            return logout("HeartBtInt(108) missing or invalid");
+        }
+        if (fields.get(FixFields::TargetCompId) != ourCompId())
+        {
+            return logout("TargetCompID mismatch");
+        }
+        // Replies swap the roles: the peer's SenderCompID is our TargetCompID
+        if (!copyCompId(fields.get(FixFields::SenderCompId), peerCompId_, peerCompIdLength_))
+        {
+            return logout("SenderCompID(49) missing or too long");
+        }
+
+        heartbeatNs_ = heartbeat * 1'000'000'000ULL;
+        state_ = State::Active;
+        char body[32];
+        const int length = std::snprintf(body, sizeof(body), "98=0\x01" "108=%llu\x01",
+                                         static_cast<unsigned long long>(heartbeat));
+        queue('A', std::string_view(body, static_cast<size_t>(length)));
+
+        // A Logon above 1 resumes a session whose earlier messages we never saw
+        if (seqNum == expectedSeqNum_)
+        {
+            ++expectedSeqNum_;
+        }
+        else
+        {
+            highestSeenSeqNum_ = seqNum;
+            requestResend();
+        }
+        return Verdict::Consumed;
+    }
+
+    void requestResend()
+    {
+        // One outstanding request covers every later message (16=0 means "through the latest");
+        // repeat it only if the peer has not answered within a heartbeat interval
+        if (resendPending_ && nowNs_ - resendSentNs_ < std::max(heartbeatNs_, uint64_t{1'000'000'000}))
+        {
+            return;
+        }
+        char body[48];
+        const int length = std::snprintf(body, sizeof(body), "7=%llu\x01" "16=0\x01",
+                                         static_cast<unsigned long long>(expectedSeqNum_));
+        queue('2', std::string_view(body, static_cast<size_t>(length)));
+        resendPending_ = true;
+        resendSentNs_ = nowNs_;
+        ++gaps_;
+    }
+
+    Verdict sequenceReset(const FixFields &fields)
+    {
+        uint64_t newSeqNum = 0;
+        if (!parseNumber(fields.get(FixFields::NewSeqNo), newSeqNum) || newSeqNum < expectedSeqNum_)
+        {
+            return logout("SequenceReset NewSeqNo(36) missing or lower than expected");
+        }
+        expectedSeqNum_ = newSeqNum;
+        resendPending_ = false;
+        return Verdict::Consumed;
+    }
+
+    Verdict gapFill(const FixFields &fields)
+    {
+        uint64_t newSeqNum = 0;
+        if (parseNumber(fields.get(FixFields::NewSeqNo), newSeqNum) && newSeqNum > expectedSeqNum_)
+        {
+            expectedSeqNum_ = newSeqNum;
+        }
+        if (expectedSeqNum_ > highestSeenSeqNum_)
+        {
+            resendPending_ = false;
+        }
+        return Verdict::Consumed;
+    }
+
+    Verdict queueHeartbeat(std::string_view testRequestId)
+    {
+        char body[64];
+        size_t length = 0;
+        if (!testRequestId.empty() && testRequestId.size() <= sizeof(body) - 6)
+        {
+            std::memcpy(body, "112=", 4);
+            std::memcpy(body + 4, testRequestId.data(), testRequestId.size());
+            length = 4 + testRequestId.size();
+            body[length++] = FIXParser::SOH;
+        }
+        queue('0', std::string_view(body, length));
+        return Verdict::Consumed;
+    }
+
+    Verdict answerResend(const FixFields &fields)
+    {
+        // Nothing outbound is stored: skip the peer straight to our next sequence number. The
+        // GapFill takes the first requested number, so the peer accepts it as in sequence.
+        uint64_t beginSeqNum = 0;
+        if (!parseNumber(fields.get(FixFields::BeginSeqNo), beginSeqNum) || beginSeqNum == 0 ||
+            beginSeqNum >= nextOutgoingSeqNum_)
+        {
+            return Verdict::Consumed;
+        }
+        char body[48];
+        const int length = std::snprintf(body, sizeof(body), "43=Y\x01" "123=Y\x01" "36=%llu\x01",
+                                         static_cast<unsigned long long>(nextOutgoingSeqNum_));
+        queue('4', std::string_view(body, static_cast<size_t>(length)), beginSeqNum);
+        return Verdict::Consumed;
+    }
+
+    Verdict acknowledgeLogout()
+    {
+        queue('5', {});
+        state_ = State::LoggedOut;
+        return Verdict::Disconnect;
+    }
+
+    Verdict logout(std::string_view reason)
+    {
+        char body[96];
+        const int length = std::snprintf(body, sizeof(body), "58=%.*s\x01", static_cast<int>(reason.size()),
+                                         reason.data());
+        queue('5', std::string_view(body, std::min(static_cast<size_t>(length), sizeof(body) - 1)));
+        state_ = State::LoggedOut;
+        return Verdict::Disconnect;
+    }
+
+    // Frames one session message into the outbox. seqNum overrides MsgSeqNum for a GapFill,
+    // which reuses the number being filled instead of consuming a new one.
+    void queue(char type, std::string_view fields, uint64_t seqNum = 0)
+    {
+        const bool gapFill = seqNum != 0;
+        char body[256];
+        int length = std::snprintf(body, sizeof(body), "35=%c\x01" "49=%.*s\x01", type,
+                                   static_cast<int>(ourCompIdLength_), ourCompId_.data());
+        if (peerCompIdLength_ != 0)
+        {
+            length += std::snprintf(body + length, sizeof(body) - length, "56=%.*s\x01",
+                                    static_cast<int>(peerCompIdLength_), peerCompId_.data());
+        }
+        length += std::snprintf(body + length, sizeof(body) - length, "34=%llu\x01" "52=",
+                                static_cast<unsigned long long>(gapFill ? seqNum : nextOutgoingSeqNum_));
+        length += formatSendingTime(nowNs_, body + length);
+        body[length++] = FIXParser::SOH;
+        if (static_cast<size_t>(length) + fields.size() > sizeof(body))
+        {
+            return;
+        }
+        std::memcpy(body + length, fields.data(), fields.size());
+        length += static_cast<int>(fields.size());
+
+        const size_t frame = FIXParser::buildFrame(std::string_view(body, static_cast<size_t>(length)),
+                                                   outbox_.data() + outboxSize_, OUTBOX_BYTES - outboxSize_);
+        if (frame == 0)
+        {
+            return; // Outbox full: the gateway flushes at half capacity, so only a runaway peer gets here
+        }
+        outboxSize_ += frame;
+        lastSentNs_ = nowNs_;
+        if (!gapFill)
+        {
+            ++nextOutgoingSeqNum_;
+        }
+    }
+
+    // SendingTime(52) as YYYYMMDD-HH:MM:SS.sss (UTC), 21 characters, without gmtime or locale
+    static int formatSendingTime(uint64_t nowNs, char *out)
+    {
+        const uint64_t millis = nowNs / 1'000'000ULL;
+        const uint64_t seconds = millis / 1000;
+        const uint64_t secondOfDay = seconds % 86400;
+        // Days since 1970-01-01 -> civil date (H. Hinnant's days_from_civil, inverted)
+        const int64_t z = static_cast<int64_t>(seconds / 86400) + 719468;
+        const int64_t era = z / 146097;
+        const int64_t dayOfEra = z - era * 146097;
+        const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int64_t mp = (5 * dayOfYear + 2) / 153;
+        const int64_t day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+        const int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+        auto put = [&out](uint64_t value, int width)
+        {
+            for (int i = width - 1; i >= 0; --i)
+            {
+                out[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+            out += width;
+        };
+        put(static_cast<uint64_t>(year), 4);
+        put(static_cast<uint64_t>(month), 2);
+        put(static_cast<uint64_t>(day), 2);
+        *out++ = '-';
+        put(secondOfDay / 3600, 2);
+        *out++ = ':';
+        put(secondOfDay / 60 % 60, 2);
+        *out++ = ':';
+        put(secondOfDay % 60, 2);
+        *out++ = '.';
+        put(millis % 1000, 3);
+        return 21;
+    }
+
+    std::array<char, OUTBOX_BYTES> outbox_;
+    size_t outboxSize_ = 0;
+
+    std::array<char, MAX_COMP_ID> ourCompId_{};
+    std::array<char, MAX_COMP_ID> peerCompId_{};
+    uint8_t ourCompIdLength_ = 0;
+    uint8_t peerCompIdLength_ = 0;
+
+    State state_ = State::AwaitingLogon;
+    bool resendPending_ = false;
+    bool testRequestPending_ = false;
+
+    uint64_t expectedSeqNum_ = 1;
+    uint64_t highestSeenSeqNum_ = 0; // Highest MsgSeqNum dropped past a gap
+    uint64_t nextOutgoingSeqNum_ = 1;
+    uint64_t heartbeatNs_ = 0;
+    uint64_t nowNs_ = 0;
+    uint64_t lastReceivedNs_ = 0;
+    uint64_t lastSentNs_ = 0;
+    uint64_t resendSentNs_ = 0;
+
+    uint64_t gaps_ = 0;
+    uint64_t duplicates_ = 0;
+};
+
+} // namespace hft
@@ -0,0 +1,107 @@
+#!/bin/bash
+set -u
+set -o pipefail
+
+# Gateway I/O model sweep: thread-per-client vs single-thread epoll / io_uring event loops, across client counts.
+# Usage: ./scripts/run_gateway_mode_sweep.sh [--book map] [--scenario tight_spread] [--runs 3] [--orders 10000]
+#                                            [--modes "threaded epoll io_uring"] [--clients "1 8 64"]
+#                                            [--gateway-core 2] [--busy-poll] [--transport unix]
+# --transport unix|shm runs every case over a Unix socket / shared-memory ring (shm: threaded mode only).
+
+SERVER_BIN="./build/src/hft_exchange_server"
+CLIENT_BIN="./build/benchmarks/orderbook_benchmark"
+CSV_OUT="results/results.csv"
+PORT=12345
+
+BOOK="map"
+SCENARIO="tight_spread"
+RUNS=3
+ORDERS=10000
+MODES="threaded epoll io_uring"
+CLIENTS="1 8 64"
+GATEWAY_CORE=""
+BUSY_POLL=0
+TRANSPORT="tcp"
+
+while [[ $# -gt 0 ]]; do
+    case $1 in
+        --book)         BOOK="$2";         shift 2 ;;
+        --scenario)     SCENARIO="$2";     shift 2 ;;
+        --runs)         RUNS="$2";         shift 2 ;;
+        --orders)       ORDERS="$2";       shift 2 ;;
+        --modes)        MODES="$2";        shift 2 ;;
+        --clients)      CLIENTS="$2";      shift 2 ;;
+        --gateway-core) GATEWAY_CORE="$2"; shift 2 ;;
+        --busy-poll)    BUSY_POLL=1;       shift ;;
+        --transport)    TRANSPORT="$2";    shift 2 ;;
+        *)
+            echo "Unknown option: $1"
+            exit 1
+            ;;
+    esac
+done
+
+mkdir -p results
+
+if [[ ! -x "$SERVER_BIN" && -x "./build/bin/hft_exchange_server" ]]; then
+    SERVER_BIN="./build/bin/hft_exchange_server"
+fi
+
+if [[ ! -x "$SERVER_BIN" || ! -x "$CLIENT_BIN" ]]; then
+    echo "Error: build the project first (missing $SERVER_BIN or $CLIENT_BIN)"
+    exit 1
+fi
+
+echo "Starting Gateway Mode Sweep..."
+echo "Book: $BOOK  Scenario: $SCENARIO  Modes: $MODES  Clients: $CLIENTS  Transport: $TRANSPORT"
+echo "========================================"
+
+for MODE in $MODES
+do
+    if [[ "$TRANSPORT" == "shm" && "$MODE" != "threaded" ]]; then
+        echo "  - skipping $MODE: the shared-memory transport needs the threaded gateway"
+        continue
+    fi
+    SERVER_ARGS=(--book "$BOOK" --port "$PORT" --gateway "$MODE" --transport "$TRANSPORT")
+    VARIANT="$MODE"
+    if [[ "$MODE" != "threaded" ]]; then
+        if [[ -n "$GATEWAY_CORE" ]]; then
+            SERVER_ARGS+=(--gateway-core "$GATEWAY_CORE")
+        fi
+        if [[ "$BUSY_POLL" -eq 1 ]]; then
+            SERVER_ARGS+=(--busy-poll)
+            VARIANT="$MODE-busy"
+        fi
+    fi
+
+    for C in $CLIENTS
+    do
+        echo "  - $VARIANT, $C client(s)"
+
+        $SERVER_BIN "${SERVER_ARGS[@]}" > /dev/null 2>&1 &
+        SERVER_PID=$!
+        sleep 1
+
+        if ! kill -0 "$SERVER_PID" >/dev/null 2>&1; then
+            echo "Error: server failed to start (gateway=$MODE)"
+            exit 1
+        fi
+
+        $CLIENT_BIN --mode gateway --book "$BOOK" --port "$PORT" --transport "$TRANSPORT" --runs "$RUNS" \
+            --orders "$ORDERS" --scenario "$SCENARIO" --clients "$C" --variant "$VARIANT" --csv_out "$CSV_OUT"
+        CLIENT_EXIT=$?
+
+        kill -INT "$SERVER_PID" >/dev/null 2>&1 || true
+        wait "$SERVER_PID" >/dev/null 2>&1 || true
+
+        if [[ "$CLIENT_EXIT" -ne 0 ]]; then
+            echo "Error: gateway case failed: $VARIANT clients=$C (exit=$CLIENT_EXIT)"
+            exit 1
+        fi
+
+        # Small gap between cases for port reuse
+        sleep 1
+    done
+done
+
+echo "Sweep Complete. Results saved to $CSV_OUT"
@@ -0,0 +1,90 @@
+#!/bin/bash
+set -u
+set -o pipefail
+
+# Gateway parser pool sweep: parser threads x concurrent clients.
+# Parser threads 0 = legacy inline parsing on each connection thread.
+# Usage: ./scripts/run_parser_pool_sweep.sh [--book map] [--scenario tight_spread] [--runs 3] [--orders 10000]
+#                                           [--parsers "0 1 2 4"] [--clients "1 4 16"]
+
+SERVER_BIN="./build/src/hft_exchange_server"
+CLIENT_BIN="./build/benchmarks/orderbook_benchmark"
+CSV_OUT="results/results.csv"
+PORT=12345
+
+BOOK="map"
+SCENARIO="tight_spread"
+RUNS=3
+ORDERS=10000
+PARSERS="0 1 2 4"
+CLIENTS="1 4 16"
+
+while [[ $# -gt 0 ]]; do
+    case $1 in
+        --book)     BOOK="$2";     shift 2 ;;
+        --scenario) SCENARIO="$2"; shift 2 ;;
+        --runs)     RUNS="$2";     shift 2 ;;
+        --orders)   ORDERS="$2";   shift 2 ;;
+        --parsers)  PARSERS="$2";  shift 2 ;;
+        --clients)  CLIENTS="$2";  shift 2 ;;
+        *)
+            echo "Unknown option: $1"
+            exit 1
+            ;;
+    esac
+done
+
+mkdir -p results
+
+if [[ ! -x "$SERVER_BIN" && -x "./build/bin/hft_exchange_server" ]]; then
+    SERVER_BIN="./build/bin/hft_exchange_server"
+fi
+
+if [[ ! -x "$SERVER_BIN" || ! -x "$CLIENT_BIN" ]]; then
+    echo "Error: build the project first (missing $SERVER_BIN or $CLIENT_BIN)"
+    exit 1
+fi
+
+echo "Starting Gateway Parser Pool Sweep..."
+echo "Book: $BOOK  Scenario: $SCENARIO  Parsers: $PARSERS  Clients: $CLIENTS"
+echo "========================================"
+
+for P in $PARSERS
+do
+    if [[ "$P" -eq 0 ]]; then
+        VARIANT="inline"
+    else
+        VARIANT="pool$P"
+    fi
+
+    for C in $CLIENTS
+    do
+        echo "  - $VARIANT, $C client(s)"
+
+        $SERVER_BIN --book "$BOOK" --port "$PORT" --parser-threads "$P" > /dev/null 2>&1 &
+        SERVER_PID=$!
+        sleep 1
+
+        if ! kill -0 "$SERVER_PID" >/dev/null 2>&1; then
+            echo "Error: server failed to start (parser-threads=$P)"
+            exit 1
+        fi
+
+        $CLIENT_BIN --mode gateway --book "$BOOK" --port "$PORT" --runs "$RUNS" --orders "$ORDERS" \
+            --scenario "$SCENARIO" --clients "$C" --variant "$VARIANT" --csv_out "$CSV_OUT"
+        CLIENT_EXIT=$?
+
+        kill -INT "$SERVER_PID" >/dev/null 2>&1 || true
+        wait "$SERVER_PID" >/dev/null 2>&1 || true
+
+        if [[ "$CLIENT_EXIT" -ne 0 ]]; then
+            echo "Error: gateway case failed: $VARIANT clients=$C (exit=$CLIENT_EXIT)"
+            exit 1
+        fi
+
+        # Small gap between cases for port reuse
+        sleep 1
+    done
+done
+
+echo "Sweep Complete. Results saved to $CSV_OUT"
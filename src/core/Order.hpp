@@ -15,9 +15,11 @@ struct Order
     Timestamp timestamp;
     uint64_t receiveTimestamp; // When the order entered the exchange gateway
     uint64_t sendTimestamp;    // When the order was sent by the client (E2E start)
+    SymbolId symbol = 0;       // Instrument (FIX tag 55), resolved to a dense id at the gateway
+    ClientId client = 0;       // Connection to send execution reports to, stamped by the gateway
 
-    // Padding to ensure cache line alignment or specific size if needed
-    // For now, keep it simple and packed
+    // symbol and client are last and defaulted so existing positional initialisers and `Order o;`
+    // mean symbol 0 / no client. sizeof(Order) == 64: one order per cache line in the queues and pools.
 };
 
 } // namespace hft
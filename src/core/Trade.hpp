@@ -11,6 +11,8 @@ struct Trade
     OrderId sellOrderId;
     Price price;
     Quantity quantity;
+    ClientId buyClient = 0; // Owners of the two orders, so fills can be reported without an id lookup
+    ClientId sellClient = 0;
 };
 
 } // namespace hft
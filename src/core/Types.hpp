@@ -10,6 +10,8 @@ using OrderId = uint64_t;
 using Price = uint64_t;
 using Quantity = uint64_t;
 using Timestamp = uint64_t;
+using SymbolId = uint32_t; // Dense instrument index assigned by SymbolTable (0 = default instrument)
+using ClientId = uint32_t; // Gateway connection an order came from (0 = none: no execution reports)
 using Index = std::size_t;
 constexpr Index NULL_IDX = std::numeric_limits<Index>::max();
 
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+
+namespace hft
+{
+
+// FIX ExecType(150) values the engine emits
+enum class ExecType : uint8_t
+{
+    New = 0,  // '0': order accepted by the engine (ack)
+    Trade = 1 // 'F': order (partially) filled
+};
+
+/**
+ * @brief One ExecutionReport (35=8) for one client, as produced by the matching engine.
+ *
+ * Fixed-size and trivially copyable so it can travel through SPSC rings; the gateway formats
+ * the FIX text on its own thread, off the engine's critical path.
+ */
+struct ExecutionReport
+{
+    ClientId client;
+    ExecType type;
+    Side side;
+    OrderId orderId;
+    Price price;        // Limit price (ack) or execution price (fill)
+    Quantity quantity;  // Order quantity (ack) or filled quantity (fill)
+    uint64_t timestamp; // Echo of the order's TransactTime(60) on acks, for client round-trip timing
+};
+
+/**
+ * @brief Where an engine hands its execution reports.
+ *
+ * publish() is called on the engine thread only. `producer` identifies that thread (the shard
+ * index; 0 for a single engine), so implementations can keep one single-producer ring per engine.
+ * Must not block: a sink that cannot keep up drops reports rather than stalling matching.
+ */
+class ExecutionReportSink
+{
+  public:
+    virtual ~ExecutionReportSink() = default;
+
+    virtual void publish(std::size_t producer, const ExecutionReport &report) = 0;
+};
+
+} // namespace hft
@@ -0,0 +1,78 @@
+#include "jitter_detector.hpp"
+#include "utils/rdtsc.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace hft
+{
+
+void JitterReport::merge(const JitterReport &other)
+{
+    thresholdNs = std::max(thresholdNs, other.thresholdNs);
+    observedNs += other.observedNs;
+    stalls += other.stalls;
+    stallNs += other.stallNs;
+    maxStallNs = std::max(maxStallNs, other.maxStallNs);
+    outliers += other.outliers;
+    outliersInStall += other.outliersInStall;
+}
+
+double JitterReport::stalledPct() const
+{
+    return observedNs > 0 ? 100.0 * static_cast<double>(stallNs) / static_cast<double>(observedNs) : 0.0;
+}
+
+JitterDetector::JitterDetector(std::chrono::nanoseconds threshold)
+{
+    if (threshold.count() <= 0)
+    {
+        throw std::runtime_error("JitterDetector: threshold must be positive");
+    }
+    thresholdNs_ = static_cast<uint64_t>(threshold.count());
+    thresholdTicks_ = std::max<uint64_t>(TscClock::fromNs(thresholdNs_), 1);
+}
+
+void JitterDetector::recordStall(uint64_t gapTicks)
+{
+    // Rare by definition: the wall-clock read stays off the ordinary poll
+    lastStallEndNs_ = getCurrentTimeNs();
+    const uint64_t count = stalls_.load(std::memory_order_relaxed);
+    events_[count % EVENT_CAPACITY] = {lastStallEndNs_, static_cast<uint64_t>(TscClock::toNs(gapTicks))};
+    stallTicks_.store(stallTicks_.load(std::memory_order_relaxed) + gapTicks, std::memory_order_relaxed);
+    if (gapTicks > maxStallTicks_.load(std::memory_order_relaxed))
+    {
+        maxStallTicks_.store(gapTicks, std::memory_order_relaxed);
+    }
+    stalls_.store(count + 1, std::memory_order_relaxed);
+}
+
+JitterReport JitterDetector::getReport() const
+{
+    const auto ns = [](const std::atomic<uint64_t> &ticks)
+    { return static_cast<uint64_t>(TscClock::toNs(static_cast<double>(ticks.load(std::memory_order_relaxed)))); };
+
+    JitterReport report;
+    report.thresholdNs = thresholdNs_;
+    report.observedNs = ns(observedTicks_);
+    report.stalls = stalls_.load(std::memory_order_relaxed);
+    report.stallNs = ns(stallTicks_);
+    report.maxStallNs = ns(maxStallTicks_);
+    report.outliers = outliers_.load(std::memory_order_relaxed);
+    report.outliersInStall = outliersInStall_.load(std::memory_order_relaxed);
+    return report;
+}
+
+std::vector<JitterEvent> JitterDetector::getEvents() const
+{
+    const uint64_t count = stalls_.load(std::memory_order_relaxed);
+    const uint64_t first = count > EVENT_CAPACITY ? count - EVENT_CAPACITY : 0;
+    std::vector<JitterEvent> events;
+    events.reserve(static_cast<std::size_t>(count - first));
+    for (uint64_t i = first; i < count; ++i)
+    {
+        events.push_back(events_[i % EVENT_CAPACITY]);
+    }
+    return events;
+}
+
+} // namespace hft
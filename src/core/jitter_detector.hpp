@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief One stall: a gap between two consecutive clock reads of a spinning thread.
+ */
+struct JitterEvent
+{
+    uint64_t endNs; // Wall clock (getCurrentTimeNs) when the thread ran again
+    uint64_t gapNs; // How long it did not run
+};
+
+/**
+ * @brief What a JitterDetector saw, in ns. Shards' reports merge into one.
+ */
+struct JitterReport
+{
+    uint64_t thresholdNs = 0;
+    uint64_t observedNs = 0;      // Spin time watched
+    uint64_t stalls = 0;          // Gaps above the threshold
+    uint64_t stallNs = 0;         // Their total length
+    uint64_t maxStallNs = 0;
+    uint64_t outliers = 0;        // Orders slower than the threshold (recordOrder)
+    uint64_t outliersInStall = 0; // ... that had arrived before a stall ended, so waited through it
+
+    void merge(const JitterReport &other);
+
+    // Share of the watched time the thread did not run, in percent
+    double stalledPct() const;
+};
+
+/**
+ * @brief Platform noise seen by a spinning thread: gaps between consecutive TSC reads above a threshold.
+ *
+ * A thread that does nothing but poll reads the clock every few tens of ns. A longer gap means it did
+ * not run: an interrupt, a preemption, an SMI, a hypervisor exit. MatchingEngine::run feeds its idle
+ * polls to observe() and calls restart() after a batch of orders, so book work is never counted as a
+ * stall. The stall that delays an order shows up at the poll that finds it.
+ *
+ * recordOrder() ties stalls to latency: an order slower than the threshold counts as an outlier, and
+ * as one in a stall when it arrived before the latest stall ended. A p99 made of such orders is the
+ * platform's, not the book's.
+ *
+ * Single writer (the spinning thread). getReport() may run on any thread; getEvents() only once the
+ * writer has stopped.
+ */
+class JitterDetector
+{
+  public:
+    // Most recent stalls kept for the report
+    static constexpr std::size_t EVENT_CAPACITY = 256;
+
+    // Throws std::runtime_error unless the threshold is positive
+    explicit JitterDetector(std::chrono::nanoseconds threshold);
+
+    JitterDetector(const JitterDetector &) = delete;
+    JitterDetector &operator=(const JitterDetector &) = delete;
+
+    // The next gap starts now: call when the thread goes back to polling after other work
+    void restart(uint64_t nowTicks)
+    {
+        last_ = nowTicks;
+    }
+
+    // One poll of the spin loop, with a TscClock::now() taken by the caller
+    void observe(uint64_t nowTicks)
+    {
+        if (last_ == 0)
+        {
+            last_ = nowTicks;
+            return;
+        }
+        const uint64_t gap = nowTicks - last_;
+        last_ = nowTicks;
+        observedTicks_.store(observedTicks_.load(std::memory_order_relaxed) + gap, std::memory_order_relaxed);
+        if (gap > thresholdTicks_)
+        {
+            recordStall(gap);
+        }
+    }
+
+    // An order's latency in ticks, and when it reached this process (wall-clock ns, 0 if unknown)
+    void recordOrder(uint64_t latencyTicks, uint64_t arrivedNs)
+    {
+        if (latencyTicks <= thresholdTicks_)
+        {
+            return;
+        }
+        outliers_.store(outliers_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (arrivedNs > 0 && arrivedNs <= lastStallEndNs_)
+        {
+            outliersInStall_.store(outliersInStall_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    JitterReport getReport() const;
+
+    // The last EVENT_CAPACITY stalls, oldest first. Only while the writer is stopped.
+    std::vector<JitterEvent> getEvents() const;
+
+  private:
+    void recordStall(uint64_t gapTicks);
+
+    uint64_t thresholdNs_;
+    uint64_t thresholdTicks_;
+    uint64_t last_ = 0;
+    uint64_t lastStallEndNs_ = 0;
+    std::atomic<uint64_t> observedTicks_{0};
+    std::atomic<uint64_t> stalls_{0};
+    std::atomic<uint64_t> stallTicks_{0};
+    std::atomic<uint64_t> maxStallTicks_{0};
+    std::atomic<uint64_t> outliers_{0};
+    std::atomic<uint64_t> outliersInStall_{0};
+    std::array<JitterEvent, EVENT_CAPACITY> events_{};
+};
+
+} // namespace hft
@@ -0,0 +1,76 @@
+#include "latency_histogram.hpp"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace hft
+{
+
+LatencyHistogram::LatencyHistogram() : buckets_{std::make_unique<std::atomic<uint64_t>[]>(BUCKET_COUNT)}
+{
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.add(*this);
+    return snapshot;
+}
+
+LatencyHistogram::Snapshot::Snapshot() : counts_(BUCKET_COUNT, 0)
+{
+}
+
+void LatencyHistogram::Snapshot::add(const LatencyHistogram &histogram)
+{
+    histogram.count(); // Acquire: every sample counted so far is in the buckets read below
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        const uint64_t samples = histogram.buckets_[i].load(std::memory_order_relaxed);
+        counts_[i] += samples;
+        count_ += samples;
+    }
+    sum_ += histogram.sum_.load(std::memory_order_relaxed);
+    max_ = std::max(max_, histogram.max_.load(std::memory_order_relaxed));
+}
+
+void LatencyHistogram::Snapshot::addTotals(uint64_t count, uint64_t sum, uint64_t max)
+{
+    count_ += count;
+    sum_ += sum;
+    max_ = std::max(max_, max);
+}
+
+LatencyStats LatencyHistogram::Snapshot::stats() const
+{
+    LatencyStats stats;
+    if (count_ == 0)
+    {
+        return stats;
+    }
+    stats.mean = static_cast<double>(sum_) / static_cast<double>(count_);
+    stats.max = max_;
+    stats.count = count_;
+
+    // Percentiles in parts per 10000, ascending, so one walk over the buckets fills them all
+    const std::array<std::pair<uint64_t, uint64_t *>, 5> targets{{{5000, &stats.p50},
+                                                                  {9000, &stats.p90},
+                                                                  {9900, &stats.p99},
+                                                                  {9990, &stats.p999},
+                                                                  {9999, &stats.p9999}}};
+    std::size_t next = 0;
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT && next < targets.size(); ++i)
+    {
+        seen += counts_[i];
+        // Nearest rank: the ceil(q * count)-th smallest sample
+        while (next < targets.size() && seen >= (count_ * targets[next].first + 9999) / 10000)
+        {
+            *targets[next].second = std::min(bucketUpperBound(i), max_);
+            ++next;
+        }
+    }
+    return stats;
+}
+
+} // namespace hft
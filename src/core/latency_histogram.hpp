@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hft
+{
+
+struct LatencyStats
+{
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t p9999 = 0;
+    uint64_t max = 0;
+    uint64_t count = 0;
+};
+
+/**
+ * @brief Log-linear (HDR-style) latency histogram with a single writer and any number of readers.
+ *
+ * Values below 256 get a bucket each. Above that, every power-of-two range is split into 128 equal
+ * buckets, so a reported percentile is at most 1/128 (< 0.8%) above the true one. The whole uint64_t
+ * range fits in a fixed BUCKET_COUNT array (~58 KB): memory does not grow with the sample count and
+ * no sample is ever dropped.
+ *
+ * record() is a few relaxed loads and stores, with no lock and no read-modify-write instruction. It
+ * must only be called from one thread; give each writer thread its own histogram and merge them
+ * with Snapshot::add(). Readers copy the counters while the writer keeps going, so a snapshot taken
+ * mid-run may be off by the samples recorded during the copy.
+ */
+class LatencyHistogram
+{
+  public:
+    static constexpr unsigned SUB_BUCKET_BITS = 8;
+    static constexpr std::size_t SUB_BUCKET_COUNT = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 2) * SUB_BUCKET_HALF;
+
+    /**
+     * @brief Merged, immutable copy of one or more histograms.
+     */
+    class Snapshot
+    {
+      public:
+        Snapshot();
+
+        // Adds the histogram's current counters; one writer thread per histogram, merged on read
+        void add(const LatencyHistogram &histogram);
+
+        // Adds samples known only by count, sum and max: they move mean and max, not the percentiles
+        void addTotals(uint64_t count, uint64_t sum, uint64_t max);
+
+        uint64_t count() const
+        {
+            return count_;
+        }
+
+        // Nearest-rank percentiles, reported as the highest value of their bucket (never above max).
+        // mean and max are exact.
+        LatencyStats stats() const;
+
+      private:
+        std::vector<uint64_t> counts_;
+        uint64_t count_ = 0;
+        uint64_t sum_ = 0;
+        uint64_t max_ = 0;
+    };
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    void record(uint64_t value)
+    {
+        std::atomic<uint64_t> &bucket = buckets_[bucketIndex(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        if (value > max_.load(std::memory_order_relaxed))
+        {
+            max_.store(value, std::memory_order_relaxed);
+        }
+        // Published last: a reader that loads count() also sees the buckets of every sample it counts
+        count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint64_t count() const
+    {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    Snapshot snapshot() const;
+
+    LatencyStats stats() const
+    {
+        return snapshot().stats();
+    }
+
+    static std::size_t bucketIndex(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT)
+        {
+            return static_cast<std::size_t>(value);
+        }
+        // value lies in [2^msb, 2^(msb+1)); keep its top SUB_BUCKET_BITS bits
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKET_HALF + static_cast<std::size_t>(value >> shift);
+    }
+
+    // Highest value that lands in the bucket
+    static uint64_t bucketUpperBound(std::size_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+        {
+            return index;
+        }
+        const unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_HALF) - 1;
+        const uint64_t top = index % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+        return (top << shift) + ((uint64_t{1} << shift) - 1);
+    }
+
+  private:
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace hft
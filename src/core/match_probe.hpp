@@ -0,0 +1,199 @@
+#pragma once
+
+#include "utils/rdtsc.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hft
+{
+
+/**
+ * @brief Sub-phases of a book's match(), for attributing its time (-DHFT_ENABLE_MATCH_PROBES=ON).
+ *
+ * Other       - match() time outside the phases below: loop control, the trade vector, returning
+ * LevelLookup - finding the best levels and maintaining the level structure (emptied-level erases,
+ *               best-price rescans, cold-to-hot promotion)
+ * FifoWalk    - walking the orders at the crossed levels: fills, quantity updates, unlinking
+ * LookupErase - removing filled orders from the order-id lookup map
+ * TradeEmit   - appending the Trade to the result
+ */
+enum class MatchPhase : uint8_t
+{
+    Other = 0,
+    LevelLookup = 1,
+    FifoWalk = 2,
+    LookupErase = 3,
+    TradeEmit = 4,
+    Count = 5
+};
+
+inline const char *matchPhaseToString(MatchPhase phase)
+{
+    switch (phase)
+    {
+        case MatchPhase::Other:
+            return "other";
+        case MatchPhase::LevelLookup:
+            return "level_lookup";
+        case MatchPhase::FifoWalk:
+            return "fifo_walk";
+        case MatchPhase::LookupErase:
+            return "lookup_erase";
+        case MatchPhase::TradeEmit:
+            return "trade_emit";
+        case MatchPhase::Count:
+            break;
+    }
+    return "unknown";
+}
+
+#if defined(HFT_MATCH_PROBES)
+inline constexpr bool MATCH_PROBES_ENABLED = true;
+#else
+inline constexpr bool MATCH_PROBES_ENABLED = false;
+#endif
+
+/**
+ * @brief TscClock ticks and probe entries per MatchPhase. Ticks are exclusive: a nested probe's time
+ * is not counted again in the probe around it, so the phases add up to the whole of match().
+ */
+struct MatchProfile
+{
+    static constexpr std::size_t PHASES = static_cast<std::size_t>(MatchPhase::Count);
+
+    std::array<uint64_t, PHASES> ticks{};
+    std::array<uint64_t, PHASES> entries{};
+
+    void merge(const MatchProfile &other)
+    {
+        for (std::size_t p = 0; p < PHASES; ++p)
+        {
+            ticks[p] += other.ticks[p];
+            entries[p] += other.entries[p];
+        }
+    }
+
+    uint64_t totalTicks() const
+    {
+        uint64_t total = 0;
+        for (const uint64_t value : ticks)
+        {
+            total += value;
+        }
+        return total;
+    }
+
+    // Every match() opens one Other probe
+    uint64_t matches() const
+    {
+        return entries[static_cast<std::size_t>(MatchPhase::Other)];
+    }
+};
+
+/**
+ * @brief Scoped probe: the time from construction to stop() (or destruction) goes to its phase.
+ *
+ * Probes nest. Opening one pauses the enclosing probe and closing it resumes that one, so each
+ * transition costs one plain TSC read. The profile is per thread, with no atomics: the direct
+ * benchmark resets it, runs one book and reads it back on the same thread.
+ *
+ * match() implementations use the MatchProbe alias. Without HFT_MATCH_PROBES it is the empty
+ * specialisation and compiles away, so the books carry no cost in normal builds.
+ */
+template <bool Enabled> class BasicMatchProbe
+{
+  public:
+    explicit BasicMatchProbe(MatchPhase phase)
+    {
+        State &state = threadState();
+        const uint64_t now = TscClock::now();
+        if (state.depth > 0)
+        {
+            state.profile.ticks[static_cast<std::size_t>(state.current)] += now - state.since;
+        }
+        ++state.profile.entries[static_cast<std::size_t>(phase)];
+        parent_ = state.current;
+        state.current = phase;
+        state.since = now;
+        ++state.depth;
+    }
+
+    ~BasicMatchProbe()
+    {
+        stop();
+    }
+
+    BasicMatchProbe(const BasicMatchProbe &) = delete;
+    BasicMatchProbe &operator=(const BasicMatchProbe &) = delete;
+
+    // Ends the phase before the scope does. Only the innermost open probe may be stopped.
+    void stop()
+    {
+        if (!open_)
+        {
+            return;
+        }
+        open_ = false;
+        State &state = threadState();
+        const uint64_t now = TscClock::now();
+        state.profile.ticks[static_cast<std::size_t>(state.current)] += now - state.since;
+        state.current = parent_;
+        state.since = now;
+        --state.depth;
+    }
+
+    // The calling thread's totals since its last reset()
+    static MatchProfile profile()
+    {
+        return threadState().profile;
+    }
+
+    static void reset()
+    {
+        threadState().profile = MatchProfile{};
+    }
+
+  private:
+    struct State
+    {
+        MatchProfile profile;
+        MatchPhase current = MatchPhase::Other;
+        uint64_t since = 0;
+        uint32_t depth = 0;
+    };
+
+    static State &threadState()
+    {
+        thread_local State state;
+        return state;
+    }
+
+    MatchPhase parent_ = MatchPhase::Other;
+    bool open_ = true;
+};
+
+template <> class BasicMatchProbe<false>
+{
+  public:
+    explicit BasicMatchProbe(MatchPhase)
+    {
+    }
+
+    void stop()
+    {
+    }
+
+    static MatchProfile profile()
+    {
+        return {};
+    }
+
+    static void reset()
+    {
+    }
+};
+
+using MatchProbe = BasicMatchProbe<MATCH_PROBES_ENABLED>;
+
+} // namespace hft
@@ -1,26 +1,70 @@
 #include "matching_engine.hpp"
 #include "utils/rdtsc.hpp"
+#include <algorithm>
 
 namespace hft
 {
 
-MatchingEngine::MatchingEngine(LockFreeQueue<Order, 1024> &inputQueue, IOrderBook &orderBook)
-    : inputQueue_(inputQueue), orderBook_(orderBook)
+MatchingEngine::MatchingEngine(LockFreeQueue<Order, 1024> &inputQueue, IOrderBook &orderBook,
+                               IdleStrategyType idleType)
+    : inputQueue_(inputQueue), books_{&orderBook}, idleStrategy_(idleType)
 {
 }
 
+MatchingEngine::MatchingEngine(LockFreeQueue<Order, 1024> &inputQueue, OrderBookRegistry &registry,
+                               IdleStrategyType idleType)
+    : inputQueue_(inputQueue), idleStrategy_(idleType)
+{
+    books_.reserve(registry.size());
+    for (std::size_t i = 0; i < registry.size(); ++i)
+    {
+        books_.push_back(&registry.get(static_cast<SymbolId>(i)));
+    }
+}
+
 void MatchingEngine::run(std::atomic<bool> &running)
 {
     Order order;
     while (running.load(std::memory_order_relaxed))
     {
-        // Busy wait / spin loop for lowest latency
-        while (inputQueue_.pop(order))
+        if (inputQueue_.pop(order))
         {
-            processOrder(order);
+            if (jitter_)
+            {
+                jitter_->observe(TscClock::now()); // A stall right before this order still counts
+            }
+            std::size_t sinceStatusCheck = 0;
+            do
+            {
+                processOrder(order);
+                if (++sinceStatusCheck == STATUS_CHECK_ORDERS)
+                {
+                    publishStatusIfDue(); // A queue that never drains still gets its status refreshed
+                    sinceStatusCheck = 0;
+                }
+            } while (inputQueue_.pop(order));
+            publishStatusIfDue();
+            idleStrategy_.reset();
+            if (jitter_)
+            {
+                jitter_->restart(TscClock::now()); // Book work is not a stall
+            }
+            continue;
+        }
+
+        // Queue empty: spin, pause, back off or park depending on the configured strategy.
+        // BusySpin is a no-op here, so the default keeps the original hard-spin behaviour.
+        publishStatusIfDue();
+        if (jitter_)
+        {
+            jitter_->observe(TscClock::now());
+        }
+        idleStrategy_.idle([this]() { return inputQueue_.size() != 0; });
+        if (jitter_ && (idleStrategy_.getType() == IdleStrategyType::Backoff ||
+                        idleStrategy_.getType() == IdleStrategyType::Park))
+        {
+            jitter_->restart(TscClock::now()); // It may have slept on purpose
         }
-        // Optional: cpu_relax() or yield if we want to be nice,
-        // but for HFT pinning we usually spin.
     }
 
     // Drain any orders already enqueued before shutdown to avoid dropping work.
@@ -28,49 +72,141 @@ void MatchingEngine::run(std::atomic<bool> &running)
     {
         processOrder(order);
     }
+    if (statusIntervalTicks_ > 0)
+    {
+        publishStatus(); // Final counts for monitors that outlive the engine
+    }
+}
+
+void MatchingEngine::publishStatusIfDue()
+{
+    if (statusIntervalTicks_ == 0)
+    {
+        return;
+    }
+    const uint64_t now = TscClock::now();
+    if (now < nextStatusTick_)
+    {
+        return;
+    }
+    nextStatusTick_ = now + statusIntervalTicks_;
+    publishStatus();
+}
+
+void MatchingEngine::publishStatus()
+{
+    EngineStatus status;
+    status.publishedNs = getCurrentTimeNs();
+    status.orders = metrics_.getOrderCount();
+    status.trades = metrics_.getTradeCount();
+    status.unrouted = getUnroutedOrderCount();
+    status.queueDepth = inputQueue_.size();
+    for (std::size_t symbol = firstOwnedSymbol_; symbol < books_.size(); symbol += ownedSymbolStride_)
+    {
+        status.bookDepth += books_[symbol]->getOrderCount();
+    }
+    status_.store(status);
 }
 
 void MatchingEngine::processOrder(const Order &order)
 {
-    // 1. Start Engine Timer
-    uint64_t engineStart = getCurrentTimeNs();
+    // 0. Route to the instrument's book (dense SymbolId -> array slot)
+    if (order.symbol >= books_.size())
+    {
+        unroutedOrders_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    IOrderBook &book = *books_[order.symbol];
+
+    // 1. Start Engine Timer: TSC ticks for the engine's own work, plus one wall-clock read when the order
+    //    carries client/gateway stamps to measure against (none with HFT_METRICS_BACKEND=disabled and
+    //    the order trace and jitter detector off)
+    const bool timed = MetricsCollector::RECORDS_LATENCY || trace_ || jitter_;
+    uint64_t wallStart = 0;
+    uint64_t engineStart = 0;
+    if (timed)
+    {
+        if (order.sendTimestamp > 0 || order.receiveTimestamp > 0)
+        {
+            wallStart = getCurrentTimeNs();
+        }
+        engineStart = TscClock::now();
+    }
 
     // 2. Insert into Order Book
-    orderBook_.addOrder(order);
+    book.addOrder(order);
 
     // 3. Match Orders
-    std::vector<Trade> trades = orderBook_.match();
+    std::vector<Trade> trades = book.match();
 
     // 4. Stop Engine Timer
-    uint64_t engineEnd = getCurrentTimeNs();
+    const uint64_t engineEnd = timed ? TscClock::now() : 0;
+
+    // 5. Trace the order's lifecycle: one 64-byte slot, overwritten once the ring wraps
+    if (trace_)
+    {
+        trace_->record({order.id, order.sendTimestamp, order.receiveTimestamp, wallStart, engineStart, engineEnd,
+                        static_cast<uint32_t>(trades.size()), static_cast<uint32_t>(book.getOrderCount()),
+                        order.symbol, order.side, order.type, 0});
+    }
+
+    // 6. Report back to the owning clients; the gateway formats and sends them on its own thread
+    if (reportSink_)
+    {
+        publishReports(order, trades);
+    }
+
+    // 7. Record Metrics. Latencies first: the U1 barrier reads them once the order count is reached
+    const uint64_t engineLat = engineEnd - engineStart;
+    if constexpr (MetricsCollector::RECORDS_LATENCY)
+    {
+        recordLatencies(order, wallStart, engineLat);
+    }
+    if (jitter_)
+    {
+        recordJitter(order, wallStart, engineLat);
+    }
+    metrics_.incrementOrders();
+    metrics_.incrementTrades(trades.size());
+}
 
-    // 5. Calculate Decomposed Latencies
+namespace
+{
+// Wall-clock interval in ticks, 0 if the stamps are out of order (e.g. a client clock ahead of ours)
+uint64_t ticksBetween(uint64_t earlierNs, uint64_t laterNs)
+{
+    return laterNs > earlierNs ? TscClock::fromNs(laterNs - earlierNs) : 0;
+}
+} // namespace
+
+void MatchingEngine::recordLatencies(const Order &order, uint64_t wallStart, uint64_t engineLat)
+{
+    // Decompose: network (client -> gateway), queue (gateway -> engine), engine (book work).
+    // Everything is recorded in TscClock ticks; stats are converted to ns when reported.
     uint64_t networkLat = 0;
     uint64_t queueLat = 0;
-    uint64_t engineLat = engineEnd - engineStart;
     uint64_t totalLat = 0;
 
     // Use sendTimestamp (E2E) if available, otherwise receiveTimestamp (Wire-to-Match)
     if (order.sendTimestamp > 0)
     {
-        totalLat = engineEnd - order.sendTimestamp;
+        totalLat = ticksBetween(order.sendTimestamp, wallStart) + engineLat;
         if (order.receiveTimestamp > 0)
         {
-            networkLat = order.receiveTimestamp - order.sendTimestamp;
-            queueLat = engineStart - order.receiveTimestamp;
+            networkLat = ticksBetween(order.sendTimestamp, order.receiveTimestamp);
+            queueLat = ticksBetween(order.receiveTimestamp, wallStart);
         }
     }
     else if (order.receiveTimestamp > 0)
     {
-        totalLat = engineEnd - order.receiveTimestamp;
-        queueLat = engineStart - order.receiveTimestamp;
+        queueLat = ticksBetween(order.receiveTimestamp, wallStart);
+        totalLat = queueLat + engineLat;
     }
     else
     {
         totalLat = engineLat; // Direct mode
     }
 
-    // 6. Record Metrics
     metrics_.recordLatency(totalLat);
     if (networkLat > 0)
     {
@@ -81,9 +217,15 @@ void MatchingEngine::processOrder(const Order &order)
         metrics_.recordQueueLatency(queueLat);
     }
     metrics_.recordEngineLatency(engineLat);
+}
 
-    metrics_.incrementOrders();
-    metrics_.incrementTrades(trades.size());
+void MatchingEngine::recordJitter(const Order &order, uint64_t wallStart, uint64_t engineLat)
+{
+    // Time in this process: from the gateway's receive when known, else from the client's send,
+    // else just the book work. Independent of the metrics backend.
+    const uint64_t arrivedNs = order.receiveTimestamp > 0 ? order.receiveTimestamp : order.sendTimestamp;
+    const uint64_t latency = (arrivedNs > 0 ? ticksBetween(arrivedNs, wallStart) : 0) + engineLat;
+    jitter_->recordOrder(latency, arrivedNs);
 }
 
 const MetricsCollector &MatchingEngine::getMetrics() const
@@ -93,12 +235,103 @@ const MetricsCollector &MatchingEngine::getMetrics() const
 
 IOrderBook &MatchingEngine::getOrderBook()
 {
-    return orderBook_;
+    return *books_[0];
 }
 
 const IOrderBook &MatchingEngine::getOrderBook() const
 {
-    return orderBook_;
+    return *books_[0];
+}
+
+IOrderBook &MatchingEngine::getOrderBook(SymbolId symbol)
+{
+    return *books_.at(symbol);
+}
+
+const IOrderBook &MatchingEngine::getOrderBook(SymbolId symbol) const
+{
+    return *books_.at(symbol);
+}
+
+std::size_t MatchingEngine::getSymbolCount() const
+{
+    return books_.size();
+}
+
+uint64_t MatchingEngine::getUnroutedOrderCount() const
+{
+    return unroutedOrders_.load(std::memory_order_relaxed);
+}
+
+IdleStrategy &MatchingEngine::getIdleStrategy()
+{
+    return idleStrategy_;
+}
+
+void MatchingEngine::setExecutionReportSink(ExecutionReportSink *sink, std::size_t producer)
+{
+    reportSink_ = sink;
+    reportProducer_ = producer;
+}
+
+void MatchingEngine::enableOrderTrace(std::size_t capacity)
+{
+    trace_ = std::make_unique<OrderTraceRing>(capacity);
+}
+
+const OrderTraceRing *MatchingEngine::getOrderTrace() const
+{
+    return trace_.get();
+}
+
+void MatchingEngine::enableJitterDetector(std::chrono::nanoseconds threshold)
+{
+    jitter_ = std::make_unique<JitterDetector>(threshold);
+}
+
+const JitterDetector *MatchingEngine::getJitterDetector() const
+{
+    return jitter_.get();
+}
+
+void MatchingEngine::setStatusInterval(std::chrono::microseconds interval)
+{
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+    statusIntervalTicks_ = ns > 0 ? std::max<uint64_t>(TscClock::fromNs(static_cast<uint64_t>(ns)), 1) : 0;
+    nextStatusTick_ = 0; // The first check publishes
+}
+
+EngineStatus MatchingEngine::getStatus() const
+{
+    return status_.load();
+}
+
+void MatchingEngine::setOwnedSymbols(std::size_t first, std::size_t stride)
+{
+    firstOwnedSymbol_ = first;
+    ownedSymbolStride_ = stride > 0 ? stride : 1;
+}
+
+void MatchingEngine::publishReports(const Order &order, const std::vector<Trade> &trades)
+{
+    if (order.client != 0)
+    {
+        reportSink_->publish(reportProducer_, {order.client, ExecType::New, order.side, order.id, order.price,
+                                               order.quantity, order.sendTimestamp});
+    }
+    for (const Trade &trade : trades)
+    {
+        if (trade.buyClient != 0)
+        {
+            reportSink_->publish(reportProducer_, {trade.buyClient, ExecType::Trade, Side::Buy, trade.buyOrderId,
+                                                   trade.price, trade.quantity, 0});
+        }
+        if (trade.sellClient != 0)
+        {
+            reportSink_->publish(reportProducer_, {trade.sellClient, ExecType::Trade, Side::Sell, trade.sellOrderId,
+                                                   trade.price, trade.quantity, 0});
+        }
+    }
 }
 
 } // namespace hft
@@ -1,10 +1,20 @@
 #pragma once
 
 #include "core/order.hpp"
+#include "execution_report.hpp"
 #include "i_order_book.hpp"
+#include "jitter_detector.hpp"
 #include "metrics_collector.hpp"
+#include "metrics_snapshot.hpp"
+#include "order_book_registry.hpp"
+#include "order_trace.hpp"
+#include "utils/idle_strategy.hpp"
 #include "utils/lock_free_queue.hpp"
+#include "utils/seqlock.hpp"
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
 
 namespace hft
 {
@@ -13,7 +23,14 @@ class MatchingEngine
 {
   public:
     // Constructor takes input queue and order book reference (dependency injection)
-    MatchingEngine(LockFreeQueue<Order, 1024> &inputQueue, IOrderBook &orderBook);
+    // idleType selects how run() waits when the queue is empty (default: pure busy-spin)
+    MatchingEngine(LockFreeQueue<Order, 1024> &inputQueue, IOrderBook &orderBook,
+                   IdleStrategyType idleType = IdleStrategyType::BusySpin);
+
+    // Multi-instrument engine: orders are routed to registry.get(order.symbol).
+    // The registry must outlive the engine.
+    MatchingEngine(LockFreeQueue<Order, 1024> &inputQueue, OrderBookRegistry &registry,
+                   IdleStrategyType idleType = IdleStrategyType::BusySpin);
 
     // Main loop for the worker thread
     void run(std::atomic<bool> &running);
@@ -24,14 +41,67 @@ class MatchingEngine
     // Accessors for verification
     const MetricsCollector &getMetrics() const;
 
-    // Const / Non-const for write/read and read only access
+    // Const / Non-const for write/read and read only access (symbol 0 for single-instrument callers)
     IOrderBook &getOrderBook();
     const IOrderBook &getOrderBook() const;
+    IOrderBook &getOrderBook(SymbolId symbol);
+    const IOrderBook &getOrderBook(SymbolId symbol) const;
+
+    std::size_t getSymbolCount() const;
+
+    // Orders dropped because their symbol has no book (should stay 0 when gateway and engine agree)
+    uint64_t getUnroutedOrderCount() const;
+
+    // Producers call getIdleStrategy().wake() after pushing so a parked engine resumes immediately
+    IdleStrategy &getIdleStrategy();
+
+    // Acks and fills for orders that carry a client go to sink->publish(producer, ...). Set before run().
+    void setExecutionReportSink(ExecutionReportSink *sink, std::size_t producer = 0);
+
+    // Keeps the lifecycle of the last `capacity` orders (rounded up to a power of two) in an
+    // OrderTraceRing; off (nullptr) by default. Call before run().
+    void enableOrderTrace(std::size_t capacity);
+    const OrderTraceRing *getOrderTrace() const;
+
+    // Watches run()'s idle polls for stalls longer than `threshold` (JitterDetector) and counts the orders
+    // slower than it; off (nullptr) by default. Only the spin and pause strategies poll continuously: with
+    // backoff or park, only the polls between sleeps are watched. Call before run().
+    void enableJitterDetector(std::chrono::nanoseconds threshold);
+    const JitterDetector *getJitterDetector() const;
+
+    // run() republishes an EngineStatus at most this often (between batches, every
+    // STATUS_CHECK_ORDERS orders under load, and while idle); 0 = never (the default). Call before run().
+    void setStatusInterval(std::chrono::microseconds interval);
+
+    // Latest published status, from any thread, without touching the engine thread
+    EngineStatus getStatus() const;
+
+    // Books whose depth the status sums: symbols first, first + stride, ... (a shard only reads its own)
+    void setOwnedSymbols(std::size_t first, std::size_t stride);
+
+    static constexpr std::size_t STATUS_CHECK_ORDERS = 256;
 
   private:
+    void publishStatusIfDue();
+    void publishStatus();
+    void publishReports(const Order &order, const std::vector<Trade> &trades);
+    void recordLatencies(const Order &order, uint64_t wallStart, uint64_t engineLat);
+    void recordJitter(const Order &order, uint64_t wallStart, uint64_t engineLat);
+
     LockFreeQueue<Order, 1024> &inputQueue_;
-    IOrderBook &orderBook_; // Reference to injected order book
+    std::vector<IOrderBook *> books_; // Indexed by SymbolId; books are owned by the caller
+    std::atomic<uint64_t> unroutedOrders_{0};
     MetricsCollector metrics_;
+    IdleStrategy idleStrategy_;
+    ExecutionReportSink *reportSink_ = nullptr;
+    std::size_t reportProducer_ = 0;
+    std::unique_ptr<OrderTraceRing> trace_;
+    std::unique_ptr<JitterDetector> jitter_;
+    uint64_t statusIntervalTicks_ = 0;
+    uint64_t nextStatusTick_ = 0;
+    std::size_t firstOwnedSymbol_ = 0;
+    std::size_t ownedSymbolStride_ = 1;
+    SeqLock<EngineStatus> status_;
 };
 
 } // namespace hft
@@ -1,67 +1,193 @@
 #pragma once
 
-#include <algorithm>
+#include "latency_histogram.hpp"
+#include "utils/rdtsc.hpp"
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <mutex>
-#include <vector>
+#include <memory>
+#include <span>
 
 namespace hft
 {
 
-struct LatencyStats
+/**
+ * @brief What the latency instrumentation records; fixed at build time (-DHFT_METRICS_BACKEND=...).
+ *
+ * Disabled  - record calls compile away and the engine takes no timestamps. Stats are all zero.
+ * Counters  - per latency: sample count, sum and max (mean/max, no percentiles).
+ * Histogram - LatencyHistogram per latency: p50..p99.99 in constant memory (the default).
+ * Trace     - Histogram, plus the first TRACE_CAPACITY raw samples of each latency in arrival order.
+ *
+ * Order and trade counts are kept by every backend: the U1 stats barrier waits on them.
+ */
+enum class MetricsBackend : uint8_t
 {
-    double mean;
-    uint64_t p99;
-    uint64_t max;
+    Disabled = 0,
+    Counters = 1,
+    Histogram = 2,
+    Trace = 3
 };
 
-class MetricsCollector
+#if defined(HFT_METRICS_BACKEND_DISABLED)
+inline constexpr MetricsBackend BUILD_METRICS_BACKEND = MetricsBackend::Disabled;
+#elif defined(HFT_METRICS_BACKEND_COUNTERS)
+inline constexpr MetricsBackend BUILD_METRICS_BACKEND = MetricsBackend::Counters;
+#elif defined(HFT_METRICS_BACKEND_TRACE)
+inline constexpr MetricsBackend BUILD_METRICS_BACKEND = MetricsBackend::Trace;
+#else
+inline constexpr MetricsBackend BUILD_METRICS_BACKEND = MetricsBackend::Histogram;
+#endif
+
+inline const char *metricsBackendToString(MetricsBackend backend)
+{
+    switch (backend)
+    {
+        case MetricsBackend::Disabled:
+            return "disabled";
+        case MetricsBackend::Counters:
+            return "counters";
+        case MetricsBackend::Histogram:
+            return "histogram";
+        case MetricsBackend::Trace:
+            return "trace";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief One latency series under a given backend. Single writer; stats may be read from any thread.
+ */
+template <MetricsBackend Backend> class LatencyRecorder;
+
+template <> class LatencyRecorder<MetricsBackend::Disabled>
 {
   public:
-    MetricsCollector() : orderCount_(0), tradeCount_(0)
+    void record(uint64_t)
     {
-        // Pre-allocate to avoid allocation during runtime
-        latencies_.reserve(1000000);
-        networkLatencies_.reserve(1000000);
-        engineLatencies_.reserve(1000000);
-        queueLatencies_.reserve(1000000);
     }
 
-    void recordLatency(uint64_t cycles)
+    void addTo(LatencyHistogram::Snapshot &) const
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        if (latencies_.size() < latencies_.capacity())
+    }
+};
+
+template <> class LatencyRecorder<MetricsBackend::Counters>
+{
+  public:
+    void record(uint64_t value)
+    {
+        // Single writer: plain load/store, no locked read-modify-write
+        sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        if (value > max_.load(std::memory_order_relaxed))
         {
-            latencies_.push_back(cycles);
+            max_.store(value, std::memory_order_relaxed);
         }
+        count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
     }
 
-    void recordNetworkLatency(uint64_t cycles)
+    void addTo(LatencyHistogram::Snapshot &snapshot) const
+    {
+        const uint64_t count = count_.load(std::memory_order_acquire);
+        snapshot.addTotals(count, sum_.load(std::memory_order_relaxed), max_.load(std::memory_order_relaxed));
+    }
+
+  private:
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+template <> class LatencyRecorder<MetricsBackend::Histogram>
+{
+  public:
+    void record(uint64_t value)
+    {
+        histogram_.record(value);
+    }
+
+    void addTo(LatencyHistogram::Snapshot &snapshot) const
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        if (networkLatencies_.size() < networkLatencies_.capacity())
+        snapshot.add(histogram_);
+    }
+
+  private:
+    LatencyHistogram histogram_;
+};
+
+template <> class LatencyRecorder<MetricsBackend::Trace>
+{
+  public:
+    static constexpr std::size_t TRACE_CAPACITY = std::size_t{1} << 20;
+
+    // Not value-initialised: only the pages the trace reaches are ever touched
+    LatencyRecorder() : samples_{new uint64_t[TRACE_CAPACITY]}
+    {
+    }
+
+    void record(uint64_t value)
+    {
+        histogram_.record(value);
+        const std::size_t size = size_.load(std::memory_order_relaxed);
+        if (size < TRACE_CAPACITY)
         {
-            networkLatencies_.push_back(cycles);
+            samples_[size] = value;
+            size_.store(size + 1, std::memory_order_release);
         }
     }
 
+    void addTo(LatencyHistogram::Snapshot &snapshot) const
+    {
+        snapshot.add(histogram_);
+    }
+
+    // Samples recorded so far, oldest first; once full, later samples only reach the histogram
+    std::span<const uint64_t> trace() const
+    {
+        return {samples_.get(), size_.load(std::memory_order_acquire)};
+    }
+
+  private:
+    LatencyHistogram histogram_;
+    std::unique_ptr<uint64_t[]> samples_;
+    std::atomic<std::size_t> size_{0};
+};
+
+/**
+ * @brief Order/trade counters and the total, network, queue and engine latencies of one engine thread.
+ *
+ * The single instrumentation layer for the server and the benchmarks, so both measure the same way.
+ * The record* calls come from the thread that owns the collector and never lock or allocate; the
+ * get* calls may run on any thread (the gateway answers U1 from its client threads). Engines that run
+ * several threads keep one collector each and merge them on read (ShardedMatchingEngine).
+ */
+template <MetricsBackend Backend> class BasicMetricsCollector
+{
+  public:
+    using Recorder = LatencyRecorder<Backend>;
+
+    static constexpr MetricsBackend BACKEND = Backend;
+    // False when timing an order would only feed no-op recorders
+    static constexpr bool RECORDS_LATENCY = Backend != MetricsBackend::Disabled;
+
+    void recordLatency(uint64_t cycles)
+    {
+        latencies_.record(cycles);
+    }
+
+    void recordNetworkLatency(uint64_t cycles)
+    {
+        networkLatencies_.record(cycles);
+    }
+
     void recordEngineLatency(uint64_t cycles)
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        if (engineLatencies_.size() < engineLatencies_.capacity())
-        {
-            engineLatencies_.push_back(cycles);
-        }
+        engineLatencies_.record(cycles);
     }
 
     void recordQueueLatency(uint64_t cycles)
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        if (queueLatencies_.size() < queueLatencies_.capacity())
-        {
-            queueLatencies_.push_back(cycles);
-        }
+        queueLatencies_.record(cycles);
     }
 
     void incrementOrders()
@@ -86,62 +212,79 @@ class MetricsCollector
 
     LatencyStats getStats() const
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        return calculateStats(latencies_);
+        return statsOf(latencies_);
     }
 
     LatencyStats getNetworkStats() const
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        return calculateStats(networkLatencies_);
+        return statsOf(networkLatencies_);
     }
 
     LatencyStats getEngineStats() const
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        return calculateStats(engineLatencies_);
+        return statsOf(engineLatencies_);
     }
 
     LatencyStats getQueueStats() const
     {
-        std::lock_guard<std::mutex> lock(samplesMutex_);
-        return calculateStats(queueLatencies_);
+        return statsOf(queueLatencies_);
     }
 
-  private:
-    LatencyStats calculateStats(const std::vector<uint64_t> &samples) const
+    // Per-series access, to merge several collectors (Recorder::addTo) or read a Trace backend's samples
+    const Recorder &getLatencyRecorder() const
     {
-        if (samples.empty())
-        {
-            return {0.0, 0, 0};
-        }
+        return latencies_;
+    }
+
+    const Recorder &getNetworkRecorder() const
+    {
+        return networkLatencies_;
+    }
 
-        std::vector<uint64_t> sorted = samples;
-        std::sort(sorted.begin(), sorted.end());
+    const Recorder &getEngineRecorder() const
+    {
+        return engineLatencies_;
+    }
 
-        double sum = 0;
-        for (auto l : sorted)
-        {
-            sum += l;
-        }
+    const Recorder &getQueueRecorder() const
+    {
+        return queueLatencies_;
+    }
+
+  private:
+    static LatencyStats statsOf(const Recorder &recorder)
+    {
+        LatencyHistogram::Snapshot snapshot;
+        recorder.addTo(snapshot);
+        return snapshot.stats();
+    }
 
-        LatencyStats stats;
-        stats.mean = sum / sorted.size();
-        stats.max = sorted.back();
-        const size_t n = sorted.size();
-        // Nearest-rank p99 index (0-based): ceil(0.99*n)-1, clamped.
-        const size_t p99Index = std::min(n - 1, ((99 * n + 99) / 100) - 1);
-        stats.p99 = sorted[p99Index];
-        return stats;
-    }
-
-    std::atomic<uint64_t> orderCount_;
-    std::atomic<uint64_t> tradeCount_;
-    std::vector<uint64_t> latencies_;
-    std::vector<uint64_t> networkLatencies_;
-    std::vector<uint64_t> engineLatencies_;
-    std::vector<uint64_t> queueLatencies_;
-    mutable std::mutex samplesMutex_;
+    std::atomic<uint64_t> orderCount_{0};
+    std::atomic<uint64_t> tradeCount_{0};
+    Recorder latencies_;
+    Recorder networkLatencies_;
+    Recorder engineLatencies_;
+    Recorder queueLatencies_;
 };
 
+using MetricsCollector = BasicMetricsCollector<BUILD_METRICS_BACKEND>;
+
+// The engine records TscClock ticks; reports (U2, the server summary, benchmarks) convert with this
+inline LatencyStats toNanoseconds(const LatencyStats &ticks)
+{
+    const auto ns = [](uint64_t value)
+    {
+        return static_cast<uint64_t>(TscClock::toNs(static_cast<double>(value)) + 0.5);
+    };
+    LatencyStats stats = ticks;
+    stats.mean = TscClock::toNs(ticks.mean);
+    stats.p50 = ns(ticks.p50);
+    stats.p90 = ns(ticks.p90);
+    stats.p99 = ns(ticks.p99);
+    stats.p999 = ns(ticks.p999);
+    stats.p9999 = ns(ticks.p9999);
+    stats.max = ns(ticks.max);
+    return stats;
+}
+
 } // namespace hft
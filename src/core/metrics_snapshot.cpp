@@ -0,0 +1,44 @@
+#include "metrics_snapshot.hpp"
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace hft
+{
+
+namespace
+{
+void formatLatency(std::ostringstream &out, const char *series, const LatencyStats &stats)
+{
+    const std::pair<const char *, uint64_t> quantiles[] = {
+        {"0.5", stats.p50}, {"0.9", stats.p90}, {"0.99", stats.p99}, {"0.999", stats.p999}, {"0.9999", stats.p9999}};
+    for (const auto &[quantile, value] : quantiles)
+    {
+        out << "hft_latency_ns{series=\"" << series << "\",quantile=\"" << quantile << "\"} " << value << "\n";
+    }
+    out << "hft_latency_ns_mean{series=\"" << series << "\"} " << stats.mean << "\n";
+    out << "hft_latency_ns_max{series=\"" << series << "\"} " << stats.max << "\n";
+    out << "hft_latency_ns_count{series=\"" << series << "\"} " << stats.count << "\n";
+}
+} // namespace
+
+std::string formatMetricsSnapshot(const MetricsSnapshot &snapshot)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    out << "hft_snapshot_time_ns " << snapshot.publishedNs << "\n";
+    out << "hft_engine_status_time_ns " << snapshot.status.publishedNs << "\n";
+    out << "hft_engines " << snapshot.engineCount << "\n";
+    out << "hft_orders_total " << snapshot.status.orders << "\n";
+    out << "hft_trades_total " << snapshot.status.trades << "\n";
+    out << "hft_unrouted_orders_total " << snapshot.status.unrouted << "\n";
+    out << "hft_queue_depth " << snapshot.status.queueDepth << "\n";
+    out << "hft_book_depth " << snapshot.status.bookDepth << "\n";
+    formatLatency(out, "total", snapshot.total);
+    formatLatency(out, "network", snapshot.network);
+    formatLatency(out, "queue", snapshot.queue);
+    formatLatency(out, "engine", snapshot.engine);
+    return out.str();
+}
+
+} // namespace hft
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "latency_histogram.hpp"
+#include "metrics_collector.hpp"
+#include "utils/rdtsc.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hft
+{
+
+/**
+ * @brief What an engine thread publishes about itself, all taken at one instant on that thread.
+ *
+ * Counts come from the engine's MetricsCollector; the depths are only safe to read on the engine
+ * thread, which is why the engine publishes them instead of readers polling it.
+ */
+struct EngineStatus
+{
+    uint64_t publishedNs = 0; // Wall clock of the refresh (aggregates: the oldest engine's)
+    uint64_t orders = 0;
+    uint64_t trades = 0;
+    uint64_t unrouted = 0;
+    uint64_t queueDepth = 0; // Orders waiting in the input queue
+    uint64_t bookDepth = 0;  // Orders resting in the engine's books
+};
+
+/**
+ * @brief Everything a monitor sees: engine status plus the four latency series in ns.
+ *
+ * Trivially copyable, so it can be published through a SeqLock and read from shared memory.
+ */
+struct MetricsSnapshot
+{
+    uint64_t publishedNs = 0;
+    uint64_t engineCount = 0;
+    EngineStatus status;
+    LatencyStats total;
+    LatencyStats network;
+    LatencyStats queue;
+    LatencyStats engine;
+};
+
+// StatsSource is a MetricsCollector or a ShardedMatchingEngine (merged across shards). Reading the
+// histograms never touches the engine thread.
+template <typename StatsSource>
+MetricsSnapshot makeMetricsSnapshot(const EngineStatus &status, std::size_t engineCount, const StatsSource &stats)
+{
+    MetricsSnapshot snapshot;
+    snapshot.publishedNs = getCurrentTimeNs();
+    snapshot.engineCount = engineCount;
+    snapshot.status = status;
+    snapshot.total = toNanoseconds(stats.getStats());
+    snapshot.network = toNanoseconds(stats.getNetworkStats());
+    snapshot.queue = toNanoseconds(stats.getQueueStats());
+    snapshot.engine = toNanoseconds(stats.getEngineStats());
+    return snapshot;
+}
+
+// Prometheus text exposition format: one `name{labels} value` line per metric
+std::string formatMetricsSnapshot(const MetricsSnapshot &snapshot);
+
+} // namespace hft
@@ -47,6 +47,17 @@ class OrderBookFactory
 
         throw std::runtime_error("Unknown OrderBook type: " + type);
     }
+
+    // capacityHint sizes books that preallocate their order storage (pool); 0 keeps the type's default.
+    // Used when one engine hosts many instruments and a full-size pool per book would not fit in memory.
+    static std::unique_ptr<IOrderBook> create(const std::string &type, Index capacityHint)
+    {
+        if (type == "pool" && capacityHint > 0)
+        {
+            return std::make_unique<PoolOrderBook>(capacityHint);
+        }
+        return create(type);
+    }
 };
 
 } // namespace hft
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "i_order_book.hpp"
+#include "order_book_factory.hpp"
+#include "types.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief Owns one order book per instrument, indexed directly by SymbolId.
+ *
+ * SymbolIds are dense (0..N-1), so routing an order is a bounds check plus an array load:
+ * no hashing or string compares on the matching path. All books share one implementation type.
+ */
+class OrderBookRegistry
+{
+  public:
+    // Same capacity for every book (capacityPerBook = 0 keeps the factory default)
+    OrderBookRegistry(const std::string &type, std::size_t symbolCount, Index capacityPerBook = 0)
+    {
+        if (symbolCount == 0)
+        {
+            throw std::runtime_error("OrderBookRegistry: at least one symbol is required");
+        }
+
+        books_.reserve(symbolCount);
+        for (std::size_t i = 0; i < symbolCount; ++i)
+        {
+            books_.push_back(OrderBookFactory::create(type, capacityPerBook));
+        }
+    }
+
+    // Per-symbol capacities, e.g. sized from a pre-generated workload with skewed popularity
+    OrderBookRegistry(const std::string &type, const std::vector<Index> &capacityBySymbol)
+    {
+        if (capacityBySymbol.empty())
+        {
+            throw std::runtime_error("OrderBookRegistry: at least one symbol is required");
+        }
+
+        books_.reserve(capacityBySymbol.size());
+        for (Index capacity : capacityBySymbol)
+        {
+            books_.push_back(OrderBookFactory::create(type, capacity));
+        }
+    }
+
+    // Single-instrument registry wrapping an existing book
+    explicit OrderBookRegistry(std::unique_ptr<IOrderBook> book)
+    {
+        books_.push_back(std::move(book));
+    }
+
+    std::size_t size() const
+    {
+        return books_.size();
+    }
+
+    bool contains(SymbolId symbol) const
+    {
+        return symbol < books_.size();
+    }
+
+    IOrderBook &get(SymbolId symbol)
+    {
+        return *books_[symbol];
+    }
+
+    const IOrderBook &get(SymbolId symbol) const
+    {
+        return *books_[symbol];
+    }
+
+  private:
+    std::vector<std::unique_ptr<IOrderBook>> books_;
+};
+
+} // namespace hft
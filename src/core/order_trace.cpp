@@ -0,0 +1,133 @@
+#include "order_trace.hpp"
+#include "utils/rdtsc.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace hft
+{
+
+namespace
+{
+constexpr char TRACE_MAGIC[8] = {'H', 'F', 'T', 'T', 'R', 'C', '0', '1'};
+
+template <typename T> void writeValue(std::ostream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> bool readValue(std::istream &in, T &value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+} // namespace
+
+OrderTraceRing::OrderTraceRing(std::size_t capacity)
+{
+    if (capacity == 0)
+    {
+        throw std::runtime_error("OrderTraceRing: capacity must be at least 1");
+    }
+    const std::size_t slots = std::bit_ceil(std::max<std::size_t>(capacity, 2));
+    // Not value-initialised: only the slots the trace reaches are ever touched
+    slots_.reset(new Slot[slots]);
+    mask_ = slots - 1;
+}
+
+std::vector<OrderTraceRecord> OrderTraceRing::snapshot() const
+{
+    // Record n is written into the slot of record n - capacity, so while the writer fills record `end`
+    // the oldest slot is fair game: copy at most capacity - 1
+    const uint64_t slots = capacity();
+    const uint64_t end = head_.load(std::memory_order_acquire);
+    const uint64_t begin = end + 1 > slots ? end + 1 - slots : 0;
+
+    std::vector<OrderTraceRecord> copy(end - begin);
+    for (uint64_t i = begin; i < end; ++i)
+    {
+        Slot &slot = slots_[i & mask_]; // atomic_ref needs a non-const referent; only loaded here
+        Words words;
+        for (std::size_t w = 0; w < WORDS; ++w)
+        {
+            words[w] = std::atomic_ref<uint64_t>(slot.words[w]).load(std::memory_order_relaxed);
+        }
+        std::memcpy(&copy[i - begin], words.data(), sizeof(OrderTraceRecord));
+    }
+
+    // While we copied, the writer may have moved on to record `after`: drop the slots it could have reused
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = head_.load(std::memory_order_relaxed);
+    const uint64_t firstIntact = after + 1 > slots ? after + 1 - slots : 0;
+    if (firstIntact > begin)
+    {
+        const uint64_t torn = std::min(firstIntact - begin, end - begin);
+        copy.erase(copy.begin(), copy.begin() + static_cast<std::ptrdiff_t>(torn));
+    }
+    return copy;
+}
+
+std::size_t OrderTraceRing::dump(std::ostream &out, uint32_t engine) const
+{
+    const std::vector<OrderTraceRecord> records = snapshot();
+    const uint64_t recordedSoFar = recorded(); // Read after the copy: never fewer than it holds
+
+    out.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    writeValue(out, FORMAT_VERSION);
+    writeValue(out, engine);
+    writeValue(out, TscClock::calibrate().ticksPerNs);
+    writeValue(out, recordedSoFar);
+    writeValue(out, static_cast<uint64_t>(records.size()));
+    out.write(reinterpret_cast<const char *>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(OrderTraceRecord)));
+    return records.size();
+}
+
+std::vector<OrderTraceChunk> OrderTraceRing::readChunks(std::istream &in)
+{
+    std::vector<OrderTraceChunk> chunks;
+    char magic[sizeof(TRACE_MAGIC)];
+    while (in.read(magic, sizeof(magic)))
+    {
+        if (std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0)
+        {
+            throw std::runtime_error("Order trace: bad magic (not an order trace dump)");
+        }
+
+        uint32_t version = 0;
+        uint64_t count = 0;
+        OrderTraceChunk chunk;
+        if (!readValue(in, version) || !readValue(in, chunk.engine) || !readValue(in, chunk.ticksPerNs) ||
+            !readValue(in, chunk.recorded) || !readValue(in, count))
+        {
+            throw std::runtime_error("Order trace: truncated chunk header");
+        }
+        if (version != FORMAT_VERSION)
+        {
+            throw std::runtime_error("Order trace: unsupported format version " + std::to_string(version));
+        }
+        if (count > chunk.recorded)
+        {
+            throw std::runtime_error("Order trace: chunk holds more records than were recorded");
+        }
+
+        chunk.records.resize(count);
+        if (!in.read(reinterpret_cast<char *>(chunk.records.data()),
+                     static_cast<std::streamsize>(count * sizeof(OrderTraceRecord))))
+        {
+            throw std::runtime_error("Order trace: truncated records");
+        }
+        chunks.push_back(std::move(chunk));
+    }
+    if (in.gcount() != 0)
+    {
+        throw std::runtime_error("Order trace: trailing bytes after the last chunk");
+    }
+    return chunks;
+}
+
+} // namespace hft
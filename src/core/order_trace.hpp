@@ -0,0 +1,127 @@
+#pragma once
+
+#include "types.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief Lifecycle of one order through an engine: one cache line, written once.
+ *
+ * sendNs, receiveNs and dequeueNs are wall-clock ns (getCurrentTimeNs), comparable across processes;
+ * each is 0 when the order did not carry client/gateway stamps (direct mode). engineStart and
+ * engineEnd are TscClock ticks around the book's addOrder + match; convert with the ticksPerNs stored
+ * in the dump.
+ */
+struct OrderTraceRecord
+{
+    OrderId orderId;
+    uint64_t sendNs;      // Client's TransactionTime (60)
+    uint64_t receiveNs;   // Gateway parsed the frame
+    uint64_t dequeueNs;   // Engine popped the order
+    uint64_t engineStart; // Ticks: before addOrder
+    uint64_t engineEnd;   // Ticks: after match
+    uint32_t trades;      // Trades the order's match produced
+    uint32_t depth;       // Orders resting in the book afterwards
+    SymbolId symbol;
+    Side side;
+    OrderType type;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(OrderTraceRecord) == 64, "one trace record per cache line");
+
+/**
+ * @brief One engine's trace, as dumped to or read back from a file.
+ */
+struct OrderTraceChunk
+{
+    uint32_t engine = 0;                   // Shard index
+    double ticksPerNs = 1.0;               // TscClock rate of the process that wrote it
+    uint64_t recorded = 0;                 // Orders traced since start, including those overwritten
+    std::vector<OrderTraceRecord> records; // Oldest first
+};
+
+/**
+ * @brief Fixed-size ring of the most recent OrderTraceRecords of one engine thread.
+ *
+ * record() is the engine's only cost: one 64-byte slot written as eight relaxed atomic words (plain
+ * moves on x86), then a release store of the head. No lock, no allocation, no read-modify-write; when
+ * full it overwrites the oldest record. Single writer; snapshot() and dump() may run on any thread
+ * while it keeps going. Racing the writer word by word is well defined, and a reader discards the
+ * slots the writer may have reused during its copy, so every record it returns is whole.
+ *
+ * Dump format, native byte order, one chunk per engine appended to the same file:
+ *   char magic[8] = "HFTTRC01", uint32 version, uint32 engine, double ticksPerNs,
+ *   uint64 recorded, uint64 count, then count OrderTraceRecords oldest first.
+ * readChunks() reads them back; tools/order_trace_decoder prints them.
+ */
+class OrderTraceRing
+{
+  public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    // Capacity is rounded up to a power of two (at least 2). Throws std::runtime_error for 0.
+    explicit OrderTraceRing(std::size_t capacity);
+
+    OrderTraceRing(const OrderTraceRing &) = delete;
+    OrderTraceRing &operator=(const OrderTraceRing &) = delete;
+
+    void record(const OrderTraceRecord &entry)
+    {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        Words words;
+        std::memcpy(words.data(), &entry, sizeof(entry));
+        Slot &slot = slots_[head & mask_];
+        for (std::size_t i = 0; i < WORDS; ++i)
+        {
+            std::atomic_ref<uint64_t>(slot.words[i]).store(words[i], std::memory_order_relaxed);
+        }
+        // Published last: a reader that sees the new head also sees the whole record
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    uint64_t recorded() const
+    {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    // The latest min(recorded, capacity - 1) records, oldest first (fewer if the writer laps the copy).
+    // The slot the writer fills next is never returned: it may be mid-write.
+    std::vector<OrderTraceRecord> snapshot() const;
+
+    // Appends one chunk (header + snapshot) for this engine to out; returns the records written
+    std::size_t dump(std::ostream &out, uint32_t engine) const;
+
+    // Reads every chunk in the stream. Throws std::runtime_error on a bad magic, version or size.
+    static std::vector<OrderTraceChunk> readChunks(std::istream &in);
+
+  private:
+    static constexpr std::size_t WORDS = sizeof(OrderTraceRecord) / sizeof(uint64_t);
+    using Words = std::array<uint64_t, WORDS>;
+
+    // Plain words, only ever accessed through std::atomic_ref so readers may race the writer
+    struct alignas(64) Slot
+    {
+        uint64_t words[WORDS];
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+};
+
+} // namespace hft
@@ -0,0 +1,215 @@
+#include "sharded_matching_engine.hpp"
+#include "utils/thread_pinning.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace hft
+{
+
+ShardedMatchingEngine::ShardedMatchingEngine(OrderBookRegistry &registry, std::size_t shardCount,
+                                             IdleStrategyType idleType)
+{
+    if (shardCount == 0)
+    {
+        throw std::runtime_error("ShardedMatchingEngine: at least one shard is required");
+    }
+
+    shards_.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i)
+    {
+        shards_.push_back(std::make_unique<Shard>(registry, idleType));
+        shards_.back()->engine.setOwnedSymbols(i, shardCount);
+    }
+}
+
+ShardedMatchingEngine::~ShardedMatchingEngine()
+{
+    stop();
+}
+
+void ShardedMatchingEngine::start(const std::vector<int> &cores)
+{
+    if (running_.exchange(true))
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+    {
+        const int core = i < cores.size() ? cores[i] : -1;
+        Shard &shard = *shards_[i];
+        shard.worker = std::thread(
+            [this, &shard, core]()
+            {
+                if (core >= 0)
+                {
+                    pinToCore(core);
+                }
+                shard.engine.run(running_);
+            });
+    }
+}
+
+void ShardedMatchingEngine::stop()
+{
+    running_.store(false, std::memory_order_relaxed);
+    for (auto &shard : shards_)
+    {
+        if (shard->worker.joinable())
+        {
+            // Parked workers notice running_ within one park timeout; wake them to exit now
+            shard->engine.getIdleStrategy().wake();
+            shard->worker.join();
+        }
+    }
+}
+
+void ShardedMatchingEngine::setExecutionReportSink(ExecutionReportSink *sink)
+{
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+    {
+        shards_[i]->engine.setExecutionReportSink(sink, i);
+    }
+}
+
+void ShardedMatchingEngine::enableOrderTrace(std::size_t capacity)
+{
+    for (auto &shard : shards_)
+    {
+        shard->engine.enableOrderTrace(capacity);
+    }
+}
+
+void ShardedMatchingEngine::enableJitterDetector(std::chrono::nanoseconds threshold)
+{
+    for (auto &shard : shards_)
+    {
+        shard->engine.enableJitterDetector(threshold);
+    }
+}
+
+void ShardedMatchingEngine::setStatusInterval(std::chrono::microseconds interval)
+{
+    for (auto &shard : shards_)
+    {
+        shard->engine.setStatusInterval(interval);
+    }
+}
+
+void ShardedMatchingEngine::submit(const Order &order)
+{
+    Shard &shard = *shards_[shardFor(order.symbol)];
+    auto tryPush = [&]()
+    {
+        while (shard.producerLock.exchange(true, std::memory_order_acquire))
+        {
+            cpuRelax();
+        }
+        const bool pushed = shard.queue.push(order);
+        shard.producerLock.store(false, std::memory_order_release);
+        return pushed;
+    };
+
+    if (!tryPush())
+    {
+        // Ring full: same escalation as the gateway's single-queue path. The lock is not held while
+        // backing off, so other producers to this shard back off too instead of spinning on it; each
+        // producer only retries its own order, so per-producer order still holds.
+        IdleStrategy fullQueueBackoff(IdleStrategyType::Backoff);
+        do
+        {
+            fullQueueBackoff.idle([]() { return false; });
+        } while (!tryPush());
+    }
+
+    shard.engine.getIdleStrategy().wake();
+}
+
+std::size_t ShardedMatchingEngine::getShardCount() const
+{
+    return shards_.size();
+}
+
+const MatchingEngine &ShardedMatchingEngine::getShard(std::size_t shard) const
+{
+    return shards_.at(shard)->engine;
+}
+
+uint64_t ShardedMatchingEngine::getOrderCount() const
+{
+    uint64_t total = 0;
+    for (const auto &shard : shards_)
+    {
+        total += shard->engine.getMetrics().getOrderCount();
+    }
+    return total;
+}
+
+uint64_t ShardedMatchingEngine::getTradeCount() const
+{
+    uint64_t total = 0;
+    for (const auto &shard : shards_)
+    {
+        total += shard->engine.getMetrics().getTradeCount();
+    }
+    return total;
+}
+
+uint64_t ShardedMatchingEngine::getUnroutedOrderCount() const
+{
+    uint64_t total = 0;
+    for (const auto &shard : shards_)
+    {
+        total += shard->engine.getUnroutedOrderCount();
+    }
+    return total;
+}
+
+template <typename Getter> LatencyStats ShardedMatchingEngine::mergeStats(Getter getter) const
+{
+    LatencyHistogram::Snapshot merged;
+    for (const auto &shard : shards_)
+    {
+        (shard->engine.getMetrics().*getter)().addTo(merged);
+    }
+    return merged.stats();
+}
+
+LatencyStats ShardedMatchingEngine::getStats() const
+{
+    return mergeStats(&MetricsCollector::getLatencyRecorder);
+}
+
+LatencyStats ShardedMatchingEngine::getNetworkStats() const
+{
+    return mergeStats(&MetricsCollector::getNetworkRecorder);
+}
+
+LatencyStats ShardedMatchingEngine::getEngineStats() const
+{
+    return mergeStats(&MetricsCollector::getEngineRecorder);
+}
+
+LatencyStats ShardedMatchingEngine::getQueueStats() const
+{
+    return mergeStats(&MetricsCollector::getQueueRecorder);
+}
+
+EngineStatus ShardedMatchingEngine::getStatus() const
+{
+    EngineStatus total;
+    total.publishedNs = UINT64_MAX;
+    for (const auto &shard : shards_)
+    {
+        const EngineStatus status = shard->engine.getStatus();
+        total.publishedNs = std::min(total.publishedNs, status.publishedNs);
+        total.orders += status.orders;
+        total.trades += status.trades;
+        total.unrouted += status.unrouted;
+        total.queueDepth += status.queueDepth;
+        total.bookDepth += status.bookDepth;
+    }
+    return total;
+}
+
+} // namespace hft
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "core/order.hpp"
+#include "matching_engine.hpp"
+#include "metrics_collector.hpp"
+#include "order_book_registry.hpp"
+#include "utils/idle_strategy.hpp"
+#include "utils/lock_free_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief Runs N MatchingEngine instances in parallel, one per symbol partition.
+ *
+ * Symbols are assigned to shards by symbol % shardCount. SymbolIds are dense and the most
+ * popular instruments have the lowest ids, so the hottest books land on different shards.
+ * Each shard owns an SPSC input ring and a worker thread (optionally pinned) running the
+ * unmodified MatchingEngine::run loop. A book is only ever touched by its shard's thread.
+ *
+ * submit() may be called from several gateway threads at once. A per-shard spin lock keeps each
+ * ring single-producer. It is uncontended when one thread feeds the engine.
+ */
+class ShardedMatchingEngine
+{
+  public:
+    // The registry must outlive the engine; every shard sees all books but only receives its own symbols.
+    ShardedMatchingEngine(OrderBookRegistry &registry, std::size_t shardCount,
+                          IdleStrategyType idleType = IdleStrategyType::BusySpin);
+    ~ShardedMatchingEngine();
+
+    ShardedMatchingEngine(const ShardedMatchingEngine &) = delete;
+    ShardedMatchingEngine &operator=(const ShardedMatchingEngine &) = delete;
+
+    // Spawns one worker per shard; shard i is pinned to cores[i] when provided (-1 = unpinned)
+    void start(const std::vector<int> &cores = {});
+
+    // Stops the workers after they drain their rings
+    void stop();
+
+    // Every shard publishes to the sink with its shard index as the producer. Call before start().
+    void setExecutionReportSink(ExecutionReportSink *sink);
+
+    // Gives every shard its own OrderTraceRing of `capacity` orders. Call before start().
+    void enableOrderTrace(std::size_t capacity);
+
+    // Gives every shard its own JitterDetector (MatchingEngine::enableJitterDetector). Call before start().
+    void enableJitterDetector(std::chrono::nanoseconds threshold);
+
+    // Every shard publishes its EngineStatus at this interval (MatchingEngine::setStatusInterval)
+    void setStatusInterval(std::chrono::microseconds interval);
+
+    std::size_t shardFor(SymbolId symbol) const
+    {
+        return symbol % shards_.size();
+    }
+
+    // Routes the order to its shard. Spins with backoff while that shard's ring is full.
+    void submit(const Order &order);
+
+    std::size_t getShardCount() const;
+    const MatchingEngine &getShard(std::size_t shard) const;
+
+    // Aggregates across shards; latency stats come from the shards' histograms merged bucket by bucket
+    uint64_t getOrderCount() const;
+    uint64_t getTradeCount() const;
+    uint64_t getUnroutedOrderCount() const;
+    LatencyStats getStats() const;
+    LatencyStats getNetworkStats() const;
+    LatencyStats getEngineStats() const;
+    LatencyStats getQueueStats() const;
+
+    // Shards' published statuses summed; publishedNs is the oldest shard's
+    EngineStatus getStatus() const;
+
+  private:
+    struct Shard
+    {
+        Shard(OrderBookRegistry &registry, IdleStrategyType idleType) : engine(queue, registry, idleType)
+        {
+        }
+
+        LockFreeQueue<Order, 1024> queue;
+        MatchingEngine engine;
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> producerLock{false};
+        std::thread worker;
+    };
+
+    template <typename Getter> LatencyStats mergeStats(Getter getter) const;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<bool> running_{false};
+};
+
+} // namespace hft
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief Interns instrument names (FIX tag 55) into dense SymbolIds.
+ *
+ * Symbols are registered at startup, before the gateway starts accepting clients.
+ * After that the table is read-only, so concurrent find() calls from gateway threads
+ * need no locking. Ids are assigned 0..N-1 in registration order, which lets the
+ * matching engine index its books with a plain array.
+ *
+ * Each symbol also carries its implied price decimals, the FIX Price(44) precision its integer
+ * ticks are counted in (2 means 101.25 arrives as 10125 ticks). New symbols default to 0, so
+ * prices are whole ticks unless configured otherwise.
+ */
+class SymbolTable
+{
+  public:
+    static constexpr SymbolId DEFAULT_SYMBOL = 0;
+    static constexpr SymbolId INVALID_SYMBOL = std::numeric_limits<SymbolId>::max();
+    static constexpr uint8_t MAX_PRICE_DECIMALS = 9; // 10^9 ticks per unit still leaves 10 integer digits
+
+    // Synthetic instruments used by the benchmark generators and mock clients: SYM0, SYM1, ...
+    static constexpr std::string_view SYNTHETIC_PREFIX = "SYM";
+
+    static std::string syntheticName(SymbolId id)
+    {
+        return std::string(SYNTHETIC_PREFIX) + std::to_string(id);
+    }
+
+    // Builds a table with SYM0..SYM{count-1}, so SymbolId i is named "SYM<i>"
+    static SymbolTable makeSynthetic(std::size_t count, uint8_t priceDecimals = 0)
+    {
+        SymbolTable table;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            table.setPriceDecimals(table.intern(syntheticName(static_cast<SymbolId>(i))), priceDecimals);
+        }
+        return table;
+    }
+
+    // Setup-time only: returns the existing id when the name is already registered.
+    SymbolId intern(std::string_view name)
+    {
+        if (name.empty())
+        {
+            throw std::runtime_error("SymbolTable: empty symbol name");
+        }
+
+        auto existing = ids_.find(name);
+        if (existing != ids_.end())
+        {
+            return existing->second;
+        }
+
+        if (names_.size() >= INVALID_SYMBOL)
+        {
+            throw std::runtime_error("SymbolTable: symbol id space exhausted");
+        }
+
+        const SymbolId id = static_cast<SymbolId>(names_.size());
+        names_.emplace_back(name);
+        priceDecimals_.push_back(0);
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    // Hot path: heterogeneous lookup straight from the FIX buffer, no std::string temporary.
+    SymbolId find(std::string_view name) const
+    {
+        auto it = ids_.find(name);
+        return it == ids_.end() ? INVALID_SYMBOL : it->second;
+    }
+
+    // Setup-time only, like intern()
+    void setPriceDecimals(SymbolId id, uint8_t decimals)
+    {
+        if (id >= names_.size())
+        {
+            throw std::runtime_error("SymbolTable: unknown symbol id " + std::to_string(id));
+        }
+        if (decimals > MAX_PRICE_DECIMALS)
+        {
+            throw std::runtime_error("SymbolTable: at most " + std::to_string(MAX_PRICE_DECIMALS) +
+                                     " price decimals");
+        }
+        priceDecimals_[id] = decimals;
+    }
+
+    uint8_t priceDecimals(SymbolId id) const
+    {
+        return id < priceDecimals_.size() ? priceDecimals_[id] : 0;
+    }
+
+    std::string_view name(SymbolId id) const
+    {
+        return id < names_.size() ? std::string_view(names_[id]) : std::string_view{};
+    }
+
+    std::size_t size() const
+    {
+        return names_.size();
+    }
+
+  private:
+    struct NameHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    std::vector<std::string> names_;
+    std::vector<uint8_t> priceDecimals_; // Indexed by SymbolId
+    std::unordered_map<std::string, SymbolId, NameHash, std::equal_to<>> ids_;
+};
+
+} // namespace hft
@@ -1,17 +1,32 @@
 #include "core/matching_engine.hpp"
 #include "core/order_book_factory.hpp"
+#include "core/order_book_registry.hpp"
+#include "core/sharded_matching_engine.hpp"
+#include "core/symbol_table.hpp"
+#include "network/execution_report_writer.hpp"
+#include "network/metrics_publisher.hpp"
 #include "network/tcp_order_gateway.hpp"
+#include "utils/idle_strategy.hpp"
 #include "utils/lock_free_queue.hpp"
 #include "utils/thread_pinning.hpp"
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <chrono>
 #include <csignal>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace hft;
 
 std::atomic<bool> isApplicationRunning{true};
+std::atomic<bool> isTraceDumpRequested{false};
 
 void signalHandler(int signum)
 {
@@ -19,18 +34,93 @@ void signalHandler(int signum)
     isApplicationRunning.store(false, std::memory_order_relaxed);
 }
 
+void traceSignalHandler(int)
+{
+    isTraceDumpRequested.store(true, std::memory_order_relaxed);
+}
+
+// Rewrites path with one chunk per engine; the engines may keep running meanwhile
+void dumpOrderTraces(const std::string &path, const std::vector<const OrderTraceRing *> &traces)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    uint64_t records = 0;
+    for (size_t engine = 0; engine < traces.size(); ++engine)
+    {
+        records += traces[engine]->dump(out, static_cast<uint32_t>(engine));
+    }
+    if (!out)
+    {
+        std::cerr << "Warning: Failed to write order trace to " << path << std::endl;
+        return;
+    }
+    std::cout << "Order trace: " << records << " orders written to " << path << std::endl;
+}
+
 void printUsage()
 {
     std::cout << "Usage: hft_exchange_server [options]\n"
               << "Options:\n"
               << "  --book <map|array|vector|hybrid|pool>  (default: map)\n"
               << "  --port <number>                        (default: 12345)\n"
-              << "  --pin-core <id>                        (optional: pin matching thread)\n"
+              << "  --transport <tcp|unix|shm>             (default: tcp; unix/shm listen on --socket-path)\n"
+              << "  --socket-path <path>                   (default: /tmp/hft-gateway-<port>.sock)\n"
+              << "  --pin-core <id>                        (optional: pin matching thread; shard i -> core id+i)\n"
+              << "  --idle <spin|pause|backoff|park>       (default: spin; engine wait strategy when idle)\n"
+              << "  --symbols <count>                      (default: 1; instruments SYM0..SYM<n-1>, one book each)\n"
+              << "  --price-decimals <n>                   (default: 0; implied decimals of Price(44), 2 = cents)\n"
+              << "  --book-capacity <orders>               (optional: per-book pool size, scales with symbols)\n"
+              << "  --shards <count>                       (default: 1; engine threads, symbols split by id % count)\n"
+              << "  --parser-threads <count>               (default: 0 = parse on client threads; N = pool)\n"
+              << "  --gateway <threaded|epoll|io_uring>    (default: threaded; others = one event loop)\n"
+              << "  --gateway-core <id>                    (optional: pin the event loop thread)\n"
+              << "  --busy-poll                            (event loop polls for completions instead of sleeping)\n"
+              << "  --exec-reports                         (send acks/fills back to clients as FIX 35=8)\n"
+              << "  --fix-validate                         (reject FIX frames with a wrong BodyLength or CheckSum)\n"
+              << "  --fix-session                          (require Logon, check MsgSeqNum, heartbeats and resends)\n"
+              << "  --trace <file>                         (optional: per-order trace, dumped on SIGUSR1 and exit)\n"
+              << "  --trace-capacity <orders>              (default: 65536; last orders kept per engine thread)\n"
+              << "  --jitter-threshold-us <us>             (optional: report engine idle stalls above this)\n"
+              << "  --metrics-port <port>                  (optional: live metrics over HTTP, Prometheus text format)\n"
+              << "  --metrics-file <path>                  (optional: live metrics in a mapped file, /dev/shm/...)\n"
+              << "  --metrics-interval-ms <ms>             (default: 100; how often engines and publisher refresh)\n"
               << "  --csv_out <filename>                   (optional: append final stats row)\n"
               << "  --list_books                           (list all supported order book types and exit)\n"
               << "  --help                                 (show this help and exit)\n";
 }
 
+// Stalls of each engine thread's idle spin, and how many slow orders waited through one
+void printJitterReports(const std::vector<const JitterDetector *> &detectors)
+{
+    if (detectors.empty())
+    {
+        return;
+    }
+    std::cout << "--- Engine Jitter (idle spin gaps > " << std::fixed << std::setprecision(1)
+              << static_cast<double>(detectors.front()->getReport().thresholdNs) / 1000.0 << " us) ---" << std::endl;
+    for (size_t engine = 0; engine < detectors.size(); ++engine)
+    {
+        const JitterReport report = detectors[engine]->getReport();
+        std::cout << "  Engine " << engine << ": " << report.stalls << " stalls, "
+                  << static_cast<double>(report.stallNs) / 1000.0 << " us total, max "
+                  << static_cast<double>(report.maxStallNs) / 1000.0 << " us, " << std::setprecision(3)
+                  << report.stalledPct() << "% of " << std::setprecision(1)
+                  << static_cast<double>(report.observedNs) / 1e6 << " ms watched" << std::endl;
+        std::cout << "    Orders over the threshold: " << report.outliers << " (" << report.outliersInStall
+                  << " arrived before a stall ended)" << std::endl;
+
+        // The largest of the recent stalls, with when they ended, to line up with client-side logs
+        std::vector<JitterEvent> events = detectors[engine]->getEvents();
+        std::sort(events.begin(), events.end(),
+                  [](const JitterEvent &a, const JitterEvent &b) { return a.gapNs > b.gapNs; });
+        events.resize(std::min<size_t>(events.size(), 3));
+        for (const JitterEvent &event : events)
+        {
+            std::cout << "    " << static_cast<double>(event.gapNs) / 1000.0 << " us ending at " << event.endNs
+                      << " ns" << std::endl;
+        }
+    }
+}
+
 /**
  * Currently tests map order book
  */
@@ -38,11 +128,32 @@ int main(int argc, char *argv[])
 {
     // Register signal handler for graceful shutdown
     signal(SIGINT, signalHandler);
+    signal(SIGUSR1, traceSignalHandler);
 
     int port = 12345;
+    std::string transportName = "tcp";
+    std::string socketPath;
     int pinCore = -1;
     std::string bookType = "map";
     std::string csvOut = "";
+    std::string idleName = "spin";
+    size_t symbolCount = 1;
+    unsigned long priceDecimals = 0;
+    Index bookCapacity = 0;
+    size_t shardCount = 1;
+    size_t parserThreads = 0;
+    std::string gatewayName = "threaded";
+    int gatewayCore = -1;
+    bool busyPoll = false;
+    bool execReports = false;
+    bool fixValidate = false;
+    bool fixSession = false;
+    std::string tracePath;
+    size_t traceCapacity = 65536;
+    int metricsPort = -1;
+    std::string metricsFile;
+    long metricsIntervalMs = 100;
+    double jitterThresholdUs = 0.0;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -66,6 +177,14 @@ int main(int argc, char *argv[])
         {
             port = std::stoi(argv[++i]);
         }
+        else if (arg == "--transport" && i + 1 < argc)
+        {
+            transportName = argv[++i];
+        }
+        else if (arg == "--socket-path" && i + 1 < argc)
+        {
+            socketPath = argv[++i];
+        }
         else if (arg == "--book" && i + 1 < argc)
         {
             bookType = argv[++i];
@@ -78,6 +197,78 @@ int main(int argc, char *argv[])
         {
             csvOut = argv[++i];
         }
+        else if (arg == "--idle" && i + 1 < argc)
+        {
+            idleName = argv[++i];
+        }
+        else if (arg == "--symbols" && i + 1 < argc)
+        {
+            symbolCount = std::stoul(argv[++i]);
+        }
+        else if (arg == "--price-decimals" && i + 1 < argc)
+        {
+            priceDecimals = std::stoul(argv[++i]);
+        }
+        else if (arg == "--book-capacity" && i + 1 < argc)
+        {
+            bookCapacity = std::stoul(argv[++i]);
+        }
+        else if (arg == "--shards" && i + 1 < argc)
+        {
+            shardCount = std::stoul(argv[++i]);
+        }
+        else if (arg == "--parser-threads" && i + 1 < argc)
+        {
+            parserThreads = std::stoul(argv[++i]);
+        }
+        else if (arg == "--gateway" && i + 1 < argc)
+        {
+            gatewayName = argv[++i];
+        }
+        else if (arg == "--gateway-core" && i + 1 < argc)
+        {
+            gatewayCore = std::stoi(argv[++i]);
+        }
+        else if (arg == "--busy-poll")
+        {
+            busyPoll = true;
+        }
+        else if (arg == "--exec-reports")
+        {
+            execReports = true;
+        }
+        else if (arg == "--fix-validate")
+        {
+            fixValidate = true;
+        }
+        else if (arg == "--fix-session")
+        {
+            fixSession = true;
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (arg == "--trace-capacity" && i + 1 < argc)
+        {
+            traceCapacity = std::stoul(argv[++i]);
+        }
+        else if (arg == "--jitter-threshold-us" && i + 1 < argc)
+        {
+            jitterThresholdUs = std::stod(argv[++i]);
+        }
+        else if (arg == "--metrics-port" && i + 1 < argc)
+        {
+            metricsPort = std::stoi(argv[++i]);
+        }
+        else if (arg == "--metrics-file" && i + 1 < argc)
+        {
+            metricsFile = argv[++i];
+        }
+        else if (arg == "--metrics-interval-ms" && i + 1 < argc)
+        {
+            metricsIntervalMs = std::stol(argv[++i]);
+        }
         else
         {
             std::cerr << "Error: Unknown or incomplete option: " << arg << "\n";
@@ -91,48 +282,339 @@ int main(int argc, char *argv[])
 
     try
     {
-        auto orderBook = OrderBookFactory::create(bookType);
+        const IdleStrategyType idleType = IdleStrategy::fromString(idleName);
+        std::cout << "Engine idle strategy: " << IdleStrategy::toString(idleType) << std::endl;
+        std::cout << "Metrics backend: " << metricsBackendToString(MetricsCollector::BACKEND) << std::endl;
+        if (TscClock::calibrate().usesTsc)
+        {
+            std::cout << "Timer: invariant TSC at " << std::fixed << std::setprecision(3)
+                      << TscClock::calibrate().ticksPerNs << " GHz" << std::endl;
+        }
+        else
+        {
+            std::cout << "Timer: steady_clock (no invariant TSC)" << std::endl;
+        }
+
+        // Symbols are interned before the gateway starts, so lookups on client threads are read-only.
+        // Pool books preallocate, so with many instruments each gets a share of the default 1M-order pool.
+        if (symbolCount == 0)
+        {
+            throw std::runtime_error("--symbols must be at least 1");
+        }
+        if (priceDecimals > SymbolTable::MAX_PRICE_DECIMALS)
+        {
+            throw std::runtime_error("--price-decimals must be at most " +
+                                     std::to_string(SymbolTable::MAX_PRICE_DECIMALS));
+        }
+        const SymbolTable symbols = SymbolTable::makeSynthetic(symbolCount, static_cast<uint8_t>(priceDecimals));
+        if (bookCapacity == 0 && symbolCount > 1)
+        {
+            bookCapacity = std::max<Index>(4096, 1000000 / symbolCount);
+        }
+        std::cout << "Instruments: " << symbols.size() << " (" << symbols.name(0)
+                  << (symbols.size() > 1 ? " .. " + std::string(symbols.name(symbols.size() - 1)) : "") << ")"
+                  << std::endl;
+        if (priceDecimals > 0)
+        {
+            std::cout << "Price decimals: " << priceDecimals << " (Price(44) is converted to integer ticks)"
+                      << std::endl;
+        }
+
+        if (shardCount == 0)
+        {
+            throw std::runtime_error("--shards must be at least 1");
+        }
+
+        OrderBookRegistry books(bookType, symbols.size(), bookCapacity);
         LockFreeQueue<Order, 1024> orderQueue;
         TCPOrderGateway gateway(port, orderQueue);
-        MatchingEngine engine(orderQueue, *orderBook);
+        gateway.setSymbolTable(&symbols);
+        gateway.setParserThreads(parserThreads);
+        if (parserThreads > 0)
+        {
+            std::cout << "Gateway parser pool: " << parserThreads << " workers" << std::endl;
+        }
 
-        // Link metrics to gateway so it can report stats to clients
-        gateway.setMetricsCollector(&engine.getMetrics());
+        const GatewayMode gatewayMode = TCPOrderGateway::modeFromString(gatewayName);
+        gateway.setMode(gatewayMode);
+        gateway.setTransport(TransportEndpoint::kindFromString(transportName), socketPath);
+        std::cout << "Transport: " << gateway.getEndpoint().describe() << std::endl;
+        gateway.setEventLoopCore(gatewayCore);
+        gateway.setBusyPoll(busyPoll);
+        gateway.setFixValidation(fixValidate);
+        if (fixValidate)
+        {
+            std::cout << "FIX validation: BodyLength and CheckSum enforced" << std::endl;
+        }
+        gateway.setFixSession(fixSession);
+        if (fixSession)
+        {
+            std::cout << "FIX session: Logon required, MsgSeqNum checked" << std::endl;
+        }
+        std::cout << "Gateway mode: " << TCPOrderGateway::modeToString(gatewayMode);
+        if (gatewayMode != GatewayMode::Threaded)
+        {
+            std::cout << (busyPoll ? " (busy poll)" : "")
+                      << (gatewayCore >= 0 ? ", event loop on core " + std::to_string(gatewayCore) : "");
+        }
+        std::cout << std::endl;
 
-        // Start Gateway to start accepting clients
-        std::cout << "Starting TCP Gateway on port " << port << "..." << std::endl;
-        gateway.start();
+        // One outbound ring per engine thread per client; the writer waits the same way the engine does
+        std::unique_ptr<ExecutionReportWriter> reportWriter;
+        if (execReports)
+        {
+            reportWriter = std::make_unique<ExecutionReportWriter>(shardCount, idleType);
+            gateway.setExecutionReportWriter(reportWriter.get());
+            reportWriter->start();
+            std::cout << "Execution reports: enabled" << std::endl;
+        }
 
-        // Start Matching Engine Loop
-        if (pinCore >= 0)
+        if (!tracePath.empty())
         {
-            if (hft::pinToCore(pinCore))
+            if (traceCapacity == 0)
             {
-                std::cout << "Matching Engine thread pinned to core " << pinCore << "." << std::endl;
+                throw std::runtime_error("--trace-capacity must be at least 1");
             }
-            else
+            std::cout << "Order trace: " << std::bit_ceil(std::max<size_t>(traceCapacity, 2))
+                      << "-slot ring per engine thread -> " << tracePath << " (kill -USR1 " << getpid()
+                      << " to dump now)" << std::endl;
+        }
+        // Polls for SIGUSR1 off the engine thread, which may be this one (single engine)
+        std::vector<const OrderTraceRing *> traces;
+        std::thread traceDumper;
+        const auto startTraceDumper = [&]()
+        {
+            if (traces.empty())
+            {
+                return;
+            }
+            traceDumper = std::thread(
+                [&]()
+                {
+                    while (isApplicationRunning.load(std::memory_order_relaxed))
+                    {
+                        if (isTraceDumpRequested.exchange(false, std::memory_order_relaxed))
+                        {
+                            dumpOrderTraces(tracePath, traces);
+                        }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    }
+                });
+        };
+        const auto stopTraceDumper = [&]()
+        {
+            if (traceDumper.joinable())
+            {
+                traceDumper.join();
+                dumpOrderTraces(tracePath, traces); // Engines are stopped: the final dump is complete
+            }
+        };
+
+        // Live metrics: engines publish their status, a publisher thread serves it with the histograms
+        const bool liveMetrics = metricsPort >= 0 || !metricsFile.empty();
+        if (liveMetrics && metricsIntervalMs <= 0)
+        {
+            throw std::runtime_error("--metrics-interval-ms must be positive");
+        }
+        const std::chrono::milliseconds metricsInterval(metricsIntervalMs);
+        std::unique_ptr<MetricsPublisher> metricsPublisher;
+        const auto startMetricsPublisher = [&](MetricsPublisher::Collect collect)
+        {
+            metricsPublisher = std::make_unique<MetricsPublisher>(std::move(collect), metricsInterval);
+            metricsPublisher->setHttpPort(metricsPort);
+            if (!metricsFile.empty())
+            {
+                metricsPublisher->setSharedFile(metricsFile);
+            }
+            metricsPublisher->start();
+            std::cout << "Live metrics every " << metricsIntervalMs << " ms:"
+                      << (metricsPort >= 0 ? " http://localhost:" + std::to_string(metricsPublisher->getHttpPort())
+                                           : "")
+                      << (metricsFile.empty() ? "" : " " + metricsFile) << std::endl;
+        };
+
+        // Engines watch their idle spin for stalls; backoff and park sleep, so most of their idle time is unseen
+        const auto jitterThreshold = std::chrono::nanoseconds(static_cast<int64_t>(jitterThresholdUs * 1000.0));
+        if (jitterThresholdUs != 0.0)
+        {
+            if (jitterThreshold.count() <= 0)
+            {
+                throw std::runtime_error("--jitter-threshold-us must be positive");
+            }
+            std::cout << "Jitter detector: idle gaps > " << jitterThresholdUs << " us" << std::endl;
+            if (idleType == IdleStrategyType::Backoff || idleType == IdleStrategyType::Park)
             {
-                std::cerr << "Warning: Failed to pin thread to core " << pinCore << "." << std::endl;
+                std::cerr << "Warning: --idle " << idleName
+                          << " sleeps when idle; the jitter detector only sees the polls in between." << std::endl;
             }
         }
-        else
+        std::vector<const JitterDetector *> jitters;
+
+        LatencyStats stats;
+        uint64_t ordersProcessed = 0;
+        uint64_t tradesExecuted = 0;
+        uint64_t unroutedOrders = 0;
+
+        if (shardCount > 1)
         {
-            std::cout << "Matching Engine thread pinning disabled." << std::endl;
+            // One engine thread per symbol partition; this thread only waits for shutdown.
+            ShardedMatchingEngine engine(books, shardCount, idleType);
+            gateway.setShardedEngine(&engine);
+            engine.setExecutionReportSink(reportWriter.get());
+            if (!tracePath.empty())
+            {
+                engine.enableOrderTrace(traceCapacity);
+                for (size_t shard = 0; shard < shardCount; ++shard)
+                {
+                    traces.push_back(engine.getShard(shard).getOrderTrace());
+                }
+            }
+            if (jitterThreshold.count() > 0)
+            {
+                engine.enableJitterDetector(jitterThreshold);
+                for (size_t shard = 0; shard < shardCount; ++shard)
+                {
+                    jitters.push_back(engine.getShard(shard).getJitterDetector());
+                }
+            }
+
+            if (liveMetrics)
+            {
+                engine.setStatusInterval(metricsInterval);
+                startMetricsPublisher([&engine, shardCount]()
+                                      { return makeMetricsSnapshot(engine.getStatus(), shardCount, engine); });
+            }
+
+            std::vector<int> cores;
+            if (pinCore >= 0)
+            {
+                for (size_t shard = 0; shard < shardCount; ++shard)
+                {
+                    cores.push_back(pinCore + static_cast<int>(shard));
+                }
+                std::cout << "Shard threads pinned to cores " << pinCore << ".." << cores.back() << "." << std::endl;
+            }
+
+            std::cout << "Starting Gateway on " << gateway.getEndpoint().describe() << "..." << std::endl;
+            gateway.start();
+            std::cout << "Starting " << shardCount << " Matching Engine shards..." << std::endl;
+            engine.start(cores);
+            startTraceDumper();
+
+            while (isApplicationRunning.load(std::memory_order_relaxed))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+
+            // Cleanup: stop producers before the shards they feed
+            gateway.stop();
+            engine.stop();
+            stopTraceDumper();
+            metricsPublisher.reset();
+
+            stats = toNanoseconds(engine.getStats());
+            ordersProcessed = engine.getOrderCount();
+            tradesExecuted = engine.getTradeCount();
+            unroutedOrders = engine.getUnroutedOrderCount();
+            for (size_t shard = 0; shard < shardCount; ++shard)
+            {
+                std::cout << "Shard " << shard << ": " << engine.getShard(shard).getMetrics().getOrderCount()
+                          << " orders" << std::endl;
+            }
+            printJitterReports(jitters); // Before the engine and its detectors go away
         }
-        std::cout << "Starting Matching Engine Loop..." << std::endl;
-        engine.run(isApplicationRunning);
+        else
+        {
+            MatchingEngine engine(orderQueue, books, idleType);
+
+            // Link metrics to gateway so it can report stats to clients
+            gateway.setMetricsCollector(&engine.getMetrics());
+            // Gateway wakes the engine after each push when it parks between orders
+            gateway.setIdleStrategy(&engine.getIdleStrategy());
+            engine.setExecutionReportSink(reportWriter.get());
+            if (!tracePath.empty())
+            {
+                engine.enableOrderTrace(traceCapacity);
+                traces.push_back(engine.getOrderTrace());
+            }
+            if (jitterThreshold.count() > 0)
+            {
+                engine.enableJitterDetector(jitterThreshold);
+                jitters.push_back(engine.getJitterDetector());
+            }
+            if (liveMetrics)
+            {
+                engine.setStatusInterval(metricsInterval);
+                startMetricsPublisher([&engine]()
+                                      { return makeMetricsSnapshot(engine.getStatus(), 1, engine.getMetrics()); });
+            }
+
+            // Start Gateway to start accepting clients
+            std::cout << "Starting Gateway on " << gateway.getEndpoint().describe() << "..." << std::endl;
+            gateway.start();
+
+            // Start Matching Engine Loop
+            if (pinCore >= 0)
+            {
+                if (hft::pinToCore(pinCore))
+                {
+                    std::cout << "Matching Engine thread pinned to core " << pinCore << "." << std::endl;
+                }
+                else
+                {
+                    std::cerr << "Warning: Failed to pin thread to core " << pinCore << "." << std::endl;
+                }
+            }
+            else
+            {
+                std::cout << "Matching Engine thread pinning disabled." << std::endl;
+            }
+            std::cout << "Starting Matching Engine Loop..." << std::endl;
+            startTraceDumper();
+            engine.run(isApplicationRunning);
 
-        // Cleanup
-        gateway.stop();
+            // Cleanup
+            gateway.stop();
+            stopTraceDumper();
+            metricsPublisher.reset();
+
+            stats = toNanoseconds(engine.getMetrics().getStats());
+            ordersProcessed = engine.getMetrics().getOrderCount();
+            tradesExecuted = engine.getMetrics().getTradeCount();
+            unroutedOrders = engine.getUnroutedOrderCount();
+            printJitterReports(jitters);
+        }
 
         std::cout << "=== Final Statistics ===" << std::endl;
-        auto stats = engine.getMetrics().getStats();
-        std::cout << "Total Orders processed: " << engine.getMetrics().getOrderCount() << std::endl;
-        std::cout << "Total Trades executed:  " << engine.getMetrics().getTradeCount() << std::endl;
+        std::cout << "Total Orders processed: " << ordersProcessed << std::endl;
+        std::cout << "Total Trades executed:  " << tradesExecuted << std::endl;
+        if (reportWriter)
+        {
+            // Engines are stopped: nothing publishes any more
+            reportWriter->stop();
+            std::cout << "Execution reports sent: " << reportWriter->getSentCount()
+                      << " (dropped: " << reportWriter->getDroppedCount() << ")" << std::endl;
+        }
+        if (unroutedOrders > 0)
+        {
+            std::cout << "Unrouted orders:        " << unroutedOrders << std::endl;
+        }
+        if (gateway.getRejectedFrames() > 0)
+        {
+            std::cout << "Rejected FIX frames:    " << gateway.getRejectedFrames() << std::endl;
+        }
+        if (gateway.getSessionGaps() > 0)
+        {
+            std::cout << "Session gaps resent:    " << gateway.getSessionGaps() << std::endl;
+        }
         std::cout << "--- Wire-to-Match Latency ---" << std::endl;
-        std::cout << "  Mean Latency: " << std::fixed << std::setprecision(2) << stats.mean << " ticks" << std::endl;
-        std::cout << "  P99 Latency:  " << stats.p99 << " ticks" << std::endl;
-        std::cout << "  Max Latency:  " << stats.max << " ticks" << std::endl;
+        std::cout << "  Mean Latency: " << std::fixed << std::setprecision(2) << stats.mean << " ns" << std::endl;
+        std::cout << "  P50 Latency:  " << stats.p50 << " ns" << std::endl;
+        std::cout << "  P90 Latency:  " << stats.p90 << " ns" << std::endl;
+        std::cout << "  P99 Latency:  " << stats.p99 << " ns" << std::endl;
+        std::cout << "  P99.9:        " << stats.p999 << " ns" << std::endl;
+        std::cout << "  P99.99:       " << stats.p9999 << " ns" << std::endl;
+        std::cout << "  Max Latency:  " << stats.max << " ns" << std::endl;
 
         // Write stats to CSV if csvOut is specified
         if (!csvOut.empty())
@@ -147,7 +629,7 @@ int main(int argc, char *argv[])
                 outFile << "Mode,Book,Mean_ticks,P99_ticks,Max_ticks,Processed\n";
             }
             outFile << "server_wire_to_match," << bookType << "," << stats.mean << "," << stats.p99 << "," << stats.max
-                    << "," << engine.getMetrics().getOrderCount() << "\n";
+                    << "," << ordersProcessed << "\n";
         }
     }
     catch (const std::exception &e)
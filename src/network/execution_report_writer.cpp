@@ -0,0 +1,307 @@
+#include "execution_report_writer.hpp"
+#include "fix/fix_parser.hpp"
+#include "network/socket_utils.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include <sys/socket.h>
+
+namespace hft
+{
+
+namespace
+{
+constexpr ClientId SOCKET_MASK = 0xffff;
+constexpr std::size_t MAX_REPORTS_PER_ROUND = 256; // Per client, so one busy client cannot starve the rest
+} // namespace
+
+ExecutionReportWriter::ExecutionReportWriter(std::size_t producerCount, IdleStrategyType idleType)
+    : producerCount_{producerCount}, idle_(idleType)
+{
+    if (producerCount_ == 0)
+    {
+        throw std::runtime_error("ExecutionReportWriter: at least one producer is required");
+    }
+
+    slots_.reserve(MAX_SOCKETS);
+    for (std::size_t i = 0; i < MAX_SOCKETS; ++i)
+    {
+        slots_.push_back(std::make_unique<Slot>());
+    }
+}
+
+ExecutionReportWriter::~ExecutionReportWriter()
+{
+    stop();
+}
+
+void ExecutionReportWriter::start()
+{
+    if (running_.exchange(true))
+    {
+        return;
+    }
+    writer_ = std::thread(&ExecutionReportWriter::writerLoop, this);
+}
+
+void ExecutionReportWriter::stop()
+{
+    running_.store(false, std::memory_order_relaxed);
+    if (writer_.joinable())
+    {
+        idle_.wake();
+        writer_.join();
+    }
+}
+
+ClientId ExecutionReportWriter::openClient(int clientSocket)
+{
+    if (clientSocket < 0 || static_cast<std::size_t>(clientSocket) >= MAX_SOCKETS)
+    {
+        return 0;
+    }
+
+    Slot &slot = *slots_[clientSocket];
+    std::lock_guard<std::mutex> lock(slot.sendMutex);
+    if (slot.rings.empty())
+    {
+        for (std::size_t i = 0; i < producerCount_; ++i)
+        {
+            slot.rings.push_back(std::make_unique<ReportRing>());
+        }
+    }
+
+    // Generation 0 is skipped so descriptor 0 never produces ClientId 0 (= no client)
+    if (++slot.generation == 0)
+    {
+        slot.generation = 1;
+    }
+    slot.pending.clear();
+    slot.pendingOffset = 0;
+    slot.execSequence = 0;
+
+    const ClientId id = (static_cast<ClientId>(slot.generation) << 16) | static_cast<ClientId>(clientSocket);
+    slot.id.store(id, std::memory_order_release); // Publishes the rings to engines and the writer
+
+    int highest = highestSocket_.load(std::memory_order_relaxed);
+    while (clientSocket > highest && !highestSocket_.compare_exchange_weak(highest, clientSocket))
+    {
+    }
+    return id;
+}
+
+void ExecutionReportWriter::closeClient(int clientSocket)
+{
+    if (clientSocket < 0 || static_cast<std::size_t>(clientSocket) >= MAX_SOCKETS)
+    {
+        return;
+    }
+
+    Slot &slot = *slots_[clientSocket];
+    std::lock_guard<std::mutex> lock(slot.sendMutex);
+    slot.id.store(0, std::memory_order_release);
+    slot.pending.clear();
+    slot.pendingOffset = 0;
+}
+
+ClientId ExecutionReportWriter::clientId(int clientSocket) const
+{
+    if (clientSocket < 0 || static_cast<std::size_t>(clientSocket) >= MAX_SOCKETS)
+    {
+        return 0;
+    }
+    return slots_[clientSocket]->id.load(std::memory_order_relaxed);
+}
+
+bool ExecutionReportWriter::sendDirect(int clientSocket, const char *data, std::size_t length)
+{
+    if (clientSocket < 0 || static_cast<std::size_t>(clientSocket) >= MAX_SOCKETS)
+    {
+        return sendAll(clientSocket, data, length);
+    }
+
+    Slot &slot = *slots_[clientSocket];
+    std::lock_guard<std::mutex> lock(slot.sendMutex);
+    // Finish any partially written report first so the frame lands on a message boundary
+    if (slot.pendingOffset < slot.pending.size())
+    {
+        if (!sendAll(clientSocket, slot.pending.data() + slot.pendingOffset, slot.pending.size() - slot.pendingOffset))
+        {
+            return false;
+        }
+        slot.pending.clear();
+        slot.pendingOffset = 0;
+    }
+    return sendAll(clientSocket, data, length);
+}
+
+void ExecutionReportWriter::publish(std::size_t producer, const ExecutionReport &report)
+{
+    const std::size_t socketIndex = report.client & SOCKET_MASK;
+    if (socketIndex >= MAX_SOCKETS)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Slot &slot = *slots_[socketIndex];
+    // The id check also guarantees the rings exist (they are allocated before the id is published)
+    if (slot.id.load(std::memory_order_acquire) != report.client || !slot.rings[producer]->push(report))
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    idle_.wake();
+}
+
+uint64_t ExecutionReportWriter::getSentCount() const
+{
+    return sent_.load(std::memory_order_relaxed);
+}
+
+uint64_t ExecutionReportWriter::getDroppedCount() const
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void ExecutionReportWriter::writerLoop()
+{
+    while (running_.load(std::memory_order_relaxed))
+    {
+        bool didWork = false;
+        const int highest = highestSocket_.load(std::memory_order_acquire);
+        for (int clientSocket = 0; clientSocket <= highest; ++clientSocket)
+        {
+            didWork |= serviceSlot(clientSocket, *slots_[clientSocket]);
+        }
+
+        if (didWork)
+        {
+            idle_.reset();
+            continue;
+        }
+        idle_.idle([this]() { return hasQueuedReports(); });
+    }
+}
+
+bool ExecutionReportWriter::serviceSlot(int clientSocket, Slot &slot)
+{
+    // Closed slots are skipped; stale reports left in their rings are discarded on the next open
+    if (slot.id.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(slot.sendMutex);
+    const ClientId id = slot.id.load(std::memory_order_relaxed);
+    if (id == 0)
+    {
+        return false;
+    }
+
+    bool didWork = false;
+    if (slot.pending.size() - slot.pendingOffset < MAX_PENDING_BYTES)
+    {
+        ExecutionReport report;
+        for (auto &ring : slot.rings)
+        {
+            for (std::size_t n = 0; n < MAX_REPORTS_PER_ROUND && ring->pop(report); ++n)
+            {
+                if (report.client == id)
+                {
+                    format(slot, report);
+                }
+                didWork = true;
+            }
+        }
+    }
+
+    if (slot.pendingOffset < slot.pending.size())
+    {
+        didWork |= flushPending(clientSocket, slot);
+    }
+    return didWork;
+}
+
+bool ExecutionReportWriter::flushPending(int clientSocket, Slot &slot)
+{
+    // Non-blocking: whatever the socket does not take now stays pending for the next round
+    const ssize_t sent = send(clientSocket, slot.pending.data() + slot.pendingOffset,
+                              slot.pending.size() - slot.pendingOffset, MSG_DONTWAIT | SEND_FLAGS);
+    if (sent <= 0)
+    {
+        if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            // Broken connection: the gateway will notice on its read side and close it
+            slot.pending.clear();
+            slot.pendingOffset = 0;
+        }
+        return false;
+    }
+
+    slot.pendingOffset += static_cast<std::size_t>(sent);
+    if (slot.pendingOffset == slot.pending.size())
+    {
+        slot.pending.clear();
+        slot.pendingOffset = 0;
+    }
+    else if (slot.pendingOffset > slot.pending.size() / 2)
+    {
+        const auto sentEnd = slot.pending.begin() + static_cast<std::ptrdiff_t>(slot.pendingOffset);
+        slot.pending.erase(slot.pending.begin(), sentEnd);
+        slot.pendingOffset = 0;
+    }
+    return true;
+}
+
+void ExecutionReportWriter::format(Slot &slot, const ExecutionReport &report)
+{
+    // 8=FIX.4.2|9=LEN|35=8|11=ID|17=EXECID|150=0/F|54=SIDE|38=QTY|44=PX (ack) or 32=QTY|31=PX (fill)|60=TS|10=CS|
+    // TransactTime(60) on an ack echoes the order's own, so the client measures round trip without bookkeeping.
+    const bool ack = report.type == ExecType::New;
+    char body[224];
+    const int bodyLen = std::snprintf(body, sizeof(body),
+                                      "35=8\x01"
+                                      "11=%llu\x01"
+                                      "17=%llu\x01"
+                                      "150=%c\x01"
+                                      "54=%d\x01"
+                                      "%s=%llu\x01"
+                                      "%s=%llu\x01"
+                                      "60=%llu\x01",
+                                      (unsigned long long)report.orderId, (unsigned long long)++slot.execSequence,
+                                      ack ? '0' : 'F', report.side == Side::Buy ? 1 : 2, ack ? "38" : "32",
+                                      (unsigned long long)report.quantity, ack ? "44" : "31",
+                                      (unsigned long long)report.price, (unsigned long long)report.timestamp);
+    char buffer[256];
+    const std::string_view bodyView(body, bodyLen > 0 ? static_cast<size_t>(bodyLen) : 0);
+    const size_t len = bodyLen > 0 ? FIXParser::buildFrame(bodyView, buffer, sizeof(buffer)) : 0;
+    if (len > 0)
+    {
+        slot.pending.insert(slot.pending.end(), buffer, buffer + len);
+        sent_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool ExecutionReportWriter::hasQueuedReports() const
+{
+    const int highest = highestSocket_.load(std::memory_order_acquire);
+    for (int clientSocket = 0; clientSocket <= highest; ++clientSocket)
+    {
+        const Slot &slot = *slots_[clientSocket];
+        if (slot.id.load(std::memory_order_acquire) == 0)
+        {
+            continue;
+        }
+        for (const auto &ring : slot.rings)
+        {
+            if (ring->size() != 0)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace hft
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "core/execution_report.hpp"
+#include "utils/idle_strategy.hpp"
+#include "utils/lock_free_queue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief Delivers engine execution reports to clients over their gateway connections.
+ *
+ * Engines publish into per-client SPSC rings, one ring per engine thread, so the engine never takes a
+ * lock or touches a socket. A single writer thread drains every client's rings, formats the reports
+ * as FIX ExecutionReports (35=8) and sends them in one batched non-blocking send per client per round.
+ *
+ * Clients are identified by ClientId = (generation << 16) | socket descriptor. The generation changes
+ * every time a descriptor is reused, so reports still in flight for a closed connection are dropped
+ * instead of reaching the next client that gets the same descriptor.
+ *
+ * A slow client never stalls the engine: when its ring is full, reports are dropped and counted.
+ */
+class ExecutionReportWriter : public ExecutionReportSink
+{
+  public:
+    static constexpr std::size_t MAX_SOCKETS = 4096;           // Higher descriptors get no reports
+    static constexpr std::size_t RING_CAPACITY = 4096;         // Per client, per engine thread
+    static constexpr std::size_t MAX_PENDING_BYTES = 4U << 20; // Unsent bytes before draining a client pauses
+
+    // producerCount = number of engine threads that publish (shard count, 1 for a single engine)
+    explicit ExecutionReportWriter(std::size_t producerCount,
+                                   IdleStrategyType idleType = IdleStrategyType::Park);
+    ~ExecutionReportWriter();
+
+    ExecutionReportWriter(const ExecutionReportWriter &) = delete;
+    ExecutionReportWriter &operator=(const ExecutionReportWriter &) = delete;
+
+    void start();
+    void stop();
+
+    // Gateway side: register a connection before reading from it (returns 0 if it cannot get reports),
+    // and unregister it before closing the descriptor.
+    ClientId openClient(int clientSocket);
+    void closeClient(int clientSocket);
+    ClientId clientId(int clientSocket) const;
+
+    // Sends a gateway-originated frame (U2 stats) without splitting a report being written.
+    bool sendDirect(int clientSocket, const char *data, std::size_t length);
+
+    // Engine side
+    void publish(std::size_t producer, const ExecutionReport &report) override;
+
+    uint64_t getSentCount() const;
+    uint64_t getDroppedCount() const;
+
+  private:
+    using ReportRing = LockFreeQueue<ExecutionReport, RING_CAPACITY>;
+
+    struct Slot
+    {
+        std::atomic<ClientId> id{0};
+        std::vector<std::unique_ptr<ReportRing>> rings; // Allocated on first open, reused afterwards
+
+        // Guards the descriptor and the formatted-but-unsent bytes
+        std::mutex sendMutex;
+        std::vector<char> pending;
+        std::size_t pendingOffset = 0;
+        uint16_t generation = 0;
+        uint64_t execSequence = 0; // ExecID(17) counter for this connection
+    };
+
+    void writerLoop();
+    bool serviceSlot(int clientSocket, Slot &slot);
+    bool flushPending(int clientSocket, Slot &slot);
+    void format(Slot &slot, const ExecutionReport &report);
+    bool hasQueuedReports() const;
+
+    std::size_t producerCount_;
+    std::vector<std::unique_ptr<Slot>> slots_; // Indexed by socket descriptor
+    std::atomic<int> highestSocket_{-1};
+
+    IdleStrategy idle_;
+    std::atomic<bool> running_{false};
+    std::thread writer_;
+
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace hft
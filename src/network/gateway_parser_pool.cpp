@@ -0,0 +1,226 @@
+#include "gateway_parser_pool.hpp"
+#include "fix/fix_session.hpp"
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace hft
+{
+
+ClientSession::ClientSession(int clientSocket, std::size_t homeWorker, std::unique_ptr<FixSession> fixSession)
+    : socket_{clientSocket}, homeWorker_{homeWorker}, fixSession_{std::move(fixSession)}
+{
+    inbox_.reserve(64 * 1024);
+    parseBuffer_.reserve(64 * 1024);
+}
+
+ClientSession::~ClientSession()
+{
+    close(socket_);
+}
+
+std::size_t ClientSession::pendingBytes()
+{
+    std::lock_guard<std::mutex> lock(inboxMutex_);
+    return inbox_.size();
+}
+
+GatewayParserPool::GatewayParserPool(std::size_t workerCount, ParseFn parse, IdleStrategyType idleType)
+    : parse_(std::move(parse))
+{
+    if (workerCount == 0)
+    {
+        throw std::runtime_error("GatewayParserPool: at least one worker is required");
+    }
+
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        workers_.push_back(std::make_unique<Worker>(idleType));
+    }
+}
+
+GatewayParserPool::~GatewayParserPool()
+{
+    stop();
+}
+
+void GatewayParserPool::start()
+{
+    if (running_.exchange(true))
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < workers_.size(); ++i)
+    {
+        workers_[i]->thread = std::thread(&GatewayParserPool::workerLoop, this, i);
+    }
+}
+
+void GatewayParserPool::stop()
+{
+    running_.store(false, std::memory_order_relaxed);
+    for (auto &worker : workers_)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->idle.wake();
+            worker->thread.join();
+        }
+    }
+
+    // Drop sessions still queued so their sockets close with the pool
+    std::shared_ptr<ClientSession> task;
+    for (auto &worker : workers_)
+    {
+        while (worker->tasks.pop(task))
+        {
+        }
+    }
+}
+
+std::shared_ptr<ClientSession> GatewayParserPool::openSession(int clientSocket)
+{
+    return openSession(clientSocket, nullptr);
+}
+
+std::shared_ptr<ClientSession> GatewayParserPool::openSession(int clientSocket, std::unique_ptr<FixSession> fixSession)
+{
+    const std::size_t home = nextHome_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    return std::make_shared<ClientSession>(clientSocket, home, std::move(fixSession));
+}
+
+void GatewayParserPool::submit(const std::shared_ptr<ClientSession> &session, const char *data, std::size_t length)
+{
+    {
+        std::lock_guard<std::mutex> lock(session->inboxMutex_);
+        session->inbox_.insert(session->inbox_.end(), data, data + length);
+    }
+
+    // Ordered after the append: if a worker is finishing this session it either sees the new
+    // bytes on its re-check, or has already cleared scheduled_ and we queue it again here.
+    if (!session->scheduled_.exchange(true))
+    {
+        schedule(session);
+    }
+}
+
+void GatewayParserPool::schedule(const std::shared_ptr<ClientSession> &session)
+{
+    Worker &home = *workers_[session->homeWorker_];
+    home.tasks.push(session);
+    if (home.idle.wake())
+    {
+        return;
+    }
+
+    // The home worker was not parked: it may be busy with another session for a while, so hand
+    // the steal to one parked peer rather than leave this session to its futex timeout
+    const std::size_t count = workers_.size();
+    for (std::size_t offset = 1; offset < count; ++offset)
+    {
+        if (workers_[(session->homeWorker_ + offset) % count]->idle.wake())
+        {
+            return;
+        }
+    }
+}
+
+bool GatewayParserPool::hasQueuedTask() const
+{
+    for (const auto &worker : workers_)
+    {
+        if (worker->tasks.size() != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GatewayParserPool::workerLoop(std::size_t self)
+{
+    Worker &worker = *workers_[self];
+    std::shared_ptr<ClientSession> task;
+
+    while (running_.load(std::memory_order_relaxed))
+    {
+        if (worker.tasks.pop(task) || stealTask(self, task))
+        {
+            runSession(*task);
+            task.reset();
+            worker.idle.reset();
+            continue;
+        }
+
+        // Any deque: work queued behind a busy peer is ours to steal
+        worker.idle.idle([this]() { return hasQueuedTask(); });
+    }
+}
+
+bool GatewayParserPool::stealTask(std::size_t self, std::shared_ptr<ClientSession> &task)
+{
+    const std::size_t count = workers_.size();
+    for (std::size_t offset = 1; offset < count; ++offset)
+    {
+        if (workers_[(self + offset) % count]->tasks.steal(task))
+        {
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GatewayParserPool::runSession(ClientSession &session)
+{
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> lock(session.inboxMutex_);
+            session.parseBuffer_.insert(session.parseBuffer_.end(), session.inbox_.begin(), session.inbox_.end());
+            session.inbox_.clear();
+        }
+
+        if (!session.failed_.load(std::memory_order_relaxed) && !session.parseBuffer_.empty())
+        {
+            std::size_t processed = 0;
+            const bool keepOpen = parse_(session.socket_, session.fixSession_.get(), session.parseBuffer_, processed);
+            session.parseBuffer_.erase(session.parseBuffer_.begin(),
+                                       session.parseBuffer_.begin() + static_cast<std::ptrdiff_t>(processed));
+
+            // Same limit as the inline path: an unterminated 1MB frame is a broken stream
+            if (!keepOpen || session.parseBuffer_.size() >= ClientSession::MAX_INBOX_BYTES)
+            {
+                session.failed_.store(true, std::memory_order_release);
+                shutdown(session.socket_, SHUT_RD); // Wakes the reader, which then disconnects
+            }
+        }
+
+        session.scheduled_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(session.inboxMutex_);
+            if (session.inbox_.empty())
+            {
+                return;
+            }
+        }
+        if (session.scheduled_.exchange(true))
+        {
+            return; // The reader re-queued it already; that task will pick the bytes up
+        }
+    }
+}
+
+std::size_t GatewayParserPool::getWorkerCount() const
+{
+    return workers_.size();
+}
+
+uint64_t GatewayParserPool::getStealCount() const
+{
+    return steals_.load(std::memory_order_relaxed);
+}
+
+} // namespace hft
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "utils/idle_strategy.hpp"
+#include "utils/work_stealing_deque.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace hft
+{
+
+class FixSession;
+
+/**
+ * @brief One client connection as seen by the parser pool.
+ *
+ * The connection's I/O thread appends raw bytes to the inbox. The session is then run by at most
+ * one parser worker at a time (the `scheduled_` flag), which drains the inbox into its own parse
+ * buffer in arrival order: per-client message order is preserved no matter which worker runs it.
+ *
+ * Owns the socket: it is closed when the last reference (I/O thread or queued task) goes away,
+ * so a worker can still send a U2 reply after the client's reader has exited. Also owns the
+ * connection's FIX session state, if any, which only the worker running the session touches.
+ */
+class ClientSession
+{
+  public:
+    // Reader backs off once this much unparsed data is queued, so TCP flow control slows the client
+    static constexpr std::size_t MAX_INBOX_BYTES = 1U << 20;
+
+    ClientSession(int clientSocket, std::size_t homeWorker, std::unique_ptr<FixSession> fixSession);
+    ~ClientSession();
+
+    ClientSession(const ClientSession &) = delete;
+    ClientSession &operator=(const ClientSession &) = delete;
+
+    int socket() const noexcept
+    {
+        return socket_;
+    }
+
+    // Set by a worker when the stream is malformed or a reply failed; the reader then disconnects
+    bool failed() const noexcept
+    {
+        return failed_.load(std::memory_order_acquire);
+    }
+
+    std::size_t pendingBytes();
+
+  private:
+    friend class GatewayParserPool;
+
+    int socket_;
+    std::size_t homeWorker_;
+    std::unique_ptr<FixSession> fixSession_;
+
+    std::mutex inboxMutex_;
+    std::vector<char> inbox_;       // Written by the I/O thread
+    std::vector<char> parseBuffer_; // Worker-only: carried-over partial message + drained inbox
+
+    std::atomic<bool> scheduled_{false};
+    std::atomic<bool> failed_{false};
+};
+
+/**
+ * @brief Parser workers decoupled from connections.
+ *
+ * Connection threads only recv(); parsing runs on a fixed pool fed through work-stealing deques,
+ * so one hot client can use every worker over time instead of saturating its own thread, and
+ * parse throughput no longer depends on the number of connections.
+ *
+ * Each session has a home worker (round-robin at open) whose deque it is queued on; idle
+ * workers steal sessions from the others. A session queued while its home worker is not parked
+ * also wakes one parked peer, so it never waits for a busy home worker or a park timeout.
+ */
+class GatewayParserPool
+{
+  public:
+    // Parses complete messages from data, sets processed to the bytes consumed. session is the
+    // connection's FIX session (nullptr without one). Returns false when the connection should be dropped.
+    using ParseFn = std::function<bool(int clientSocket, FixSession *session, std::span<const char> data,
+                                       std::size_t &processed)>;
+
+    GatewayParserPool(std::size_t workerCount, ParseFn parse, IdleStrategyType idleType = IdleStrategyType::Park);
+    ~GatewayParserPool();
+
+    GatewayParserPool(const GatewayParserPool &) = delete;
+    GatewayParserPool &operator=(const GatewayParserPool &) = delete;
+
+    void start();
+    void stop();
+
+    std::shared_ptr<ClientSession> openSession(int clientSocket);
+    std::shared_ptr<ClientSession> openSession(int clientSocket, std::unique_ptr<FixSession> fixSession);
+
+    // I/O thread: queue received bytes and schedule the session if it is not already queued/running
+    void submit(const std::shared_ptr<ClientSession> &session, const char *data, std::size_t length);
+
+    std::size_t getWorkerCount() const;
+    uint64_t getStealCount() const;
+
+  private:
+    struct Worker
+    {
+        explicit Worker(IdleStrategyType idleType) : idle(idleType)
+        {
+        }
+
+        WorkStealingDeque<std::shared_ptr<ClientSession>> tasks;
+        IdleStrategy idle;
+        std::thread thread;
+    };
+
+    void workerLoop(std::size_t self);
+    bool stealTask(std::size_t self, std::shared_ptr<ClientSession> &task);
+    bool hasQueuedTask() const;
+    void runSession(ClientSession &session);
+    void schedule(const std::shared_ptr<ClientSession> &session);
+
+    ParseFn parse_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::size_t> nextHome_{0};
+    std::atomic<uint64_t> steals_{0};
+};
+
+} // namespace hft
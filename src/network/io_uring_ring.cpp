@@ -0,0 +1,223 @@
+#include "io_uring_ring.hpp"
+
+#if HFT_HAS_IO_URING
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace hft
+{
+
+namespace
+{
+[[noreturn]] void throwErrno(const char *what, int error)
+{
+    throw std::runtime_error(std::string(what) + ": " + std::strerror(error));
+}
+} // namespace
+
+IoUringRing::IoUringRing(unsigned entries, unsigned completionEntries)
+{
+    io_uring_params params{};
+    // SINGLE_ISSUER (6.0) doubles as the probe for multishot recv, which landed in the same release
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER;
+    params.cq_entries = completionEntries;
+
+    ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd_ < 0)
+    {
+        throwErrno("io_uring_setup", errno);
+    }
+
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG) ||
+        !(params.features & IORING_FEAT_NODROP))
+    {
+        close(ringFd_);
+        throw std::runtime_error("io_uring: kernel lacks SINGLE_MMAP/EXT_ARG/NODROP");
+    }
+
+    // SQ and CQ rings share one mapping (IORING_FEAT_SINGLE_MMAP)
+    const std::size_t sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    const std::size_t cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    ringMemorySize_ = std::max(sqRingSize, cqRingSize);
+    ringMemory_ = mmap(nullptr, ringMemorySize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_,
+                       IORING_OFF_SQ_RING);
+    if (ringMemory_ == MAP_FAILED)
+    {
+        const int error = errno;
+        close(ringFd_);
+        throwErrno("io_uring ring mmap", error);
+    }
+
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        const int error = errno;
+        munmap(ringMemory_, ringMemorySize_);
+        close(ringFd_);
+        throwErrno("io_uring sqe mmap", error);
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    char *ring = static_cast<char *>(ringMemory_);
+    sqHead_ = reinterpret_cast<unsigned *>(ring + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned *>(ring + params.sq_off.tail);
+    sqMask_ = *reinterpret_cast<unsigned *>(ring + params.sq_off.ring_mask);
+    sqEntries_ = params.sq_entries;
+    sqeTail_ = *sqTail_;
+
+    // Identity index mapping, written once: slot i of the SQ ring always refers to sqes_[i]
+    unsigned *sqArray = reinterpret_cast<unsigned *>(ring + params.sq_off.array);
+    for (unsigned i = 0; i < sqEntries_; ++i)
+    {
+        sqArray[i] = i;
+    }
+
+    cqHead_ = reinterpret_cast<unsigned *>(ring + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned *>(ring + params.cq_off.tail);
+    cqMask_ = *reinterpret_cast<unsigned *>(ring + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(ring + params.cq_off.cqes);
+}
+
+IoUringRing::~IoUringRing()
+{
+    // Closing the ring cancels whatever is still in flight (multishot accept/recv)
+    close(ringFd_);
+    munmap(sqes_, sqesSize_);
+    munmap(ringMemory_, ringMemorySize_);
+    if (bufRing_)
+    {
+        munmap(bufRing_, bufRingSize_);
+    }
+    if (arena_)
+    {
+        munmap(arena_, arenaSize_);
+    }
+}
+
+io_uring_sqe *IoUringRing::getSqe()
+{
+    const unsigned head = std::atomic_ref<unsigned>(*sqHead_).load(std::memory_order_acquire);
+    if (sqeTail_ - head >= sqEntries_)
+    {
+        return nullptr;
+    }
+    io_uring_sqe *sqe = &sqes_[sqeTail_ & sqMask_];
+    ++sqeTail_;
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+unsigned IoUringRing::flushSubmissions()
+{
+    const unsigned published = *sqTail_;
+    std::atomic_ref<unsigned>(*sqTail_).store(sqeTail_, std::memory_order_release);
+    return sqeTail_ - published;
+}
+
+int IoUringRing::enter(unsigned toSubmit, unsigned minComplete, unsigned flags, const void *arg, std::size_t argSize)
+{
+    for (;;)
+    {
+        const long result = syscall(__NR_io_uring_enter, ringFd_, toSubmit, minComplete, flags, arg, argSize);
+        if (result >= 0)
+        {
+            return static_cast<int>(result);
+        }
+        if (errno != EINTR)
+        {
+            return -errno;
+        }
+    }
+}
+
+int IoUringRing::submit()
+{
+    const unsigned toSubmit = flushSubmissions();
+    return toSubmit == 0 ? 0 : enter(toSubmit, 0, 0, nullptr, 0);
+}
+
+int IoUringRing::submitAndWait(std::chrono::nanoseconds timeout)
+{
+    __kernel_timespec ts{};
+    ts.tv_sec = timeout.count() / 1000000000;
+    ts.tv_nsec = timeout.count() % 1000000000;
+
+    io_uring_getevents_arg arg{};
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+
+    // -ETIME just means nothing completed before the timeout
+    return enter(flushSubmissions(), 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+}
+
+void IoUringRing::setupBufferRing(uint16_t groupId, uint16_t count, uint32_t bufferSize)
+{
+    if (count == 0 || (count & (count - 1)) != 0)
+    {
+        throw std::runtime_error("io_uring: provided buffer count must be a power of two");
+    }
+
+    // The ring must be page aligned; anonymous mmap gives us that
+    bufRingSize_ = static_cast<std::size_t>(count) * sizeof(io_uring_buf);
+    void *ringMemory = mmap(nullptr, bufRingSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ringMemory == MAP_FAILED)
+    {
+        throwErrno("io_uring buffer ring mmap", errno);
+    }
+    bufRing_ = static_cast<io_uring_buf *>(ringMemory);
+
+    arenaSize_ = static_cast<std::size_t>(count) * bufferSize;
+    void *arena = mmap(nullptr, arenaSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (arena == MAP_FAILED)
+    {
+        throwErrno("io_uring buffer arena mmap", errno);
+    }
+    arena_ = static_cast<char *>(arena);
+    bufferSize_ = bufferSize;
+    bufMask_ = static_cast<uint16_t>(count - 1);
+    bufTail_ = 0;
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(bufRing_);
+    reg.ring_entries = count;
+    reg.bgid = groupId;
+    if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        throwErrno("io_uring_register(PBUF_RING)", errno);
+    }
+
+    for (uint16_t id = 0; id < count; ++id)
+    {
+        recycleBuffer(id);
+    }
+    publishBuffers();
+}
+
+void IoUringRing::recycleBuffer(uint16_t bufferId)
+{
+    io_uring_buf &slot = bufRing_[bufTail_ & bufMask_];
+    slot.addr = reinterpret_cast<uint64_t>(buffer(bufferId));
+    slot.len = bufferSize_;
+    slot.bid = bufferId;
+    ++bufTail_;
+}
+
+void IoUringRing::publishBuffers()
+{
+    // The ring tail overlays the reserved field of the first entry
+    auto *ring = reinterpret_cast<io_uring_buf_ring *>(bufRing_);
+    std::atomic_ref<uint16_t>(ring->tail).store(bufTail_, std::memory_order_release);
+}
+
+} // namespace hft
+
+#endif
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+// Multishot recv (and, with it, provided buffer rings and single-issuer rings) arrived in Linux 6.0 headers
+#if defined(__linux__) && defined(IORING_RECV_MULTISHOT)
+#define HFT_HAS_IO_URING 1
+#else
+#define HFT_HAS_IO_URING 0
+#endif
+
+namespace hft
+{
+
+#if HFT_HAS_IO_URING
+
+/**
+ * @brief Minimal io_uring ring driven through raw syscalls (no liburing dependency).
+ *
+ * Owns the submission/completion rings and, optionally, one provided buffer ring: a pool of
+ * fixed-size buffers the kernel picks from when a recv completes, so received bytes land in
+ * memory registered once at startup instead of a buffer passed on every call.
+ *
+ * Single-threaded: the ring is created with IORING_SETUP_SINGLE_ISSUER, so construct and use it
+ * on the thread that drives it. Construction throws std::runtime_error when the running kernel
+ * lacks a required feature; callers fall back to another I/O model.
+ */
+class IoUringRing
+{
+  public:
+    IoUringRing(unsigned entries, unsigned completionEntries);
+    ~IoUringRing();
+
+    IoUringRing(const IoUringRing &) = delete;
+    IoUringRing &operator=(const IoUringRing &) = delete;
+
+    // Next free submission entry (zeroed), or nullptr when the queue is full (submit() first)
+    io_uring_sqe *getSqe();
+
+    // Hands queued entries to the kernel without waiting. No syscall when nothing is queued.
+    int submit();
+
+    // Submits queued entries and sleeps until at least one completion or the timeout expires.
+    int submitAndWait(std::chrono::nanoseconds timeout);
+
+    // Calls fn(const io_uring_cqe &) for every available completion and releases them.
+    template <typename Fn> unsigned drainCompletions(Fn &&fn)
+    {
+        unsigned head = *cqHead_;
+        const unsigned tail = std::atomic_ref<unsigned>(*cqTail_).load(std::memory_order_acquire);
+        unsigned count = 0;
+        while (head != tail)
+        {
+            fn(cqes_[head & cqMask_]);
+            ++head;
+            ++count;
+        }
+        std::atomic_ref<unsigned>(*cqHead_).store(head, std::memory_order_release);
+        return count;
+    }
+
+    // Registers a provided buffer ring of `count` (power of two) buffers of bufferSize bytes as groupId.
+    void setupBufferRing(uint16_t groupId, uint16_t count, uint32_t bufferSize);
+
+    char *buffer(uint16_t bufferId) const
+    {
+        return arena_ + static_cast<std::size_t>(bufferId) * bufferSize_;
+    }
+
+    // Returns a consumed buffer to the kernel; visible after publishBuffers()
+    void recycleBuffer(uint16_t bufferId);
+    void publishBuffers();
+
+  private:
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags, const void *arg, std::size_t argSize);
+    unsigned flushSubmissions();
+
+    int ringFd_ = -1;
+
+    void *ringMemory_ = nullptr;
+    std::size_t ringMemorySize_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    std::size_t sqesSize_ = 0;
+
+    unsigned *sqHead_ = nullptr;
+    unsigned *sqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned sqeTail_ = 0; // Local tail: entries handed out but not yet published to the kernel
+
+    unsigned *cqHead_ = nullptr;
+    unsigned *cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+
+    io_uring_buf *bufRing_ = nullptr;
+    std::size_t bufRingSize_ = 0;
+    char *arena_ = nullptr;
+    std::size_t arenaSize_ = 0;
+    uint32_t bufferSize_ = 0;
+    uint16_t bufMask_ = 0;
+    uint16_t bufTail_ = 0;
+};
+
+#endif
+
+} // namespace hft
@@ -0,0 +1,227 @@
+#include "metrics_publisher.hpp"
+#include "socket_utils.hpp"
+#include "transport.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <new>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace hft
+{
+
+namespace
+{
+constexpr char SHARED_MAGIC[8] = {'H', 'F', 'T', 'M', 'E', 'T', 'R', 'X'};
+} // namespace
+
+struct MetricsPublisher::SharedLayout
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t snapshotSize; // sizeof(MetricsSnapshot) of the writer: readers refuse a different layout
+    SeqLock<MetricsSnapshot> snapshot;
+};
+
+MetricsPublisher::MetricsPublisher(Collect collect, std::chrono::milliseconds interval)
+    : collect_(std::move(collect)), interval_(interval)
+{
+    if (interval_.count() <= 0)
+    {
+        throw std::runtime_error("MetricsPublisher: interval must be positive");
+    }
+}
+
+MetricsPublisher::~MetricsPublisher()
+{
+    stop();
+}
+
+void MetricsPublisher::setHttpPort(int port)
+{
+    requestedPort_ = port;
+}
+
+void MetricsPublisher::setSharedFile(const std::string &path)
+{
+    sharedPath_ = path;
+}
+
+void MetricsPublisher::start()
+{
+    if (running_.load())
+    {
+        return;
+    }
+
+    if (!sharedPath_.empty())
+    {
+        const int fd = open(sharedPath_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, sizeof(SharedLayout)) != 0)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            throw std::runtime_error("MetricsPublisher: cannot create " + sharedPath_);
+        }
+        void *memory = mmap(nullptr, sizeof(SharedLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd); // The mapping keeps the file
+        if (memory == MAP_FAILED)
+        {
+            throw std::runtime_error("MetricsPublisher: cannot map " + sharedPath_);
+        }
+        shared_ = new (memory) SharedLayout{{}, SHARED_FILE_VERSION, sizeof(MetricsSnapshot), {}};
+        // Magic last: a reader that sees it also sees an initialised sequence lock
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(shared_->magic, SHARED_MAGIC, sizeof(SHARED_MAGIC));
+    }
+
+    if (requestedPort_ >= 0)
+    {
+        TransportEndpoint endpoint;
+        endpoint.port = requestedPort_;
+        listenFd_ = endpoint.listen();
+        sockaddr_in address{};
+        socklen_t length = sizeof(address);
+        getsockname(listenFd_, reinterpret_cast<sockaddr *>(&address), &length);
+        boundPort_ = ntohs(address.sin_port);
+    }
+
+    publish(); // Readers never see the empty snapshot once start() returns
+    running_.store(true);
+    thread_ = std::thread([this]() { runLoop(); });
+}
+
+void MetricsPublisher::stop()
+{
+    if (running_.exchange(false) && thread_.joinable())
+    {
+        thread_.join();
+        publish(); // Final numbers stay readable in the file after the server exits
+    }
+    if (listenFd_ >= 0)
+    {
+        close(listenFd_);
+        listenFd_ = -1;
+    }
+    if (shared_)
+    {
+        munmap(shared_, sizeof(SharedLayout));
+        shared_ = nullptr;
+    }
+}
+
+MetricsSnapshot MetricsPublisher::latest() const
+{
+    return latest_.load();
+}
+
+int MetricsPublisher::getHttpPort() const
+{
+    return boundPort_;
+}
+
+void MetricsPublisher::publish()
+{
+    const MetricsSnapshot snapshot = collect_();
+    latest_.store(snapshot);
+    if (shared_)
+    {
+        shared_->snapshot.store(snapshot);
+    }
+}
+
+void MetricsPublisher::runLoop()
+{
+    auto nextPublish = std::chrono::steady_clock::now() + interval_;
+    while (running_.load(std::memory_order_relaxed))
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextPublish)
+        {
+            publish();
+            nextPublish = now + interval_;
+        }
+
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(nextPublish - now).count();
+        if (listenFd_ < 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::max<long long>(wait, 1)));
+            continue;
+        }
+        pollfd pfd{listenFd_, POLLIN, 0};
+        if (poll(&pfd, 1, static_cast<int>(std::max<long long>(wait, 1))) > 0 && (pfd.revents & POLLIN))
+        {
+            const int clientFd = accept(listenFd_, nullptr, nullptr);
+            if (clientFd >= 0)
+            {
+                serveClient(clientFd);
+                close(clientFd);
+            }
+        }
+    }
+}
+
+void MetricsPublisher::serveClient(int clientFd) const
+{
+    // Read (and ignore) the request, so the close does not reset the connection under an HTTP client.
+    // A bare `nc` sends nothing: give up after a moment and answer anyway.
+    timeval timeout{0, 100000};
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    char request[1024];
+    (void)recv(clientFd, request, sizeof(request), 0);
+
+    const std::string body = formatMetricsSnapshot(latest_.load());
+    const std::string response = "HTTP/1.0 200 OK\r\n"
+                                 "Content-Type: text/plain; version=0.0.4\r\n"
+                                 "Content-Length: " +
+                                 std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    sendAll(clientFd, response.data(), response.size());
+}
+
+MetricsSnapshot MetricsPublisher::readSharedFile(const std::string &path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Metrics file: cannot open " + path);
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(SharedLayout))
+    {
+        close(fd);
+        throw std::runtime_error("Metrics file: " + path + " is too small");
+    }
+    void *memory = mmap(nullptr, sizeof(SharedLayout), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        throw std::runtime_error("Metrics file: cannot map " + path);
+    }
+
+    const auto *layout = static_cast<const SharedLayout *>(memory);
+    const bool valid = std::memcmp(layout->magic, SHARED_MAGIC, sizeof(SHARED_MAGIC)) == 0 &&
+                       layout->version == SHARED_FILE_VERSION && layout->snapshotSize == sizeof(MetricsSnapshot);
+    MetricsSnapshot snapshot;
+    if (valid)
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        snapshot = layout->snapshot.load();
+    }
+    munmap(memory, sizeof(SharedLayout));
+    if (!valid)
+    {
+        throw std::runtime_error("Metrics file: " + path + " was not written by this version of the server");
+    }
+    return snapshot;
+}
+
+} // namespace hft
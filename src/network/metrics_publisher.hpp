@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/metrics_snapshot.hpp"
+#include "utils/seqlock.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace hft
+{
+
+/**
+ * @brief Live monitoring: publishes a MetricsSnapshot every interval from its own thread.
+ *
+ * collect() runs on the publisher thread. It reads the engines' published EngineStatus (SeqLocks the
+ * engines refresh themselves) and the latency histograms, both lock-free, so monitoring never stops or
+ * signals an engine thread. Each snapshot goes to up to three readers:
+ *
+ *   latest()        - in-process, through a SeqLock
+ *   HTTP endpoint   - GET on the metrics port returns the Prometheus text format (curl, nc, scrapers)
+ *   shared file     - a SeqLock<MetricsSnapshot> in a mmap-ed file; readSharedFile() from any process
+ */
+class MetricsPublisher
+{
+  public:
+    using Collect = std::function<MetricsSnapshot()>;
+
+    static constexpr uint32_t SHARED_FILE_VERSION = 1;
+
+    MetricsPublisher(Collect collect, std::chrono::milliseconds interval);
+    ~MetricsPublisher();
+
+    MetricsPublisher(const MetricsPublisher &) = delete;
+    MetricsPublisher &operator=(const MetricsPublisher &) = delete;
+
+    // Serve snapshots over TCP on this port (0 = any free port, see getHttpPort). Call before start().
+    void setHttpPort(int port);
+
+    // Publish into this file (created or truncated; /dev/shm keeps it in memory). Call before start().
+    void setSharedFile(const std::string &path);
+
+    // Binds the endpoint and maps the file, then starts the thread. Throws std::runtime_error.
+    void start();
+
+    // Publishes one last snapshot and joins the thread
+    void stop();
+
+    MetricsSnapshot latest() const;
+
+    // The port actually bound, or -1 without an endpoint
+    int getHttpPort() const;
+
+    // Reads the latest snapshot another process published with setSharedFile. Throws std::runtime_error.
+    static MetricsSnapshot readSharedFile(const std::string &path);
+
+  private:
+    struct SharedLayout;
+
+    void runLoop();
+    void publish();
+    void serveClient(int clientFd) const;
+
+    Collect collect_;
+    std::chrono::milliseconds interval_;
+    int requestedPort_ = -1;
+    int listenFd_ = -1;
+    int boundPort_ = -1;
+    std::string sharedPath_;
+    SharedLayout *shared_ = nullptr;
+    SeqLock<MetricsSnapshot> latest_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace hft
@@ -0,0 +1,119 @@
+#include "mirrored_ring_buffer.hpp"
+#include "network/shared_memory.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+
+namespace hft
+{
+
+namespace
+{
+std::size_t roundToPages(std::size_t bytes)
+{
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return std::max<std::size_t>(page, (bytes + page - 1) / page * page);
+}
+} // namespace
+
+MirroredRingBuffer::MirroredRingBuffer(std::size_t capacity, bool mirror) : capacity_{roundToPages(capacity)}
+{
+    if (mirror && mapMirrored())
+    {
+        return;
+    }
+    base_ = new char[capacity_];
+}
+
+MirroredRingBuffer::~MirroredRingBuffer()
+{
+    release();
+}
+
+bool MirroredRingBuffer::mapMirrored()
+{
+    const int fd = createSharedMemory(capacity_, "hft-rx-ring");
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    // Reserve 2x the address space, then map the same pages over both halves
+    void *reserved = mmap(nullptr, 2 * capacity_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    bool mapped = reserved != MAP_FAILED;
+    char *const base = static_cast<char *>(reserved);
+    for (int half = 0; mapped && half < 2; ++half)
+    {
+        mapped = mmap(base + half * capacity_, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) !=
+                 MAP_FAILED;
+    }
+    close(fd); // The mappings keep the memory alive
+
+    if (!mapped)
+    {
+        if (reserved != MAP_FAILED)
+        {
+            munmap(reserved, 2 * capacity_);
+        }
+        return false;
+    }
+    base_ = base;
+    mirrored_ = true;
+    return true;
+}
+
+void MirroredRingBuffer::release()
+{
+    if (mirrored_)
+    {
+        munmap(base_, 2 * capacity_);
+    }
+    else
+    {
+        delete[] base_;
+    }
+    base_ = nullptr;
+}
+
+char *MirroredRingBuffer::writeData()
+{
+    if (mirrored_)
+    {
+        return base_ + writePos_ % capacity_;
+    }
+    if (readPos_ > 0)
+    {
+        const std::size_t unread = size();
+        std::memmove(base_, base_ + readPos_, unread);
+        readPos_ = 0;
+        writePos_ = unread;
+    }
+    return base_ + writePos_;
+}
+
+bool MirroredRingBuffer::grow(std::size_t maxCapacity)
+{
+    const std::size_t target = roundToPages(std::min(capacity_ * 2, maxCapacity));
+    if (target <= capacity_)
+    {
+        return false;
+    }
+
+    MirroredRingBuffer larger(target, mirrored_);
+    const auto unread = readable();
+    std::memcpy(larger.writeData(), unread.data(), unread.size());
+    larger.commit(unread.size());
+
+    release();
+    base_ = std::exchange(larger.base_, nullptr);
+    capacity_ = larger.capacity_;
+    mirrored_ = larger.mirrored_;
+    readPos_ = 0;
+    writePos_ = unread.size();
+    larger.mirrored_ = false; // Nothing left to release
+    return true;
+}
+
+} // namespace hft
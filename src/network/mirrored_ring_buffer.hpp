@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace hft
+{
+
+/**
+ * @brief Per-connection receive buffer whose unread bytes are always one contiguous span.
+ *
+ * The same physical pages (a memfd, or an unlinked POSIX shm object off Linux) are mapped twice,
+ * back to back, so a frame that wraps past the end of the ring continues seamlessly into the
+ * second mapping. recv() writes straight into the free space and the parser reads straight out
+ * of the unread span: a partial frame left over after a recv() is never copied to the front.
+ * When the buffer drains completely both positions reset to the start, keeping the hot pages few.
+ *
+ * Capacity is rounded up to whole pages. Where the double mapping is unavailable (or mirror is
+ * false) the buffer is a plain allocation that compacts the unread bytes with memmove before
+ * each write, i.e. the grow-and-memmove behaviour it replaces. Single-threaded.
+ */
+class MirroredRingBuffer
+{
+  public:
+    explicit MirroredRingBuffer(std::size_t capacity, bool mirror = true);
+    ~MirroredRingBuffer();
+
+    MirroredRingBuffer(const MirroredRingBuffer &) = delete;
+    MirroredRingBuffer &operator=(const MirroredRingBuffer &) = delete;
+
+    // Free space as one contiguous block of writable() bytes: recv() into it, then commit()
+    char *writeData();
+
+    std::size_t writable() const
+    {
+        return capacity_ - size();
+    }
+
+    void commit(std::size_t bytes)
+    {
+        writePos_ += bytes;
+    }
+
+    // Unread bytes, contiguous even when they wrap around the end of the ring
+    std::span<const char> readable() const
+    {
+        return {base_ + (mirrored_ ? readPos_ % capacity_ : readPos_), size()};
+    }
+
+    void consume(std::size_t bytes)
+    {
+        readPos_ += bytes;
+        if (readPos_ == writePos_)
+        {
+            readPos_ = writePos_ = 0; // Drained: restart at the first page
+        }
+    }
+
+    // Doubles the capacity (at most maxCapacity), keeping the unread bytes. False once at the limit.
+    bool grow(std::size_t maxCapacity);
+
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(writePos_ - readPos_);
+    }
+
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    bool isMirrored() const
+    {
+        return mirrored_;
+    }
+
+  private:
+    bool mapMirrored();
+    void release();
+
+    char *base_ = nullptr;
+    std::size_t capacity_ = 0;
+    uint64_t readPos_ = 0; // Mirrored: running byte counts, offset = pos % capacity. Plain: offsets.
+    uint64_t writePos_ = 0;
+    bool mirrored_ = false;
+};
+
+} // namespace hft
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace hft
+{
+
+// Descriptor for size bytes of zeroed shared memory that no other process can open by name: a memfd on
+// Linux, an immediately unlinked POSIX shm object elsewhere. It can still be mapped twice, or handed to
+// another process over a Unix socket. -1 on failure.
+inline int createSharedMemory(std::size_t size, const char *name)
+{
+#if defined(__linux__)
+    const int fd = memfd_create(name, MFD_CLOEXEC);
+#else
+    static std::atomic<unsigned> counter{0};
+    const std::string path =
+        "/" + std::string(name) + "-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+    const int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0)
+    {
+        shm_unlink(path.c_str());
+    }
+#endif
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace hft
@@ -0,0 +1,206 @@
+#include "shm_channel.hpp"
+#include "network/shared_memory.hpp"
+#include "utils/lock_free_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hft
+{
+
+// Lives at the start of the shared memory, followed by the ring's data
+struct ShmChannel::Header
+{
+    static constexpr uint64_t MAGIC = 0x48465453484D5231ULL; // "HFTSHMR1"
+
+    uint64_t magic;
+    uint64_t capacity;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> writePosition; // Bytes ever written; producer only
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> readPosition;  // Bytes ever read; consumer only
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> producerClosed;
+    std::atomic<uint32_t> consumerClosed;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring positions are shared between processes");
+
+std::unique_ptr<ShmChannel> ShmChannel::create(std::size_t capacity)
+{
+    capacity = std::bit_ceil(std::max<std::size_t>(capacity, 4096));
+    const int memoryFd = createSharedMemory(sizeof(Header) + capacity, "hft-shm-channel");
+    if (memoryFd < 0)
+    {
+        throw std::runtime_error(std::string("Failed to create shared memory: ") + std::strerror(errno));
+    }
+    return std::unique_ptr<ShmChannel>(new ShmChannel(memoryFd, true));
+}
+
+std::unique_ptr<ShmChannel> ShmChannel::attach(int memoryFd)
+{
+    return std::unique_ptr<ShmChannel>(new ShmChannel(memoryFd, false));
+}
+
+ShmChannel::ShmChannel(int memoryFd, bool producer) : memoryFd_{memoryFd}, producer_{producer}
+{
+    static_assert(sizeof(Header) % CACHE_LINE_SIZE == 0, "ring data starts on its own cache line");
+    struct stat info{};
+    if (fstat(memoryFd_, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+        close(memoryFd_);
+        throw std::runtime_error("Shared memory channel: descriptor is not a ring");
+    }
+    mappedBytes_ = static_cast<std::size_t>(info.st_size);
+    void *memory = mmap(nullptr, mappedBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd_, 0);
+    if (memory == MAP_FAILED)
+    {
+        close(memoryFd_);
+        throw std::runtime_error(std::string("Shared memory channel mmap: ") + std::strerror(errno));
+    }
+    header_ = static_cast<Header *>(memory);
+    data_ = static_cast<char *>(memory) + sizeof(Header);
+
+    if (producer_)
+    {
+        // Fresh memory is zeroed: positions and flags start at 0
+        header_->capacity = mappedBytes_ - sizeof(Header);
+        header_->magic = Header::MAGIC;
+    }
+    capacity_ = mappedBytes_ - sizeof(Header);
+    if (header_->magic != Header::MAGIC || header_->capacity != capacity_ || !std::has_single_bit(capacity_))
+    {
+        munmap(memory, mappedBytes_);
+        close(memoryFd_);
+        throw std::runtime_error("Shared memory channel: descriptor is not a ring");
+    }
+
+    if (!producer_)
+    {
+        // The mapping keeps the memory alive; a consumer has no use for the descriptor
+        close(memoryFd_);
+        memoryFd_ = -1;
+        peerPosition_ = header_->writePosition.load(std::memory_order_acquire);
+    }
+}
+
+ShmChannel::~ShmChannel()
+{
+    (producer_ ? header_->producerClosed : header_->consumerClosed).store(1, std::memory_order_release);
+    munmap(header_, mappedBytes_);
+    if (memoryFd_ >= 0)
+    {
+        close(memoryFd_);
+    }
+}
+
+void ShmChannel::copyIn(uint64_t position, const char *data, std::size_t length)
+{
+    const std::size_t offset = position & (capacity_ - 1);
+    const std::size_t first = std::min(length, capacity_ - offset);
+    std::memcpy(data_ + offset, data, first);
+    std::memcpy(data_, data + first, length - first);
+}
+
+void ShmChannel::copyOut(uint64_t position, char *data, std::size_t length) const
+{
+    const std::size_t offset = position & (capacity_ - 1);
+    const std::size_t first = std::min(length, capacity_ - offset);
+    std::memcpy(data, data_ + offset, first);
+    std::memcpy(data + first, data_, length - first);
+}
+
+bool ShmChannel::write(const char *data, std::size_t length, std::chrono::milliseconds timeout)
+{
+    // Read-mostly line: costs a shared-cache load until the consumer actually closes
+    if (header_->consumerClosed.load(std::memory_order_relaxed) != 0)
+    {
+        return false;
+    }
+    uint64_t position = header_->writePosition.load(std::memory_order_relaxed);
+    IdleStrategy idle(IdleStrategyType::Backoff);
+    std::chrono::steady_clock::time_point deadline{};
+    while (length > 0)
+    {
+        std::size_t room = capacity_ - static_cast<std::size_t>(position - peerPosition_);
+        if (room == 0)
+        {
+            peerPosition_ = header_->readPosition.load(std::memory_order_acquire);
+            room = capacity_ - static_cast<std::size_t>(position - peerPosition_);
+        }
+        if (room == 0)
+        {
+            if (header_->consumerClosed.load(std::memory_order_acquire) != 0)
+            {
+                return false;
+            }
+            const auto now = std::chrono::steady_clock::now();
+            if (deadline == std::chrono::steady_clock::time_point{})
+            {
+                deadline = now + timeout;
+            }
+            else if (now > deadline)
+            {
+                return false;
+            }
+            idle.idle([]() { return false; });
+            continue;
+        }
+
+        const std::size_t chunk = std::min(room, length);
+        copyIn(position, data, chunk);
+        position += chunk;
+        header_->writePosition.store(position, std::memory_order_release);
+        data += chunk;
+        length -= chunk;
+        idle.reset();
+    }
+    return true;
+}
+
+ssize_t ShmChannel::receive(char *data, std::size_t length, std::chrono::milliseconds wait, IdleStrategyType idleType)
+{
+    const uint64_t position = header_->readPosition.load(std::memory_order_relaxed);
+    if (peerPosition_ == position)
+    {
+        peerPosition_ = header_->writePosition.load(std::memory_order_acquire);
+    }
+    if (peerPosition_ == position)
+    {
+        IdleStrategy idle(idleType);
+        const auto deadline = std::chrono::steady_clock::now() + wait;
+        for (uint32_t round = 1;; ++round)
+        {
+            // The producer's final write is published before its closed flag
+            const bool closed = header_->producerClosed.load(std::memory_order_acquire) != 0;
+            peerPosition_ = header_->writePosition.load(std::memory_order_acquire);
+            if (peerPosition_ != position)
+            {
+                break;
+            }
+            if (closed)
+            {
+                return 0;
+            }
+            if (round % 64 == 0 && std::chrono::steady_clock::now() > deadline)
+            {
+                errno = EAGAIN;
+                return -1;
+            }
+            idle.idle([]() { return false; });
+        }
+    }
+
+    // The producer is another process: never trust it to stay within the ring
+    const std::size_t count =
+        std::min({length, capacity_, static_cast<std::size_t>(peerPosition_ - position)});
+    copyOut(position, data, count);
+    header_->readPosition.store(position + count, std::memory_order_release);
+    return static_cast<ssize_t>(count);
+}
+
+} // namespace hft
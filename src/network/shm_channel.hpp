@@ -0,0 +1,80 @@
+#pragma once
+
+#include "utils/idle_strategy.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sys/types.h>
+
+namespace hft
+{
+
+/**
+ * @brief One-way byte stream between two processes through a ring in shared memory.
+ *
+ * The producer creates the ring in fresh shared memory (createSharedMemory) and passes fd() to the
+ * consumer, typically with sendDescriptor() over a Unix socket; the consumer attaches to it. After
+ * that, moving bytes costs a memcpy and a release store on each side: no system calls, no kernel
+ * buffers. Each side caches the other's position and only rereads its cache line when the ring
+ * looks full (producer) or empty (consumer).
+ *
+ * receive() behaves like recv() on a socket with a receive timeout, so the gateway treats the ring
+ * as one more transport: bytes, 0 once the producer has closed and everything was read, or -1 with
+ * errno = EAGAIN when nothing arrived in time. Destroying either side marks it closed for the peer.
+ *
+ * Exactly one producer and one consumer; the ring only holds positions, never pointers, so both
+ * processes may map it at different addresses.
+ */
+class ShmChannel
+{
+  public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1U << 20;
+
+    // Producer side: a new ring of capacity bytes (rounded up to a power of two). Throws std::runtime_error.
+    static std::unique_ptr<ShmChannel> create(std::size_t capacity = DEFAULT_CAPACITY);
+
+    // Consumer side: maps the ring behind memoryFd, taking ownership of the descriptor. Throws
+    // std::runtime_error if it is not a ring create() made.
+    static std::unique_ptr<ShmChannel> attach(int memoryFd);
+
+    ~ShmChannel();
+
+    ShmChannel(const ShmChannel &) = delete;
+    ShmChannel &operator=(const ShmChannel &) = delete;
+
+    // Producer: the shared memory to hand to the consumer (owned by the channel)
+    int fd() const
+    {
+        return memoryFd_;
+    }
+
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // Producer: copies all of data in, waiting (pause, then yield) while the ring is full. False if the
+    // consumer closed or no room appeared within timeout.
+    bool write(const char *data, std::size_t length, std::chrono::milliseconds timeout);
+
+    // Consumer: copies up to length bytes out, waiting up to `wait` with the given idle strategy.
+    ssize_t receive(char *data, std::size_t length, std::chrono::milliseconds wait, IdleStrategyType idle);
+
+  private:
+    struct Header;
+
+    ShmChannel(int memoryFd, bool producer);
+    void copyIn(uint64_t position, const char *data, std::size_t length);
+    void copyOut(uint64_t position, char *data, std::size_t length) const;
+
+    Header *header_ = nullptr;
+    char *data_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t mappedBytes_ = 0;
+    int memoryFd_ = -1;
+    bool producer_ = false;
+    uint64_t peerPosition_ = 0; // Producer: last seen read position. Consumer: last seen write position.
+};
+
+} // namespace hft
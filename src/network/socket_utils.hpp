@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace hft
+{
+
+// A client hanging up mid-write must not kill the server with SIGPIPE
+#if defined(MSG_NOSIGNAL)
+inline constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+inline constexpr int SEND_FLAGS = 0;
+#endif
+
+// Sends the whole buffer, retrying on EINTR. On non-blocking sockets (event loops, the report writer)
+// waits briefly for room in the send buffer instead of failing on EAGAIN.
+inline bool sendAll(int socketFd, const char *data, std::size_t length)
+{
+    std::size_t sentBytes = 0;
+    while (sentBytes < length)
+    {
+        const ssize_t sentNow = send(socketFd, data + sentBytes, length - sentBytes, SEND_FLAGS);
+        if (sentNow < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                pollfd pfd{socketFd, POLLOUT, 0};
+                if (poll(&pfd, 1, 200) > 0)
+                {
+                    continue;
+                }
+            }
+            return false;
+        }
+        if (sentNow == 0)
+        {
+            return false;
+        }
+        sentBytes += static_cast<std::size_t>(sentNow);
+    }
+    return true;
+}
+
+} // namespace hft
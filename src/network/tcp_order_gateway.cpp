@@ -1,6 +1,15 @@
 #include "tcp_order_gateway.hpp"
 #include "core/metrics_collector.hpp"
+#include "binary/binary_parser.hpp"
+#include "core/sharded_matching_engine.hpp"
 #include "fix/fix_parser.hpp"
+#include "fix/fix_session.hpp"
+#include "network/execution_report_writer.hpp"
+#include "network/gateway_parser_pool.hpp"
+#include "network/mirrored_ring_buffer.hpp"
+#include "network/shm_channel.hpp"
+#include "network/socket_utils.hpp"
+#include "utils/idle_strategy.hpp"
 #include "utils/rdtsc.hpp"
 #include <cerrno>
 #include <charconv>
@@ -8,9 +17,11 @@
 #include <cstdio>
 #include <cstring>
 #include <iostream>
-#include <netinet/in.h>
+#include <memory>
+#include <optional>
 #include <poll.h>
 #include <span>
+#include <stdexcept>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
@@ -20,6 +31,9 @@
  *
  * Each client sends orders through TCP and gets a dedicated buffer and thread in the exchange.
  * The receive buffer grows as needed and tracks how much has already been processed.
+ * In epoll mode the per-client buffers live on a single event loop thread instead
+ * (see tcp_order_gateway_epoll.cpp). With the shared-memory transport the client thread
+ * reads the client's ShmChannel instead of the socket, which then only carries replies.
  *
  */
 
@@ -28,33 +42,135 @@ namespace hft
 
 namespace
 {
-bool sendAll(int socketFd, const char *data, size_t length)
+// Waits for the engine to reach expectedCount (bounded), then replies with a U2 stats frame.
+// StatsSource is a MetricsCollector (single engine) or a ShardedMatchingEngine (aggregated across shards).
+// Send writes the finished frame to the client.
+template <typename StatsSource, typename Send>
+bool replyWithStats(const StatsSource &source, size_t expectedCount, const std::atomic<bool> &running, Send &&send)
 {
-    size_t sentBytes = 0;
-    while (sentBytes < length)
+    // Wait until matching engine reaches expected order count, but never block forever.
+    const auto waitStart = std::chrono::steady_clock::now();
+    while (source.getOrderCount() < expectedCount && running)
     {
-        const ssize_t sentNow = send(socketFd, data + sentBytes, length - sentBytes, 0);
-        if (sentNow < 0)
+        if (std::chrono::steady_clock::now() - waitStart > std::chrono::seconds(30))
         {
-            if (errno == EINTR)
+            std::cerr << "Warning: Stats barrier timeout. expected=" << expectedCount
+                      << " observed=" << source.getOrderCount() << "\n";
+            break;
+        }
+        std::this_thread::yield();
+    }
+
+    auto stats = toNanoseconds(source.getStats());
+    auto netStats = toNanoseconds(source.getNetworkStats());
+    auto engStats = toNanoseconds(source.getEngineStats());
+    auto queStats = toNanoseconds(source.getQueueStats());
+
+    char statsBody[448];
+    int bodyLen = std::snprintf(statsBody, sizeof(statsBody),
+                                "35=U2\x01"
+                                "Mean=%0.2f\x01"
+                                "P50=%llu\x01"
+                                "P90=%llu\x01"
+                                "P99=%llu\x01"
+                                "P999=%llu\x01"
+                                "P9999=%llu\x01"
+                                "Max=%llu\x01"
+                                "NetMean=%0.2f\x01"
+                                "QueMean=%0.2f\x01"
+                                "EngMean=%0.2f\x01"
+                                "Count=%llu\x01",
+                                stats.mean, (unsigned long long)stats.p50, (unsigned long long)stats.p90,
+                                (unsigned long long)stats.p99, (unsigned long long)stats.p999,
+                                (unsigned long long)stats.p9999, (unsigned long long)stats.max,
+                                netStats.mean, queStats.mean, engStats.mean,
+                                (unsigned long long)source.getOrderCount());
+    char statsData[512];
+    const size_t len = bodyLen > 0 ? FIXParser::buildFrame(std::string_view(statsBody, static_cast<size_t>(bodyLen)),
+                                                           statsData, sizeof(statsData))
+                                   : 0;
+    return len > 0 && send(statsData, len);
+}
+
+// Same bound as the socket receive timeout: heartbeats and stop() are noticed as quickly
+constexpr auto SHM_RECEIVE_WAIT = std::chrono::milliseconds(200);
+
+// Shared-memory handshake: the client's first message on the socket carries its ring
+std::unique_ptr<ShmChannel> attachClientChannel(int clientSocket, const std::atomic<bool> &running)
+{
+    // Each attempt is bounded by the 200ms receive timeout; a client that never sends a ring is dropped
+    for (int attempt = 0; attempt < 10 && running; ++attempt)
+    {
+        const int memoryFd = receiveDescriptor(clientSocket);
+        if (memoryFd >= 0)
+        {
+            try
             {
-                continue;
+                return ShmChannel::attach(memoryFd);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Rejected shared-memory client: " << e.what() << std::endl;
+                return nullptr;
             }
-            return false;
         }
-        if (sentNow == 0)
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
         {
-            return false;
+            break;
         }
-        sentBytes += static_cast<size_t>(sentNow);
     }
-    return true;
+    return nullptr;
+}
+
+// A client process that died never marks its ring closed, but its socket does hang up
+bool peerHungUp(int clientSocket)
+{
+    char probe;
+    return recv(clientSocket, &probe, 1, MSG_PEEK | MSG_DONTWAIT) == 0;
 }
 } // namespace
 
+std::vector<std::string> TCPOrderGateway::getSupportedModes()
+{
+    return {"threaded", "epoll", "io_uring"};
+}
+
+GatewayMode TCPOrderGateway::modeFromString(const std::string &name)
+{
+    if (name == "threaded")
+    {
+        return GatewayMode::Threaded;
+    }
+    else if (name == "epoll")
+    {
+        return GatewayMode::Epoll;
+    }
+    else if (name == "io_uring")
+    {
+        return GatewayMode::IoUring;
+    }
+
+    throw std::runtime_error("Unknown gateway mode: " + name);
+}
+
+const char *TCPOrderGateway::modeToString(GatewayMode mode)
+{
+    switch (mode)
+    {
+        case GatewayMode::Threaded:
+            return "threaded";
+        case GatewayMode::Epoll:
+            return "epoll";
+        case GatewayMode::IoUring:
+            return "io_uring";
+    }
+    return "unknown";
+}
+
 TCPOrderGateway::TCPOrderGateway(int port, LockFreeQueue<Order, 1024> &queue)
-    : serverSocket_{-1}, port_{port}, orderQueue_{queue}, running_{false}
+    : serverSocket_{-1}, orderQueue_{queue}, running_{false}
 {
+    endpoint_.port = port;
 }
 
 TCPOrderGateway::~TCPOrderGateway()
@@ -64,37 +180,43 @@ TCPOrderGateway::~TCPOrderGateway()
 
 void TCPOrderGateway::start()
 {
-    // Create TCP socket: AF_INET = IPv4, SOCK_STREAM = TCP, 0 = default protocol
-    serverSocket_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (serverSocket_ < 0)
+    if (mode_ != GatewayMode::Threaded && parserThreads_ > 0)
     {
-        throw std::runtime_error("Failed to create socket");
+        throw std::runtime_error("Gateway parser pool requires the threaded gateway mode");
     }
+#if !defined(__linux__)
+    if (mode_ != GatewayMode::Threaded)
+    {
+        throw std::runtime_error(std::string(modeToString(mode_)) + " gateway mode is only available on Linux");
+    }
+#endif
 
-    // Allow immediate socket reuse after restart (avoids "Address already in use" errors)
-    int reuseAddressOption = 1;
-    setsockopt(serverSocket_, SOL_SOCKET, SO_REUSEADDR, &reuseAddressOption, sizeof(reuseAddressOption));
+    if (endpoint_.kind == TransportKind::SharedMemory && (mode_ != GatewayMode::Threaded || parserThreads_ > 0))
+    {
+        throw std::runtime_error("Shared-memory transport requires the threaded gateway mode without a parser pool");
+    }
 
-    // Configure server address structure
-    sockaddr_in serverAddress{};
-    serverAddress.sin_family = AF_INET;         // IPv4
-    serverAddress.sin_addr.s_addr = INADDR_ANY; // Bind to all network interfaces (0.0.0.0)
-    serverAddress.sin_port = htons(port_);      // Convert port to network byte order (big-endian)
+    serverSocket_ = endpoint_.listen();
 
-    // Bind socket to the address and port
-    if (bind(serverSocket_, (struct sockaddr *)&serverAddress, sizeof(serverAddress)) < 0)
+    if (parserThreads_ > 0)
     {
-        throw std::runtime_error("Failed to bind socket");
+        parserPool_ = std::make_unique<GatewayParserPool>(
+            parserThreads_,
+            [this](int clientSocket, FixSession *session, std::span<const char> data, size_t &processed)
+            { return processMessages(clientSocket, session, data, processed); });
+        parserPool_->start();
     }
 
-    // Start listening for connections (backlog of 5 pending connections)
-    if (listen(serverSocket_, 5) < 0)
+    running_ = true;
+    if (mode_ != GatewayMode::Threaded)
     {
-        throw std::runtime_error("Failed to listen");
+        // One thread accepts, reads and parses for every client
+        eventLoopThread_ = std::jthread(
+            mode_ == GatewayMode::IoUring ? &TCPOrderGateway::ioUringLoop : &TCPOrderGateway::eventLoop, this);
+        return;
     }
 
     // Start accepting connections in a separate thread
-    running_ = true;
     acceptConnectionThread_ = std::jthread(&TCPOrderGateway::acceptLoop, this);
 }
 
@@ -107,6 +229,10 @@ void TCPOrderGateway::stop()
         close(serverSocket_);
     }
     // Although using J:thread auto joins we call .join() for dterministic shutdown ordering
+    if (eventLoopThread_.joinable())
+    {
+        eventLoopThread_.join(); // Closes its client sockets on exit
+    }
     if (acceptConnectionThread_.joinable())
     {
         acceptConnectionThread_.join();
@@ -118,7 +244,16 @@ void TCPOrderGateway::stop()
             clientThread.join();
         }
     }
+    if (parserPool_)
+    {
+        parserPool_->stop();
+        parserPool_.reset();
+    }
 
+    if (serverSocket_ >= 0)
+    {
+        endpoint_.removeSocketFile();
+    }
     serverSocket_ = -1;
 }
 
@@ -160,27 +295,60 @@ void TCPOrderGateway::clientHandler(int clientSocket)
     setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &socketTimeout, sizeof(socketTimeout));
     setsockopt(clientSocket, SOL_SOCKET, SO_SNDTIMEO, &socketTimeout, sizeof(socketTimeout));
 
-    // Start with 4KB, grow up to 1MB for fragmented or bursty payloads.
-    std::vector<char> buffer(4096);
-    constexpr size_t kMaxBufferBytes = 1U << 20;
-    size_t offset = 0; // Track partially received message data
+    std::unique_ptr<ShmChannel> channel;
+    if (endpoint_.kind == TransportKind::SharedMemory)
+    {
+        channel = attachClientChannel(clientSocket, running_);
+        if (!channel)
+        {
+            close(clientSocket);
+            return;
+        }
+    }
+    const IdleStrategyType channelIdle = busyPoll_ ? IdleStrategyType::Pause : IdleStrategyType::Backoff;
+
+    if (reports_)
+    {
+        reports_->openClient(clientSocket);
+    }
+
+    if (parserPool_)
+    {
+        pooledClientHandler(clientSocket);
+        return;
+    }
+
+    // Frames split across recv() calls stay in place: the ring's unread bytes are always contiguous
+    MirroredRingBuffer buffer(RECEIVE_RING_BYTES);
+    std::unique_ptr<FixSession> session = fixSession_ ? std::make_unique<FixSession>() : nullptr;
+    uint64_t lastTimerNs = 0;
 
     while (running_)
     {
-        if (offset == buffer.size())
+        // The 200ms recv timeout bounds how late a heartbeat can be
+        if (session)
         {
-            if (buffer.size() >= kMaxBufferBytes)
+            const uint64_t nowNs = getCurrentTimeNs();
+            if (nowNs - lastTimerNs >= SESSION_TIMER_NS)
             {
-                // Drop unbounded malformed stream from this client.
-                break;
+                lastTimerNs = nowNs;
+                if (!runSessionTimer(clientSocket, *session, nowNs))
+                {
+                    break;
+                }
             }
+        }
 
-            const size_t nextSize = std::min(buffer.size() * 2, kMaxBufferBytes);
-            buffer.resize(nextSize);
+        if (buffer.writable() == 0 && !buffer.grow(MAX_RECEIVE_BYTES))
+        {
+            // Drop unbounded malformed stream from this client.
+            break;
         }
 
-        // Read data from socket into buffer.
-        ssize_t bytesRead = recv(clientSocket, buffer.data() + offset, buffer.size() - offset, 0);
+        // Read data from the socket (or the client's shared-memory ring) into the ring's free space.
+        ssize_t bytesRead =
+            channel ? channel->receive(buffer.writeData(), buffer.writable(), SHM_RECEIVE_WAIT, channelIdle)
+                    : recv(clientSocket, buffer.writeData(), buffer.writable(), 0);
         if (bytesRead < 0)
         {
             if (errno == EINTR)
@@ -189,6 +357,10 @@ void TCPOrderGateway::clientHandler(int clientSocket)
             }
             if (errno == EAGAIN || errno == EWOULDBLOCK)
             {
+                if (channel && peerHungUp(clientSocket))
+                {
+                    break;
+                }
                 continue;
             }
             break; // Fatal read error
@@ -198,123 +370,295 @@ void TCPOrderGateway::clientHandler(int clientSocket)
             break; // Connection closed by peer
         }
 
-        size_t totalBytes = offset + bytesRead;
+        buffer.commit(static_cast<size_t>(bytesRead));
         size_t processed = 0;
 
         // Parse all complete FIX messages in the buffer
-        while (processed < totalBytes)
+        if (!processMessages(clientSocket, session.get(), buffer.readable(), processed))
         {
-            size_t consumed = 0;
-            std::span<const char> data(buffer.data() + processed, totalBytes - processed);
+            break;
+        }
+
+        // An incomplete trailing message stays where it is; the next recv() appends after it
+        buffer.consume(processed);
+    }
+    if (reports_)
+    {
+        reports_->closeClient(clientSocket);
+    }
+    close(clientSocket); // Clean up when client disconnects
+}
+
+void TCPOrderGateway::pooledClientHandler(int clientSocket)
+{
+    // This thread only reads; parsing happens on the pool. The session owns (and closes) the socket.
+    auto session =
+        parserPool_->openSession(clientSocket, fixSession_ ? std::make_unique<FixSession>() : nullptr);
+    std::vector<char> buffer(64 * 1024);
+
+    while (running_ && !session->failed())
+    {
+        // Backpressure: stop reading while the pool is behind, so TCP flow control slows the client
+        if (session->pendingBytes() >= ClientSession::MAX_INBOX_BYTES)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        ssize_t bytesRead = recv(clientSocket, buffer.data(), buffer.size(), 0);
+        if (bytesRead < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                continue;
+            }
+            break; // Fatal read error
+        }
+        if (bytesRead == 0)
+        {
+            break; // Connection closed by peer (or shut down by a worker after a failure)
+        }
+
+        parserPool_->submit(session, buffer.data(), static_cast<size_t>(bytesRead));
+    }
+    if (reports_)
+    {
+        reports_->closeClient(clientSocket); // Before our reference goes: the session may close the socket
+    }
+}
 
-            // Check message type
-            auto msgType = FIXParser::getMessageType(data);
+bool TCPOrderGateway::processMessages(int clientSocket, FixSession *session, std::span<const char> buffer,
+                                      size_t &processed)
+{
+    processed = 0;
+    std::optional<FixScanner> fixScanner; // One delimiter scan for all FIX frames of this segment
+    uint64_t gapsBefore = 0;
+    if (session)
+    {
+        session->beginBatch(getCurrentTimeNs()); // One clock read for every frame of this recv()
+        gapsBefore = session->getGapCount();
+    }
+    while (processed < buffer.size())
+    {
+        size_t consumed = 0;
+        std::span<const char> data = buffer.subspan(processed);
 
-            // CLIENT REQUESTS STATS
-            if (msgType == "U1")
+        // BINARY ORDER ENTRY (first byte is the binary magic; FIX always starts with '8')
+        if (BinaryParser::isBinary(data))
+        {
+            if (BinaryParser::getMessageType(data) == BinaryParser::MSG_STATS_REQUEST)
             {
-                FIXParser::parse(data, consumed); // Advance consumed for complete/invalid U1 frame
+                BinaryParser::parse(data, consumed); // Advance consumed for the complete frame
                 if (consumed == 0)
                 {
-                    break; // Incomplete frame
+                    break;
                 }
-
-                // metrics_ set by main.cpp belonging to the matching engine
-                if (metrics_)
+                if (!handleStatsRequest(clientSocket, BinaryParser::getExpectedCount(data.first(consumed))))
                 {
-                    // Wait for processing to complete (Sync Benchmarking)
-                    // Tag 596 in our custom U1 message = ExpectedCount
-                    size_t expectedCount = 0;
-                    const std::string_view frame(data.data(), consumed);
-                    auto expectedCountStr = FIXParser::getTagValue(frame, 596);
-
-                    // Extract expected count from the FIX message
-                    if (!expectedCountStr.empty())
-                    {
-                        auto result = std::from_chars(expectedCountStr.data(),
-                                                      expectedCountStr.data() + expectedCountStr.size(), expectedCount);
-                        if (result.ec != std::errc{} || result.ptr != expectedCountStr.data() + expectedCountStr.size())
-                        {
-                            expectedCount = 0;
-                        }
-                    }
-
-                    // Wait until matching engine reaches expected order count, but never block forever.
-                    const auto waitStart = std::chrono::steady_clock::now();
-                    while (metrics_->getOrderCount() < expectedCount && running_)
-                    {
-                        if (std::chrono::steady_clock::now() - waitStart > std::chrono::seconds(30))
-                        {
-                            std::cerr << "Warning: Stats barrier timeout. expected=" << expectedCount
-                                      << " observed=" << metrics_->getOrderCount() << "\n";
-                            break;
-                        }
-                        std::this_thread::yield();
-                    }
-
-                    auto stats = metrics_->getStats();
-                    auto netStats = metrics_->getNetworkStats();
-                    auto engStats = metrics_->getEngineStats();
-                    auto queStats = metrics_->getQueueStats();
-
-                    char statsData[512];
-                    int len = std::snprintf(statsData, sizeof(statsData),
-                                            "8=FIX.4.2\x01"
-                                            "35=U2\x01"
-                                            "Mean=%0.2f\x01"
-                                            "P99=%llu\x01"
-                                            "Max=%llu\x01"
-                                            "NetMean=%0.2f\x01"
-                                            "QueMean=%0.2f\x01"
-                                            "EngMean=%0.2f\x01"
-                                            "Count=%llu\x01"
-                                            "10=000\x01",
-                                            stats.mean, (unsigned long long)stats.p99, (unsigned long long)stats.max,
-                                            netStats.mean, queStats.mean, engStats.mean,
-                                            (unsigned long long)metrics_->getOrderCount());
-                    if (len <= 0 || !sendAll(clientSocket, statsData, static_cast<size_t>(len)))
-                    {
-                        break;
-                    }
+                    return false;
                 }
             }
-            // CLIENT SENDING REGULAR ORDER
             else
             {
-                auto order = FIXParser::parse(data, consumed);
+                auto order = BinaryParser::parse(data, consumed, symbols_);
                 if (consumed == 0)
                 {
-                    break; // Incomplete message - need more data from socket
+                    break; // Incomplete frame
                 }
-
-                // If parsing succeeded, push order to lock-free queue for processing
                 if (order)
                 {
-                    // order->receiveTimestamp is set here, receiveTimestamp - sendTimestamp = network latency
-                    order->receiveTimestamp = getCurrentTimeNs();
-                    while (!orderQueue_.push(*order))
-                    {
-                        // Queue full - yield CPU and retry (busy-wait for low latency)
-                        std::this_thread::yield();
-                    }
+                    order->client = reports_ ? reports_->clientId(clientSocket) : 0;
+                    deliverOrder(*order);
                 }
             }
             processed += consumed;
+            continue;
+        }
+
+        // One pass over the FIX frame captures every field we read
+        if (!fixScanner)
+        {
+            fixScanner.emplace(buffer);
+        }
+        FixFields fields;
+        const auto status = FIXParser::tokenize(*fixScanner, processed, consumed, fields, validateFix_);
+        if (status == FIXParser::FrameStatus::Incomplete)
+        {
+            break; // Incomplete message - need more data from socket
+        }
+        if (status == FIXParser::FrameStatus::Malformed)
+        {
+            rejectedFrames_.fetch_add(1, std::memory_order_relaxed);
+            if (validateFix_ || session)
+            {
+                processed += consumed; // Failed validation: not even a U1 is acted on
+                continue;
+            }
+        }
+        if (session)
+        {
+            // Session messages, duplicates and frames past a gap stop here
+            const auto verdict = session->onMessage(fields);
+            if (verdict == FixSession::Verdict::Disconnect)
+            {
+                flushSession(clientSocket, *session);
+                return false;
+            }
+            if (session->outbox().size() >= FixSession::OUTBOX_BYTES / 2 && !flushSession(clientSocket, *session))
+            {
+                return false;
+            }
+            if (verdict == FixSession::Verdict::Consumed)
+            {
+                processed += consumed;
+                continue;
+            }
         }
 
-        // Move any unparsed/incomplete message data to the front of the buffer
-        // This handles FIX messages that span multiple recv() calls
-        if (processed < totalBytes)
+        // CLIENT REQUESTS STATS
+        if (fields.get(FixFields::MsgType) == "U1")
         {
-            std::memmove(buffer.data(), buffer.data() + processed, totalBytes - processed);
-            offset = totalBytes - processed; // Next recv() appends after this
+            // Wait for processing to complete (Sync Benchmarking)
+            // Tag 596 in our custom U1 message = ExpectedCount
+            size_t expectedCount = 0;
+            auto expectedCountStr = fields.get(FixFields::ExpectedCount);
+            if (!expectedCountStr.empty())
+            {
+                auto result = std::from_chars(expectedCountStr.data(),
+                                              expectedCountStr.data() + expectedCountStr.size(), expectedCount);
+                if (result.ec != std::errc{} || result.ptr != expectedCountStr.data() + expectedCountStr.size())
+                {
+                    expectedCount = 0;
+                }
+            }
+
+            if (!handleStatsRequest(clientSocket, expectedCount))
+            {
+                return false;
+            }
         }
-        else
+        // CLIENT SENDING REGULAR ORDER
+        else if (status == FIXParser::FrameStatus::Complete)
         {
-            offset = 0; // Buffer fully consumed, start fresh
+            // If parsing succeeded, hand the order to the matching engine
+            if (auto order = FIXParser::toOrder(fields, symbols_))
+            {
+                order->client = reports_ ? reports_->clientId(clientSocket) : 0;
+                deliverOrder(*order);
+            }
         }
+        processed += consumed;
+    }
+
+    if (session)
+    {
+        sessionGaps_.fetch_add(session->getGapCount() - gapsBefore, std::memory_order_relaxed);
+        return flushSession(clientSocket, *session);
+    }
+    return true;
+}
+
+bool TCPOrderGateway::flushSession(int clientSocket, FixSession &session)
+{
+    const auto outbox = session.outbox();
+    if (outbox.empty())
+    {
+        return true;
+    }
+    const bool sent = sendToClient(clientSocket, outbox.data(), outbox.size());
+    session.clearOutbox();
+    return sent;
+}
+
+bool TCPOrderGateway::runSessionTimer(int clientSocket, FixSession &session, uint64_t nowNs)
+{
+    const bool alive = session.onTimer(nowNs);
+    return flushSession(clientSocket, session) && alive;
+}
+
+bool TCPOrderGateway::sendToClient(int clientSocket, const char *data, size_t length)
+{
+    // With execution reports on, the writer thread shares the socket: go through it so nothing we send
+    // lands in the middle of a partially sent report.
+    return reports_ ? reports_->sendDirect(clientSocket, data, length) : sendAll(clientSocket, data, length);
+}
+
+bool TCPOrderGateway::handleStatsRequest(int clientSocket, size_t expectedCount)
+{
+    // metrics_ (single engine) or shardedEngine_ set by main.cpp
+    if (!metrics_ && !shardedEngine_)
+    {
+        return true;
+    }
+
+    if (mode_ != GatewayMode::Threaded)
+    {
+        // Blocking here would stall every other client, including ones whose orders
+        // the barrier is waiting for: the event loop answers once the count is reached.
+        pendingStats_.push_back(
+            {clientSocket, expectedCount, std::chrono::steady_clock::now() + std::chrono::seconds(30)});
+        return true;
+    }
+    return sendStatsReply(clientSocket, expectedCount);
+}
+
+size_t TCPOrderGateway::engineOrderCount() const
+{
+    if (shardedEngine_)
+    {
+        return shardedEngine_->getOrderCount();
+    }
+    return metrics_ ? metrics_->getOrderCount() : 0;
+}
+
+bool TCPOrderGateway::sendStatsReply(int clientSocket, size_t expectedCount)
+{
+    auto send = [&](const char *data, size_t length) { return sendToClient(clientSocket, data, length); };
+    return shardedEngine_ ? replyWithStats(*shardedEngine_, expectedCount, running_, send)
+                          : replyWithStats(*metrics_, expectedCount, running_, send);
+}
+
+void TCPOrderGateway::deliverOrder(Order &order)
+{
+    // order.receiveTimestamp is set here, receiveTimestamp - sendTimestamp = network latency
+    order.receiveTimestamp = getCurrentTimeNs();
+
+    if (shardedEngine_)
+    {
+        shardedEngine_->submit(order); // Routes by symbol and wakes the owning shard
+        return;
+    }
+
+    // The engine queue is SPSC but several client threads or parser workers may deliver at once:
+    // serialise producers. Uncontended (a single client) this is one exchange and one store.
+    auto tryPush = [&]()
+    {
+        while (ingressLock_.exchange(true, std::memory_order_acquire))
+        {
+            cpuRelax();
+        }
+        const bool pushed = orderQueue_.push(order);
+        ingressLock_.store(false, std::memory_order_release);
+        return pushed;
+    };
+
+    if (!tryPush())
+    {
+        // Queue full - pause-spin first (the engine usually frees a slot within
+        // a few hundred ns), then yield, then sleep if the engine is stalled.
+        // The lock is not held while backing off, so other producers back off too instead of
+        // spinning on it; each retries only its own order, so per-producer order still holds.
+        IdleStrategy fullQueueBackoff(IdleStrategyType::Backoff);
+        do
+        {
+            fullQueueBackoff.idle([]() { return false; });
+        } while (!tryPush());
+    }
+
+    if (idleStrategy_)
+    {
+        idleStrategy_->wake();
     }
-    close(clientSocket); // Clean up when client disconnects
 }
 
 } // namespace hft
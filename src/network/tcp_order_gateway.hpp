@@ -1,19 +1,50 @@
 #pragma once
 
+#include "core/metrics_collector.hpp"
 #include "core/order.hpp"
+#include "network/transport.hpp"
 #include "utils/lock_free_queue.hpp"
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
 #include <thread>
 #include <vector>
 
 namespace hft
 {
 
-class MetricsCollector;
+class IdleStrategy;
+class SymbolTable;
+class ShardedMatchingEngine;
+class GatewayParserPool;
+class ExecutionReportWriter;
+class FixSession;
+
+/**
+ * @brief How the gateway drives client I/O.
+ *
+ * Threaded - one accept thread plus one blocking recv() thread per client.
+ * Epoll    - one edge-triggered epoll loop handles accept, read and parse for every client (Linux only).
+ * IoUring  - one io_uring ring with multishot accept/recv into a provided buffer ring (Linux 6.0+);
+ *            falls back to Epoll at start-up when the kernel lacks support.
+ */
+enum class GatewayMode : uint8_t
+{
+    Threaded = 0,
+    Epoll = 1,
+    IoUring = 2
+};
 
 class TCPOrderGateway
 {
   public:
+    static std::vector<std::string> getSupportedModes();
+    static GatewayMode modeFromString(const std::string &name);
+    static const char *modeToString(GatewayMode mode);
+
     TCPOrderGateway(int port, LockFreeQueue<Order, 1024> &queue);
     ~TCPOrderGateway();
 
@@ -25,15 +56,162 @@ class TCPOrderGateway
         metrics_ = metrics;
     }
 
+    // Consumer wait strategy to signal after each push (wakes a parked matching engine)
+    void setIdleStrategy(IdleStrategy *idleStrategy)
+    {
+        idleStrategy_ = idleStrategy;
+    }
+
+    // Resolves FIX Symbol(55); orders for unknown symbols are dropped. Without a table every order
+    // goes to symbol 0. The table must be fully populated before start() and outlive the gateway.
+    void setSymbolTable(const SymbolTable *symbols)
+    {
+        symbols_ = symbols;
+    }
+
+    // Multi-core mode: orders go to engine->submit() (routed by symbol) instead of the single queue,
+    // and U1 stats are aggregated across shards. Replaces setMetricsCollector/setIdleStrategy.
+    void setShardedEngine(ShardedMatchingEngine *engine)
+    {
+        shardedEngine_ = engine;
+    }
+
+    // 0 (default): each connection thread parses what it reads. N > 0: connection threads only recv()
+    // and N pooled parser workers parse, preserving per-client order. Call before start().
+    void setParserThreads(size_t count)
+    {
+        parserThreads_ = count;
+    }
+
+    // I/O model; call before start(). The parser pool only applies to Threaded.
+    void setMode(GatewayMode mode)
+    {
+        mode_ = mode;
+    }
+
+    // Where clients connect (TCP on the constructor's port by default). Unix works with every mode;
+    // SharedMemory needs the threaded mode without a parser pool. Call before start().
+    void setTransport(TransportKind kind, const std::string &socketPath = "")
+    {
+        endpoint_.kind = kind;
+        endpoint_.path = socketPath;
+    }
+
+    const TransportEndpoint &getEndpoint() const
+    {
+        return endpoint_;
+    }
+
+    // Epoll/IoUring modes: core to pin the event loop thread to (-1 = unpinned), and whether it spins on
+    // epoll_wait(timeout 0) instead of sleeping in the kernel between events. With the shared-memory
+    // transport, busy polling makes each connection thread spin on its ring instead of backing off.
+    void setEventLoopCore(int core)
+    {
+        eventLoopCore_ = core;
+    }
+
+    void setBusyPoll(bool busyPoll)
+    {
+        busyPoll_ = busyPoll;
+    }
+
+    // Execution reports: every connection is registered with the writer, orders carry their connection's
+    // ClientId, and U2 replies go through the writer so they never interleave with a report. Call before
+    // start(); the writer must outlive the gateway and be the engine's ExecutionReportSink.
+    void setExecutionReportWriter(ExecutionReportWriter *writer)
+    {
+        reports_ = writer;
+    }
+
+    // Enforce FIX BodyLength(9) and CheckSum(10) on every session (off by default: frames are framed by
+    // BodyLength when it is right and by scanning for 10= otherwise, and the CheckSum value is not checked).
+    // Frames failing validation are consumed and dropped. Call before start().
+    void setFixValidation(bool enabled)
+    {
+        validateFix_ = enabled;
+    }
+
+    // FIX frames consumed but dropped as malformed (bad trailer, or failed validation)
+    uint64_t getRejectedFrames() const
+    {
+        return rejectedFrames_.load(std::memory_order_relaxed);
+    }
+
+    // Run a FixSession per FIX connection: the client must Logon first and every message must carry
+    // the next MsgSeqNum(34); gaps are recovered with ResendRequest, and heartbeats are exchanged at the
+    // client's HeartBtInt (not in parser pool mode, whose connections have no timer). Binary order entry
+    // bypasses the session. Call before start().
+    void setFixSession(bool enabled)
+    {
+        fixSession_ = enabled;
+    }
+
+    // Sequence gaps detected across all sessions (each one answered with a ResendRequest)
+    uint64_t getSessionGaps() const
+    {
+        return sessionGaps_.load(std::memory_order_relaxed);
+    }
+
+    // Per-connection mirrored receive ring; it only grows while a single partial frame fills it
+    static constexpr size_t RECEIVE_RING_BYTES = 64 * 1024;
+    static constexpr size_t MAX_RECEIVE_BYTES = 1U << 20; // Unbounded malformed stream: drop the client
+
   private:
+    static constexpr uint64_t SESSION_TIMER_NS = 100'000'000; // Heartbeat timer granularity
+
+    // U1 received on the event loop: answered once the engine reaches expectedCount (or at deadline),
+    // so the loop never blocks other clients while waiting for the engine.
+    struct PendingStatsRequest
+    {
+        int clientSocket;
+        size_t expectedCount;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
     void acceptLoop();
+    void eventLoop();
+    void ioUringLoop();
+    void flushPendingStats();
     void clientHandler(int clientSock);
+    void pooledClientHandler(int clientSock);
+    // Parses every complete message in buffer; processed = bytes consumed. False = drop the connection.
+    // FIX and binary frames may be mixed: each message's first byte selects its parser. With a session,
+    // FIX frames pass its sequence checks first and its replies are sent once for the whole buffer.
+    bool processMessages(int clientSock, FixSession *session, std::span<const char> buffer, size_t &processed);
+    // Sends and clears the session's queued replies. False if the client is gone.
+    bool flushSession(int clientSock, FixSession &session);
+    // Heartbeat/TestRequest timers, at most every SESSION_TIMER_NS. False = drop the connection.
+    bool runSessionTimer(int clientSock, FixSession &session, uint64_t nowNs);
+    // Session replies and U2 go through the report writer when there is one, so writes never interleave
+    bool sendToClient(int clientSock, const char *data, size_t length);
+    // U1 (FIX) or binary stats request: replies now (threaded) or queues for the event loop.
+    bool handleStatsRequest(int clientSocket, size_t expectedCount);
+    void deliverOrder(Order &order);
+    size_t engineOrderCount() const;
+    // Waits (bounded) for the engine to reach expectedCount, then sends a U2 stats frame.
+    bool sendStatsReply(int clientSocket, size_t expectedCount);
 
     int serverSocket_;
-    int port_;
+    TransportEndpoint endpoint_;
     LockFreeQueue<Order, 1024> &orderQueue_;
     std::atomic<bool> running_;
     const MetricsCollector *metrics_ = nullptr;
+    IdleStrategy *idleStrategy_ = nullptr;
+    const SymbolTable *symbols_ = nullptr;
+    ShardedMatchingEngine *shardedEngine_ = nullptr;
+    size_t parserThreads_ = 0;
+    std::unique_ptr<GatewayParserPool> parserPool_;
+    ExecutionReportWriter *reports_ = nullptr;
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> ingressLock_{false};
+    GatewayMode mode_ = GatewayMode::Threaded;
+    int eventLoopCore_ = -1;
+    bool busyPoll_ = false;
+    bool validateFix_ = false;
+    bool fixSession_ = false;
+    std::atomic<uint64_t> rejectedFrames_{0};
+    std::atomic<uint64_t> sessionGaps_{0};
+    std::vector<PendingStatsRequest> pendingStats_; // Event loop thread only
+    std::jthread eventLoopThread_;
     std::jthread acceptConnectionThread_;
     std::vector<std::jthread> clientThreads_;
 };
@@ -0,0 +1,285 @@
+#include "tcp_order_gateway.hpp"
+#include "fix/fix_session.hpp"
+#include "network/execution_report_writer.hpp"
+#include "network/mirrored_ring_buffer.hpp"
+#include "utils/rdtsc.hpp"
+#include "utils/thread_pinning.hpp"
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#endif
+
+/**
+ *
+ * Single-threaded gateway: one edge-triggered epoll loop accepts, reads and parses for all clients.
+ * No per-client threads, no blocking recv() timeouts, and with busy polling no kernel sleep between events.
+ *
+ */
+
+namespace hft
+{
+
+#if defined(__linux__)
+
+namespace
+{
+// Per-client framing state, same growth policy as the threaded handler.
+struct EpollConnection
+{
+    MirroredRingBuffer buffer{TCPOrderGateway::RECEIVE_RING_BYTES}; // Partial messages carried between reads
+    std::unique_ptr<FixSession> session;                             // With setFixSession(true)
+};
+
+constexpr int MAX_EVENTS = 64;
+
+bool setNonBlocking(int socketFd)
+{
+    const int flags = fcntl(socketFd, F_GETFL, 0);
+    return flags >= 0 && fcntl(socketFd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+} // namespace
+
+void TCPOrderGateway::eventLoop()
+{
+    if (eventLoopCore_ >= 0 && !pinToCore(eventLoopCore_))
+    {
+        std::cerr << "Warning: Failed to pin gateway event loop to core " << eventLoopCore_ << "." << std::endl;
+    }
+
+    const int epollFd = epoll_create1(0);
+    if (epollFd < 0 || !setNonBlocking(serverSocket_))
+    {
+        std::cerr << "Gateway event loop setup failed: " << std::strerror(errno) << std::endl;
+        if (epollFd >= 0)
+        {
+            close(epollFd);
+        }
+        return;
+    }
+
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN | EPOLLET;
+    listenEvent.data.fd = serverSocket_;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, serverSocket_, &listenEvent);
+
+    std::unordered_map<int, EpollConnection> connections;
+    std::array<epoll_event, MAX_EVENTS> events{};
+    uint64_t lastTimerNs = 0;
+    std::vector<int> expired; // Sessions the heartbeat timer gave up on
+
+    auto closeConnection = [&](int clientSocket)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, clientSocket, nullptr);
+        if (reports_)
+        {
+            reports_->closeClient(clientSocket);
+        }
+        close(clientSocket);
+        connections.erase(clientSocket);
+        // The descriptor number may be reused by the next accept: forget its pending U1
+        std::erase_if(pendingStats_, [&](const PendingStatsRequest &r) { return r.clientSocket == clientSocket; });
+    };
+
+    auto acceptAll = [&]()
+    {
+        // Edge-triggered: drain the accept queue completely
+        for (;;)
+        {
+            const int clientSocket = accept4(serverSocket_, nullptr, nullptr, SOCK_NONBLOCK);
+            if (clientSocket < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (running_ && errno != EAGAIN && errno != EWOULDBLOCK)
+                {
+                    std::cerr << "Accept failed" << std::endl;
+                }
+                return;
+            }
+
+            // U2 replies are small and latency-sensitive
+            int noDelay = 1;
+            setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+            epoll_event clientEvent{};
+            clientEvent.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+            clientEvent.data.fd = clientSocket;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientSocket, &clientEvent) < 0)
+            {
+                close(clientSocket);
+                continue;
+            }
+            auto &conn = connections.try_emplace(clientSocket).first->second;
+            if (fixSession_)
+            {
+                conn.session = std::make_unique<FixSession>();
+            }
+            if (reports_)
+            {
+                reports_->openClient(clientSocket);
+            }
+        }
+    };
+
+    // Returns false when the connection should be closed
+    auto readAll = [&](int clientSocket, EpollConnection &conn)
+    {
+        // Edge-triggered: keep reading until the socket reports EAGAIN, or we would miss data
+        for (;;)
+        {
+            if (conn.buffer.writable() == 0 && !conn.buffer.grow(MAX_RECEIVE_BYTES))
+            {
+                return false; // Drop unbounded malformed stream from this client.
+            }
+
+            const ssize_t bytesRead = recv(clientSocket, conn.buffer.writeData(), conn.buffer.writable(), 0);
+            if (bytesRead < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            if (bytesRead == 0)
+            {
+                return false; // Connection closed by peer
+            }
+
+            conn.buffer.commit(static_cast<size_t>(bytesRead));
+            size_t processed = 0;
+            if (!processMessages(clientSocket, conn.session.get(), conn.buffer.readable(), processed))
+            {
+                return false;
+            }
+            conn.buffer.consume(processed);
+        }
+    };
+
+    while (running_)
+    {
+        // Busy polling never sleeps in the kernel. Otherwise wake often enough to answer pending U1
+        // barriers promptly and to notice stop().
+        const int timeoutMs = busyPoll_ ? 0 : (pendingStats_.empty() ? 100 : 1);
+        const int ready = epoll_wait(epollFd, events.data(), MAX_EVENTS, timeoutMs);
+        if (ready < 0 && errno != EINTR)
+        {
+            std::cerr << "epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < ready; ++i)
+        {
+            const int fd = events[i].data.fd;
+            if (fd == serverSocket_)
+            {
+                acceptAll();
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end())
+            {
+                continue;
+            }
+
+            // Read even on hang-up: the peer may have sent its last orders together with the FIN
+            const bool keepOpen = readAll(fd, it->second);
+            if (!keepOpen || (events[i].events & (EPOLLERR | EPOLLHUP)))
+            {
+                flushPendingStats(); // A client may send U1 and close; answer it if the count is reached
+                closeConnection(fd);
+            }
+        }
+
+        flushPendingStats();
+
+        // Session heartbeats: one sweep over every connection per timer period
+        if (fixSession_)
+        {
+            const uint64_t nowNs = getCurrentTimeNs();
+            if (nowNs - lastTimerNs >= SESSION_TIMER_NS)
+            {
+                lastTimerNs = nowNs;
+                for (auto &[clientSocket, conn] : connections)
+                {
+                    if (conn.session && !runSessionTimer(clientSocket, *conn.session, nowNs))
+                    {
+                        expired.push_back(clientSocket);
+                    }
+                }
+                for (const int clientSocket : expired)
+                {
+                    closeConnection(clientSocket);
+                }
+                expired.clear();
+            }
+        }
+    }
+
+    for (auto &[clientSocket, conn] : connections)
+    {
+        if (reports_)
+        {
+            reports_->closeClient(clientSocket);
+        }
+        close(clientSocket);
+    }
+    pendingStats_.clear();
+    close(epollFd);
+}
+
+void TCPOrderGateway::flushPendingStats()
+{
+    if (pendingStats_.empty())
+    {
+        return;
+    }
+
+    const size_t observed = engineOrderCount();
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(pendingStats_,
+                  [&](const PendingStatsRequest &request)
+                  {
+                      if (observed < request.expectedCount && now < request.deadline)
+                      {
+                          return false;
+                      }
+                      if (observed < request.expectedCount)
+                      {
+                          std::cerr << "Warning: Stats barrier timeout. expected=" << request.expectedCount
+                                    << " observed=" << observed << "\n";
+                      }
+                      sendStatsReply(request.clientSocket, 0); // Count reached or timed out: reply now
+                      return true;
+                  });
+}
+
+#else
+
+void TCPOrderGateway::eventLoop()
+{
+}
+
+void TCPOrderGateway::flushPendingStats()
+{
+}
+
+#endif
+
+} // namespace hft
@@ -0,0 +1,289 @@
+// Before the kernel headers: <linux/fs.h> defines a BLOCK_SIZE macro that clashes with FixScanner
+#include "fix/fix_session.hpp"
+#include "io_uring_ring.hpp"
+#include "tcp_order_gateway.hpp"
+#include "network/execution_report_writer.hpp"
+#include "utils/rdtsc.hpp"
+#include "utils/thread_pinning.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#if HFT_HAS_IO_URING
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+/**
+ *
+ * io_uring gateway: one thread, one ring. A multishot accept produces a completion per new client,
+ * and a multishot recv per client produces a completion per chunk of bytes, each landing in a buffer
+ * from the provided buffer ring. In steady state nothing is re-armed, so the only syscall is the wait
+ * for completions (none at all with busy polling). Parsing and delivery are the same as the other modes.
+ *
+ */
+
+namespace hft
+{
+
+#if HFT_HAS_IO_URING
+
+namespace
+{
+constexpr unsigned RING_ENTRIES = 256;
+constexpr unsigned COMPLETION_ENTRIES = 4096;
+constexpr uint16_t BUFFER_GROUP = 0;
+constexpr uint16_t BUFFER_COUNT = 512;     // Power of two
+constexpr uint32_t BUFFER_SIZE = 16 * 1024; // 8MB receive arena
+constexpr size_t MAX_CARRY_BYTES = 1U << 20;
+
+enum class UringOp : uint64_t
+{
+    Accept = 1,
+    Recv = 2
+};
+
+uint64_t tag(UringOp op, int fd)
+{
+    return (static_cast<uint64_t>(op) << 32) | static_cast<uint32_t>(fd);
+}
+
+struct UringConnection
+{
+    std::vector<char> carry;             // Partial message left over from previous buffers
+    std::unique_ptr<FixSession> session; // With setFixSession(true)
+    bool closing = false;                // Parse failed: recv was shut down, waiting for its final completion
+};
+} // namespace
+
+void TCPOrderGateway::ioUringLoop()
+{
+    if (eventLoopCore_ >= 0 && !pinToCore(eventLoopCore_))
+    {
+        std::cerr << "Warning: Failed to pin gateway event loop to core " << eventLoopCore_ << "." << std::endl;
+    }
+
+    std::unique_ptr<IoUringRing> ringOwner;
+    try
+    {
+        ringOwner = std::make_unique<IoUringRing>(RING_ENTRIES, COMPLETION_ENTRIES);
+        ringOwner->setupBufferRing(BUFFER_GROUP, BUFFER_COUNT, BUFFER_SIZE);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Warning: io_uring unavailable (" << e.what() << "), falling back to the epoll gateway."
+                  << std::endl;
+        ringOwner.reset();
+        eventLoop();
+        return;
+    }
+    IoUringRing &ring = *ringOwner;
+
+    std::unordered_map<int, UringConnection> connections;
+    uint64_t lastTimerNs = 0;
+
+    // Queues an SQE, flushing to the kernel first if the submission queue is full
+    auto nextSqe = [&]()
+    {
+        io_uring_sqe *sqe = ring.getSqe();
+        while (!sqe)
+        {
+            ring.submit();
+            sqe = ring.getSqe();
+        }
+        return sqe;
+    };
+
+    auto armAccept = [&]()
+    {
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = serverSocket_;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->user_data = tag(UringOp::Accept, serverSocket_);
+    };
+
+    auto armRecv = [&](int clientSocket)
+    {
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = clientSocket;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT; // Kernel picks the buffer from BUFFER_GROUP
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = tag(UringOp::Recv, clientSocket);
+    };
+
+    auto closeConnection = [&](int clientSocket)
+    {
+        if (reports_)
+        {
+            reports_->closeClient(clientSocket);
+        }
+        close(clientSocket);
+        connections.erase(clientSocket);
+        std::erase_if(pendingStats_, [&](const PendingStatsRequest &r) { return r.clientSocket == clientSocket; });
+    };
+
+    // Ends the multishot recv; the connection is closed on its final completion
+    auto closeRecv = [&](int clientSocket, UringConnection &conn)
+    {
+        conn.closing = true;
+        conn.carry.clear();
+        shutdown(clientSocket, SHUT_RDWR);
+    };
+
+    // Parses straight out of the provided buffer when nothing is carried over (the common case)
+    auto onData = [&](int clientSocket, UringConnection &conn, const char *data, size_t length)
+    {
+        size_t processed = 0;
+        bool keepOpen;
+        if (conn.carry.empty())
+        {
+            keepOpen =
+                processMessages(clientSocket, conn.session.get(), std::span<const char>(data, length), processed);
+            if (keepOpen && processed < length)
+            {
+                conn.carry.assign(data + processed, data + length);
+            }
+        }
+        else
+        {
+            conn.carry.insert(conn.carry.end(), data, data + length);
+            keepOpen = processMessages(clientSocket, conn.session.get(), conn.carry, processed);
+            conn.carry.erase(conn.carry.begin(), conn.carry.begin() + static_cast<std::ptrdiff_t>(processed));
+        }
+
+        if (!keepOpen || conn.carry.size() >= MAX_CARRY_BYTES)
+        {
+            closeRecv(clientSocket, conn);
+        }
+    };
+
+    auto onCompletion = [&](const io_uring_cqe &cqe)
+    {
+        const auto op = static_cast<UringOp>(cqe.user_data >> 32);
+        const bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+
+        if (op == UringOp::Accept)
+        {
+            if (cqe.res >= 0)
+            {
+                const int clientSocket = cqe.res;
+                int noDelay = 1;
+                setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                auto &conn = connections.try_emplace(clientSocket).first->second;
+                if (fixSession_)
+                {
+                    conn.session = std::make_unique<FixSession>();
+                }
+                if (reports_)
+                {
+                    reports_->openClient(clientSocket);
+                }
+                armRecv(clientSocket);
+            }
+            if (!more && running_)
+            {
+                armAccept();
+            }
+            return;
+        }
+
+        const int clientSocket = static_cast<int>(cqe.user_data & 0xffffffffu);
+        auto it = connections.find(clientSocket);
+
+        if (cqe.flags & IORING_CQE_F_BUFFER)
+        {
+            const auto bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            if (cqe.res > 0 && it != connections.end() && !it->second.closing)
+            {
+                onData(clientSocket, it->second, ring.buffer(bufferId), static_cast<size_t>(cqe.res));
+            }
+            ring.recycleBuffer(bufferId);
+        }
+
+        if (more || it == connections.end())
+        {
+            return;
+        }
+
+        // The multishot recv ended. Out of buffers (or a data completion that ends it): re-arm.
+        // EOF, errors and shut-down connections: close.
+        if (!it->second.closing && (cqe.res > 0 || cqe.res == -ENOBUFS))
+        {
+            armRecv(clientSocket);
+        }
+        else
+        {
+            flushPendingStats(); // A client may send U1 and close; answer it if the count is reached
+            closeConnection(clientSocket);
+        }
+    };
+
+    armAccept();
+
+    while (running_)
+    {
+        if (busyPoll_)
+        {
+            ring.submit(); // No-op unless something was re-armed
+        }
+        else
+        {
+            // Wake often enough to answer pending U1 barriers promptly and to notice stop()
+            ring.submitAndWait(pendingStats_.empty() ? std::chrono::milliseconds(100) : std::chrono::milliseconds(1));
+        }
+
+        ring.drainCompletions(onCompletion);
+        ring.publishBuffers();
+        flushPendingStats();
+
+        // Session heartbeats: one sweep over every connection per timer period
+        if (fixSession_)
+        {
+            const uint64_t nowNs = getCurrentTimeNs();
+            if (nowNs - lastTimerNs >= SESSION_TIMER_NS)
+            {
+                lastTimerNs = nowNs;
+                for (auto &[clientSocket, conn] : connections)
+                {
+                    if (conn.session && !conn.closing && !runSessionTimer(clientSocket, *conn.session, nowNs))
+                    {
+                        closeRecv(clientSocket, conn);
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto &[clientSocket, conn] : connections)
+    {
+        if (reports_)
+        {
+            reports_->closeClient(clientSocket);
+        }
+        close(clientSocket);
+    }
+    pendingStats_.clear();
+}
+
+#else
+
+void TCPOrderGateway::ioUringLoop()
+{
+    std::cerr << "Warning: built without io_uring support, falling back to the epoll gateway." << std::endl;
+    eventLoop();
+}
+
+#endif
+
+} // namespace hft
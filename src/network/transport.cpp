@@ -0,0 +1,263 @@
+#include "transport.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hft
+{
+
+namespace
+{
+// False when the path does not fit sun_path
+bool makeUnixAddress(const std::string &path, sockaddr_un &address)
+{
+    address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+} // namespace
+
+std::vector<std::string> TransportEndpoint::getSupportedKinds()
+{
+    return {"tcp", "unix", "shm"};
+}
+
+TransportKind TransportEndpoint::kindFromString(const std::string &name)
+{
+    if (name == "tcp")
+    {
+        return TransportKind::Tcp;
+    }
+    else if (name == "unix")
+    {
+        return TransportKind::Unix;
+    }
+    else if (name == "shm")
+    {
+        return TransportKind::SharedMemory;
+    }
+
+    throw std::runtime_error("Unknown transport: " + name);
+}
+
+const char *TransportEndpoint::kindToString(TransportKind kind)
+{
+    switch (kind)
+    {
+        case TransportKind::Tcp:
+            return "tcp";
+        case TransportKind::Unix:
+            return "unix";
+        case TransportKind::SharedMemory:
+            return "shm";
+    }
+    return "unknown";
+}
+
+std::string TransportEndpoint::defaultSocketPath(int port)
+{
+    return "/tmp/hft-gateway-" + std::to_string(port) + ".sock";
+}
+
+std::string TransportEndpoint::describe() const
+{
+    if (kind == TransportKind::Tcp)
+    {
+        return "tcp:" + std::to_string(port);
+    }
+    return std::string(kindToString(kind)) + ":" + socketPath();
+}
+
+int TransportEndpoint::listen() const
+{
+    int serverSocket = -1;
+    if (kind == TransportKind::Tcp)
+    {
+        // Create TCP socket: AF_INET = IPv4, SOCK_STREAM = TCP, 0 = default protocol
+        serverSocket = socket(AF_INET, SOCK_STREAM, 0);
+        if (serverSocket < 0)
+        {
+            throw std::runtime_error("Failed to create socket");
+        }
+
+        // Allow immediate socket reuse after restart (avoids "Address already in use" errors)
+        int reuseAddressOption = 1;
+        setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddressOption, sizeof(reuseAddressOption));
+
+        // Configure server address structure
+        sockaddr_in serverAddress{};
+        serverAddress.sin_family = AF_INET;         // IPv4
+        serverAddress.sin_addr.s_addr = INADDR_ANY; // Bind to all network interfaces (0.0.0.0)
+        serverAddress.sin_port = htons(port);       // Convert port to network byte order (big-endian)
+
+        // Bind socket to the address and port
+        if (bind(serverSocket, (struct sockaddr *)&serverAddress, sizeof(serverAddress)) < 0)
+        {
+            close(serverSocket);
+            throw std::runtime_error("Failed to bind socket");
+        }
+    }
+    else
+    {
+        const std::string socketFile = socketPath();
+        sockaddr_un serverAddress;
+        if (!makeUnixAddress(socketFile, serverAddress))
+        {
+            throw std::runtime_error("Unix socket path too long: " + socketFile);
+        }
+        serverSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (serverSocket < 0)
+        {
+            throw std::runtime_error("Failed to create socket");
+        }
+
+        // A previous server that did not shut down cleanly leaves its socket file behind
+        unlink(socketFile.c_str());
+        if (bind(serverSocket, (struct sockaddr *)&serverAddress, sizeof(serverAddress)) < 0)
+        {
+            close(serverSocket);
+            throw std::runtime_error("Failed to bind socket " + socketFile);
+        }
+    }
+
+    // Start listening for connections. Benchmarks open dozens of clients back to back, so allow a full backlog
+    if (::listen(serverSocket, SOMAXCONN) < 0)
+    {
+        close(serverSocket);
+        throw std::runtime_error("Failed to listen");
+    }
+    return serverSocket;
+}
+
+int TransportEndpoint::connect(const std::string &host) const
+{
+    int sock = -1;
+    int result = -1;
+    if (kind == TransportKind::Tcp)
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) <= 0)
+        {
+            errno = EINVAL;
+            return -1;
+        }
+        sock = socket(AF_INET, SOCK_STREAM, 0);
+        if (sock >= 0)
+        {
+            result = ::connect(sock, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+        }
+    }
+    else
+    {
+        sockaddr_un address;
+        if (!makeUnixAddress(socketPath(), address))
+        {
+            errno = ENAMETOOLONG;
+            return -1;
+        }
+        sock = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (sock >= 0)
+        {
+            result = ::connect(sock, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+        }
+    }
+
+    if (sock >= 0 && result < 0)
+    {
+        const int error = errno;
+        close(sock);
+        errno = error;
+        return -1;
+    }
+    return sock;
+}
+
+void TransportEndpoint::removeSocketFile() const
+{
+    if (kind != TransportKind::Tcp)
+    {
+        unlink(socketPath().c_str());
+    }
+}
+
+bool sendDescriptor(int socketFd, int fd)
+{
+    char payload = 'F'; // At least one byte of data has to carry the control message
+    iovec io{&payload, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+    msghdr message{};
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr *header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(header), &fd, sizeof(int));
+
+    ssize_t sent;
+    do
+    {
+        sent = sendmsg(socketFd, &message, 0);
+    } while (sent < 0 && errno == EINTR);
+    return sent == 1;
+}
+
+int receiveDescriptor(int socketFd)
+{
+    char payload = 0;
+    iovec io{&payload, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+    msghdr message{};
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do
+    {
+#if defined(MSG_CMSG_CLOEXEC)
+        received = recvmsg(socketFd, &message, MSG_CMSG_CLOEXEC);
+#else
+        received = recvmsg(socketFd, &message, 0);
+#endif
+    } while (received < 0 && errno == EINTR);
+    if (received == 0)
+    {
+        errno = ECONNRESET;
+    }
+    if (received != 1)
+    {
+        return -1;
+    }
+
+    cmsghdr *header = CMSG_FIRSTHDR(&message);
+    if (!header || header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS ||
+        header->cmsg_len != CMSG_LEN(sizeof(int)))
+    {
+        errno = EPROTO;
+        return -1;
+    }
+    int fd = -1;
+    std::memcpy(&fd, CMSG_DATA(header), sizeof(int));
+    return fd;
+}
+
+} // namespace hft
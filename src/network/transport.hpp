@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hft
+{
+
+/**
+ * @brief How client bytes reach the gateway.
+ *
+ * Tcp          - AF_INET stream socket on the port (the default).
+ * Unix         - AF_UNIX stream socket at a filesystem path: the same byte stream without the TCP/IP
+ *                stack. Every gateway mode works unchanged on it.
+ * SharedMemory - orders go through a ShmChannel (SPSC byte ring in shared memory) that the client
+ *                creates and passes over the Unix socket with SCM_RIGHTS. The socket stays open for
+ *                the replies (session, U2, execution reports) and to notice a client that went away.
+ *                Threaded gateway mode only; kernel-bypass transports would plug in at the same seam.
+ */
+enum class TransportKind : uint8_t
+{
+    Tcp = 0,
+    Unix = 1,
+    SharedMemory = 2
+};
+
+/**
+ * @brief Where the gateway listens and clients connect: a TCP port or a Unix socket path.
+ */
+struct TransportEndpoint
+{
+    TransportKind kind = TransportKind::Tcp;
+    int port = 12345;
+    std::string path; // Unix and SharedMemory; empty = defaultSocketPath(port)
+
+    static std::vector<std::string> getSupportedKinds();
+    static TransportKind kindFromString(const std::string &name);
+    static const char *kindToString(TransportKind kind);
+
+    // Per-port default, so several servers can run side by side as they do on TCP
+    static std::string defaultSocketPath(int port);
+
+    std::string socketPath() const
+    {
+        return path.empty() ? defaultSocketPath(port) : path;
+    }
+
+    // "tcp:12345" or "unix:/tmp/..." for logs
+    std::string describe() const;
+
+    // Bound and listening socket. A stale socket file at the path is replaced. Throws std::runtime_error.
+    int listen() const;
+
+    // Connected stream socket (host applies to Tcp only), or -1 with errno set
+    int connect(const std::string &host) const;
+
+    // Removes the socket file listen() created
+    void removeSocketFile() const;
+};
+
+// SCM_RIGHTS: passes a copy of fd over a connected Unix socket (the shared-memory handshake)
+bool sendDescriptor(int socketFd, int fd);
+
+// The descriptor sent by the peer, or -1 (closed, no descriptor attached, or the socket's SO_RCVTIMEO expired)
+int receiveDescriptor(int socketFd);
+
+} // namespace hft
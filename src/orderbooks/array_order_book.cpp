@@ -1,4 +1,5 @@
 #include "array_order_book.hpp"
+#include "core/match_probe.hpp"
 #include <iostream>
 #include <stdexcept>
 
@@ -146,24 +147,30 @@ void ArrayOrderBook::modifyOrder(OrderId orderId, Quantity newQuantity)
 
 std::vector<Trade> ArrayOrderBook::match()
 {
+    MatchProbe probe(MatchPhase::Other);
     std::vector<Trade> trades;
 
     while (cachedBestBid_ >= cachedBestAsk_)
     {
+        MatchProbe levelProbe(MatchPhase::LevelLookup);
         Index bidIndex = priceToIndex(cachedBestBid_);
         Index askIndex = priceToIndex(cachedBestAsk_);
 
         auto &bidList = bidLevels_[bidIndex];
         auto &askList = askLevels_[askIndex];
+        levelProbe.stop();
 
         // Price time priority
+        MatchProbe walkProbe(MatchPhase::FifoWalk);
         Order &bidOrder = bidList.front();
         Order &askOrder = askList.front();
 
         Quantity tradeQty = std::min(bidOrder.quantity, askOrder.quantity);
 
         // Create trade
-        trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty});
+        MatchProbe emitProbe(MatchPhase::TradeEmit);
+        trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty, bidOrder.client, askOrder.client});
+        emitProbe.stop();
 
         // Update quantities
         bidOrder.quantity -= tradeQty;
@@ -172,10 +179,13 @@ std::vector<Trade> ArrayOrderBook::match()
         // Clean up empty price levels (must update caches and activeLevels on empty)
         if (bidOrder.quantity == 0)
         {
+            MatchProbe eraseProbe(MatchPhase::LookupErase);
             orderLookup_.erase(bidOrder.id);
+            eraseProbe.stop();
             bidList.pop_front();
             if (bidList.empty())
             {
+                MatchProbe rescanProbe(MatchPhase::LevelLookup); // Linear scan for the next best bid
                 activeBidLevels_[bidIndex] = false;
                 updateBestBidCache();
             }
@@ -183,10 +193,13 @@ std::vector<Trade> ArrayOrderBook::match()
 
         if (askOrder.quantity == 0)
         {
+            MatchProbe eraseProbe(MatchPhase::LookupErase);
             orderLookup_.erase(askOrder.id);
+            eraseProbe.stop();
             askList.pop_front();
             if (askList.empty())
             {
+                MatchProbe rescanProbe(MatchPhase::LevelLookup);
                 activeAskLevels_[askIndex] = false;
                 updateBestAskCache();
             }
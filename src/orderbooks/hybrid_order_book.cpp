@@ -1,4 +1,5 @@
 #include "hybrid_order_book.hpp"
+#include "core/match_probe.hpp"
 #include <algorithm>
 #include <iostream>
 
@@ -213,10 +214,13 @@ void HybridOrderBook::modifyOrder(OrderId orderId, Quantity newQuantity)
 // Lazy promotion: only promotes from cold when needed for matching.
 std::vector<Trade> HybridOrderBook::match()
 {
+    MatchProbe probe(MatchPhase::Other);
     std::vector<Trade> trades;
 
     while (true)
     {
+        MatchProbe levelProbe(MatchPhase::LevelLookup);
+
         // Get best bid (check hot first, then cold)
         Price bestBidPrice = 0;
         bool bidInHot = !hotBids_.empty();
@@ -264,15 +268,19 @@ std::vector<Trade> HybridOrderBook::match()
         // Match orders at this price level
         auto &bidOrderList = hotBids_.front().second;
         auto &askOrderList = hotAsks_.front().second;
+        levelProbe.stop();
 
         while (!bidOrderList.empty() && !askOrderList.empty())
         {
+            MatchProbe walkProbe(MatchPhase::FifoWalk);
             auto &bidOrder = bidOrderList.front();
             auto &askOrder = askOrderList.front();
 
             Quantity tradeQty = std::min(bidOrder.quantity, askOrder.quantity);
 
-            trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty});
+            MatchProbe emitProbe(MatchPhase::TradeEmit);
+            trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty, bidOrder.client, askOrder.client});
+            emitProbe.stop();
 
             bidOrder.quantity -= tradeQty;
             askOrder.quantity -= tradeQty;
@@ -280,17 +288,22 @@ std::vector<Trade> HybridOrderBook::match()
             // Remove filled orders
             if (bidOrder.quantity == 0)
             {
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(bidOrder.id);
+                eraseProbe.stop();
                 bidOrderList.pop_front();
             }
             if (askOrder.quantity == 0)
             {
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(askOrder.id);
+                eraseProbe.stop();
                 askOrderList.pop_front();
             }
         }
 
         // Clean up empty price levels
+        MatchProbe cleanupProbe(MatchPhase::LevelLookup);
         if (bidOrderList.empty())
         {
             hotBids_.erase(hotBids_.begin());
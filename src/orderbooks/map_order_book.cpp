@@ -1,4 +1,5 @@
 #include "map_order_book.hpp"
+#include "core/match_probe.hpp"
 #include <iostream>
 
 namespace hft
@@ -86,11 +87,13 @@ void MapOrderBook::modifyOrder(OrderId orderId, Quantity newQuantity)
 // Returns a vector of executed trades.
 std::vector<Trade> MapOrderBook::match()
 {
+    MatchProbe probe(MatchPhase::Other);
     std::vector<Trade> trades;
 
     // Continue matching while there are overlapping prices
     while (!bids_.empty() && !asks_.empty())
     {
+        MatchProbe levelProbe(MatchPhase::LevelLookup);
         auto bestBidIterator = bids_.begin(); // Highest buy price
         auto bestAskIterator = asks_.begin(); // Lowest sell price
 
@@ -103,16 +106,20 @@ std::vector<Trade> MapOrderBook::match()
         // Iterator to the best price lists
         auto &bidOrderList = bestBidIterator->second;
         auto &askOrderList = bestAskIterator->second;
+        levelProbe.stop();
 
         // Match orders at this price level
         while (!bidOrderList.empty() && !askOrderList.empty())
         {
+            MatchProbe walkProbe(MatchPhase::FifoWalk);
             auto &bidOrder = bidOrderList.front();
             auto &askOrder = askOrderList.front();
 
             Quantity tradeQty = std::min(bidOrder.quantity, askOrder.quantity);
 
-            trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty});
+            MatchProbe emitProbe(MatchPhase::TradeEmit);
+            trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty, bidOrder.client, askOrder.client});
+            emitProbe.stop();
 
             bidOrder.quantity -= tradeQty;
             askOrder.quantity -= tradeQty;
@@ -120,17 +127,22 @@ std::vector<Trade> MapOrderBook::match()
             // Remove filled orders
             if (bidOrder.quantity == 0)
             {
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(bidOrder.id);
+                eraseProbe.stop();
                 bidOrderList.pop_front();
             }
             if (askOrder.quantity == 0)
             {
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(askOrder.id);
+                eraseProbe.stop();
                 askOrderList.pop_front();
             }
         }
 
         // Clean up empty price levels
+        MatchProbe cleanupProbe(MatchPhase::LevelLookup);
         if (bidOrderList.empty())
         {
             bids_.erase(bestBidIterator);
@@ -1,4 +1,5 @@
 #include "pool_order_book.hpp"
+#include "core/match_probe.hpp"
 #include <algorithm>
 #include <stdexcept>
 
@@ -86,11 +87,13 @@ void PoolOrderBook::modifyOrder(OrderId orderId, Quantity newQuantity)
 
 std::vector<Trade> PoolOrderBook::match()
 {
+    MatchProbe probe(MatchPhase::Other);
     std::vector<Trade> trades;
     trades.reserve(100);
 
     while (!bids_.empty() && !asks_.empty())
     {
+        MatchProbe levelProbe(MatchPhase::LevelLookup);
         auto bestBidIt = bids_.begin();
         auto bestAskIt = asks_.begin();
 
@@ -105,18 +108,21 @@ std::vector<Trade> PoolOrderBook::match()
 
         Index bidIdx = bidLevel.head;
         Index askIdx = askLevel.head;
+        levelProbe.stop();
 
         // Iterate through orders at this price level.
         while (true)
         {
-
+            MatchProbe walkProbe(MatchPhase::FifoWalk);
             Order &bid = orders_[bidIdx].order;
             Order &ask = orders_[askIdx].order;
 
             // Determine trade size (minimum of the two order quantities).
             Quantity quantity = std::min(bid.quantity, ask.quantity);
 
-            trades.push_back({bid.id, ask.id, ask.price, quantity});
+            MatchProbe emitProbe(MatchPhase::TradeEmit);
+            trades.push_back({bid.id, ask.id, ask.price, quantity, bid.client, ask.client});
+            emitProbe.stop();
 
             bid.quantity -= quantity;
             ask.quantity -= quantity;
@@ -141,20 +147,30 @@ std::vector<Trade> PoolOrderBook::match()
             }
 
             // Remove filled orders from the book and return slot to pool.
+            // removeFromLevel looks the level up in the ladder again, so it counts as level lookup.
             if (bidToRemove != NULL_IDX)
             {
+                MatchProbe unlinkProbe(MatchPhase::LevelLookup);
                 removeFromLevel(bids_, bidToRemove);
+                unlinkProbe.stop();
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(bid.id);
+                eraseProbe.stop();
                 freeSlot(bidToRemove);
             }
 
             if (askToRemove != NULL_IDX)
             {
+                MatchProbe unlinkProbe(MatchPhase::LevelLookup);
                 removeFromLevel(asks_, askToRemove);
+                unlinkProbe.stop();
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(ask.id);
+                eraseProbe.stop();
                 freeSlot(askToRemove);
             }
 
+            MatchProbe levelCheckProbe(MatchPhase::LevelLookup);
             if (bids_.find(bidLevel.price) == bids_.end() || asks_.find(askLevel.price) == asks_.end())
             {
                 break;
@@ -1,4 +1,5 @@
 #include "vector_order_book.hpp"
+#include "core/match_probe.hpp"
 #include <algorithm>
 #include <iostream>
 
@@ -130,11 +131,13 @@ void VectorOrderBook::modifyOrder(OrderId orderId, Quantity newQuantity)
 // Returns a vector of executed trades.
 std::vector<Trade> VectorOrderBook::match()
 {
+    MatchProbe probe(MatchPhase::Other);
     std::vector<Trade> trades;
 
     // Continue matching while there are overlapping prices
     while (!bids_.empty() && !asks_.empty())
     {
+        MatchProbe levelProbe(MatchPhase::LevelLookup);
         auto &bestBid = bids_.front(); // Highest buy price
         auto &bestAsk = asks_.front(); // Lowest sell price
 
@@ -146,16 +149,20 @@ std::vector<Trade> VectorOrderBook::match()
 
         auto &bidOrderList = bestBid.second;
         auto &askOrderList = bestAsk.second;
+        levelProbe.stop();
 
         // Match orders at this price level
         while (!bidOrderList.empty() && !askOrderList.empty())
         {
+            MatchProbe walkProbe(MatchPhase::FifoWalk);
             auto &bidOrder = bidOrderList.front();
             auto &askOrder = askOrderList.front();
 
             Quantity tradeQty = std::min(bidOrder.quantity, askOrder.quantity);
 
-            trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty});
+            MatchProbe emitProbe(MatchPhase::TradeEmit);
+            trades.push_back({bidOrder.id, askOrder.id, askOrder.price, tradeQty, bidOrder.client, askOrder.client});
+            emitProbe.stop();
 
             bidOrder.quantity -= tradeQty;
             askOrder.quantity -= tradeQty;
@@ -163,17 +170,22 @@ std::vector<Trade> VectorOrderBook::match()
             // Remove filled orders
             if (bidOrder.quantity == 0)
             {
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(bidOrder.id);
+                eraseProbe.stop();
                 bidOrderList.pop_front();
             }
             if (askOrder.quantity == 0)
             {
+                MatchProbe eraseProbe(MatchPhase::LookupErase);
                 orderLookup_.erase(askOrder.id);
+                eraseProbe.stop();
                 askOrderList.pop_front();
             }
         }
 
-        // Clean up empty price levels
+        // Clean up empty price levels (shifts the vector)
+        MatchProbe cleanupProbe(MatchPhase::LevelLookup);
         if (bidOrderList.empty())
         {
             bids_.erase(bids_.begin());
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "utils/lock_free_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hft
+{
+
+/**
+ * @brief How a consumer thread waits when its input queue is empty.
+ *
+ * BusySpin  - re-poll immediately (lowest wake-up latency, 100% of a core).
+ * Pause     - re-poll after a CPU pause hint (same latency class, friendlier to the SMT sibling).
+ * Backoff   - pause, then yield, then sleep with exponentially growing periods (bounded CPU burn).
+ * Park      - short pause spin, then sleep on a futex until a producer calls wake().
+ */
+enum class IdleStrategyType : uint8_t
+{
+    BusySpin = 0,
+    Pause = 1,
+    Backoff = 2,
+    Park = 3
+};
+
+// Spin-loop hint: tells the core we are waiting so it can save power and free pipeline resources.
+inline void cpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+class IdleStrategy
+{
+  public:
+    // Backoff: pause rounds, then yield rounds, then sleeps doubling from MIN to MAX.
+    static constexpr uint32_t BACKOFF_SPIN_ROUNDS = 64;
+    static constexpr uint32_t BACKOFF_YIELD_ROUNDS = 16;
+    static constexpr std::chrono::nanoseconds BACKOFF_MIN_SLEEP{1000};
+    static constexpr std::chrono::nanoseconds BACKOFF_MAX_SLEEP{1000000};
+
+    // Park: pause rounds before sleeping on the futex. The timeout bounds how long a parked
+    // consumer takes to notice shutdown (running=false) without a producer wake.
+    static constexpr uint32_t PARK_SPIN_ROUNDS = 256;
+    static constexpr std::chrono::nanoseconds PARK_TIMEOUT{1000000};
+
+    explicit IdleStrategy(IdleStrategyType type = IdleStrategyType::BusySpin) : type_{type}
+    {
+    }
+
+    IdleStrategy(const IdleStrategy &) = delete;
+    IdleStrategy &operator=(const IdleStrategy &) = delete;
+
+    static std::vector<std::string> getSupportedTypes()
+    {
+        return {"spin", "pause", "backoff", "park"};
+    }
+
+    static IdleStrategyType fromString(const std::string &name)
+    {
+        if (name == "spin")
+        {
+            return IdleStrategyType::BusySpin;
+        }
+        else if (name == "pause")
+        {
+            return IdleStrategyType::Pause;
+        }
+        else if (name == "backoff")
+        {
+            return IdleStrategyType::Backoff;
+        }
+        else if (name == "park")
+        {
+            return IdleStrategyType::Park;
+        }
+
+        throw std::runtime_error("Unknown idle strategy: " + name);
+    }
+
+    static const char *toString(IdleStrategyType type)
+    {
+        switch (type)
+        {
+            case IdleStrategyType::BusySpin:
+                return "spin";
+            case IdleStrategyType::Pause:
+                return "pause";
+            case IdleStrategyType::Backoff:
+                return "backoff";
+            case IdleStrategyType::Park:
+                return "park";
+        }
+        return "unknown";
+    }
+
+    IdleStrategyType getType() const noexcept
+    {
+        return type_;
+    }
+
+    // Consumer side: call after finding work so the next idle period starts from the cheapest phase.
+    void reset() noexcept
+    {
+        idleRounds_ = 0;
+    }
+
+    // Consumer side: call when a poll found nothing. hasWork() is re-checked after announcing a park
+    // so a producer that pushed just before the announcement is never missed.
+    template <typename HasWork> void idle(HasWork &&hasWork)
+    {
+        switch (type_)
+        {
+            case IdleStrategyType::BusySpin:
+                break;
+            case IdleStrategyType::Pause:
+                cpuRelax();
+                break;
+            case IdleStrategyType::Backoff:
+                backoff();
+                break;
+            case IdleStrategyType::Park:
+                park(hasWork);
+                break;
+        }
+    }
+
+    // Producer side: call after a successful push. Costs one fence and a load unless the consumer is parked.
+    // Returns true if it had to signal a parked consumer.
+    bool wake() noexcept
+    {
+        if (type_ != IdleStrategyType::Park)
+        {
+            return false;
+        }
+
+        // Pairs with the fence in park(): either we see parked_ == 1, or the consumer sees our push.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_relaxed) != 0 && parked_.exchange(0, std::memory_order_relaxed) != 0)
+        {
+            futexWake();
+            wakeCount_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // Number of producer wakes that actually had to signal a parked consumer.
+    uint64_t getWakeCount() const noexcept
+    {
+        return wakeCount_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void backoff()
+    {
+        const uint32_t round = idleRounds_++;
+        if (round < BACKOFF_SPIN_ROUNDS)
+        {
+            cpuRelax();
+        }
+        else if (round < BACKOFF_SPIN_ROUNDS + BACKOFF_YIELD_ROUNDS)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            const uint32_t doublings = round - BACKOFF_SPIN_ROUNDS - BACKOFF_YIELD_ROUNDS;
+            auto sleepFor = BACKOFF_MAX_SLEEP;
+            if (doublings < 10)
+            {
+                sleepFor = std::min(BACKOFF_MAX_SLEEP, BACKOFF_MIN_SLEEP * (1U << doublings));
+            }
+            std::this_thread::sleep_for(sleepFor);
+        }
+    }
+
+    template <typename HasWork> void park(HasWork &hasWork)
+    {
+        if (idleRounds_ < PARK_SPIN_ROUNDS)
+        {
+            ++idleRounds_;
+            cpuRelax();
+            return;
+        }
+
+        parked_.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (hasWork())
+        {
+            parked_.store(0, std::memory_order_relaxed);
+            return;
+        }
+
+        futexWait(1);
+        parked_.store(0, std::memory_order_relaxed);
+    }
+
+#if defined(__linux__)
+    uint32_t *futexWord() noexcept
+    {
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+        return reinterpret_cast<uint32_t *>(&parked_);
+    }
+
+    void futexWait(uint32_t expected) noexcept
+    {
+        timespec timeout{};
+        timeout.tv_nsec = static_cast<long>(PARK_TIMEOUT.count());
+        // Returns immediately (EAGAIN) if a producer already flipped the word back to 0.
+        syscall(SYS_futex, futexWord(), FUTEX_WAIT_PRIVATE, expected, &timeout, nullptr, 0);
+    }
+
+    void futexWake() noexcept
+    {
+        syscall(SYS_futex, futexWord(), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+#else
+    // No futex outside Linux: fall back to a bounded sleep, producers' wake() only clears the flag.
+    void futexWait(uint32_t) noexcept
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    void futexWake() noexcept
+    {
+    }
+#endif
+
+    IdleStrategyType type_;
+    uint32_t idleRounds_ = 0; // Consumer-only state
+
+    // Written by the consumer, read by every producer: keep it off the consumer's hot line.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> parked_{0};
+    std::atomic<uint64_t> wakeCount_{0};
+};
+
+} // namespace hft
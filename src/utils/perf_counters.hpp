@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hft
+{
+
+// One hardware (or software) event to count; type and config as in perf_event_attr
+struct PerfEventSpec
+{
+    std::string name;
+    uint32_t type;
+    uint64_t config;
+};
+
+/**
+ * @brief A perf_event_open counter group on the calling thread, read with one system call.
+ *
+ * The events are opened as one group, so the kernel schedules them onto the PMU together and every
+ * reading covers exactly the same instructions. Only user-space work is counted (exclude_kernel),
+ * which also keeps the group usable with the default perf_event_paranoid of 2.
+ *
+ * Events the CPU does not have, or that a VM does not expose, fail to open and are left out; has()
+ * tells which ones count. When more events are requested than the PMU has counters the kernel
+ * multiplexes the group: a Reading carries enabled and running times so totals can be scaled.
+ *
+ * Readings are cumulative. Subtract two of them around a region (PerfTotals does) to count it.
+ */
+class PerfCounterGroup
+{
+  public:
+    static constexpr std::size_t MAX_EVENTS = 8;
+
+    struct Reading
+    {
+        std::array<uint64_t, MAX_EVENTS> values{}; // Indexed like events(); 0 for events that did not open
+        uint64_t timeEnabled = 0;
+        uint64_t timeRunning = 0;
+    };
+
+    // Cycles, instructions, L1D read misses, last-level cache misses, branch misses, dTLB read misses
+    static std::vector<PerfEventSpec> defaultEvents()
+    {
+#if defined(__linux__)
+        auto cache = [](uint64_t cache, uint64_t op, uint64_t result) { return cache | (op << 8) | (result << 16); };
+        return {
+            {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"l1d_misses", PERF_TYPE_HW_CACHE,
+             cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+            {"llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {"dtlb_misses", PERF_TYPE_HW_CACHE,
+             cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        };
+#else
+        return {};
+#endif
+    }
+
+    // Opens the events for the calling thread, stopped. Never throws: check isAvailable().
+    explicit PerfCounterGroup(std::vector<PerfEventSpec> events = defaultEvents()) : events_(std::move(events))
+    {
+        if (events_.size() > MAX_EVENTS)
+        {
+            events_.resize(MAX_EVENTS);
+        }
+        slots_.fill(-1);
+#if defined(__linux__)
+        for (std::size_t i = 0; i < events_.size(); ++i)
+        {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = events_[i].type;
+            attr.config = events_[i].config;
+            attr.disabled = leaderFd_ < 0 ? 1 : 0; // Members follow the leader
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leaderFd_, 0));
+            if (fd < 0)
+            {
+                continue;
+            }
+            if (leaderFd_ < 0)
+            {
+                leaderFd_ = fd;
+            }
+            slots_[i] = static_cast<int>(fds_.size());
+            fds_.push_back(fd);
+        }
+#endif
+    }
+
+    ~PerfCounterGroup()
+    {
+#if defined(__linux__)
+        for (auto it = fds_.rbegin(); it != fds_.rend(); ++it)
+        {
+            close(*it);
+        }
+#endif
+    }
+
+    PerfCounterGroup(const PerfCounterGroup &) = delete;
+    PerfCounterGroup &operator=(const PerfCounterGroup &) = delete;
+
+    bool isAvailable() const
+    {
+        return leaderFd_ >= 0;
+    }
+
+    bool has(std::size_t event) const
+    {
+        return event < events_.size() && slots_[event] >= 0;
+    }
+
+    const std::vector<PerfEventSpec> &events() const
+    {
+        return events_;
+    }
+
+    void enable()
+    {
+#if defined(__linux__)
+        if (leaderFd_ >= 0)
+        {
+            ioctl(leaderFd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    void disable()
+    {
+#if defined(__linux__)
+        if (leaderFd_ >= 0)
+        {
+            ioctl(leaderFd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    // All counters at once: a single read() of the group leader
+    Reading read() const
+    {
+        Reading reading;
+#if defined(__linux__)
+        if (leaderFd_ < 0)
+        {
+            return reading;
+        }
+        // nr, time_enabled, time_running, then one value per opened event
+        std::array<uint64_t, 3 + MAX_EVENTS> buffer{};
+        if (::read(leaderFd_, buffer.data(), sizeof(buffer)) <= 0)
+        {
+            return reading;
+        }
+        reading.timeEnabled = buffer[1];
+        reading.timeRunning = buffer[2];
+        for (std::size_t i = 0; i < events_.size(); ++i)
+        {
+            if (slots_[i] >= 0 && static_cast<uint64_t>(slots_[i]) < buffer[0])
+            {
+                reading.values[i] = buffer[3 + slots_[i]];
+            }
+        }
+#endif
+        return reading;
+    }
+
+  private:
+    std::vector<PerfEventSpec> events_;
+    std::array<int, MAX_EVENTS> slots_{}; // Position of each event in the group read, -1 if not opened
+    std::vector<int> fds_;
+    int leaderFd_ = -1;
+};
+
+/**
+ * @brief Counts accumulated over many regions, e.g. every insert of a run.
+ */
+struct PerfTotals
+{
+    std::array<uint64_t, PerfCounterGroup::MAX_EVENTS> values{};
+    uint64_t timeEnabled = 0;
+    uint64_t timeRunning = 0;
+    uint64_t regions = 0;
+
+    // One region, or regionCount regions read as a whole (per-region values are then averages)
+    void add(const PerfCounterGroup::Reading &before, const PerfCounterGroup::Reading &after,
+             uint64_t regionCount = 1)
+    {
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] += after.values[i] - before.values[i];
+        }
+        timeEnabled += after.timeEnabled - before.timeEnabled;
+        timeRunning += after.timeRunning - before.timeRunning;
+        regions += regionCount;
+    }
+
+    void merge(const PerfTotals &other)
+    {
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] += other.values[i];
+        }
+        timeEnabled += other.timeEnabled;
+        timeRunning += other.timeRunning;
+        regions += other.regions;
+    }
+
+    // Event count per region, scaled up if the group was multiplexed; 0 if it never ran
+    double perRegion(std::size_t event) const
+    {
+        if (regions == 0 || timeRunning == 0)
+        {
+            return 0.0;
+        }
+        const double scale = static_cast<double>(timeEnabled) / static_cast<double>(timeRunning);
+        return static_cast<double>(values[event]) * scale / static_cast<double>(regions);
+    }
+};
+
+} // namespace hft
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace hft
+{
+
+/**
+ * @brief Single-writer sequence lock: publishes a small trivially copyable value to any number of
+ * readers without ever blocking the writer.
+ *
+ * store() bumps the sequence to odd, writes the value, then bumps it to even (release). load() copies
+ * the value between two reads of the sequence and retries while a write was in progress or happened
+ * in between, so it always returns a value exactly as some store() wrote it. The value is kept in
+ * relaxed atomic words, so readers racing the writer are well defined; on x86 the words compile to
+ * plain moves.
+ *
+ * Holds no pointers and is lock-free, so it may live in shared memory mapped by another process.
+ */
+template <typename T> class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock values are copied word by word");
+
+  public:
+    SeqLock()
+    {
+        store(T{});
+    }
+
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    // Writer only. A handful of stores; never waits for readers.
+    void store(const T &value)
+    {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // The odd sequence is visible before any word
+        for (std::size_t i = 0; i < WORDS; ++i)
+        {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Any thread. Retries (spinning) only while the writer is mid-store.
+    T load() const
+    {
+        T value;
+        while (!tryLoad(value))
+        {
+        }
+        return value;
+    }
+
+    // One attempt: false if a store overlapped the copy
+    bool tryLoad(T &value) const
+    {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            return false;
+        }
+        Words words;
+        for (std::size_t i = 0; i < WORDS; ++i)
+        {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire); // Words are read before the sequence is rechecked
+        if (sequence_.load(std::memory_order_relaxed) != before)
+        {
+            return false;
+        }
+        std::memcpy(static_cast<void *>(&value), words.data(), sizeof(T));
+        return true;
+    }
+
+    // Number of completed stores (the constructor's included)
+    uint64_t version() const
+    {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+  private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    using Words = std::array<uint64_t, WORDS>;
+
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+};
+
+} // namespace hft
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "utils/lock_free_queue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace hft
+{
+
+/**
+ * @brief Per-worker task deque for a work-stealing pool.
+ *
+ * Submitters push to the back. The owning worker pops the oldest task from the front so
+ * connections are served in arrival order. Idle workers steal from the back, the opposite end,
+ * so an owner and a thief only meet on the last task.
+ *
+ * Tasks here are coarse (a whole batch of received bytes), so a short mutex section per
+ * operation is negligible next to the parse work; thieves use try_lock and move on rather than
+ * queueing behind the owner. size() is a lock-free hint for idle checks and steal targeting.
+ */
+template <typename T> class WorkStealingDeque
+{
+  public:
+    void push(T item)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.push_back(std::move(item));
+        size_.store(items_.size(), std::memory_order_release);
+    }
+
+    // Owner side: oldest task first
+    bool pop(T &out)
+    {
+        if (size_.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.empty())
+        {
+            return false;
+        }
+        out = std::move(items_.front());
+        items_.pop_front();
+        size_.store(items_.size(), std::memory_order_release);
+        return true;
+    }
+
+    // Thief side: newest task, never blocks on a busy deque
+    bool steal(T &out)
+    {
+        if (size_.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock() || items_.empty())
+        {
+            return false;
+        }
+        out = std::move(items_.back());
+        items_.pop_back();
+        size_.store(items_.size(), std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::mutex mutex_;
+    std::deque<T> items_;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> size_{0};
+};
+
+} // namespace hft
@@ -1,18 +1,27 @@
 #include <gtest/gtest.h>
 
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "binary/binary_parser.hpp"
 #include "core/matching_engine.hpp"
 #include "core/order_book_factory.hpp"
+#include "fix/fix_parser.hpp"
+#include "network/shm_channel.hpp"
 #include "network/tcp_order_gateway.hpp"
 #include "utils/lock_free_queue.hpp"
 
@@ -72,6 +81,181 @@ bool waitUntil(std::function<bool()> predicate, std::chrono::milliseconds timeou
     return false;
 }
 
+// FIX session run against a gateway with setFixSession(true): Logon, a lost order (seq 3) that the
+// gateway recovers with a ResendRequest, then the resent copies. All three orders must arrive once.
+void expectSessionGapRecovery(GatewayMode mode, int port)
+{
+    LockFreeQueue<Order, 1024> queue;
+    auto orderBook = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *orderBook);
+    TCPOrderGateway gateway(port, queue);
+    gateway.setMode(mode);
+    gateway.setFixSession(true);
+
+    std::atomic<bool> running{true};
+    std::thread engineThread([&]() { engine.run(running); });
+
+    gateway.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    auto frameFor = [](const std::string &fields)
+    {
+        char frame[256];
+        return std::string(frame, FIXParser::buildFrame(fields, frame, sizeof(frame)));
+    };
+    auto orderFor = [&](int seqNum, Price price, bool possDup)
+    {
+        return frameFor("35=D\x01" "49=SIM\x01" "56=EXCHANGE\x01" "34=" + std::to_string(seqNum) + "\x01" +
+                        (possDup ? "43=Y\x01" : "") + "11=" + std::to_string(7000 + seqNum) + "\x01" "54=1\x01" +
+                        "44=" + std::to_string(price) + "\x01" "38=4\x01" "40=2\x01");
+    };
+
+    int client = connectClient(port);
+    ASSERT_GE(client, 0);
+    timeval timeout{1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    const std::string opening = frameFor("35=A\x01" "49=SIM\x01" "56=EXCHANGE\x01" "34=1\x01" "98=0\x01"
+                                         "108=30\x01") +
+                                orderFor(2, 120, false) + orderFor(4, 130, false);
+    ASSERT_EQ(send(client, opening.data(), opening.size(), 0), static_cast<ssize_t>(opening.size()));
+
+    // Logon reply, then a ResendRequest from the first missing number
+    std::string replies;
+    char buffer[1024];
+    while (replies.find("\x01" "35=2\x01") == std::string::npos)
+    {
+        const ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+        ASSERT_GT(received, 0) << "no ResendRequest, got: " << replies;
+        replies.append(buffer, static_cast<size_t>(received));
+    }
+    EXPECT_NE(replies.find("\x01" "35=A\x01"), std::string::npos);
+    EXPECT_NE(replies.find("\x01" "7=3\x01"), std::string::npos);
+
+    const std::string resent = orderFor(3, 125, true) + orderFor(4, 130, true);
+    ASSERT_EQ(send(client, resent.data(), resent.size(), 0), static_cast<ssize_t>(resent.size()));
+
+    ASSERT_TRUE(waitUntil([&]() { return engine.getMetrics().getOrderCount() >= 3; }, std::chrono::milliseconds(500)));
+    close(client);
+
+    running.store(false);
+    gateway.stop();
+    engineThread.join();
+
+    EXPECT_EQ(engine.getMetrics().getOrderCount(), 3u);
+    EXPECT_EQ(gateway.getSessionGaps(), 1u);
+    EXPECT_EQ(engine.getOrderBook().getBestBid(), 130u);
+}
+
+// Streams well over one receive ring (64KB) of orders in pieces of 1..97 bytes, so frames are split at
+// every offset, including inside "8=FIX", "9=" and "10=" and across the ring's wrap. Every order must arrive.
+void expectFragmentedStreamParses(GatewayMode mode, int port)
+{
+    LockFreeQueue<Order, 1024> queue;
+    auto orderBook = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *orderBook);
+    TCPOrderGateway gateway(port, queue);
+    gateway.setMode(mode);
+
+    std::atomic<bool> running{true};
+    std::thread engineThread([&]() { engine.run(running); });
+
+    gateway.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    constexpr int kOrders = 2000;
+    std::string stream;
+    for (int i = 0; i < kOrders; ++i)
+    {
+        stream += makeFixNewOrder(8000 + i, 100 + (i % 50), 1, Side::Buy);
+    }
+
+    int client = connectClient(port);
+    ASSERT_GE(client, 0);
+    const int noDelay = 1;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    for (size_t offset = 0, piece = 1; offset < stream.size(); offset += piece, piece = piece % 97 + 1)
+    {
+        piece = std::min(piece, stream.size() - offset);
+        ASSERT_EQ(send(client, stream.data() + offset, piece, 0), static_cast<ssize_t>(piece));
+    }
+
+    ASSERT_TRUE(waitUntil([&]() { return engine.getMetrics().getOrderCount() >= kOrders; },
+                          std::chrono::milliseconds(2000)));
+    close(client);
+
+    running.store(false);
+    gateway.stop();
+    engineThread.join();
+
+    EXPECT_EQ(engine.getMetrics().getOrderCount(), static_cast<uint64_t>(kOrders));
+    EXPECT_EQ(engine.getOrderBook().getBestBid(), 149u);
+}
+
+// Orders plus a U1 barrier over a non-TCP transport; the U2 reply always comes back on the socket.
+// With SharedMemory the client creates the ring and passes it over the socket, as MockClient does.
+void expectOrdersOverTransport(GatewayMode mode, TransportKind kind, int port)
+{
+    LockFreeQueue<Order, 1024> queue;
+    auto orderBook = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *orderBook);
+    TCPOrderGateway gateway(port, queue);
+    gateway.setMode(mode);
+    gateway.setTransport(kind);
+    gateway.setMetricsCollector(&engine.getMetrics());
+
+    std::atomic<bool> running{true};
+    std::thread engineThread([&]() { engine.run(running); });
+
+    gateway.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    const int client = gateway.getEndpoint().connect("127.0.0.1");
+    ASSERT_GE(client, 0);
+    timeval timeout{2, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::unique_ptr<ShmChannel> channel;
+    if (kind == TransportKind::SharedMemory)
+    {
+        channel = ShmChannel::create(4096);
+        ASSERT_TRUE(sendDescriptor(client, channel->fd()));
+    }
+    auto sendBytes = [&](const std::string &bytes)
+    {
+        return channel ? channel->write(bytes.data(), bytes.size(), std::chrono::milliseconds(500))
+                       : send(client, bytes.data(), bytes.size(), 0) == static_cast<ssize_t>(bytes.size());
+    };
+
+    // More than the 4KB ring in one go, so the channel wraps and waits for the gateway
+    std::string orders;
+    for (int i = 0; i < 100; ++i)
+    {
+        orders += makeFixNewOrder(9000 + i, 100 + (i % 20), 1, Side::Buy);
+    }
+    orders += makeFixNewOrder(9100, 119, 1, Side::Sell);
+    ASSERT_TRUE(sendBytes(orders));
+    ASSERT_TRUE(sendBytes("8=FIX.4.2\x01"
+                          "35=U1\x01"
+                          "596=101\x01"
+                          "10=000\x01"));
+
+    char reply[512];
+    const ssize_t received = recv(client, reply, sizeof(reply) - 1, 0);
+    ASSERT_GT(received, 0);
+    const std::string frame(reply, static_cast<size_t>(received));
+    EXPECT_NE(frame.find("35=U2"), std::string::npos);
+    EXPECT_NE(frame.find("Count=101"), std::string::npos);
+
+    channel.reset();
+    close(client);
+    running.store(false);
+    gateway.stop();
+    engineThread.join();
+
+    EXPECT_EQ(engine.getMetrics().getTradeCount(), 1u);
+    EXPECT_EQ(engine.getOrderBook().getOrderCount(), 99u);
+}
+
 TEST(TcpGatewayIntegrationTest, SingleClientOrderReachesMatchingEngine)
 {
     const int port = static_cast<int>(22000 + (getpid() % 1000));
@@ -226,5 +410,250 @@ TEST(TcpGatewayIntegrationTest, OversizedMalformedStreamDoesNotBreakGateway)
     EXPECT_EQ(engine.getOrderBook().getBestBid(), 133u);
 }
 
+TEST(TcpGatewayIntegrationTest, BinaryAndFixOrdersShareOneConnection)
+{
+    const int port = static_cast<int>(28000 + (getpid() % 1000));
+
+    LockFreeQueue<Order, 1024> queue;
+    auto orderBook = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *orderBook);
+    TCPOrderGateway gateway(port, queue);
+
+    std::atomic<bool> running{true};
+    std::thread engineThread([&]() { engine.run(running); });
+
+    gateway.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    // Binary bid split mid-frame, then a FIX ask on the same connection that crosses it
+    Order bid{5001, 140, 6, Side::Buy, OrderType::Limit, 0, 0, 123456789};
+    char frame[BinaryParser::NEW_ORDER_SIZE];
+    BinaryParser::encodeNewOrder(bid, frame);
+    const std::string ask = makeFixNewOrder(5002, 140, 2, Side::Sell);
+
+    int client = connectClient(port);
+    ASSERT_GE(client, 0);
+    ASSERT_EQ(send(client, frame, 10, 0), 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(send(client, frame + 10, sizeof(frame) - 10, 0), static_cast<ssize_t>(sizeof(frame) - 10));
+    ASSERT_EQ(send(client, ask.data(), ask.size(), 0), static_cast<ssize_t>(ask.size()));
+    close(client);
+
+    ASSERT_TRUE(waitUntil([&]() { return engine.getMetrics().getOrderCount() >= 2; }, std::chrono::milliseconds(500)));
+
+    running.store(false);
+    gateway.stop();
+    engineThread.join();
+
+    EXPECT_EQ(engine.getMetrics().getOrderCount(), 2u);
+    EXPECT_EQ(engine.getMetrics().getTradeCount(), 1u);
+    EXPECT_EQ(engine.getOrderBook().getBestBid(), 140u);
+}
+
+TEST(TcpGatewayIntegrationTest, FixValidationDropsCorruptFramesOnly)
+{
+    const int port = static_cast<int>(29000 + (getpid() % 1000));
+
+    LockFreeQueue<Order, 1024> queue;
+    auto orderBook = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *orderBook);
+    TCPOrderGateway gateway(port, queue);
+    gateway.setFixValidation(true);
+
+    std::atomic<bool> running{true};
+    std::thread engineThread([&]() { engine.run(running); });
+
+    gateway.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    const std::string body = "35=D\x01" "54=1\x01" "38=4\x01" "40=2\x01" "60=123456789\x01";
+    auto frameFor = [&](OrderId id, Price price)
+    {
+        const std::string fields = "11=" + std::to_string(id) + "\x01" "44=" + std::to_string(price) + "\x01" + body;
+        char frame[256];
+        return std::string(frame, FIXParser::buildFrame(fields, frame, sizeof(frame)));
+    };
+    std::string corrupt = frameFor(6002, 150);
+    corrupt[corrupt.size() - 2] ^= 1;
+    const std::string stream = frameFor(6001, 120) + corrupt + frameFor(6003, 125);
+
+    int client = connectClient(port);
+    ASSERT_GE(client, 0);
+    ASSERT_EQ(send(client, stream.data(), stream.size(), 0), static_cast<ssize_t>(stream.size()));
+    close(client);
+
+    ASSERT_TRUE(waitUntil([&]() { return engine.getMetrics().getOrderCount() >= 2; }, std::chrono::milliseconds(500)));
+
+    running.store(false);
+    gateway.stop();
+    engineThread.join();
+
+    EXPECT_EQ(engine.getMetrics().getOrderCount(), 2u);
+    EXPECT_EQ(gateway.getRejectedFrames(), 1u);
+    EXPECT_EQ(engine.getOrderBook().getBestBid(), 125u);
+}
+
+TEST(TcpGatewayIntegrationTest, FixSessionRecoversASequenceGap)
+{
+    expectSessionGapRecovery(GatewayMode::Threaded, static_cast<int>(30000 + (getpid() % 1000)));
+}
+
+TEST(TcpGatewayIntegrationTest, FragmentedStreamParsesEveryOrder)
+{
+    expectFragmentedStreamParses(GatewayMode::Threaded, static_cast<int>(32000 + (getpid() % 1000)));
+}
+
+TEST(TcpGatewayIntegrationTest, UnixSocketTransportServesOrdersAndStats)
+{
+    expectOrdersOverTransport(GatewayMode::Threaded, TransportKind::Unix, static_cast<int>(34000 + (getpid() % 1000)));
+}
+
+TEST(TcpGatewayIntegrationTest, SharedMemoryTransportServesOrdersAndStats)
+{
+    expectOrdersOverTransport(GatewayMode::Threaded, TransportKind::SharedMemory,
+                              static_cast<int>(35000 + (getpid() % 1000)));
+}
+
+TEST(TcpGatewayIntegrationTest, SharedMemoryTransportRequiresThreadedMode)
+{
+    LockFreeQueue<Order, 1024> queue;
+    TCPOrderGateway gateway(36000 + (getpid() % 1000), queue);
+    gateway.setMode(GatewayMode::Epoll);
+    gateway.setTransport(TransportKind::SharedMemory);
+    EXPECT_THROW(gateway.start(), std::runtime_error);
+}
+
+// Single-thread event loop modes (io_uring falls back to epoll on kernels without support)
+class EventLoopGatewayTest : public ::testing::TestWithParam<GatewayMode>
+{
+};
+
+TEST_P(EventLoopGatewayTest, ServesManyClientsOnOneThread)
+{
+    const int modeOffset = (GetParam() == GatewayMode::IoUring) ? 500 : 0;
+    const int port = static_cast<int>(26000 + (getpid() % 500) + modeOffset);
+
+    LockFreeQueue<Order, 1024> queue;
+    auto orderBook = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *orderBook);
+    TCPOrderGateway gateway(port, queue);
+    gateway.setMode(GetParam());
+
+    std::atomic<bool> running{true};
+    std::thread engineThread([&]() { engine.run(running); });
+
+    gateway.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    // Non-crossing bids from 8 concurrent connections, the first one split across two sends
+    std::vector<int> clients;
+    for (int c = 0; c < 8; ++c)
+    {
+        clients.push_back(connectClient(port));
+        ASSERT_GE(clients.back(), 0);
+    }
+    for (int c = 0; c < 8; ++c)
+    {
+        const std::string message = makeFixNewOrder(5001 + c, 100 + c, 1, Side::Buy);
+        const size_t split = (c == 0) ? message.size() / 2 : message.size();
+        ASSERT_EQ(send(clients[c], message.data(), split, 0), static_cast<ssize_t>(split));
+        if (split < message.size())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            ASSERT_EQ(send(clients[c], message.data() + split, message.size() - split, 0),
+                      static_cast<ssize_t>(message.size() - split));
+        }
+    }
+    for (int client : clients)
+    {
+        close(client);
+    }
+
+    ASSERT_TRUE(waitUntil([&]() { return engine.getMetrics().getOrderCount() >= 8; }, std::chrono::milliseconds(1000)));
+
+    running.store(false);
+    gateway.stop();
+    engineThread.join();
+
+    EXPECT_EQ(engine.getMetrics().getOrderCount(), 8u);
+    EXPECT_EQ(engine.getOrderBook().getBestBid(), 107u);
+}
+
+TEST_P(EventLoopGatewayTest, StatsBarrierDoesNotBlockOtherClients)
+{
+    const int modeOffset = (GetParam() == GatewayMode::IoUring) ? 500 : 0;
+    const int port = static_cast<int>(27000 + (getpid() % 500) + modeOffset);
+
+    LockFreeQueue<Order, 1024> queue;
+    auto orderBook = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *orderBook);
+    TCPOrderGateway gateway(port, queue);
+    gateway.setMode(GetParam());
+    gateway.setMetricsCollector(&engine.getMetrics());
+
+    std::atomic<bool> running{true};
+    std::thread engineThread([&]() { engine.run(running); });
+
+    gateway.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    // The control client asks for stats before the orders it waits for have even been sent.
+    int control = connectClient(port);
+    ASSERT_GE(control, 0);
+    const std::string statsRequest = "8=FIX.4.2\x01"
+                                     "35=U1\x01"
+                                     "596=2\x01"
+                                     "10=000\x01";
+    ASSERT_EQ(send(control, statsRequest.data(), statsRequest.size(), 0), static_cast<ssize_t>(statsRequest.size()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    int trader = connectClient(port);
+    ASSERT_GE(trader, 0);
+    const std::string orders = makeFixNewOrder(6001, 140, 5, Side::Buy) + makeFixNewOrder(6002, 140, 5, Side::Sell);
+    ASSERT_EQ(send(trader, orders.data(), orders.size(), 0), static_cast<ssize_t>(orders.size()));
+
+    timeval timeout{};
+    timeout.tv_sec = 2;
+    setsockopt(control, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    char reply[512];
+    const ssize_t received = recv(control, reply, sizeof(reply) - 1, 0);
+    ASSERT_GT(received, 0);
+    const std::string frame(reply, static_cast<size_t>(received));
+    EXPECT_NE(frame.find("35=U2"), std::string::npos);
+    EXPECT_NE(frame.find("Count=2"), std::string::npos);
+    EXPECT_NE(frame.find("\x01P50="), std::string::npos);
+    EXPECT_NE(frame.find("\x01P9999="), std::string::npos);
+
+    close(trader);
+    close(control);
+    running.store(false);
+    gateway.stop();
+    engineThread.join();
+
+    EXPECT_EQ(engine.getMetrics().getTradeCount(), 1u);
+}
+
+TEST_P(EventLoopGatewayTest, FixSessionRecoversASequenceGap)
+{
+    const int modeOffset = (GetParam() == GatewayMode::IoUring) ? 500 : 0;
+    expectSessionGapRecovery(GetParam(), static_cast<int>(31000 + (getpid() % 500) + modeOffset));
+}
+
+TEST_P(EventLoopGatewayTest, FragmentedStreamParsesEveryOrder)
+{
+    const int modeOffset = (GetParam() == GatewayMode::IoUring) ? 500 : 0;
+    expectFragmentedStreamParses(GetParam(), static_cast<int>(33000 + (getpid() % 500) + modeOffset));
+}
+
+TEST_P(EventLoopGatewayTest, UnixSocketTransportServesOrdersAndStats)
+{
+    const int modeOffset = (GetParam() == GatewayMode::IoUring) ? 500 : 0;
+    expectOrdersOverTransport(GetParam(), TransportKind::Unix, static_cast<int>(37000 + (getpid() % 500) + modeOffset));
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, EventLoopGatewayTest, ::testing::Values(GatewayMode::Epoll, GatewayMode::IoUring),
+                         [](const ::testing::TestParamInfo<GatewayMode> &info)
+                         { return std::string(info.param == GatewayMode::Epoll ? "epoll" : "io_uring"); });
+
 } // namespace
 } // namespace hft
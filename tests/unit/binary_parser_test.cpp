@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "binary/binary_parser.hpp"
+#include "core/symbol_table.hpp"
+
+namespace hft
+{
+namespace
+{
+
+std::array<char, BinaryParser::NEW_ORDER_SIZE> makeNewOrderFrame(const Order &order)
+{
+    std::array<char, BinaryParser::NEW_ORDER_SIZE> frame{};
+    BinaryParser::encodeNewOrder(order, frame.data());
+    return frame;
+}
+
+TEST(BinaryParserTest, RoundTripsNewOrder)
+{
+    Order in{123, 130, 50, Side::Sell, OrderType::Limit, 0, 0, 123456789};
+    in.symbol = 3;
+    auto frame = makeNewOrderFrame(in);
+    const SymbolTable symbols = SymbolTable::makeSynthetic(4);
+    size_t consumed = 0;
+
+    ASSERT_TRUE(BinaryParser::isBinary(frame));
+    auto order = BinaryParser::parse(frame, consumed, &symbols);
+
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(consumed, BinaryParser::NEW_ORDER_SIZE);
+    EXPECT_EQ(order->id, 123u);
+    EXPECT_EQ(order->side, Side::Sell);
+    EXPECT_EQ(order->quantity, 50u);
+    EXPECT_EQ(order->price, 130u);
+    EXPECT_EQ(order->type, OrderType::Limit);
+    EXPECT_EQ(order->sendTimestamp, 123456789u);
+    EXPECT_EQ(order->symbol, 3u);
+}
+
+TEST(BinaryParserTest, LayoutIsLittleEndianAtFixedOffsets)
+{
+    Order in{0x0102030405060708ULL, 0, 1, Side::Buy, OrderType::Market, 0, 0, 0};
+    auto frame = makeNewOrderFrame(in);
+
+    EXPECT_EQ(static_cast<unsigned char>(frame[0]), BinaryParser::MAGIC);
+    EXPECT_EQ(static_cast<unsigned char>(frame[1]), BinaryParser::MSG_NEW_ORDER);
+    EXPECT_EQ(frame[2], 48);
+    EXPECT_EQ(frame[3], 0);
+    EXPECT_EQ(frame[4], 1); // Buy
+    EXPECT_EQ(frame[5], 1); // Market
+    EXPECT_EQ(frame[16], 0x08);
+    EXPECT_EQ(frame[23], 0x01);
+}
+
+TEST(BinaryParserTest, IncompleteFrameConsumesNothing)
+{
+    auto frame = makeNewOrderFrame({1, 100, 1, Side::Buy, OrderType::Limit, 0, 0, 0});
+    size_t consumed = 99;
+
+    EXPECT_FALSE(BinaryParser::parse(std::span<const char>(frame.data(), 3), consumed).has_value());
+    EXPECT_EQ(consumed, 0u);
+    EXPECT_FALSE(BinaryParser::parse(std::span<const char>(frame.data(), 47), consumed).has_value());
+    EXPECT_EQ(consumed, 0u);
+}
+
+TEST(BinaryParserTest, InvalidFieldsConsumeTheFrameAndReject)
+{
+    auto badSide = makeNewOrderFrame({1, 100, 1, Side::Buy, OrderType::Limit, 0, 0, 0});
+    badSide[4] = 7;
+    auto zeroQuantity = makeNewOrderFrame({1, 100, 0, Side::Buy, OrderType::Limit, 0, 0, 0});
+    auto zeroLimitPrice = makeNewOrderFrame({1, 0, 5, Side::Buy, OrderType::Limit, 0, 0, 0});
+    size_t consumed = 0;
+
+    EXPECT_FALSE(BinaryParser::parse(badSide, consumed).has_value());
+    EXPECT_EQ(consumed, BinaryParser::NEW_ORDER_SIZE);
+    EXPECT_FALSE(BinaryParser::parse(zeroQuantity, consumed).has_value());
+    EXPECT_EQ(consumed, BinaryParser::NEW_ORDER_SIZE);
+    EXPECT_FALSE(BinaryParser::parse(zeroLimitPrice, consumed).has_value());
+    EXPECT_EQ(consumed, BinaryParser::NEW_ORDER_SIZE);
+}
+
+TEST(BinaryParserTest, UnknownSymbolIdIsRejectedOnlyWithATable)
+{
+    Order in{1, 100, 1, Side::Buy, OrderType::Limit, 0, 0, 0};
+    in.symbol = 9;
+    auto frame = makeNewOrderFrame(in);
+    const SymbolTable symbols = SymbolTable::makeSynthetic(2);
+    size_t consumed = 0;
+
+    EXPECT_FALSE(BinaryParser::parse(frame, consumed, &symbols).has_value());
+    auto order = BinaryParser::parse(frame, consumed);
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(order->symbol, SymbolTable::DEFAULT_SYMBOL);
+}
+
+TEST(BinaryParserTest, StatsRequestCarriesExpectedCount)
+{
+    std::array<char, BinaryParser::STATS_REQUEST_SIZE> frame{};
+    BinaryParser::encodeStatsRequest(250000, frame.data());
+    size_t consumed = 0;
+
+    EXPECT_EQ(BinaryParser::getMessageType(frame), BinaryParser::MSG_STATS_REQUEST);
+    EXPECT_FALSE(BinaryParser::parse(frame, consumed).has_value());
+    EXPECT_EQ(consumed, BinaryParser::STATS_REQUEST_SIZE);
+    EXPECT_EQ(BinaryParser::getExpectedCount(frame), 250000u);
+}
+
+TEST(BinaryParserTest, FixFramesAreNotBinary)
+{
+    const std::string fix = "8=FIX.4.2\x01" "35=D\x01";
+    EXPECT_FALSE(BinaryParser::isBinary(std::span<const char>(fix.data(), fix.size())));
+}
+
+} // namespace
+} // namespace hft
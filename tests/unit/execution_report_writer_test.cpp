@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "network/execution_report_writer.hpp"
+
+namespace hft
+{
+namespace
+{
+
+// fds[0] plays the gateway's client connection, fds[1] the client reading its reports.
+class ExecutionReportWriterTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds_), 0);
+        timeval timeout{};
+        timeout.tv_sec = 2;
+        setsockopt(fds_[1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+
+    void TearDown() override
+    {
+        close(fds_[0]);
+        close(fds_[1]);
+    }
+
+    // Reads until `count` complete frames (each ends with the 10= CheckSum field) have arrived
+    std::string readFrames(std::size_t count)
+    {
+        std::string received;
+        char buffer[1024];
+        auto frames = [&]()
+        {
+            std::size_t n = 0;
+            for (std::size_t pos = received.find("\x01" "10="); pos != std::string::npos;
+                 pos = received.find("\x01" "10=", pos + 1))
+            {
+                ++n;
+            }
+            return n;
+        };
+        while (frames() < count)
+        {
+            const ssize_t n = recv(fds_[1], buffer, sizeof(buffer), 0);
+            if (n <= 0)
+            {
+                break;
+            }
+            received.append(buffer, static_cast<std::size_t>(n));
+        }
+        return received;
+    }
+
+    int fds_[2] = {-1, -1};
+};
+
+TEST_F(ExecutionReportWriterTest, AckReachesClientAsFixExecutionReport)
+{
+    ExecutionReportWriter writer(1);
+    writer.start();
+    const ClientId client = writer.openClient(fds_[0]);
+    ASSERT_NE(client, 0u);
+    EXPECT_EQ(writer.clientId(fds_[0]), client);
+
+    writer.publish(0, {client, ExecType::New, Side::Buy, 42, 101, 7, 123456789});
+    const std::string frame = readFrames(1);
+    writer.stop();
+
+    EXPECT_NE(frame.find("\x01" "35=8\x01"), std::string::npos);
+    EXPECT_NE(frame.find("\x01" "11=42\x01"), std::string::npos);
+    EXPECT_NE(frame.find("\x01" "150=0\x01"), std::string::npos);
+    EXPECT_NE(frame.find("\x01" "54=1\x01"), std::string::npos);
+    EXPECT_NE(frame.find("\x01" "38=7\x01"), std::string::npos);
+    EXPECT_NE(frame.find("\x01" "44=101\x01"), std::string::npos);
+    EXPECT_NE(frame.find("\x01" "60=123456789\x01"), std::string::npos);
+    EXPECT_EQ(writer.getSentCount(), 1u);
+}
+
+TEST_F(ExecutionReportWriterTest, FillsFromEveryProducerAreDelivered)
+{
+    ExecutionReportWriter writer(2);
+    writer.start();
+    const ClientId client = writer.openClient(fds_[0]);
+
+    writer.publish(0, {client, ExecType::Trade, Side::Sell, 1, 100, 3, 0});
+    writer.publish(1, {client, ExecType::Trade, Side::Sell, 2, 100, 4, 0});
+    const std::string frames = readFrames(2);
+    writer.stop();
+
+    EXPECT_NE(frames.find("\x01" "150=F\x01" "54=2\x01" "32=3\x01" "31=100\x01"), std::string::npos);
+    EXPECT_NE(frames.find("\x01" "150=F\x01" "54=2\x01" "32=4\x01" "31=100\x01"), std::string::npos);
+    EXPECT_EQ(writer.getDroppedCount(), 0u);
+}
+
+TEST_F(ExecutionReportWriterTest, ReportsForAPreviousConnectionOnTheSameSocketAreDropped)
+{
+    ExecutionReportWriter writer(1);
+    const ClientId oldClient = writer.openClient(fds_[0]);
+    writer.closeClient(fds_[0]);
+    EXPECT_EQ(writer.clientId(fds_[0]), 0u);
+
+    // Same descriptor number, new connection: a new generation, so a new id
+    const ClientId newClient = writer.openClient(fds_[0]);
+    EXPECT_NE(newClient, oldClient);
+    EXPECT_EQ(newClient & 0xffffu, oldClient & 0xffffu);
+
+    writer.publish(0, {oldClient, ExecType::New, Side::Buy, 1, 100, 1, 0});
+    EXPECT_EQ(writer.getDroppedCount(), 1u);
+}
+
+TEST_F(ExecutionReportWriterTest, StatsFrameSentDirectlyArrivesWithReports)
+{
+    ExecutionReportWriter writer(1);
+    writer.start();
+    const ClientId client = writer.openClient(fds_[0]);
+
+    writer.publish(0, {client, ExecType::New, Side::Buy, 5, 100, 1, 0});
+    const std::string stats = "8=FIX.4.2\x01" "35=U2\x01" "Count=1\x01" "10=000\x01";
+    ASSERT_TRUE(writer.sendDirect(fds_[0], stats.data(), stats.size()));
+    const std::string frames = readFrames(2);
+    writer.stop();
+
+    EXPECT_NE(frames.find("\x01" "35=U2\x01"), std::string::npos);
+    EXPECT_NE(frames.find("\x01" "11=5\x01"), std::string::npos);
+}
+
+} // namespace
+} // namespace hft
@@ -23,6 +23,12 @@ std::string makeNewOrderFix()
            "10=000\x01";
 }
 
+std::string buildFrame(std::string_view body)
+{
+    char frame[256];
+    return std::string(frame, FIXParser::buildFrame(body, frame, sizeof(frame)));
+}
+
 TEST(FixParserTest, ParsesValidNewOrderSingle)
 {
     std::string msg = makeNewOrderFix();
@@ -551,5 +557,225 @@ TEST(FixParserTest, GetMessageTypeReadsTag35)
     EXPECT_EQ(type, "U1");
 }
 
+std::string makeNewOrderFixWithSymbol(const std::string &symbol)
+{
+    return "8=FIX.4.2\x01"
+           "35=D\x01"
+           "11=7\x01"
+           "55=" +
+           symbol +
+           "\x01"
+           "54=2\x01"
+           "38=10\x01"
+           "44=101\x01"
+           "40=2\x01"
+           "10=000\x01";
+}
+
+TEST(FixParserTest, SymbolIsResolvedThroughSymbolTable)
+{
+    SymbolTable symbols = SymbolTable::makeSynthetic(3);
+    std::string msg = makeNewOrderFixWithSymbol("SYM2");
+    size_t consumed = 0;
+
+    auto order = FIXParser::parse(std::span<const char>(msg.data(), msg.size()), consumed, &symbols);
+
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(order->symbol, 2u);
+    EXPECT_EQ(consumed, msg.size());
+}
+
+TEST(FixParserTest, UnknownSymbolIsRejectedButFrameConsumed)
+{
+    SymbolTable symbols = SymbolTable::makeSynthetic(3);
+    std::string msg = makeNewOrderFixWithSymbol("AAPL");
+    size_t consumed = 0;
+
+    auto order = FIXParser::parse(std::span<const char>(msg.data(), msg.size()), consumed, &symbols);
+
+    EXPECT_FALSE(order.has_value());
+    EXPECT_EQ(consumed, msg.size());
+}
+
+TEST(FixParserTest, MissingSymbolOrNoTableRoutesToDefaultSymbol)
+{
+    SymbolTable symbols = SymbolTable::makeSynthetic(3);
+    std::string withoutSymbol = makeNewOrderFix();
+    size_t consumed = 0;
+
+    auto order = FIXParser::parse(std::span<const char>(withoutSymbol.data(), withoutSymbol.size()), consumed, &symbols);
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(order->symbol, SymbolTable::DEFAULT_SYMBOL);
+
+    std::string withSymbol = makeNewOrderFixWithSymbol("SYM2");
+    order = FIXParser::parse(std::span<const char>(withSymbol.data(), withSymbol.size()), consumed);
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(order->symbol, SymbolTable::DEFAULT_SYMBOL);
+}
+
+TEST(FixParserTest, DecimalPriceIsScaledByTheSymbolsImpliedDecimals)
+{
+    SymbolTable symbols = SymbolTable::makeSynthetic(2);
+    symbols.setPriceDecimals(1, 2);
+    std::string cents = buildFrame("35=D\x01" "11=5\x01" "55=SYM1\x01" "54=1\x01" "44=101.25\x01" "38=3\x01"
+                                   "40=2\x01");
+    std::string whole = buildFrame("35=D\x01" "11=6\x01" "55=SYM0\x01" "54=1\x01" "44=101.25\x01" "38=3\x01"
+                                   "40=2\x01");
+    size_t consumed = 0;
+
+    auto order = FIXParser::parse(std::span<const char>(cents.data(), cents.size()), consumed, &symbols);
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(order->price, 10125u);
+
+    // SYM0 keeps whole ticks, so a fractional price is off its grid
+    EXPECT_FALSE(FIXParser::parse(std::span<const char>(whole.data(), whole.size()), consumed, &symbols).has_value());
+    EXPECT_EQ(consumed, whole.size());
+}
+
+TEST(FixParserTest, TokenizeFillsFieldTableInOnePass)
+{
+    std::string msg = "8=FIX.4.2\x01"
+                      "9=120\x01"
+                      "35=D\x01"
+                      "49=CLIENT01\x01"
+                      "56=EXCHANGE\x01"
+                      "34=7\x01"
+                      "11=42\x01"
+                      "1=ACCT\x01"
+                      "55=SYM1\x01"
+                      "54=2\x01"
+                      "38=5\x01"
+                      "40=1\x01"
+                      "10=000\x01";
+    size_t consumed = 0;
+    FixFields fields;
+
+    auto status = FIXParser::tokenize(std::span<const char>(msg.data(), msg.size()), consumed, fields);
+
+    EXPECT_EQ(status, FIXParser::FrameStatus::Complete);
+    EXPECT_EQ(consumed, msg.size());
+    EXPECT_EQ(fields.get(FixFields::MsgType), "D");
+    EXPECT_EQ(fields.get(FixFields::ClOrdId), "42");
+    EXPECT_EQ(fields.get(FixFields::Symbol), "SYM1");
+    EXPECT_EQ(fields.get(FixFields::Side), "2");
+    EXPECT_EQ(fields.get(FixFields::OrderQty), "5");
+    EXPECT_EQ(fields.get(FixFields::OrdType), "1");
+    EXPECT_FALSE(fields.has(FixFields::Price));
+    EXPECT_FALSE(fields.has(FixFields::TransactTime));
+}
+
+TEST(FixParserTest, TokenizeKeepsFirstOccurrenceAndSkipsUnknownTags)
+{
+    std::string msg = "8=FIX.4.2\x01"
+                      "35=U1\x01"
+                      "596=250\x01"
+                      "5960=1\x01"
+                      "x=y\x01"
+                      "596=999\x01"
+                      "10=000\x01";
+    size_t consumed = 0;
+    FixFields fields;
+
+    auto status = FIXParser::tokenize(std::span<const char>(msg.data(), msg.size()), consumed, fields);
+
+    EXPECT_EQ(status, FIXParser::FrameStatus::Complete);
+    EXPECT_EQ(fields.get(FixFields::MsgType), "U1");
+    EXPECT_EQ(fields.get(FixFields::ExpectedCount), "250");
+    EXPECT_FALSE(FIXParser::toOrder(fields).has_value());
+}
+
+TEST(FixParserTest, TokenizeStopsAtFirstFrameOfABatch)
+{
+    std::string first = makeNewOrderFix();
+    std::string batch = first + makeNewOrderFixWithSymbol("SYM0");
+    size_t consumed = 0;
+    FixFields fields;
+
+    auto status = FIXParser::tokenize(std::span<const char>(batch.data(), batch.size()), consumed, fields);
+
+    EXPECT_EQ(status, FIXParser::FrameStatus::Complete);
+    EXPECT_EQ(consumed, first.size());
+    EXPECT_EQ(fields.get(FixFields::ClOrdId), "123");
+    EXPECT_FALSE(fields.has(FixFields::Symbol));
+}
+
+TEST(FixParserTest, BuildFrameWritesBodyLengthAndChecksum)
+{
+    std::string frame = buildFrame("35=D\x01" "11=7\x01");
+
+    EXPECT_EQ(frame.substr(0, 15), std::string("8=FIX.4.2\x01" "9=10\x01"));
+    unsigned sum = 0;
+    for (size_t i = 0; i + 7 < frame.size(); ++i)
+    {
+        sum += static_cast<unsigned char>(frame[i]);
+    }
+    char expected[8];
+    std::snprintf(expected, sizeof(expected), "10=%03u\x01", sum % 256);
+    EXPECT_EQ(frame.substr(frame.size() - 7), expected);
+
+    char tooSmall[16];
+    EXPECT_EQ(FIXParser::buildFrame("35=D\x01" "11=7\x01", tooSmall, sizeof(tooSmall)), 0u);
+}
+
+TEST(FixParserTest, VerifyAcceptsAWellFormedFrame)
+{
+    std::string frame = buildFrame("35=D\x01" "11=9\x01" "54=1\x01" "44=100\x01" "38=10\x01" "40=2\x01");
+    std::string batch = frame + frame;
+    size_t consumed = 0;
+    FixFields fields;
+
+    auto status = FIXParser::tokenize(std::span<const char>(batch.data(), batch.size()), consumed, fields, true);
+
+    EXPECT_EQ(status, FIXParser::FrameStatus::Complete);
+    EXPECT_EQ(consumed, frame.size());
+    EXPECT_EQ(fields.get(FixFields::ClOrdId), "9");
+    EXPECT_TRUE(FIXParser::toOrder(fields).has_value());
+}
+
+TEST(FixParserTest, VerifyRejectsBadChecksumAndBodyLength)
+{
+    std::string frame = buildFrame("35=D\x01" "11=9\x01" "54=1\x01" "38=10\x01" "40=1\x01");
+
+    std::string badSum = frame;
+    badSum[badSum.size() - 2] ^= 1; // Last checksum digit, still a digit
+    std::string badLength = frame;
+    badLength.replace(badLength.find("9=") + 2, 2, "10");
+    std::string noLength = frame;
+    noLength.erase(noLength.find("9="), noLength.find('\x01', noLength.find("9=")) - noLength.find("9=") + 1);
+    // 9=67 points past this frame; it is caught once the next frame is behind it
+    std::string tooLong = makeNewOrderFix();
+
+    for (const std::string &msg : {badSum, badLength, noLength, tooLong})
+    {
+        std::string batch = msg + frame;
+        size_t consumed = 0;
+        FixFields fields;
+        auto status = FIXParser::tokenize(std::span<const char>(batch.data(), batch.size()), consumed, fields, true);
+        EXPECT_EQ(status, FIXParser::FrameStatus::Malformed);
+        EXPECT_EQ(consumed, msg.size());
+
+        // Without verify the same bytes still decode
+        consumed = 0;
+        FixFields lenient;
+        EXPECT_EQ(FIXParser::tokenize(std::span<const char>(batch.data(), batch.size()), consumed, lenient),
+                  FIXParser::FrameStatus::Complete);
+        EXPECT_EQ(consumed, msg.size());
+    }
+}
+
+TEST(FixParserTest, VerifyWaitsForTheWholeBodyFromTheHeader)
+{
+    std::string frame = buildFrame("35=D\x01" "11=9\x01" "54=1\x01" "38=10\x01" "40=1\x01");
+    size_t consumed = 0;
+    FixFields fields;
+
+    for (size_t cut = 16; cut < frame.size(); ++cut)
+    {
+        EXPECT_EQ(FIXParser::tokenize(std::span<const char>(frame.data(), cut), consumed, fields, true),
+                  FIXParser::FrameStatus::Incomplete);
+        EXPECT_EQ(consumed, 0u);
+    }
+}
+
 } // namespace
 } // namespace hft
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include "fix/fix_price.hpp"
+
+namespace hft
+{
+namespace
+{
+
+Price ticksOf(std::string_view text, uint8_t decimals)
+{
+    Price ticks = 0;
+    EXPECT_TRUE(FixPrice::parse(text, decimals, ticks)) << text;
+    return ticks;
+}
+
+bool rejects(std::string_view text, uint8_t decimals)
+{
+    Price ticks = 0;
+    return !FixPrice::parse(text, decimals, ticks);
+}
+
+TEST(FixPriceTest, ScalesToImpliedDecimals)
+{
+    EXPECT_EQ(ticksOf("101.25", 2), 10125u);
+    EXPECT_EQ(ticksOf("101.2", 2), 10120u);
+    EXPECT_EQ(ticksOf("101", 2), 10100u);
+    EXPECT_EQ(ticksOf("101.", 2), 10100u);
+    EXPECT_EQ(ticksOf("0.0001", 4), 1u);
+    EXPECT_EQ(ticksOf("130", 0), 130u);
+    EXPECT_EQ(ticksOf("00042", 0), 42u);
+}
+
+TEST(FixPriceTest, TrailingZerosPastPrecisionAreAccepted)
+{
+    EXPECT_EQ(ticksOf("101.250000", 2), 10125u);
+    EXPECT_EQ(ticksOf("130.00", 0), 130u);
+    EXPECT_EQ(ticksOf("1.50", 1), 15u);
+    EXPECT_TRUE(rejects("101.255", 2)); // Off the tick grid
+    EXPECT_TRUE(rejects("130.5", 0));
+}
+
+TEST(FixPriceTest, NonDigitsAreRejected)
+{
+    for (std::string_view text : {"", ".", ".5", "-1", "+1", "1e3", "1.2.3", "12a4", "1 2", "130x", "1/2", "9:"})
+    {
+        EXPECT_TRUE(rejects(text, 2)) << text;
+    }
+    EXPECT_TRUE(rejects("1", FixPrice::MAX_DECIMALS + 1));
+}
+
+TEST(FixPriceTest, LongValuesUseTheScalarPathAndDetectOverflow)
+{
+    EXPECT_EQ(ticksOf("1234567890123456", 0), 1234567890123456u); // 16 digits: last SWAR length
+    EXPECT_EQ(ticksOf("12345678901.234567", 7), 123456789012345670u);
+    EXPECT_EQ(ticksOf("18446744073709551615", 0), 18446744073709551615u);
+    EXPECT_TRUE(rejects("18446744073709551616", 0));
+    EXPECT_TRUE(rejects("18446744073.709551616", 9));
+}
+
+TEST(FixPriceTest, MatchesIntegerParsingForRandomValues)
+{
+    std::mt19937_64 rng(5);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint64_t ticks = rng() >> (rng() % 64);
+        for (uint8_t decimals : {0, 2, 4, 8})
+        {
+            std::string text = std::to_string(ticks);
+            if (decimals > 0)
+            {
+                text.insert(0, text.size() <= decimals ? decimals + 1 - text.size() : 0, '0');
+                text.insert(text.size() - decimals, 1, '.');
+            }
+            EXPECT_EQ(ticksOf(text, decimals), ticks) << text;
+        }
+    }
+}
+
+} // namespace
+} // namespace hft
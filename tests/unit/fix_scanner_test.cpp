@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fix/fix_checksum.hpp"
+#include "fix/fix_parser.hpp"
+#include "fix/fix_scanner.hpp"
+
+namespace hft
+{
+namespace
+{
+
+// Restores the startup kernel so other tests see the dispatched default
+class FixScannerTest : public ::testing::Test
+{
+  protected:
+    void TearDown() override
+    {
+        FixScanner::setLevel(defaultLevel_);
+    }
+
+    ScanLevel defaultLevel_ = FixScanner::getLevel();
+};
+
+std::vector<std::pair<size_t, bool>> collectDelimiters(const std::string &buffer)
+{
+    std::vector<std::pair<size_t, bool>> delimiters;
+    FixScanner scanner(std::span<const char>(buffer.data(), buffer.size()));
+    size_t position = 0;
+    bool isSoh = false;
+    while (scanner.next(position, isSoh))
+    {
+        delimiters.emplace_back(position, isSoh);
+    }
+    return delimiters;
+}
+
+TEST_F(FixScannerTest, EveryLevelFindsTheSameDelimitersAsAByteLoop)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, 5);
+    for (size_t size : {0u, 1u, 63u, 64u, 65u, 130u, 1000u})
+    {
+        std::string buffer(size, 'a');
+        for (char &c : buffer)
+        {
+            const int roll = pick(rng);
+            c = roll == 0 ? '\x01' : roll == 1 ? '=' : static_cast<char>('0' + roll);
+        }
+        std::vector<std::pair<size_t, bool>> expected;
+        for (size_t i = 0; i < buffer.size(); ++i)
+        {
+            if (buffer[i] == '\x01' || buffer[i] == '=')
+            {
+                expected.emplace_back(i, buffer[i] == '\x01');
+            }
+        }
+
+        for (ScanLevel level : FixScanner::getSupportedLevels())
+        {
+            ASSERT_TRUE(FixScanner::setLevel(level));
+            EXPECT_EQ(collectDelimiters(buffer), expected) << FixScanner::toString(level) << " size " << size;
+        }
+    }
+}
+
+TEST_F(FixScannerTest, BytesPastTheEndOfAPartialBlockAreIgnored)
+{
+    const std::string backing = "35=D\x01" "=\x01=\x01";
+    auto mask = FixScanner::scanBlock(backing.data(), 5); // Only "35=D<SOH>" is ours
+
+    EXPECT_EQ(mask.equals, 1ull << 2);
+    EXPECT_EQ(mask.soh, 1ull << 4);
+}
+
+TEST_F(FixScannerTest, TokenizerResultIsIndependentOfLevel)
+{
+    // Fields straddle the 64-byte block boundary, and a value contains '='
+    std::string msg = "8=FIX.4.2\x01" "9=150\x01" "35=D\x01" "49=CLIENT01\x01" "56=EXCHANGE\x01" "34=12\x01"
+                      "52=20240101-12:00:00.000\x01" "58=a=b\x01" "11=777\x01" "54=1\x01" "38=25\x01" "40=2\x01"
+                      "44=101\x01" "60=42\x01" "10=000\x01" "35=D\x01";
+
+    for (ScanLevel level : FixScanner::getSupportedLevels())
+    {
+        ASSERT_TRUE(FixScanner::setLevel(level));
+        size_t consumed = 0;
+        auto order = FIXParser::parse(std::span<const char>(msg.data(), msg.size()), consumed);
+
+        ASSERT_TRUE(order.has_value()) << FixScanner::toString(level);
+        EXPECT_EQ(consumed, msg.size() - 5);
+        EXPECT_EQ(order->id, 777u);
+        EXPECT_EQ(order->quantity, 25u);
+        EXPECT_EQ(order->price, 101u);
+        EXPECT_EQ(order->sendTimestamp, 42u);
+    }
+}
+
+TEST_F(FixScannerTest, ChecksumMatchesAByteSumAtEveryLevel)
+{
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (size_t size : {0u, 1u, 15u, 16u, 33u, 64u, 1000u})
+    {
+        std::string buffer(size, '\0');
+        unsigned expected = 0;
+        for (char &c : buffer)
+        {
+            c = static_cast<char>(byte(rng));
+            expected += static_cast<unsigned char>(c);
+        }
+
+        for (ScanLevel level : FixScanner::getSupportedLevels())
+        {
+            EXPECT_EQ(FixChecksum::compute(buffer.data(), buffer.size(), level), expected % 256)
+                << FixScanner::toString(level) << " size " << size;
+        }
+    }
+}
+
+TEST_F(FixScannerTest, ScalarIsAlwaysAvailable)
+{
+    EXPECT_TRUE(FixScanner::isSupported(ScanLevel::Scalar));
+    EXPECT_FALSE(FixScanner::getSupportedLevels().empty());
+}
+
+} // namespace
+} // namespace hft
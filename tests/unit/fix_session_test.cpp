@@ -0,0 +1,341 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "fix/fix_session.hpp"
+
+namespace hft
+{
+namespace
+{
+
+constexpr uint64_t SECOND_NS = 1'000'000'000ULL;
+
+// Frames one client message and runs it through the session (the frame must outlive the fields)
+class SessionHarness
+{
+  public:
+    FixSession::Verdict send(const std::string &body)
+    {
+        char frame[512];
+        const size_t length = FIXParser::buildFrame(body, frame, sizeof(frame));
+        size_t consumed = 0;
+        FixFields fields;
+        EXPECT_EQ(FIXParser::tokenize(std::span<const char>(frame, length), consumed, fields),
+                  FIXParser::FrameStatus::Complete);
+        return session.onMessage(fields);
+    }
+
+    FixSession::Verdict logon(uint64_t seqNum = 1, uint32_t heartbeatSeconds = 30)
+    {
+        return send("35=A\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=" + std::to_string(seqNum) +
+                    "\x01" "98=0\x01" "108=" + std::to_string(heartbeatSeconds) + "\x01");
+    }
+
+    FixSession::Verdict order(uint64_t seqNum, bool possDup = false)
+    {
+        return send("35=D\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=" + std::to_string(seqNum) + "\x01" +
+                    (possDup ? "43=Y\x01" : "") + "11=" + std::to_string(seqNum) +
+                    "\x01" "54=1\x01" "44=100\x01" "38=10\x01");
+    }
+
+    // Session replies queued so far, one body-less string of fields per frame; clears the outbox
+    std::vector<std::string> drain()
+    {
+        std::vector<std::string> frames;
+        const auto outbox = session.outbox();
+        size_t offset = 0;
+        while (offset < outbox.size())
+        {
+            size_t consumed = 0;
+            FixFields fields;
+            const auto status = FIXParser::tokenize(outbox.subspan(offset), consumed, fields, true);
+            EXPECT_EQ(status, FIXParser::FrameStatus::Complete);
+            if (status != FIXParser::FrameStatus::Complete)
+            {
+                break;
+            }
+            frames.emplace_back(outbox.data() + offset, consumed);
+            offset += consumed;
+        }
+        session.clearOutbox();
+        return frames;
+    }
+
+    FixSession session;
+};
+
+bool contains(const std::string &frame, const std::string &field)
+{
+    return frame.find("\x01" + field + "\x01") != std::string::npos;
+}
+
+TEST(FixSessionTest, LogonIsAcknowledgedAndOrdersAreDelivered)
+{
+    SessionHarness h;
+    EXPECT_EQ(h.logon(), FixSession::Verdict::Consumed);
+    EXPECT_EQ(h.session.getState(), FixSession::State::Active);
+    EXPECT_EQ(h.session.getHeartbeatSeconds(), 30u);
+
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=A"));
+    EXPECT_TRUE(contains(replies[0], "49=EXCHANGE"));
+    EXPECT_TRUE(contains(replies[0], "56=CLIENT"));
+    EXPECT_TRUE(contains(replies[0], "34=1"));
+    EXPECT_TRUE(contains(replies[0], "108=30"));
+
+    EXPECT_EQ(h.order(2), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.order(3), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.session.getExpectedSeqNum(), 4u);
+    EXPECT_TRUE(h.drain().empty()); // Nothing to say while in sequence
+}
+
+TEST(FixSessionTest, FirstMessageMustBeLogon)
+{
+    SessionHarness h;
+    EXPECT_EQ(h.order(1), FixSession::Verdict::Disconnect);
+    EXPECT_EQ(h.session.getState(), FixSession::State::LoggedOut);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=5"));
+}
+
+TEST(FixSessionTest, MissingSequenceNumberEndsTheSession)
+{
+    SessionHarness h;
+    h.logon();
+    EXPECT_EQ(h.send("35=D\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "11=1\x01" "54=1\x01" "44=100\x01" "38=10\x01"),
+              FixSession::Verdict::Disconnect);
+}
+
+TEST(FixSessionTest, GapIsRecoveredWithOneResendRequest)
+{
+    SessionHarness h;
+    h.logon();
+    h.drain();
+    EXPECT_EQ(h.order(2), FixSession::Verdict::Deliver);
+
+    // 3 is lost: 4 and 5 are held back and a single ResendRequest asks for 3 onwards
+    EXPECT_EQ(h.order(4), FixSession::Verdict::Consumed);
+    EXPECT_EQ(h.order(5), FixSession::Verdict::Consumed);
+    EXPECT_EQ(h.session.getGapCount(), 1u);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=2"));
+    EXPECT_TRUE(contains(replies[0], "7=3"));
+    EXPECT_TRUE(contains(replies[0], "16=0"));
+
+    // The resent copies are processed in order, then new traffic continues
+    EXPECT_EQ(h.order(3, true), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.order(4, true), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.order(5, true), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.order(6), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.session.getExpectedSeqNum(), 7u);
+    EXPECT_TRUE(h.drain().empty());
+}
+
+TEST(FixSessionTest, GapAfterAReplayIsRequestedAgain)
+{
+    SessionHarness h;
+    h.logon();
+    h.order(3); // 2 lost
+    h.order(2, true);
+    h.order(3, true);
+    h.drain();
+
+    // Recovery was all resent copies; a new loss must not wait for the resend throttle
+    EXPECT_EQ(h.order(5), FixSession::Verdict::Consumed);
+    EXPECT_EQ(h.session.getGapCount(), 2u);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "7=4"));
+}
+
+TEST(FixSessionTest, LogonAboveOneRequestsTheMissingRange)
+{
+    SessionHarness h;
+    EXPECT_EQ(h.logon(5), FixSession::Verdict::Consumed);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 2u);
+    EXPECT_TRUE(contains(replies[0], "35=A"));
+    EXPECT_TRUE(contains(replies[1], "35=2"));
+    EXPECT_TRUE(contains(replies[1], "7=1"));
+    EXPECT_EQ(h.session.getExpectedSeqNum(), 1u);
+}
+
+TEST(FixSessionTest, DuplicatesAreIgnoredOnlyWhenFlagged)
+{
+    SessionHarness h;
+    h.logon();
+    h.order(2);
+    h.order(3);
+    EXPECT_EQ(h.order(2, true), FixSession::Verdict::Consumed);
+    EXPECT_EQ(h.session.getDuplicateCount(), 1u);
+    EXPECT_EQ(h.session.getExpectedSeqNum(), 4u);
+
+    EXPECT_EQ(h.order(3), FixSession::Verdict::Disconnect);
+    h.drain();
+    EXPECT_EQ(h.order(4), FixSession::Verdict::Disconnect); // Nothing is accepted after a Logout
+}
+
+TEST(FixSessionTest, TestRequestIsAnsweredWithItsId)
+{
+    SessionHarness h;
+    h.logon();
+    h.drain();
+    EXPECT_EQ(h.send("35=1\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=2\x01" "112=PING7\x01"),
+              FixSession::Verdict::Consumed);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=0"));
+    EXPECT_TRUE(contains(replies[0], "112=PING7"));
+    EXPECT_TRUE(contains(replies[0], "34=2"));
+}
+
+TEST(FixSessionTest, ClientResendRequestIsGapFilled)
+{
+    SessionHarness h;
+    h.logon();
+    h.send("35=1\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=2\x01" "112=A\x01"); // Outbound 2
+    h.drain();
+    EXPECT_EQ(h.session.getNextOutgoingSeqNum(), 3u);
+
+    EXPECT_EQ(h.send("35=2\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=3\x01" "7=1\x01" "16=0\x01"),
+              FixSession::Verdict::Consumed);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=4"));
+    EXPECT_TRUE(contains(replies[0], "34=1"));
+    EXPECT_TRUE(contains(replies[0], "43=Y"));
+    EXPECT_TRUE(contains(replies[0], "123=Y"));
+    EXPECT_TRUE(contains(replies[0], "36=3"));
+    EXPECT_EQ(h.session.getNextOutgoingSeqNum(), 3u); // A GapFill does not consume a number
+}
+
+TEST(FixSessionTest, SequenceResetMovesTheExpectedNumber)
+{
+    SessionHarness h;
+    h.logon();
+    EXPECT_EQ(h.send("35=4\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=2\x01" "43=Y\x01" "123=Y\x01" "36=10\x01"),
+              FixSession::Verdict::Consumed);
+    EXPECT_EQ(h.session.getExpectedSeqNum(), 10u);
+    // Reset mode
+    EXPECT_EQ(h.send("35=4\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=1\x01" "36=20\x01"),
+              FixSession::Verdict::Consumed);
+    EXPECT_EQ(h.session.getExpectedSeqNum(), 20u);
+    EXPECT_EQ(h.order(20), FixSession::Verdict::Deliver);
+    // Never backwards
+    EXPECT_EQ(h.send("35=4\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=21\x01" "36=5\x01"),
+              FixSession::Verdict::Disconnect);
+}
+
+TEST(FixSessionTest, LogoutIsAcknowledged)
+{
+    SessionHarness h;
+    h.logon();
+    h.drain();
+    EXPECT_EQ(h.send("35=5\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=2\x01"), FixSession::Verdict::Disconnect);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=5"));
+    EXPECT_EQ(h.session.getState(), FixSession::State::LoggedOut);
+}
+
+TEST(FixSessionTest, TimersSendHeartbeatsThenTestRequestThenGiveUp)
+{
+    SessionHarness h;
+    const uint64_t start = 100 * SECOND_NS;
+    h.session.beginBatch(start);
+    h.logon(1, 10);
+    h.drain();
+
+    EXPECT_TRUE(h.session.onTimer(start + 5 * SECOND_NS));
+    EXPECT_TRUE(h.drain().empty());
+
+    // 10s without sending: Heartbeat. Receiving stays within 1.2 x HeartBtInt.
+    EXPECT_TRUE(h.session.onTimer(start + 10 * SECOND_NS));
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=0"));
+
+    // 12s of receive silence: TestRequest (its send also resets the heartbeat timer)
+    EXPECT_TRUE(h.session.onTimer(start + 12 * SECOND_NS));
+    replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=1"));
+
+    // Still silent after 2 x HeartBtInt: Logout and close
+    EXPECT_FALSE(h.session.onTimer(start + 20 * SECOND_NS));
+    replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=5"));
+}
+
+TEST(FixSessionTest, InboundTrafficClearsAPendingTestRequest)
+{
+    SessionHarness h;
+    const uint64_t start = 100 * SECOND_NS;
+    h.session.beginBatch(start);
+    h.logon(1, 10);
+    EXPECT_TRUE(h.session.onTimer(start + 12 * SECOND_NS)); // TestRequest
+    h.session.beginBatch(start + 13 * SECOND_NS);
+    h.send("35=0\x01" "49=CLIENT\x01" "56=EXCHANGE\x01" "34=2\x01" "112=TEST2\x01");
+    EXPECT_TRUE(h.session.onTimer(start + 20 * SECOND_NS));
+    EXPECT_EQ(h.session.getState(), FixSession::State::Active);
+}
+
+TEST(FixSessionTest, LogonToAnotherCompIdIsRejected)
+{
+    SessionHarness h;
+    EXPECT_EQ(h.send("35=A\x01" "49=CLIENT\x01" "56=OTHER\x01" "34=1\x01" "98=0\x01" "108=30\x01"),
+              FixSession::Verdict::Disconnect);
+    EXPECT_EQ(h.session.getState(), FixSession::State::LoggedOut);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "35=5"));
+    EXPECT_TRUE(contains(replies[0], "49=EXCHANGE")); // Our identity is not taken from the peer
+    EXPECT_TRUE(contains(replies[0], "58=TargetCompID mismatch"));
+}
+
+TEST(FixSessionTest, MessageFromAnotherSenderEndsTheSession)
+{
+    SessionHarness h;
+    h.logon();
+    h.drain();
+    EXPECT_EQ(h.order(2), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.send("35=D\x01" "49=INTRUDER\x01" "56=EXCHANGE\x01" "34=3\x01" "11=3\x01" "54=1\x01" "44=100\x01"
+                     "38=10\x01"),
+              FixSession::Verdict::Disconnect);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "58=SenderCompID mismatch"));
+}
+
+TEST(FixSessionTest, MessageToAnotherCompIdEndsTheSession)
+{
+    SessionHarness h;
+    h.logon();
+    h.drain();
+    EXPECT_EQ(h.order(2), FixSession::Verdict::Deliver);
+    EXPECT_EQ(h.send("35=D\x01" "49=CLIENT\x01" "56=OTHER\x01" "34=3\x01" "11=3\x01" "54=1\x01" "44=100\x01"
+                     "38=10\x01"),
+              FixSession::Verdict::Disconnect);
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "58=TargetCompID mismatch"));
+}
+
+TEST(FixSessionTest, SendingTimeIsUtc)
+{
+    SessionHarness h;
+    h.session.beginBatch(1709210096ULL * SECOND_NS + 789'000'000ULL); // 2024-02-29 12:34:56.789 UTC
+    h.logon();
+    auto replies = h.drain();
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_TRUE(contains(replies[0], "52=20240229-12:34:56.789"));
+}
+
+} // namespace
+} // namespace hft
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "network/gateway_parser_pool.hpp"
+#include "utils/work_stealing_deque.hpp"
+
+namespace hft
+{
+namespace
+{
+
+// Sessions own (and close) their socket, so tests hand them one end of a real socketpair.
+int openTestSocket()
+{
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+        return -1;
+    }
+    close(fds[1]);
+    return fds[0];
+}
+
+// Newline-delimited decimal numbers; records every complete one per socket in parse order.
+class RecordingParser
+{
+  public:
+    bool operator()(int clientSocket, std::span<const char> data, std::size_t &processed)
+    {
+        processed = 0;
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+            if (data[i] != '\n')
+            {
+                continue;
+            }
+            const std::string token(data.data() + processed, i - processed);
+            processed = i + 1;
+            if (token == "bad")
+            {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            seen_[clientSocket].push_back(std::stoi(token));
+            ++total_;
+        }
+        return true;
+    }
+
+    std::vector<int> seen(int clientSocket)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return seen_[clientSocket];
+    }
+
+    std::size_t total()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return total_;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::map<int, std::vector<int>> seen_;
+    std::size_t total_ = 0;
+};
+
+bool waitFor(const std::function<bool()> &done)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return done();
+}
+
+TEST(WorkStealingDequeTest, OwnerPopsOldestAndThiefStealsNewest)
+{
+    WorkStealingDeque<int> deque;
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+    EXPECT_EQ(deque.size(), 3u);
+
+    int value = 0;
+    ASSERT_TRUE(deque.pop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(deque.steal(value));
+    EXPECT_EQ(value, 3);
+    ASSERT_TRUE(deque.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(deque.pop(value));
+    EXPECT_FALSE(deque.steal(value));
+}
+
+TEST(GatewayParserPoolTest, RejectsZeroWorkers)
+{
+    EXPECT_THROW(GatewayParserPool(0, [](int, FixSession *, std::span<const char>, std::size_t &) { return true; }),
+                 std::runtime_error);
+}
+
+TEST(GatewayParserPoolTest, PreservesPerClientOrderAcrossFragmentedSubmits)
+{
+    RecordingParser parser;
+    GatewayParserPool pool(4, [&](int s, FixSession *, std::span<const char> d, std::size_t &p)
+                           { return parser(s, d, p); });
+    pool.start();
+
+    constexpr int CLIENTS = 6;
+    constexpr int MESSAGES = 2000;
+    std::vector<std::shared_ptr<ClientSession>> sessions;
+    for (int c = 0; c < CLIENTS; ++c)
+    {
+        const int fd = openTestSocket();
+        ASSERT_GE(fd, 0);
+        sessions.push_back(pool.openSession(fd));
+    }
+
+    // One I/O thread per client, submitting in odd-sized chunks so messages straddle submits
+    std::vector<std::thread> readers;
+    for (int c = 0; c < CLIENTS; ++c)
+    {
+        readers.emplace_back(
+            [&, c]()
+            {
+                std::string stream;
+                for (int i = 0; i < MESSAGES; ++i)
+                {
+                    stream += std::to_string(i) + "\n";
+                }
+                for (std::size_t pos = 0; pos < stream.size(); pos += 7)
+                {
+                    const std::size_t len = std::min<std::size_t>(7, stream.size() - pos);
+                    pool.submit(sessions[c], stream.data() + pos, len);
+                }
+            });
+    }
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_TRUE(waitFor([&]() { return parser.total() == static_cast<std::size_t>(CLIENTS * MESSAGES); }));
+    pool.stop();
+
+    for (const auto &session : sessions)
+    {
+        const auto seen = parser.seen(session->socket());
+        ASSERT_EQ(seen.size(), static_cast<std::size_t>(MESSAGES));
+        for (int i = 0; i < MESSAGES; ++i)
+        {
+            ASSERT_EQ(seen[i], i) << "client socket " << session->socket();
+        }
+        EXPECT_FALSE(session->failed());
+        EXPECT_EQ(session->pendingBytes(), 0u);
+    }
+}
+
+TEST(GatewayParserPoolTest, ParseFailureMarksSessionFailedAndStopsParsingIt)
+{
+    RecordingParser parser;
+    GatewayParserPool pool(2, [&](int s, FixSession *, std::span<const char> d, std::size_t &p)
+                           { return parser(s, d, p); });
+    pool.start();
+
+    const int fd = openTestSocket();
+    ASSERT_GE(fd, 0);
+    auto session = pool.openSession(fd);
+
+    const std::string first = "1\nbad\n2\n";
+    pool.submit(session, first.data(), first.size());
+    ASSERT_TRUE(waitFor([&]() { return session->failed(); }));
+
+    const std::string later = "3\n";
+    pool.submit(session, later.data(), later.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pool.stop();
+
+    EXPECT_EQ(parser.seen(fd), std::vector<int>{1});
+}
+
+TEST(GatewayParserPoolTest, SessionQueuedBehindABusyHomeWorkerIsStolenPromptly)
+{
+    // Two workers: sessions 0 and 2 share home worker 0. Session 0's parse blocks until released,
+    // so session 2 can only run if worker 1 wakes up and steals it.
+    std::atomic<int> blockedSocket{-1};
+    std::atomic<bool> release{false};
+    std::atomic<bool> blocking{false};
+    std::atomic<int64_t> parsedAtNs{0};
+    const auto nowNs = []()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    };
+    GatewayParserPool pool(2,
+                           [&](int s, FixSession *, std::span<const char> d, std::size_t &p)
+                           {
+                               p = d.size();
+                               if (s == blockedSocket.load())
+                               {
+                                   blocking.store(true);
+                                   while (!release.load())
+                                   {
+                                       std::this_thread::sleep_for(std::chrono::microseconds(50));
+                                   }
+                               }
+                               else
+                               {
+                                   parsedAtNs.store(nowNs());
+                               }
+                               return true;
+                           });
+    pool.start();
+
+    std::vector<std::shared_ptr<ClientSession>> sessions;
+    for (int c = 0; c < 3; ++c)
+    {
+        const int fd = openTestSocket();
+        ASSERT_GE(fd, 0);
+        sessions.push_back(pool.openSession(fd));
+    }
+    blockedSocket.store(sessions[0]->socket());
+
+    const std::string data = "x";
+    pool.submit(sessions[0], data.data(), data.size());
+    ASSERT_TRUE(waitFor([&]() { return blocking.load(); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Worker 1 is parked by now
+
+    const int64_t submittedNs = nowNs();
+    pool.submit(sessions[2], data.data(), data.size());
+    const bool parsed = waitFor([&]() { return parsedAtNs.load() != 0; });
+    release.store(true);
+    pool.stop();
+
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(pool.getStealCount(), 1u);
+    // A park timeout is 1 ms; a woken peer picks the session up in a few tens of microseconds
+    EXPECT_LT(parsedAtNs.load() - submittedNs, 500000);
+}
+
+} // namespace
+} // namespace hft
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "core/matching_engine.hpp"
+#include "core/order_book_factory.hpp"
+#include "utils/idle_strategy.hpp"
+
+namespace hft
+{
+namespace
+{
+
+TEST(IdleStrategyTest, NamesRoundTripForEverySupportedType)
+{
+    for (const auto &name : IdleStrategy::getSupportedTypes())
+    {
+        EXPECT_EQ(IdleStrategy::toString(IdleStrategy::fromString(name)), name);
+    }
+}
+
+TEST(IdleStrategyTest, UnknownNameThrows)
+{
+    EXPECT_THROW(IdleStrategy::fromString("sleepy"), std::runtime_error);
+}
+
+TEST(IdleStrategyTest, WakeIsNoOpUnlessParking)
+{
+    IdleStrategy spin(IdleStrategyType::BusySpin);
+    spin.wake();
+    EXPECT_EQ(spin.getWakeCount(), 0u);
+
+    IdleStrategy park(IdleStrategyType::Park);
+    park.wake(); // Nobody parked yet
+    EXPECT_EQ(park.getWakeCount(), 0u);
+}
+
+TEST(IdleStrategyTest, ParkReturnsImmediatelyWhenWorkArrivedBeforeSleeping)
+{
+    IdleStrategy park(IdleStrategyType::Park);
+
+    // Exhaust the spin phase; the next idle() announces the park and re-checks for work.
+    for (uint32_t i = 0; i < IdleStrategy::PARK_SPIN_ROUNDS; ++i)
+    {
+        park.idle([]() { return false; });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    park.idle([]() { return true; });
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, IdleStrategy::PARK_TIMEOUT);
+}
+
+TEST(IdleStrategyTest, BackoffEventuallySleepsButStaysBounded)
+{
+    IdleStrategy backoff(IdleStrategyType::Backoff);
+
+    const uint32_t warmRounds = IdleStrategy::BACKOFF_SPIN_ROUNDS + IdleStrategy::BACKOFF_YIELD_ROUNDS;
+    for (uint32_t i = 0; i < warmRounds + 20; ++i)
+    {
+        backoff.idle([]() { return false; });
+    }
+
+    // Sleep period is capped, so one more round cannot take much longer than the maximum.
+    const auto start = std::chrono::steady_clock::now();
+    backoff.idle([]() { return false; });
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, IdleStrategy::BACKOFF_MAX_SLEEP);
+    EXPECT_LT(elapsed, IdleStrategy::BACKOFF_MAX_SLEEP * 50);
+
+    backoff.reset();
+    const auto afterReset = std::chrono::steady_clock::now();
+    backoff.idle([]() { return false; });
+    EXPECT_LT(std::chrono::steady_clock::now() - afterReset, IdleStrategy::BACKOFF_MAX_SLEEP);
+}
+
+class IdleStrategyEngineTest : public ::testing::TestWithParam<IdleStrategyType>
+{
+};
+
+TEST_P(IdleStrategyEngineTest, EngineConsumesOrdersAndStopsUnderEachStrategy)
+{
+    LockFreeQueue<Order, 1024> queue;
+    auto book = OrderBookFactory::create("map");
+    MatchingEngine engine(queue, *book, GetParam());
+
+    std::atomic<bool> running{true};
+    std::thread t([&]() { engine.run(running); });
+
+    // Let the engine fall idle (and park, for the park strategy) before each push.
+    for (OrderId id = 1; id <= 5; ++id)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        ASSERT_TRUE(queue.push(Order{id, 100 + id, 10, Side::Buy, OrderType::Limit, 0, 0, 0}));
+        engine.getIdleStrategy().wake();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (engine.getMetrics().getOrderCount() < 5 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    t.join();
+
+    EXPECT_EQ(engine.getMetrics().getOrderCount(), 5u);
+    EXPECT_EQ(engine.getOrderBook().getOrderCount(), 5u);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllStrategies, IdleStrategyEngineTest,
+                         ::testing::Values(IdleStrategyType::BusySpin, IdleStrategyType::Pause,
+                                           IdleStrategyType::Backoff, IdleStrategyType::Park),
+                         [](const ::testing::TestParamInfo<IdleStrategyType> &info)
+                         { return std::string(IdleStrategy::toString(info.param)); });
+
+} // namespace
+} // namespace hft
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+#include "core/jitter_detector.hpp"
+#include "utils/rdtsc.hpp"
+
+namespace hft
+{
+namespace
+{
+
+using namespace std::chrono_literals;
+
+// Synthetic clock reads: `ns` after an arbitrary origin, in ticks
+uint64_t at(uint64_t ns)
+{
+    return 1000 + TscClock::fromNs(ns);
+}
+
+TEST(JitterDetectorTest, RejectsNonPositiveThreshold)
+{
+    EXPECT_THROW(JitterDetector(0ns), std::runtime_error);
+    EXPECT_THROW(JitterDetector(-5ns), std::runtime_error);
+}
+
+TEST(JitterDetectorTest, CountsOnlyGapsAboveTheThreshold)
+{
+    JitterDetector detector(1us);
+    detector.observe(at(0)); // First read only starts the clock
+    detector.observe(at(500));
+    detector.observe(at(900));
+    EXPECT_EQ(detector.getReport().stalls, 0u);
+
+    detector.observe(at(6900)); // 6 us gap
+    detector.observe(at(7000));
+    detector.observe(at(10000)); // 3 us gap
+
+    const JitterReport report = detector.getReport();
+    EXPECT_EQ(report.thresholdNs, 1000u);
+    EXPECT_EQ(report.stalls, 2u);
+    EXPECT_NEAR(static_cast<double>(report.stallNs), 9000.0, 10.0);
+    EXPECT_NEAR(static_cast<double>(report.maxStallNs), 6000.0, 10.0);
+    EXPECT_NEAR(static_cast<double>(report.observedNs), 10000.0, 10.0);
+    EXPECT_NEAR(report.stalledPct(), 90.0, 0.5);
+}
+
+TEST(JitterDetectorTest, RestartSkipsTheTimeSpentElsewhere)
+{
+    JitterDetector detector(1us);
+    detector.observe(at(0));
+    detector.restart(at(50000)); // e.g. a batch of orders: not a stall
+    detector.observe(at(50200));
+
+    const JitterReport report = detector.getReport();
+    EXPECT_EQ(report.stalls, 0u);
+    EXPECT_NEAR(static_cast<double>(report.observedNs), 200.0, 10.0);
+}
+
+TEST(JitterDetectorTest, EventsKeepTheMostRecentStallsOldestFirst)
+{
+    JitterDetector detector(1us);
+    uint64_t ns = 0;
+    detector.observe(at(ns));
+    for (std::size_t i = 0; i < JitterDetector::EVENT_CAPACITY + 10; ++i)
+    {
+        ns += 2000 + i * 10; // Every gap a stall, each a little longer
+        detector.observe(at(ns));
+    }
+
+    const std::vector<JitterEvent> events = detector.getEvents();
+    ASSERT_EQ(events.size(), JitterDetector::EVENT_CAPACITY);
+    EXPECT_EQ(detector.getReport().stalls, JitterDetector::EVENT_CAPACITY + 10);
+    EXPECT_NEAR(static_cast<double>(events.front().gapNs), 2100.0, 10.0); // The 10 oldest were overwritten
+    for (std::size_t i = 1; i < events.size(); ++i)
+    {
+        EXPECT_GT(events[i].gapNs, events[i - 1].gapNs);
+        EXPECT_GE(events[i].endNs, events[i - 1].endNs);
+    }
+}
+
+TEST(JitterDetectorTest, OutliersAreTiedToTheStallTheyWaitedThrough)
+{
+    JitterDetector detector(1us);
+    const uint64_t beforeStall = getCurrentTimeNs();
+    detector.observe(at(0));
+    detector.observe(at(5000));
+    ASSERT_EQ(detector.getEvents().size(), 1u);
+    const uint64_t stallEnd = detector.getEvents().front().endNs;
+
+    detector.recordOrder(TscClock::fromNs(500), beforeStall); // Fast: not an outlier
+    detector.recordOrder(TscClock::fromNs(8000), beforeStall);
+    detector.recordOrder(TscClock::fromNs(8000), stallEnd + 1); // Slow for another reason
+    detector.recordOrder(TscClock::fromNs(8000), 0);            // Arrival unknown
+
+    const JitterReport report = detector.getReport();
+    EXPECT_EQ(report.outliers, 3u);
+    EXPECT_EQ(report.outliersInStall, 1u);
+}
+
+TEST(JitterDetectorTest, MergeAddsReports)
+{
+    JitterReport a;
+    a.thresholdNs = 1000;
+    a.observedNs = 1000000;
+    a.stalls = 2;
+    a.stallNs = 10000;
+    a.maxStallNs = 8000;
+    a.outliers = 3;
+    a.outliersInStall = 1;
+    JitterReport b;
+    b.thresholdNs = 1000;
+    b.observedNs = 3000000;
+    b.stalls = 1;
+    b.stallNs = 30000;
+    b.maxStallNs = 30000;
+    b.outliers = 1;
+
+    a.merge(b);
+    EXPECT_EQ(a.observedNs, 4000000u);
+    EXPECT_EQ(a.stalls, 3u);
+    EXPECT_EQ(a.stallNs, 40000u);
+    EXPECT_EQ(a.maxStallNs, 30000u);
+    EXPECT_EQ(a.outliers, 4u);
+    EXPECT_EQ(a.outliersInStall, 1u);
+    EXPECT_DOUBLE_EQ(a.stalledPct(), 1.0);
+    EXPECT_DOUBLE_EQ(JitterReport{}.stalledPct(), 0.0);
+}
+
+} // namespace
+} // namespace hft
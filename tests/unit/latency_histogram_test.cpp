@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "core/latency_histogram.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace hft
+{
+namespace
+{
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKET_COUNT; ++value)
+    {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(value), value);
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(value), value);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsCoverTheRangeWithBoundedError)
+{
+    const uint64_t values[] = {256, 257, 1000, 123456, 987654321, 1ULL << 40, (1ULL << 63) + 12345, ~0ULL};
+    for (uint64_t value : values)
+    {
+        const std::size_t index = LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+        const uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / LatencyHistogram::SUB_BUCKET_HALF);
+        EXPECT_EQ(LatencyHistogram::bucketIndex(upper), index);
+        if (upper != ~0ULL)
+        {
+            EXPECT_EQ(LatencyHistogram::bucketIndex(upper + 1), index + 1);
+        }
+    }
+    EXPECT_EQ(LatencyHistogram::bucketIndex(~0ULL), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformSamples)
+{
+    LatencyHistogram histogram;
+    constexpr uint64_t kSamples = 100000;
+    for (uint64_t i = 1; i <= kSamples; ++i)
+    {
+        histogram.record(i);
+    }
+
+    const LatencyStats stats = histogram.stats();
+    EXPECT_EQ(stats.count, kSamples);
+    EXPECT_DOUBLE_EQ(stats.mean, (kSamples + 1) / 2.0);
+    EXPECT_EQ(stats.max, kSamples);
+
+    const std::pair<uint64_t, uint64_t> expected[] = {
+        {stats.p50, 50000}, {stats.p90, 90000}, {stats.p99, 99000}, {stats.p999, 99900}, {stats.p9999, 99990}};
+    for (const auto &[reported, exact] : expected)
+    {
+        EXPECT_GE(reported, exact);
+        EXPECT_LE(reported, exact + exact / LatencyHistogram::SUB_BUCKET_HALF);
+    }
+}
+
+TEST(LatencyHistogramTest, TailPercentilesNeverExceedMax)
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 999; ++i)
+    {
+        histogram.record(100);
+    }
+    histogram.record(1000001);
+
+    const LatencyStats stats = histogram.stats();
+    EXPECT_EQ(stats.p50, 100u);
+    EXPECT_EQ(stats.p99, 100u);
+    EXPECT_EQ(stats.p999, 100u);
+    EXPECT_EQ(stats.p9999, 1000001u);
+    EXPECT_EQ(stats.max, 1000001u);
+}
+
+TEST(LatencyHistogramTest, SnapshotsMergeAcrossWriters)
+{
+    LatencyHistogram even;
+    LatencyHistogram odd;
+    LatencyHistogram all;
+    for (uint64_t i = 1; i <= 20000; ++i)
+    {
+        (i % 2 == 0 ? even : odd).record(i * 7);
+        all.record(i * 7);
+    }
+
+    LatencyHistogram::Snapshot merged;
+    merged.add(even);
+    merged.add(odd);
+
+    const LatencyStats fromMerge = merged.stats();
+    const LatencyStats fromOne = all.stats();
+    EXPECT_EQ(merged.count(), 20000u);
+    EXPECT_DOUBLE_EQ(fromMerge.mean, fromOne.mean);
+    EXPECT_EQ(fromMerge.p50, fromOne.p50);
+    EXPECT_EQ(fromMerge.p99, fromOne.p99);
+    EXPECT_EQ(fromMerge.p9999, fromOne.p9999);
+    EXPECT_EQ(fromMerge.max, fromOne.max);
+}
+
+TEST(LatencyHistogramTest, ReadersRunAlongsideTheWriter)
+{
+    LatencyHistogram histogram;
+    constexpr uint64_t kSamples = 200000;
+    std::atomic<bool> done{false};
+
+    std::thread writer(
+        [&]()
+        {
+            for (uint64_t i = 0; i < kSamples; ++i)
+            {
+                histogram.record(i % 5000);
+            }
+            done.store(true);
+        });
+
+    uint64_t lastCount = 0;
+    while (!done.load())
+    {
+        const LatencyStats stats = histogram.stats();
+        EXPECT_GE(stats.count, lastCount);
+        EXPECT_LE(stats.p50, 4999u);
+        lastCount = stats.count;
+    }
+    writer.join();
+
+    EXPECT_EQ(histogram.stats().count, kSamples);
+}
+
+} // namespace
+} // namespace hft
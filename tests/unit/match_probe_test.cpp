@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include "core/match_probe.hpp"
+#include "core/order_book_factory.hpp"
+
+namespace hft
+{
+namespace
+{
+
+using EnabledProbe = BasicMatchProbe<true>;
+
+volatile uint64_t sink = 0;
+
+void burn()
+{
+    for (uint64_t i = 0; i < 200000; ++i)
+    {
+        sink = sink + i;
+    }
+}
+
+size_t index(MatchPhase phase)
+{
+    return static_cast<size_t>(phase);
+}
+
+TEST(MatchProbeTest, NestedProbesAttributeTimeExclusively)
+{
+    EnabledProbe::reset();
+    {
+        EnabledProbe outer(MatchPhase::Other);
+        {
+            EnabledProbe walk(MatchPhase::FifoWalk);
+            burn();
+            EnabledProbe emit(MatchPhase::TradeEmit);
+            burn();
+        }
+    }
+    const MatchProfile profile = EnabledProbe::profile();
+
+    EXPECT_EQ(profile.matches(), 1u);
+    EXPECT_EQ(profile.entries[index(MatchPhase::FifoWalk)], 1u);
+    EXPECT_EQ(profile.entries[index(MatchPhase::TradeEmit)], 1u);
+    EXPECT_EQ(profile.entries[index(MatchPhase::LevelLookup)], 0u);
+    EXPECT_GT(profile.ticks[index(MatchPhase::FifoWalk)], 0u);
+    EXPECT_GT(profile.ticks[index(MatchPhase::TradeEmit)], 0u);
+    // The burns ran inside the inner probes: the outer one only saw the transitions
+    EXPECT_LT(profile.ticks[index(MatchPhase::Other)], profile.ticks[index(MatchPhase::FifoWalk)]);
+    EXPECT_EQ(profile.totalTicks(), profile.ticks[0] + profile.ticks[1] + profile.ticks[2] + profile.ticks[3] +
+                                        profile.ticks[4]);
+}
+
+TEST(MatchProbeTest, StopEndsThePhaseOnceAndResumesTheParent)
+{
+    EnabledProbe::reset();
+    {
+        EnabledProbe outer(MatchPhase::Other);
+        EnabledProbe lookup(MatchPhase::LevelLookup);
+        lookup.stop();
+        const MatchProfile afterStop = EnabledProbe::profile();
+        burn(); // Back in Other
+        lookup.stop();
+        EXPECT_EQ(EnabledProbe::profile().ticks[index(MatchPhase::LevelLookup)],
+                  afterStop.ticks[index(MatchPhase::LevelLookup)]);
+    }
+    const MatchProfile profile = EnabledProbe::profile();
+    EXPECT_EQ(profile.entries[index(MatchPhase::LevelLookup)], 1u);
+    EXPECT_GT(profile.ticks[index(MatchPhase::Other)], profile.ticks[index(MatchPhase::LevelLookup)]);
+
+    EnabledProbe::reset();
+    EXPECT_EQ(EnabledProbe::profile().totalTicks(), 0u);
+    EXPECT_EQ(EnabledProbe::profile().matches(), 0u);
+}
+
+TEST(MatchProbeTest, DisabledProbeRecordsNothing)
+{
+    BasicMatchProbe<false> probe(MatchPhase::TradeEmit);
+    probe.stop();
+    EXPECT_EQ(BasicMatchProbe<false>::profile().totalTicks(), 0u);
+    EXPECT_EQ(BasicMatchProbe<false>::profile().matches(), 0u);
+}
+
+TEST(MatchProbeTest, MergeAddsPhases)
+{
+    MatchProfile a;
+    a.ticks[index(MatchPhase::FifoWalk)] = 10;
+    a.entries[index(MatchPhase::Other)] = 1;
+    MatchProfile b;
+    b.ticks[index(MatchPhase::FifoWalk)] = 5;
+    b.ticks[index(MatchPhase::TradeEmit)] = 3;
+    b.entries[index(MatchPhase::Other)] = 2;
+
+    a.merge(b);
+    EXPECT_EQ(a.ticks[index(MatchPhase::FifoWalk)], 15u);
+    EXPECT_EQ(a.totalTicks(), 18u);
+    EXPECT_EQ(a.matches(), 3u);
+    EXPECT_STREQ(matchPhaseToString(MatchPhase::LookupErase), "lookup_erase");
+}
+
+class MatchProbeBookTest : public ::testing::TestWithParam<std::string>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(AllBooks, MatchProbeBookTest, ::testing::ValuesIn(OrderBookFactory::getSupportedTypes()));
+
+// One bid filled by two asks at one level: two trades, three filled orders
+TEST_P(MatchProbeBookTest, MatchReportsItsPhasesWhenProbesAreBuiltIn)
+{
+    auto book = OrderBookFactory::create(GetParam());
+    book->addOrder(Order{1, 100, 10, Side::Buy, OrderType::Limit, 0, 0, 0});
+    book->addOrder(Order{2, 100, 4, Side::Sell, OrderType::Limit, 0, 0, 0});
+    book->addOrder(Order{3, 100, 6, Side::Sell, OrderType::Limit, 0, 0, 0});
+
+    MatchProbe::reset();
+    ASSERT_EQ(book->match().size(), 2u);
+    const MatchProfile profile = MatchProbe::profile();
+
+    if (!MATCH_PROBES_ENABLED)
+    {
+        EXPECT_EQ(profile.totalTicks(), 0u);
+        EXPECT_EQ(profile.matches(), 0u);
+        return;
+    }
+    EXPECT_EQ(profile.matches(), 1u);
+    EXPECT_EQ(profile.entries[index(MatchPhase::TradeEmit)], 2u);
+    EXPECT_EQ(profile.entries[index(MatchPhase::FifoWalk)], 2u);
+    EXPECT_EQ(profile.entries[index(MatchPhase::LookupErase)], 3u);
+    EXPECT_GE(profile.entries[index(MatchPhase::LevelLookup)], 1u);
+    EXPECT_GT(profile.totalTicks(), 0u);
+}
+
+} // namespace
+} // namespace hft
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 
+#include "core/execution_report.hpp"
 #include "core/matching_engine.hpp"
 
 namespace hft
@@ -54,6 +56,19 @@ class StubOrderBook : public IOrderBook
     std::vector<Trade> tradesToReturn;
 };
 
+class RecordingReportSink : public ExecutionReportSink
+{
+  public:
+    void publish(std::size_t producer, const ExecutionReport &report) override
+    {
+        producers.push_back(producer);
+        reports.push_back(report);
+    }
+
+    std::vector<std::size_t> producers;
+    std::vector<ExecutionReport> reports;
+};
+
 TEST(MatchingEngineTest, ProcessOrderInvokesBookAndUpdatesCounters)
 {
     LockFreeQueue<Order, 1024> queue;
@@ -91,6 +106,11 @@ TEST(MatchingEngineTest, ProcessOrderCapturesLatencySample)
 
 TEST(MatchingEngineTest, ProcessOrderWithSendAndReceiveRecordsDecomposedStats)
 {
+    if constexpr (!MetricsCollector::RECORDS_LATENCY)
+    {
+        GTEST_SKIP() << "HFT_METRICS_BACKEND=disabled records no latencies";
+    }
+
     LockFreeQueue<Order, 1024> queue;
     StubOrderBook book;
 
@@ -106,6 +126,11 @@ TEST(MatchingEngineTest, ProcessOrderWithSendAndReceiveRecordsDecomposedStats)
 
 TEST(MatchingEngineTest, ProcessOrderWithOnlyReceiveTimestampRecordsQueue)
 {
+    if constexpr (!MetricsCollector::RECORDS_LATENCY)
+    {
+        GTEST_SKIP() << "HFT_METRICS_BACKEND=disabled records no latencies";
+    }
+
     LockFreeQueue<Order, 1024> queue;
     StubOrderBook book;
 
@@ -187,5 +212,182 @@ TEST(MatchingEngineTest, OrderBookGettersReturnBoundInstance)
     EXPECT_EQ(&constRef, &book);
 }
 
+TEST(MatchingEngineTest, RegistryEngineRoutesOrdersBySymbol)
+{
+    LockFreeQueue<Order, 1024> queue;
+    OrderBookRegistry books("map", 3);
+    MatchingEngine engine(queue, books);
+
+    Order order{1, 100, 10, Side::Buy, OrderType::Limit, 0, 0, 0};
+    order.symbol = 2;
+    engine.processOrder(order);
+
+    order.id = 2;
+    order.symbol = 0;
+    engine.processOrder(order);
+
+    EXPECT_EQ(engine.getSymbolCount(), 3u);
+    EXPECT_EQ(engine.getOrderBook(0).getOrderCount(), 1u);
+    EXPECT_EQ(engine.getOrderBook(1).getOrderCount(), 0u);
+    EXPECT_EQ(engine.getOrderBook(2).getOrderCount(), 1u);
+    EXPECT_EQ(&engine.getOrderBook(2), &books.get(2));
+}
+
+TEST(MatchingEngineTest, OrderForUnknownSymbolIsCountedNotProcessed)
+{
+    LockFreeQueue<Order, 1024> queue;
+    StubOrderBook book;
+    MatchingEngine engine(queue, book);
+
+    Order order{1, 100, 10, Side::Buy, OrderType::Limit, 0, 0, 0};
+    order.symbol = 5;
+    engine.processOrder(order);
+
+    EXPECT_EQ(book.addCalls, 0);
+    EXPECT_EQ(engine.getUnroutedOrderCount(), 1u);
+    EXPECT_EQ(engine.getMetrics().getOrderCount(), 0u);
+}
+
+TEST(MatchingEngineTest, PublishesAckAndFillsToOwningClients)
+{
+    LockFreeQueue<Order, 1024> queue;
+    StubOrderBook book;
+    // Only the resting side (client 9) and the incoming order (client 7) have connections
+    book.tradesToReturn = {{21, 20, 130, 4, 7, 9}, {21, 19, 130, 1, 7, 0}};
+    RecordingReportSink sink;
+    MatchingEngine engine(queue, book);
+    engine.setExecutionReportSink(&sink, 3);
+
+    Order order{21, 131, 5, Side::Buy, OrderType::Limit, 0, 0, 555};
+    order.client = 7;
+    engine.processOrder(order);
+
+    ASSERT_EQ(sink.reports.size(), 4u);
+    EXPECT_EQ(sink.reports[0].client, 7u);
+    EXPECT_EQ(sink.reports[0].type, ExecType::New);
+    EXPECT_EQ(sink.reports[0].price, 131u);
+    EXPECT_EQ(sink.reports[0].quantity, 5u);
+    EXPECT_EQ(sink.reports[0].timestamp, 555u); // Echo of the client's send time
+
+    EXPECT_EQ(sink.reports[1].client, 7u);
+    EXPECT_EQ(sink.reports[1].type, ExecType::Trade);
+    EXPECT_EQ(sink.reports[1].side, Side::Buy);
+    EXPECT_EQ(sink.reports[2].client, 9u);
+    EXPECT_EQ(sink.reports[2].side, Side::Sell);
+    EXPECT_EQ(sink.reports[2].orderId, 20u);
+    EXPECT_EQ(sink.reports[2].quantity, 4u);
+    EXPECT_EQ(sink.reports[3].client, 7u);
+    EXPECT_EQ(sink.reports[3].quantity, 1u);
+
+    for (std::size_t producer : sink.producers)
+    {
+        EXPECT_EQ(producer, 3u);
+    }
+}
+
+TEST(MatchingEngineTest, OrdersWithoutClientPublishNothing)
+{
+    LockFreeQueue<Order, 1024> queue;
+    StubOrderBook book;
+    book.tradesToReturn = {{1, 2, 130, 5}};
+    RecordingReportSink sink;
+    MatchingEngine engine(queue, book);
+    engine.setExecutionReportSink(&sink);
+
+    engine.processOrder({1, 130, 5, Side::Buy, OrderType::Limit, 0, 0, 0});
+
+    EXPECT_TRUE(sink.reports.empty());
+}
+
+TEST(MatchingEngineTest, RunPublishesStatusOnlyWhenEnabled)
+{
+    LockFreeQueue<Order, 1024> queue;
+    StubOrderBook book;
+    book.tradesToReturn = {{1, 2, 130, 5}};
+    MatchingEngine engine(queue, book);
+    std::atomic<bool> running{false};
+
+    ASSERT_TRUE(queue.push({1, 130, 5, Side::Buy, OrderType::Limit, 0, 0, 0}));
+    engine.run(running);
+    EXPECT_EQ(engine.getStatus().orders, 0u); // Interval 0: never published
+
+    engine.setStatusInterval(std::chrono::microseconds(50));
+    running.store(true);
+    std::thread worker([&]() { engine.run(running); });
+    EXPECT_TRUE(queue.push({2, 130, 5, Side::Sell, OrderType::Limit, 0, 0, 0}));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (engine.getStatus().orders < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+    const EngineStatus status = engine.getStatus();
+    running.store(false);
+    worker.join();
+
+    EXPECT_EQ(status.orders, 2u);
+    EXPECT_EQ(status.trades, 2u);
+    EXPECT_EQ(status.queueDepth, 0u);
+    EXPECT_GT(status.publishedNs, 0u);
+}
+
+TEST(MatchingEngineTest, OrderTraceRecordsEachOrderLifecycle)
+{
+    LockFreeQueue<Order, 1024> queue;
+    StubOrderBook book;
+    book.tradesToReturn = {{1, 2, 130, 5}, {1, 3, 130, 2}};
+    MatchingEngine engine(queue, book);
+    EXPECT_EQ(engine.getOrderTrace(), nullptr);
+    engine.enableOrderTrace(16);
+
+    const uint64_t now = getCurrentTimeNs();
+    engine.processOrder({7, 130, 7, Side::Sell, OrderType::Market, 0, now - 100, now - 500});
+    engine.processOrder({8, 131, 1, Side::Buy, OrderType::Limit, 0, 0, 0});
+
+    ASSERT_NE(engine.getOrderTrace(), nullptr);
+    const std::vector<OrderTraceRecord> trace = engine.getOrderTrace()->snapshot();
+    ASSERT_EQ(trace.size(), 2u);
+
+    EXPECT_EQ(trace[0].orderId, 7u);
+    EXPECT_EQ(trace[0].sendNs, now - 500);
+    EXPECT_EQ(trace[0].receiveNs, now - 100);
+    EXPECT_GE(trace[0].dequeueNs, now);
+    EXPECT_GE(trace[0].engineEnd, trace[0].engineStart);
+    EXPECT_EQ(trace[0].trades, 2u);
+    EXPECT_EQ(trace[0].depth, 0u);
+    EXPECT_EQ(trace[0].side, Side::Sell);
+    EXPECT_EQ(trace[0].type, OrderType::Market);
+
+    // Direct orders carry no stamps: only the engine interval is traced
+    EXPECT_EQ(trace[1].orderId, 8u);
+    EXPECT_EQ(trace[1].dequeueNs, 0u);
+    EXPECT_GE(trace[1].engineEnd, trace[1].engineStart);
+    EXPECT_GE(trace[1].engineStart, trace[0].engineEnd);
+}
+
+TEST(MatchingEngineTest, JitterDetectorWatchesIdlePollsAndCountsSlowOrders)
+{
+    LockFreeQueue<Order, 1024> queue;
+    StubOrderBook book;
+    MatchingEngine engine(queue, book);
+    EXPECT_EQ(engine.getJitterDetector(), nullptr);
+    engine.enableJitterDetector(std::chrono::milliseconds(1));
+    ASSERT_NE(engine.getJitterDetector(), nullptr);
+
+    // Received 20 ms ago: slower than the threshold. A direct order is not.
+    engine.processOrder({1, 130, 5, Side::Buy, OrderType::Limit, 0, getCurrentTimeNs() - 20000000, 0});
+    engine.processOrder({2, 130, 5, Side::Buy, OrderType::Limit, 0, 0, 0});
+    EXPECT_EQ(engine.getJitterDetector()->getReport().outliers, 1u);
+    EXPECT_EQ(engine.getJitterDetector()->getReport().observedNs, 0u);
+
+    std::atomic<bool> running{true};
+    std::thread worker([&]() { engine.run(running); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    running.store(false, std::memory_order_relaxed);
+    worker.join();
+
+    EXPECT_GT(engine.getJitterDetector()->getReport().observedNs, 0u);
+}
+
 } // namespace
 } // namespace hft
@@ -2,14 +2,20 @@
 
 #include "core/metrics_collector.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace hft
 {
 namespace
 {
 
+// The histogram backend explicitly, so these hold whatever HFT_METRICS_BACKEND the tree is built with
+using HistogramMetrics = BasicMetricsCollector<MetricsBackend::Histogram>;
+
 TEST(MetricsCollectorTest, EmptyStatsReturnZeros)
 {
-    MetricsCollector metrics;
+    HistogramMetrics metrics;
 
     auto total = metrics.getStats();
     auto net = metrics.getNetworkStats();
@@ -27,7 +33,7 @@ TEST(MetricsCollectorTest, EmptyStatsReturnZeros)
 
 TEST(MetricsCollectorTest, RecordsSamplesAndCounters)
 {
-    MetricsCollector metrics;
+    HistogramMetrics metrics;
 
     metrics.recordLatency(100);
     metrics.recordLatency(200);
@@ -68,12 +74,12 @@ TEST(MetricsCollectorTest, RecordsSamplesAndCounters)
     EXPECT_EQ(que.max, 60u);
 }
 
-TEST(MetricsCollectorTest, CapacityGuardsStopAdditionalSamples)
+TEST(MetricsCollectorTest, KeepsRecordingPastOneMillionSamples)
 {
-    MetricsCollector metrics;
-    constexpr uint64_t kCap = 1000000;
+    HistogramMetrics metrics;
+    constexpr uint64_t kSamples = 1500000;
 
-    for (uint64_t i = 1; i <= kCap + 1; ++i)
+    for (uint64_t i = 1; i <= kSamples; ++i)
     {
         metrics.recordLatency(i);
         metrics.recordNetworkLatency(i);
@@ -81,20 +87,71 @@ TEST(MetricsCollectorTest, CapacityGuardsStopAdditionalSamples)
         metrics.recordQueueLatency(i);
     }
 
-    auto total = metrics.getStats();
-    auto net = metrics.getNetworkStats();
-    auto eng = metrics.getEngineStats();
-    auto que = metrics.getQueueStats();
+    for (const LatencyStats &stats :
+         {metrics.getStats(), metrics.getNetworkStats(), metrics.getEngineStats(), metrics.getQueueStats()})
+    {
+        EXPECT_EQ(stats.count, kSamples);
+        EXPECT_DOUBLE_EQ(stats.mean, (kSamples + 1) / 2.0);
+        EXPECT_EQ(stats.max, kSamples);
+        EXPECT_GE(stats.p99, kSamples * 99 / 100);
+        EXPECT_LE(stats.p99, kSamples * 99 / 100 + kSamples / 128);
+    }
+}
+
+TEST(MetricsCollectorTest, DisabledBackendOnlyCountsOrdersAndTrades)
+{
+    BasicMetricsCollector<MetricsBackend::Disabled> metrics;
+    static_assert(!decltype(metrics)::RECORDS_LATENCY);
+
+    metrics.recordLatency(100);
+    metrics.recordQueueLatency(50);
+    metrics.incrementOrders();
+    metrics.incrementTrades(2);
+
+    EXPECT_EQ(metrics.getOrderCount(), 1u);
+    EXPECT_EQ(metrics.getTradeCount(), 2u);
+    EXPECT_EQ(metrics.getStats().count, 0u);
+    EXPECT_EQ(metrics.getStats().max, 0u);
+    EXPECT_EQ(metrics.getQueueStats().mean, 0.0);
+}
+
+TEST(MetricsCollectorTest, CountersBackendKeepsMeanAndMaxOnly)
+{
+    BasicMetricsCollector<MetricsBackend::Counters> metrics;
+
+    metrics.recordLatency(100);
+    metrics.recordLatency(200);
+    metrics.recordLatency(600);
+
+    const LatencyStats stats = metrics.getStats();
+    EXPECT_EQ(stats.count, 3u);
+    EXPECT_DOUBLE_EQ(stats.mean, 300.0);
+    EXPECT_EQ(stats.max, 600u);
+    EXPECT_EQ(stats.p50, 0u);
+    EXPECT_EQ(stats.p99, 0u);
+    EXPECT_EQ(metrics.getEngineStats().count, 0u);
+}
+
+TEST(MetricsCollectorTest, TraceBackendKeepsSamplesInArrivalOrder)
+{
+    BasicMetricsCollector<MetricsBackend::Trace> metrics;
+
+    const uint64_t samples[] = {300, 100, 200, 5000};
+    for (uint64_t sample : samples)
+    {
+        metrics.recordEngineLatency(sample);
+    }
+
+    const auto trace = metrics.getEngineRecorder().trace();
+    ASSERT_EQ(trace.size(), 4u);
+    EXPECT_TRUE(std::equal(trace.begin(), trace.end(), std::begin(samples)));
+    EXPECT_TRUE(metrics.getLatencyRecorder().trace().empty());
 
-    // If guard works, vectors stop at exactly kCap and ignore kCap+1 sample.
-    EXPECT_DOUBLE_EQ(total.mean, (kCap + 1) / 2.0);
-    EXPECT_DOUBLE_EQ(net.mean, (kCap + 1) / 2.0);
-    EXPECT_DOUBLE_EQ(eng.mean, (kCap + 1) / 2.0);
-    EXPECT_DOUBLE_EQ(que.mean, (kCap + 1) / 2.0);
-    EXPECT_EQ(total.max, kCap);
-    EXPECT_EQ(net.max, kCap);
-    EXPECT_EQ(eng.max, kCap);
-    EXPECT_EQ(que.max, kCap);
+    // Same stats as the histogram backend
+    const LatencyStats stats = metrics.getEngineStats();
+    EXPECT_EQ(stats.count, 4u);
+    EXPECT_EQ(stats.p50, 200u);
+    EXPECT_EQ(stats.max, 5000u);
 }
 
 } // namespace
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include "network/metrics_publisher.hpp"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace hft
+{
+namespace
+{
+
+MetricsSnapshot makeSnapshot(uint64_t orders)
+{
+    MetricsSnapshot snapshot;
+    snapshot.publishedNs = getCurrentTimeNs();
+    snapshot.engineCount = 1;
+    snapshot.status.orders = orders;
+    snapshot.status.bookDepth = 7;
+    snapshot.total.p99 = 1234;
+    snapshot.total.count = orders;
+    return snapshot;
+}
+
+std::string httpGet(int port)
+{
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return "";
+    }
+    const std::string request = "GET /metrics HTTP/1.0\r\n\r\n";
+    (void)send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char buffer[4096];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+    {
+        response.append(buffer, static_cast<size_t>(received));
+    }
+    close(fd);
+    return response;
+}
+
+TEST(MetricsPublisherTest, FormatsPrometheusText)
+{
+    const std::string text = formatMetricsSnapshot(makeSnapshot(42));
+    EXPECT_NE(text.find("hft_orders_total 42\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_book_depth 7\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_latency_ns{series=\"total\",quantile=\"0.99\"} 1234\n"), std::string::npos);
+    EXPECT_NE(text.find("hft_latency_ns_count{series=\"engine\"} 0\n"), std::string::npos);
+}
+
+TEST(MetricsPublisherTest, RepublishesEveryInterval)
+{
+    std::atomic<uint64_t> calls{0};
+    MetricsPublisher publisher([&]() { return makeSnapshot(++calls); }, std::chrono::milliseconds(5));
+    publisher.start();
+    EXPECT_GE(publisher.latest().status.orders, 1u); // start() publishes before returning
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (publisher.latest().status.orders < 3 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(publisher.latest().status.orders, 3u);
+    publisher.stop();
+    EXPECT_EQ(publisher.latest().status.orders, calls.load()); // stop() publishes once more
+}
+
+TEST(MetricsPublisherTest, ServesSnapshotOverHttp)
+{
+    MetricsPublisher publisher([]() { return makeSnapshot(99); }, std::chrono::milliseconds(10));
+    publisher.setHttpPort(0);
+    publisher.start();
+    ASSERT_GT(publisher.getHttpPort(), 0);
+
+    const std::string response = httpGet(publisher.getHttpPort());
+    publisher.stop();
+
+    EXPECT_EQ(response.rfind("HTTP/1.0 200 OK\r\n", 0), 0u);
+    EXPECT_NE(response.find("hft_orders_total 99\n"), std::string::npos);
+}
+
+TEST(MetricsPublisherTest, SharedFileIsReadableFromOutside)
+{
+    const std::string path = "/tmp/hft_metrics_publisher_test_" + std::to_string(getpid());
+    {
+        std::atomic<uint64_t> orders{10};
+        MetricsPublisher publisher([&]() { return makeSnapshot(orders.load()); }, std::chrono::milliseconds(5));
+        publisher.setSharedFile(path);
+        publisher.start();
+        EXPECT_EQ(MetricsPublisher::readSharedFile(path).status.orders, 10u);
+
+        orders.store(11);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (MetricsPublisher::readSharedFile(path).status.orders != 11 &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(MetricsPublisher::readSharedFile(path).status.orders, 11u);
+    }
+    // The file outlives the publisher with its final snapshot
+    const MetricsSnapshot last = MetricsPublisher::readSharedFile(path);
+    EXPECT_EQ(last.status.orders, 11u);
+    EXPECT_EQ(last.status.bookDepth, 7u);
+    std::remove(path.c_str());
+}
+
+TEST(MetricsPublisherTest, ReadSharedFileRejectsOtherFiles)
+{
+    const std::string path = "/tmp/hft_metrics_publisher_foreign_" + std::to_string(getpid());
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(4096, 'x');
+    }
+    EXPECT_THROW(MetricsPublisher::readSharedFile(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(MetricsPublisher::readSharedFile(path), std::runtime_error);
+}
+
+} // namespace
+} // namespace hft
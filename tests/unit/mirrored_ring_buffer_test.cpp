@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+#include "network/mirrored_ring_buffer.hpp"
+
+namespace hft
+{
+namespace
+{
+
+std::string_view view(std::span<const char> bytes)
+{
+    return {bytes.data(), bytes.size()};
+}
+
+void write(MirroredRingBuffer &buffer, std::string_view bytes)
+{
+    ASSERT_GE(buffer.writable(), bytes.size());
+    std::memcpy(buffer.writeData(), bytes.data(), bytes.size());
+    buffer.commit(bytes.size());
+}
+
+// Leaves the read position `offset` bytes into the ring with `pending` unread bytes
+void advanceTo(MirroredRingBuffer &buffer, std::size_t offset, std::string_view pending)
+{
+    write(buffer, std::string(offset, 'x'));
+    write(buffer, pending);
+    buffer.consume(offset);
+}
+
+TEST(MirroredRingBufferTest, CapacityIsRoundedToWholePages)
+{
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    MirroredRingBuffer buffer(1);
+
+    EXPECT_EQ(buffer.capacity(), page);
+    EXPECT_EQ(buffer.writable(), page);
+    EXPECT_EQ(buffer.size(), 0u);
+}
+
+TEST(MirroredRingBufferTest, FrameWrappingTheEndStaysContiguous)
+{
+    MirroredRingBuffer buffer(4096);
+    if (!buffer.isMirrored())
+    {
+        GTEST_SKIP() << "double mapping unavailable";
+    }
+    const std::size_t capacity = buffer.capacity();
+    advanceTo(buffer, capacity - 8, "8=FIX.4.");
+
+    // The free space itself wraps: this write lands on the first page through the second mapping
+    write(buffer, "4\x01" "35=D\x01");
+
+    EXPECT_EQ(view(buffer.readable()), "8=FIX.4.4\x01" "35=D\x01");
+    buffer.consume(10);
+    EXPECT_EQ(view(buffer.readable()), "35=D\x01");
+}
+
+TEST(MirroredRingBufferTest, PartialFrameIsNeverMoved)
+{
+    MirroredRingBuffer buffer(4096);
+    if (!buffer.isMirrored())
+    {
+        GTEST_SKIP() << "double mapping unavailable";
+    }
+    write(buffer, "complete|partial");
+    buffer.consume(9);
+    const char *partial = buffer.readable().data();
+
+    write(buffer, "-rest");
+
+    EXPECT_EQ(buffer.readable().data(), partial);
+    EXPECT_EQ(view(buffer.readable()), "partial-rest");
+}
+
+TEST(MirroredRingBufferTest, DrainingRestartsAtTheFirstPage)
+{
+    MirroredRingBuffer buffer(4096);
+    write(buffer, "abc");
+    const char *start = buffer.readable().data();
+    buffer.consume(3);
+
+    EXPECT_EQ(buffer.size(), 0u);
+    EXPECT_EQ(buffer.writeData(), start);
+    EXPECT_EQ(buffer.writable(), buffer.capacity());
+}
+
+TEST(MirroredRingBufferTest, UnmirroredFallbackCompactsBeforeWriting)
+{
+    MirroredRingBuffer buffer(4096, false);
+    ASSERT_FALSE(buffer.isMirrored());
+    advanceTo(buffer, buffer.capacity() - 4, "8=FI");
+
+    write(buffer, "X.4.4");
+
+    EXPECT_EQ(view(buffer.readable()), "8=FIX.4.4");
+    EXPECT_EQ(buffer.writable(), buffer.capacity() - 9);
+}
+
+TEST(MirroredRingBufferTest, GrowKeepsUnreadBytesUpToTheLimit)
+{
+    MirroredRingBuffer buffer(4096);
+    const std::size_t capacity = buffer.capacity();
+    advanceTo(buffer, capacity / 2, std::string(capacity / 2, 'p'));
+    write(buffer, std::string(capacity / 2, 'q'));
+    ASSERT_EQ(buffer.writable(), 0u);
+
+    ASSERT_TRUE(buffer.grow(4 * capacity));
+    EXPECT_EQ(buffer.capacity(), 2 * capacity);
+    EXPECT_EQ(view(buffer.readable()), std::string(capacity / 2, 'p') + std::string(capacity / 2, 'q'));
+    EXPECT_EQ(buffer.writable(), capacity);
+
+    EXPECT_TRUE(buffer.grow(4 * capacity));
+    EXPECT_FALSE(buffer.grow(4 * capacity));
+    EXPECT_EQ(buffer.capacity(), 4 * capacity);
+    EXPECT_EQ(buffer.size(), capacity);
+}
+
+} // namespace
+} // namespace hft
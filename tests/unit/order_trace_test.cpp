@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "core/order_trace.hpp"
+
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace hft
+{
+namespace
+{
+
+// Every field derived from n, so a torn record (fields from two different orders) is detectable
+OrderTraceRecord makeRecord(uint64_t n)
+{
+    return {n, n + 1, n + 2, n + 3, n + 4, n + 5, static_cast<uint32_t>(n), static_cast<uint32_t>(n * 3),
+            static_cast<SymbolId>(n % 7), n % 2 ? Side::Sell : Side::Buy, OrderType::Limit, 0};
+}
+
+bool isIntact(const OrderTraceRecord &r)
+{
+    const uint64_t n = r.orderId;
+    return r.sendNs == n + 1 && r.receiveNs == n + 2 && r.dequeueNs == n + 3 && r.engineStart == n + 4 &&
+           r.engineEnd == n + 5 && r.trades == static_cast<uint32_t>(n) && r.depth == static_cast<uint32_t>(n * 3);
+}
+
+TEST(OrderTraceTest, CapacityRoundsUpToPowerOfTwo)
+{
+    EXPECT_EQ(OrderTraceRing(1).capacity(), 2u);
+    EXPECT_EQ(OrderTraceRing(5).capacity(), 8u);
+    EXPECT_EQ(OrderTraceRing(1024).capacity(), 1024u);
+    EXPECT_THROW(OrderTraceRing(0), std::runtime_error);
+}
+
+TEST(OrderTraceTest, KeepsRecordsOldestFirst)
+{
+    OrderTraceRing ring(8);
+    EXPECT_TRUE(ring.snapshot().empty());
+    for (uint64_t n = 0; n < 5; ++n)
+    {
+        ring.record(makeRecord(n));
+    }
+
+    const auto records = ring.snapshot();
+    ASSERT_EQ(records.size(), 5u);
+    for (uint64_t n = 0; n < 5; ++n)
+    {
+        EXPECT_EQ(records[n].orderId, n);
+        EXPECT_TRUE(isIntact(records[n]));
+    }
+}
+
+TEST(OrderTraceTest, OverwritesOldestWhenFull)
+{
+    OrderTraceRing ring(8);
+    for (uint64_t n = 0; n < 21; ++n)
+    {
+        ring.record(makeRecord(n));
+    }
+
+    EXPECT_EQ(ring.recorded(), 21u);
+    const auto records = ring.snapshot();
+    ASSERT_EQ(records.size(), 7u); // The next slot to be written is left out
+    for (uint64_t i = 0; i < records.size(); ++i)
+    {
+        EXPECT_EQ(records[i].orderId, 14 + i);
+    }
+}
+
+TEST(OrderTraceTest, DumpRoundTripsThroughReadChunks)
+{
+    OrderTraceRing first(4);
+    OrderTraceRing second(4);
+    for (uint64_t n = 0; n < 6; ++n)
+    {
+        first.record(makeRecord(n));
+    }
+    second.record(makeRecord(100));
+
+    std::stringstream file;
+    EXPECT_EQ(first.dump(file, 0), 3u);
+    EXPECT_EQ(second.dump(file, 1), 1u);
+
+    const auto chunks = OrderTraceRing::readChunks(file);
+    ASSERT_EQ(chunks.size(), 2u);
+    EXPECT_EQ(chunks[0].engine, 0u);
+    EXPECT_EQ(chunks[0].recorded, 6u);
+    EXPECT_GT(chunks[0].ticksPerNs, 0.0);
+    ASSERT_EQ(chunks[0].records.size(), 3u);
+    EXPECT_EQ(chunks[0].records.front().orderId, 3u);
+    EXPECT_TRUE(isIntact(chunks[0].records.back()));
+    EXPECT_EQ(chunks[1].engine, 1u);
+    ASSERT_EQ(chunks[1].records.size(), 1u);
+    EXPECT_EQ(chunks[1].records[0].orderId, 100u);
+}
+
+TEST(OrderTraceTest, ReadChunksRejectsForeignAndTruncatedFiles)
+{
+    std::stringstream foreign("8=FIX.4.2\x01" "9=5\x01");
+    EXPECT_THROW(OrderTraceRing::readChunks(foreign), std::runtime_error);
+
+    OrderTraceRing ring(4);
+    ring.record(makeRecord(1));
+    std::stringstream full;
+    ring.dump(full, 0);
+    const std::string bytes = full.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 10));
+    EXPECT_THROW(OrderTraceRing::readChunks(truncated), std::runtime_error);
+
+    std::stringstream empty;
+    EXPECT_TRUE(OrderTraceRing::readChunks(empty).empty());
+}
+
+TEST(OrderTraceTest, SnapshotWhileRecordingReturnsOnlyWholeRecords)
+{
+    OrderTraceRing ring(64);
+    std::atomic<bool> done{false};
+    std::thread writer(
+        [&]()
+        {
+            for (uint64_t n = 0; n < 2000000; ++n)
+            {
+                ring.record(makeRecord(n));
+            }
+            done.store(true);
+        });
+
+    size_t snapshots = 0;
+    while (!done.load() || snapshots == 0)
+    {
+        const auto records = ring.snapshot();
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            ASSERT_TRUE(isIntact(records[i])) << "torn record at " << i;
+            if (i > 0)
+            {
+                ASSERT_EQ(records[i].orderId, records[i - 1].orderId + 1);
+            }
+        }
+        ++snapshots;
+    }
+    writer.join();
+    EXPECT_EQ(ring.snapshot().size(), 63u);
+}
+
+} // namespace
+} // namespace hft
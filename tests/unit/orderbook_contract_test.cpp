@@ -94,6 +94,22 @@ TEST_P(OrderBookContractTest, HappyPath_CrossedTradeExecutesAtPassiveRestingPric
     EXPECT_EQ(book->getOrderCount(), 0u);
 }
 
+TEST_P(OrderBookContractTest, HappyPath_TradeCarriesOwningClients)
+{
+    Order bid = makeOrder(1301, 130, 5, Side::Buy);
+    bid.client = 7;
+    Order ask = makeOrder(1302, 130, 5, Side::Sell);
+    ask.client = 9;
+    book->addOrder(bid);
+    book->addOrder(ask);
+
+    auto trades = book->match();
+
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].buyClient, 7u);
+    EXPECT_EQ(trades[0].sellClient, 9u);
+}
+
 TEST_P(OrderBookContractTest, HappyPath_ModifyNonZeroAffectsMatchedQuantity)
 {
     book->addOrder(makeOrder(301, 130, 5, Side::Buy));
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "utils/perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <vector>
+
+namespace hft
+{
+namespace
+{
+
+// Software events exist on every kernel, PMU or not; hardware ones are often missing in VMs
+std::vector<PerfEventSpec> softwareEvents()
+{
+    return {{"task_clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+            {"bogus", 0xFFFF, 0},
+            {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}};
+}
+
+volatile uint64_t sink = 0;
+
+void burn()
+{
+    for (uint64_t i = 0; i < 2000000; ++i)
+    {
+        sink = sink + i;
+    }
+}
+
+TEST(PerfCountersTest, GroupWithoutOpenableEventsIsUnavailable)
+{
+    PerfCounterGroup group({{"bogus", 0xFFFF, 0}});
+    EXPECT_FALSE(group.isAvailable());
+    EXPECT_FALSE(group.has(0));
+    group.enable(); // No-ops
+    group.disable();
+    const auto reading = group.read();
+    EXPECT_EQ(reading.values[0], 0u);
+    EXPECT_EQ(reading.timeRunning, 0u);
+}
+
+TEST(PerfCountersTest, CountsOnlyWhileEnabledAndSkipsUnknownEvents)
+{
+    PerfCounterGroup group(softwareEvents());
+    if (!group.isAvailable())
+    {
+        GTEST_SKIP() << "perf_event_open is not permitted here";
+    }
+    EXPECT_TRUE(group.has(0));
+    EXPECT_FALSE(group.has(1)); // Left out; the events after it keep their indices
+    EXPECT_TRUE(group.has(2));
+
+    const auto stopped = group.read();
+    burn();
+    EXPECT_EQ(group.read().values[0], stopped.values[0]); // Opened disabled
+
+    group.enable();
+    const auto before = group.read();
+    burn();
+    const auto after = group.read();
+    group.disable();
+
+    EXPECT_GT(after.values[0], before.values[0]);
+    EXPECT_EQ(after.values[1], 0u);
+    EXPECT_GT(after.timeRunning, before.timeRunning);
+
+    PerfTotals totals;
+    totals.add(before, after);
+    EXPECT_EQ(totals.regions, 1u);
+    EXPECT_GT(totals.perRegion(0), 0.0);
+}
+
+TEST(PerfCountersTest, TotalsAverageOverRegionsAndScaleForMultiplexing)
+{
+    PerfCounterGroup::Reading before;
+    PerfCounterGroup::Reading after;
+    after.values[0] = 600;
+    after.timeEnabled = 200;
+    after.timeRunning = 100; // Counted half the time: scale by two
+
+    PerfTotals totals;
+    EXPECT_EQ(totals.perRegion(0), 0.0);
+    totals.add(before, after, 3);
+    EXPECT_DOUBLE_EQ(totals.perRegion(0), 400.0);
+
+    PerfTotals other;
+    other.add(before, after, 3);
+    totals.merge(other);
+    EXPECT_EQ(totals.regions, 6u);
+    EXPECT_DOUBLE_EQ(totals.perRegion(0), 400.0);
+}
+
+} // namespace
+} // namespace hft
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "utils/seqlock.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace hft
+{
+namespace
+{
+
+// Odd size on purpose: the last word is only partly used
+struct Sample
+{
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+    uint32_t d;
+};
+
+TEST(SeqLockTest, StartsValueInitialised)
+{
+    SeqLock<Sample> lock;
+    const Sample value = lock.load();
+    EXPECT_EQ(value.a, 0u);
+    EXPECT_EQ(value.d, 0u);
+    EXPECT_EQ(lock.version(), 1u);
+}
+
+TEST(SeqLockTest, LoadReturnsLatestStore)
+{
+    SeqLock<Sample> lock;
+    lock.store({1, 2, 3, 4});
+    lock.store({5, 6, 7, 8});
+
+    const Sample value = lock.load();
+    EXPECT_EQ(value.a, 5u);
+    EXPECT_EQ(value.b, 6u);
+    EXPECT_EQ(value.c, 7u);
+    EXPECT_EQ(value.d, 8u);
+    EXPECT_EQ(lock.version(), 3u);
+
+    Sample again{};
+    EXPECT_TRUE(lock.tryLoad(again));
+    EXPECT_EQ(again.c, 7u);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeAHalfWrittenValue)
+{
+    SeqLock<Sample> lock;
+    std::atomic<bool> done{false};
+    std::thread writer(
+        [&]()
+        {
+            for (uint64_t n = 1; n <= 2000000; ++n)
+            {
+                lock.store({n, n, n, static_cast<uint32_t>(n)});
+            }
+            done.store(true);
+        });
+
+    uint64_t previous = 0;
+    while (!done.load())
+    {
+        const Sample value = lock.load();
+        ASSERT_EQ(value.a, value.b);
+        ASSERT_EQ(value.b, value.c);
+        ASSERT_EQ(static_cast<uint32_t>(value.a), value.d);
+        ASSERT_GE(value.a, previous); // One writer: values only move forward
+        previous = value.a;
+    }
+    writer.join();
+    EXPECT_EQ(lock.load().a, 2000000u);
+}
+
+} // namespace
+} // namespace hft
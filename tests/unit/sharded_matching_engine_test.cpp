@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/sharded_matching_engine.hpp"
+
+namespace hft
+{
+namespace
+{
+
+Order makeOrder(OrderId id, SymbolId symbol)
+{
+    Order order{id, 100, 10, Side::Buy, OrderType::Limit, 0, 0, 0};
+    order.symbol = symbol;
+    return order;
+}
+
+void waitForOrders(const ShardedMatchingEngine &engine, uint64_t expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (engine.getOrderCount() < expected && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+TEST(ShardedMatchingEngineTest, SymbolsArePartitionedByModulo)
+{
+    OrderBookRegistry books("map", 8);
+    ShardedMatchingEngine engine(books, 3);
+
+    EXPECT_EQ(engine.getShardCount(), 3u);
+    EXPECT_EQ(engine.shardFor(0), 0u);
+    EXPECT_EQ(engine.shardFor(4), 1u);
+    EXPECT_EQ(engine.shardFor(5), 2u);
+}
+
+TEST(ShardedMatchingEngineTest, ZeroShardsIsRejected)
+{
+    OrderBookRegistry books("map", 1);
+    EXPECT_THROW(ShardedMatchingEngine(books, 0), std::runtime_error);
+}
+
+TEST(ShardedMatchingEngineTest, OrdersReachTheOwningShardAndBook)
+{
+    OrderBookRegistry books("map", 4);
+    ShardedMatchingEngine engine(books, 2);
+    engine.start();
+
+    // Symbols 0 and 2 -> shard 0, symbol 3 -> shard 1
+    engine.submit(makeOrder(1, 0));
+    engine.submit(makeOrder(2, 2));
+    engine.submit(makeOrder(3, 2));
+    engine.submit(makeOrder(4, 3));
+    waitForOrders(engine, 4);
+    engine.stop();
+
+    EXPECT_EQ(engine.getOrderCount(), 4u);
+    EXPECT_EQ(engine.getShard(0).getMetrics().getOrderCount(), 3u);
+    EXPECT_EQ(engine.getShard(1).getMetrics().getOrderCount(), 1u);
+    EXPECT_EQ(books.get(2).getOrderCount(), 2u);
+    EXPECT_EQ(books.get(3).getOrderCount(), 1u);
+    EXPECT_EQ(books.get(1).getOrderCount(), 0u);
+}
+
+TEST(ShardedMatchingEngineTest, StatusSumsEachShardsOwnBooks)
+{
+    OrderBookRegistry books("map", 4);
+    ShardedMatchingEngine engine(books, 2);
+    engine.setStatusInterval(std::chrono::microseconds(100));
+    engine.start();
+
+    engine.submit(makeOrder(1, 0));
+    engine.submit(makeOrder(2, 1));
+    engine.submit(makeOrder(3, 3));
+    waitForOrders(engine, 3);
+    engine.stop(); // Each shard publishes a final status on exit
+
+    const EngineStatus status = engine.getStatus();
+    EXPECT_EQ(status.orders, 3u);
+    EXPECT_EQ(status.queueDepth, 0u);
+    // Every shard sees all four books; each resting order must be counted once
+    EXPECT_EQ(status.bookDepth, 3u);
+    EXPECT_EQ(engine.getShard(0).getStatus().bookDepth, 1u);
+    EXPECT_EQ(engine.getShard(1).getStatus().bookDepth, 2u);
+    EXPECT_GT(status.publishedNs, 0u);
+}
+
+TEST(ShardedMatchingEngineTest, ConcurrentSubmittersLoseNoOrders)
+{
+    constexpr int producers = 4;
+    constexpr OrderId perProducer = 3000; // Several times the ring capacity to exercise backpressure
+
+    OrderBookRegistry books("map", 8);
+    ShardedMatchingEngine engine(books, 2, IdleStrategyType::Park);
+    engine.start();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back(
+            [&engine, p]()
+            {
+                for (OrderId i = 0; i < perProducer; ++i)
+                {
+                    const OrderId id = static_cast<OrderId>(p) * perProducer + i + 1;
+                    engine.submit(makeOrder(id, static_cast<SymbolId>(id % 8)));
+                }
+            });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    waitForOrders(engine, producers * perProducer);
+    engine.stop();
+
+    EXPECT_EQ(engine.getOrderCount(), static_cast<uint64_t>(producers * perProducer));
+    EXPECT_EQ(engine.getUnroutedOrderCount(), 0u);
+}
+
+TEST(ShardedMatchingEngineTest, AggregatedStatsWeightShardsByOrderCount)
+{
+    OrderBookRegistry books("map", 2);
+    ShardedMatchingEngine engine(books, 2);
+    engine.start();
+
+    for (OrderId id = 1; id <= 10; ++id)
+    {
+        engine.submit(makeOrder(id, static_cast<SymbolId>(id % 2)));
+    }
+    waitForOrders(engine, 10);
+    engine.stop();
+
+    const LatencyStats merged = engine.getEngineStats();
+    const LatencyStats shard0 = engine.getShard(0).getMetrics().getEngineStats();
+    const LatencyStats shard1 = engine.getShard(1).getMetrics().getEngineStats();
+
+    EXPECT_EQ(merged.max, std::max(shard0.max, shard1.max));
+    EXPECT_EQ(merged.p99, std::max(shard0.p99, shard1.p99));
+    EXPECT_NEAR(merged.mean, (shard0.mean + shard1.mean) / 2.0, 1e-6); // 5 orders each
+}
+
+} // namespace
+} // namespace hft
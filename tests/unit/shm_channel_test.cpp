@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "network/shared_memory.hpp"
+#include "network/shm_channel.hpp"
+#include "network/transport.hpp"
+
+namespace hft
+{
+namespace
+{
+
+using namespace std::chrono_literals;
+
+// The consumer side as the gateway gets it: a copy of the producer's descriptor
+std::unique_ptr<ShmChannel> attachTo(const ShmChannel &producer)
+{
+    return ShmChannel::attach(dup(producer.fd()));
+}
+
+std::string receiveAll(ShmChannel &consumer, size_t length)
+{
+    std::string received(length, '\0');
+    size_t offset = 0;
+    while (offset < length)
+    {
+        const ssize_t count = consumer.receive(received.data() + offset, length - offset, 100ms,
+                                               IdleStrategyType::Pause);
+        if (count <= 0)
+        {
+            break;
+        }
+        offset += static_cast<size_t>(count);
+    }
+    received.resize(offset);
+    return received;
+}
+
+TEST(ShmChannelTest, CapacityIsAPowerOfTwo)
+{
+    auto producer = ShmChannel::create(5000);
+    EXPECT_EQ(producer->capacity(), 8192u);
+    EXPECT_EQ(attachTo(*producer)->capacity(), 8192u);
+}
+
+TEST(ShmChannelTest, BytesWrittenArriveInOrderAcrossTheWrap)
+{
+    auto producer = ShmChannel::create(4096);
+    auto consumer = attachTo(*producer);
+
+    // 3000 + 3000 bytes: the second write wraps past the end of the 4096-byte ring
+    const std::string first(3000, 'a');
+    std::string second;
+    for (int i = 0; i < 3000; ++i)
+    {
+        second.push_back(static_cast<char>('0' + i % 10));
+    }
+    ASSERT_TRUE(producer->write(first.data(), first.size(), 100ms));
+    EXPECT_EQ(receiveAll(*consumer, first.size()), first);
+    ASSERT_TRUE(producer->write(second.data(), second.size(), 100ms));
+    EXPECT_EQ(receiveAll(*consumer, second.size()), second);
+}
+
+TEST(ShmChannelTest, ReceiveTimesOutLikeASocket)
+{
+    auto producer = ShmChannel::create(4096);
+    auto consumer = attachTo(*producer);
+    char buffer[16];
+
+    errno = 0;
+    EXPECT_EQ(consumer->receive(buffer, sizeof(buffer), 5ms, IdleStrategyType::Pause), -1);
+    EXPECT_EQ(errno, EAGAIN);
+}
+
+TEST(ShmChannelTest, ClosedProducerIsEndOfStreamAfterTheLastByte)
+{
+    auto producer = ShmChannel::create(4096);
+    auto consumer = attachTo(*producer);
+    ASSERT_TRUE(producer->write("tail", 4, 100ms));
+    producer.reset();
+
+    char buffer[16];
+    EXPECT_EQ(consumer->receive(buffer, sizeof(buffer), 100ms, IdleStrategyType::Pause), 4);
+    EXPECT_EQ(consumer->receive(buffer, sizeof(buffer), 100ms, IdleStrategyType::Pause), 0);
+}
+
+TEST(ShmChannelTest, FullRingWaitsForTheConsumer)
+{
+    auto producer = ShmChannel::create(4096);
+    auto consumer = attachTo(*producer);
+    const std::string payload(3 * producer->capacity(), 'x');
+
+    std::string received;
+    std::thread reader([&]() { received = receiveAll(*consumer, payload.size()); });
+    EXPECT_TRUE(producer->write(payload.data(), payload.size(), 1000ms));
+    reader.join();
+    EXPECT_EQ(received, payload);
+}
+
+TEST(ShmChannelTest, WriteFailsOnceTheConsumerIsGone)
+{
+    auto producer = ShmChannel::create(4096);
+    attachTo(*producer).reset();
+
+    EXPECT_FALSE(producer->write("x", 1, 10ms));
+}
+
+TEST(ShmChannelTest, AttachRejectsMemoryThatIsNotARing)
+{
+    const int memoryFd = createSharedMemory(8192, "not-a-ring");
+    ASSERT_GE(memoryFd, 0);
+    EXPECT_THROW(ShmChannel::attach(memoryFd), std::runtime_error);
+}
+
+TEST(ShmChannelTest, DescriptorCrossesAUnixSocket)
+{
+    int sockets[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    auto producer = ShmChannel::create(4096);
+
+    ASSERT_TRUE(sendDescriptor(sockets[0], producer->fd()));
+    const int received = receiveDescriptor(sockets[1]);
+    ASSERT_GE(received, 0);
+    auto consumer = ShmChannel::attach(received);
+    ASSERT_TRUE(producer->write("35=D", 4, 100ms));
+    EXPECT_EQ(receiveAll(*consumer, 4), "35=D");
+
+    close(sockets[0]);
+    EXPECT_EQ(receiveDescriptor(sockets[1]), -1); // Peer gone, nothing attached
+    close(sockets[1]);
+}
+
+TEST(TransportEndpointTest, NamesRoundTrip)
+{
+    for (const std::string &name : TransportEndpoint::getSupportedKinds())
+    {
+        EXPECT_EQ(TransportEndpoint::kindToString(TransportEndpoint::kindFromString(name)), name);
+    }
+    EXPECT_THROW(TransportEndpoint::kindFromString("rdma"), std::runtime_error);
+
+    const TransportEndpoint unixEndpoint{TransportKind::Unix, 4242, ""};
+    EXPECT_EQ(unixEndpoint.socketPath(), "/tmp/hft-gateway-4242.sock");
+    EXPECT_EQ(unixEndpoint.describe(), "unix:/tmp/hft-gateway-4242.sock");
+    EXPECT_EQ((TransportEndpoint{TransportKind::Tcp, 4242, ""}.describe()), "tcp:4242");
+}
+
+} // namespace
+} // namespace hft
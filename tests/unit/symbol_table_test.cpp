@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "core/order_book_registry.hpp"
+#include "core/symbol_table.hpp"
+
+namespace hft
+{
+namespace
+{
+
+TEST(SymbolTableTest, InternAssignsDenseIdsInRegistrationOrder)
+{
+    SymbolTable symbols;
+    EXPECT_EQ(symbols.intern("AAPL"), 0u);
+    EXPECT_EQ(symbols.intern("MSFT"), 1u);
+    EXPECT_EQ(symbols.intern("AAPL"), 0u); // Re-interning returns the existing id
+    EXPECT_EQ(symbols.size(), 2u);
+    EXPECT_EQ(symbols.name(1), "MSFT");
+}
+
+TEST(SymbolTableTest, FindReturnsInvalidForUnknownSymbol)
+{
+    SymbolTable symbols;
+    symbols.intern("AAPL");
+    EXPECT_EQ(symbols.find("AAPL"), 0u);
+    EXPECT_EQ(symbols.find("GOOG"), SymbolTable::INVALID_SYMBOL);
+    EXPECT_TRUE(symbols.name(7).empty());
+}
+
+TEST(SymbolTableTest, EmptyNameIsRejected)
+{
+    SymbolTable symbols;
+    EXPECT_THROW(symbols.intern(""), std::runtime_error);
+}
+
+TEST(SymbolTableTest, PriceDecimalsDefaultToWholeTicks)
+{
+    SymbolTable symbols = SymbolTable::makeSynthetic(2, 4);
+    symbols.intern("AAPL");
+    EXPECT_EQ(symbols.priceDecimals(1), 4u);
+    EXPECT_EQ(symbols.priceDecimals(2), 0u);
+
+    symbols.setPriceDecimals(2, 2);
+    EXPECT_EQ(symbols.priceDecimals(2), 2u);
+    EXPECT_THROW(symbols.setPriceDecimals(3, 2), std::runtime_error);
+    EXPECT_THROW(symbols.setPriceDecimals(0, SymbolTable::MAX_PRICE_DECIMALS + 1), std::runtime_error);
+}
+
+TEST(SymbolTableTest, SyntheticTableMatchesSyntheticNames)
+{
+    SymbolTable symbols = SymbolTable::makeSynthetic(100);
+    ASSERT_EQ(symbols.size(), 100u);
+    for (SymbolId id = 0; id < 100; ++id)
+    {
+        EXPECT_EQ(symbols.find(SymbolTable::syntheticName(id)), id);
+    }
+}
+
+TEST(OrderBookRegistryTest, BuildsOneIndependentBookPerSymbol)
+{
+    OrderBookRegistry books("pool", std::vector<Index>{4, 1});
+    ASSERT_EQ(books.size(), 2u);
+    EXPECT_TRUE(books.contains(1));
+    EXPECT_FALSE(books.contains(2));
+
+    books.get(0).addOrder(Order{1, 100, 10, Side::Buy, OrderType::Limit, 0, 0, 0});
+    EXPECT_EQ(books.get(0).getOrderCount(), 1u);
+    EXPECT_EQ(books.get(1).getOrderCount(), 0u);
+}
+
+TEST(OrderBookRegistryTest, ZeroSymbolsIsRejected)
+{
+    EXPECT_THROW(OrderBookRegistry("map", 0), std::runtime_error);
+}
+
+} // namespace
+} // namespace hft
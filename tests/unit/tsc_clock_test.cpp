@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "core/metrics_collector.hpp"
+#include "utils/rdtsc.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace hft
+{
+namespace
+{
+
+TEST(TscClockTest, CalibrationIsConsistent)
+{
+    const TscClock::Calibration &calibration = TscClock::calibrate();
+    EXPECT_EQ(&calibration, &TscClock::calibrate());
+    EXPECT_NEAR(calibration.ticksPerNs * calibration.nsPerTick, 1.0, 1e-9);
+    if (calibration.usesTsc)
+    {
+        EXPECT_TRUE(TscClock::hasInvariantTsc());
+        EXPECT_GT(calibration.ticksPerNs, 0.05);
+        EXPECT_LT(calibration.ticksPerNs, 20.0);
+    }
+    else
+    {
+        EXPECT_DOUBLE_EQ(calibration.ticksPerNs, 1.0);
+    }
+}
+
+TEST(TscClockTest, ReadsNeverGoBackwards)
+{
+    uint64_t previous = TscClock::now();
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint64_t begin = TscClock::start();
+        const uint64_t end = TscClock::stop();
+        EXPECT_GE(begin, previous);
+        EXPECT_GE(end, begin);
+        previous = end;
+    }
+}
+
+TEST(TscClockTest, TicksConvertToSteadyClockTime)
+{
+    const auto steadyBegin = std::chrono::steady_clock::now();
+    const uint64_t begin = TscClock::start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const uint64_t end = TscClock::stop();
+    const auto steadyEnd = std::chrono::steady_clock::now();
+
+    const double steadyNs = std::chrono::duration<double, std::nano>(steadyEnd - steadyBegin).count();
+    const double tscNs = TscClock::toNs(static_cast<double>(end - begin));
+    // The TSC interval sits inside the steady_clock one; a loose bound tolerates calibration error
+    EXPECT_LE(tscNs, steadyNs * 1.05);
+    EXPECT_GE(tscNs, 20e6 * 0.95);
+}
+
+TEST(TscClockTest, NanosecondRoundTrip)
+{
+    for (uint64_t ns : {0ULL, 1000ULL, 123456789ULL, 5000000000ULL})
+    {
+        const double back = TscClock::toNs(static_cast<double>(TscClock::fromNs(ns)));
+        EXPECT_NEAR(back, static_cast<double>(ns), 1.0 + static_cast<double>(ns) * 1e-9);
+    }
+}
+
+TEST(TscClockTest, StatsConvertToNanoseconds)
+{
+    LatencyStats ticks;
+    ticks.mean = static_cast<double>(TscClock::fromNs(1500));
+    ticks.p50 = TscClock::fromNs(1000);
+    ticks.p99 = TscClock::fromNs(4000);
+    ticks.max = TscClock::fromNs(9000);
+    ticks.count = 42;
+
+    const LatencyStats ns = toNanoseconds(ticks);
+    EXPECT_NEAR(ns.mean, 1500.0, 1.0);
+    EXPECT_NEAR(static_cast<double>(ns.p50), 1000.0, 1.0);
+    EXPECT_NEAR(static_cast<double>(ns.p99), 4000.0, 1.0);
+    EXPECT_NEAR(static_cast<double>(ns.max), 9000.0, 1.0);
+    EXPECT_EQ(ns.count, 42u);
+}
+
+} // namespace
+} // namespace hft
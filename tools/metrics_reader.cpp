@@ -0,0 +1,75 @@
+#include "network/metrics_publisher.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace hft;
+
+namespace
+{
+
+void printUsage()
+{
+    std::cout << "Usage: metrics_reader <file> [options]\n"
+              << "Prints the snapshot an hft_exchange_server --metrics-file publishes, without touching the server.\n"
+              << "Options:\n"
+              << "  --watch <ms>  (reprint every ms milliseconds until interrupted)\n"
+              << "  --help        (show this help and exit)\n";
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string path;
+    long watchMs = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--watch" && i + 1 < argc)
+        {
+            watchMs = std::stol(argv[++i]);
+        }
+        else if (path.empty() && arg.rfind("--", 0) != 0)
+        {
+            path = arg;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (path.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        do
+        {
+            std::cout << formatMetricsSnapshot(MetricsPublisher::readSharedFile(path));
+            if (watchMs > 0)
+            {
+                std::cout << std::endl;
+                std::this_thread::sleep_for(std::chrono::milliseconds(watchMs));
+            }
+        } while (watchMs > 0);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
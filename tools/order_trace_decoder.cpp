@@ -0,0 +1,169 @@
+#include "core/order_trace.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace hft;
+
+namespace
+{
+
+void printUsage()
+{
+    std::cout << "Usage: order_trace_decoder <dump> [options]\n"
+              << "Decodes an hft_exchange_server --trace dump (one chunk per engine thread).\n"
+              << "Options:\n"
+              << "  --top <n>    (print the n slowest orders instead of every order as CSV)\n"
+              << "  --help       (show this help and exit)\n";
+}
+
+// One record with its intervals in ns. Intervals the order has no stamps for are -1.
+struct DecodedOrder
+{
+    uint32_t engine;
+    OrderTraceRecord record;
+    int64_t networkNs; // Client send -> gateway receive (both wall clock; skewed if the client is remote)
+    int64_t queueNs;   // Gateway receive -> engine dequeue
+    int64_t engineNs;  // Book work (addOrder + match)
+    int64_t totalNs;   // First stamp -> match done; engineNs alone in direct mode
+};
+
+int64_t interval(uint64_t from, uint64_t to)
+{
+    return from > 0 && to >= from ? static_cast<int64_t>(to - from) : -1;
+}
+
+DecodedOrder decode(const OrderTraceChunk &chunk, const OrderTraceRecord &record)
+{
+    DecodedOrder order{chunk.engine, record, -1, -1, -1, -1};
+    order.networkNs = record.receiveNs > 0 ? interval(record.sendNs, record.receiveNs) : -1;
+    order.queueNs = interval(record.receiveNs, record.dequeueNs);
+    const double engineTicks = static_cast<double>(record.engineEnd - record.engineStart);
+    order.engineNs = static_cast<int64_t>(engineTicks / chunk.ticksPerNs + 0.5);
+    const int64_t waited = interval(record.sendNs > 0 ? record.sendNs : record.receiveNs, record.dequeueNs);
+    order.totalNs = waited >= 0 ? waited + order.engineNs : order.engineNs;
+    return order;
+}
+
+std::string formatNs(int64_t ns)
+{
+    return ns >= 0 ? std::to_string(ns) : "";
+}
+
+void printCsv(const std::vector<DecodedOrder> &orders)
+{
+    std::cout << "Engine,OrderId,Symbol,Side,Type,Send_ns,Receive_ns,Dequeue_ns,Network_ns,Queue_ns,Engine_ns,"
+                 "Total_ns,Trades,Depth\n";
+    for (const auto &order : orders)
+    {
+        const OrderTraceRecord &r = order.record;
+        std::cout << order.engine << "," << r.orderId << "," << r.symbol << ","
+                  << (r.side == Side::Buy ? "buy" : "sell") << "," << (r.type == OrderType::Limit ? "limit" : "market")
+                  << "," << r.sendNs << "," << r.receiveNs << "," << r.dequeueNs << "," << formatNs(order.networkNs)
+                  << "," << formatNs(order.queueNs) << "," << order.engineNs << "," << order.totalNs << ","
+                  << r.trades << "," << r.depth << "\n";
+    }
+}
+
+void printTop(std::vector<DecodedOrder> orders, size_t count)
+{
+    count = std::min(count, orders.size());
+    std::partial_sort(orders.begin(), orders.begin() + static_cast<std::ptrdiff_t>(count), orders.end(),
+                      [](const DecodedOrder &a, const DecodedOrder &b) { return a.totalNs > b.totalNs; });
+
+    std::cout << std::left << std::setw(8) << "Engine" << std::setw(14) << "OrderId" << std::right << std::setw(8)
+              << "Symbol" << std::setw(12) << "Network" << std::setw(12) << "Queue" << std::setw(12) << "Engine"
+              << std::setw(12) << "Total" << std::setw(8) << "Trades" << std::setw(8) << "Depth"
+              << "  (ns)\n"
+              << std::string(94, '-') << "\n";
+    for (size_t i = 0; i < count; ++i)
+    {
+        const DecodedOrder &order = orders[i];
+        std::cout << std::left << std::setw(8) << order.engine << std::setw(14) << order.record.orderId << std::right
+                  << std::setw(8) << order.record.symbol << std::setw(12) << formatNs(order.networkNs)
+                  << std::setw(12) << formatNs(order.queueNs) << std::setw(12) << order.engineNs << std::setw(12)
+                  << order.totalNs << std::setw(8) << order.record.trades << std::setw(8) << order.record.depth
+                  << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string path;
+    size_t top = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--top" && i + 1 < argc)
+        {
+            top = std::stoul(argv[++i]);
+        }
+        else if (path.empty() && arg.rfind("--", 0) != 0)
+        {
+            path = arg;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown or incomplete option: " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (path.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            throw std::runtime_error("cannot open " + path);
+        }
+        const std::vector<OrderTraceChunk> chunks = OrderTraceRing::readChunks(in);
+
+        std::vector<DecodedOrder> orders;
+        for (const auto &chunk : chunks)
+        {
+            // Summary on stderr so stdout stays plain CSV
+            std::cerr << "Engine " << chunk.engine << ": " << chunk.records.size() << " of " << chunk.recorded
+                      << " orders traced (TSC " << std::fixed << std::setprecision(3) << chunk.ticksPerNs
+                      << " ticks/ns)\n";
+            for (const auto &record : chunk.records)
+            {
+                orders.push_back(decode(chunk, record));
+            }
+        }
+
+        if (top > 0)
+        {
+            printTop(std::move(orders), top);
+        }
+        else
+        {
+            printCsv(orders);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}